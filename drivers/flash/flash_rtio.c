@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/flash.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/work.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(flash_rtio, CONFIG_FLASH_LOG_LEVEL);
+
+static int flash_iodev_do(const struct device *dev, const struct rtio_sqe *sqe)
+{
+	off_t offset = (off_t)sqe->storage.offset;
+
+	/* Offsets beyond a 32 bit off_t */
+	if (offset < 0) {
+		return -EINVAL;
+	}
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_RX:
+		return flash_read(dev, offset, sqe->rx.buf, sqe->rx.buf_len);
+	case RTIO_OP_TX:
+		return flash_write(dev, offset, sqe->tx.buf, sqe->tx.buf_len);
+	case RTIO_OP_TINY_TX:
+		return flash_write(dev, offset, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len);
+	case RTIO_OP_ERASE:
+		return flash_erase(dev, offset, sqe->storage.buf_len);
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EINVAL;
+	}
+}
+
+static void flash_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const struct flash_iodev_data *data = txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	int rc;
+
+	LOG_DBG("Sync RTIO work item for: %p", (void *)txn_first);
+
+	do {
+		rc = flash_iodev_do(data->dev, &txn_curr->sqe);
+		txn_curr = rtio_txn_next(txn_curr);
+	} while ((rc == 0) && (txn_curr != NULL));
+
+	if (rc != 0) {
+		rtio_iodev_sqe_err(txn_first, rc);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, 0);
+	}
+}
+
+static void flash_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct flash_iodev_data *data = iodev_sqe->sqe.iodev->data;
+
+	rtio_work_queue_submit(&data->queue, iodev_sqe, flash_iodev_submit_work_handler);
+}
+
+const struct rtio_iodev_api flash_iodev_api = {
+	.submit = flash_iodev_submit,
+};
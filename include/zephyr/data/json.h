@@ -74,6 +74,75 @@ struct json_obj_token {
 	size_t length;
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_JSON_STREAM_MAX_DEPTH
+#define Z_JSON_STREAM_MAX_DEPTH CONFIG_JSON_STREAM_MAX_DEPTH
+#else
+#define Z_JSON_STREAM_MAX_DEPTH 8
+#endif
+
+struct json_obj_descr;
+
+/* Object or array being decoded by a struct json_stream */
+struct json_stream_frame {
+	/* Object: field descriptors. Array: element descriptor */
+	const struct json_obj_descr *descr;
+	/* Object: struct being decoded. Array: struct holding the count */
+	void *val;
+	union {
+		struct {
+			size_t descr_len;
+			int64_t decoded;
+			/* Field of the key just read, -1 to skip its value */
+			int field;
+		} obj;
+		struct {
+			char *field;
+			char *last;
+			size_t *count;
+			ptrdiff_t elem_size;
+		} arr;
+	};
+	uint8_t type;
+	uint8_t state;
+};
+
+/** @endcond */
+
+/**
+ * @brief Incremental JSON parser state
+ *
+ * Set up with json_stream_obj_init() or json_stream_arr_init() and feed
+ * with json_stream_feed(). All the members are private.
+ */
+struct json_stream {
+	/** @cond INTERNAL_HIDDEN */
+	/* Scratch buffer for decoded values, NULL to decode in place */
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+
+	/* Token split across calls */
+	char *tok_start;
+	size_t tok_len;
+	uint8_t tok;
+	uint8_t tok_state;
+	bool tok_store;
+
+	/* Values skipped or captured whole (JSON_TOK_OBJ_ARRAY) */
+	size_t skip_depth;
+	struct json_obj_token *capture;
+	char *capture_start;
+	size_t capture_len;
+
+	enum json_tokens root;
+	int64_t result;
+	size_t depth;
+	struct json_stream_frame stack[Z_JSON_STREAM_MAX_DEPTH];
+	/** @endcond */
+};
+
 
 struct json_obj_descr {
 	const char *field_name;
@@ -672,6 +741,71 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief Initialize incremental parsing of a JSON-encoded object
+ *
+ * Sets up @a stream to decode an object according to the descriptor pointed
+ * to by @a descr into the struct pointed to by @a val, from data passed in
+ * chunks of any size to json_stream_feed(). This accepts the same input and
+ * fills @a val the same way as json_obj_parse(), without needing the whole
+ * payload in one buffer.
+ *
+ * Tokens may be split across chunks, so decoded strings, and the
+ * @ref json_obj_token of JSON_TOK_OPAQUE, JSON_TOK_FLOAT and
+ * JSON_TOK_OBJ_ARRAY values, are copied to @a buf, where they are
+ * NUL-terminated. It must outlive @a val and be large enough to hold them
+ * as well as the longest key or number.
+ *
+ * @param stream Parser state
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be less
+ * than 63.
+ * @param val Pointer to the struct to hold the decoded values
+ * @param buf Scratch buffer for the decoded values
+ * @param buf_size Size of @a buf
+ *
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+int json_stream_obj_init(struct json_stream *stream, const struct json_obj_descr *descr,
+			 size_t descr_len, void *val, char *buf, size_t buf_size);
+
+/**
+ * @brief Initialize incremental parsing of a JSON-encoded array
+ *
+ * Same as json_stream_obj_init(), for an array decoded like
+ * json_arr_parse() does.
+ *
+ * @param stream Parser state
+ * @param descr Pointer to the array descriptor
+ * @param val Pointer to the struct to hold the decoded values
+ * @param buf Scratch buffer for the decoded values
+ * @param buf_size Size of @a buf
+ *
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+int json_stream_arr_init(struct json_stream *stream, const struct json_obj_descr *descr,
+			 void *val, char *buf, size_t buf_size);
+
+/**
+ * @brief Feed the next chunk of JSON-encoded data to an incremental parser
+ *
+ * Values are stored in the struct given at initialization as soon as they
+ * are complete. Data following the end of the top-level value is ignored.
+ *
+ * @param stream Parser state
+ * @param data Next chunk of data, which need not be kept after the call
+ * @param len Length of @a data
+ *
+ * @return -EAGAIN if the top-level value is not complete yet, in which case
+ * more data is needed; once it is complete, the bitmap of decoded fields for
+ * an object, as returned by json_obj_parse(), or 0 for an array; -ENOMEM if
+ * the scratch buffer is too small or the values are nested more than
+ * @kconfig{CONFIG_JSON_STREAM_MAX_DEPTH} deep, or another negative error code
+ * as returned by json_obj_parse(). The result is returned again by any later
+ * call.
+ */
+int64_t json_stream_feed(struct json_stream *stream, const char *data, size_t len);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -27,6 +27,10 @@
 #include <sys/types.h>
 #include <zephyr/device.h>
 
+#if defined(CONFIG_FLASH_RTIO) || defined(__DOXYGEN__)
+#include <zephyr/rtio/work.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -702,6 +706,54 @@ static inline int z_impl_flash_ex_op(const struct device *dev, uint16_t code,
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
 }
 
+#if defined(CONFIG_FLASH_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief Data of a flash iodev defined by FLASH_DT_IODEV_DEFINE
+ */
+struct flash_iodev_data {
+	/** Flash device */
+	const struct device *dev;
+	/** Work queue serializing the operations on the flash device */
+	struct rtio_work_queue queue;
+};
+
+extern const struct rtio_iodev_api flash_iodev_api;
+
+/**
+ * @brief Define an iodev for a flash device
+ *
+ * Read, write and erase submissions prepared with rtio_sqe_prep_read_at(),
+ * rtio_sqe_prep_write_at() and rtio_sqe_prep_erase() are done with
+ * flash_read(), flash_write() and flash_erase() at the byte offset of the
+ * submission. They are done on the RTIO work queue one after the other, in
+ * submission order, so an erase, the write of the erased area and the read
+ * verifying it can be submitted together. The submissions of a transaction
+ * are completed together, and the first failing one fails the transaction.
+ *
+ * @param name Symbolic name of the iodev to define
+ * @param _dev Flash device
+ */
+#define FLASH_IODEV_DEFINE(name, _dev)						\
+	static struct flash_iodev_data _flash_iodev_data_##name = {		\
+		.dev = (_dev),							\
+		.queue = RTIO_WORK_QUEUE_INIT(_flash_iodev_data_##name.queue),	\
+	};									\
+	RTIO_IODEV_DEFINE(name, &flash_iodev_api, &_flash_iodev_data_##name)
+
+/**
+ * @brief Define an iodev for a flash device from a devicetree node
+ *
+ * @param name Symbolic name of the iodev to define
+ * @param node_id Devicetree node identifier of the flash device
+ *
+ * @see FLASH_IODEV_DEFINE
+ */
+#define FLASH_DT_IODEV_DEFINE(name, node_id)					\
+	FLASH_IODEV_DEFINE(name, DEVICE_DT_GET(node_id))
+
+#endif /* CONFIG_FLASH_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
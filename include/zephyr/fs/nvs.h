@@ -33,6 +33,16 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage lookup index entry
+ */
+struct nvs_lookup_index_entry {
+	/** NVS ID, 0xFFFF for a free entry */
+	uint16_t id;
+	/** Address of the most recent allocation table entry of the ID */
+	uint32_t addr;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  */
@@ -62,6 +72,14 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_LOOKUP_INDEX
+	/** Number of IDs in the lookup index */
+	uint16_t lookup_index_count;
+	/** Flag indicating that some IDs did not fit in the lookup index */
+	bool lookup_index_partial;
+	/** Open-addressing table of the most recent allocation table entry of the written IDs */
+	struct nvs_lookup_index_entry lookup_index[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+#endif
 };
 
 /**
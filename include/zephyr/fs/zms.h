@@ -31,6 +31,16 @@ extern "C" {
  * @{
  */
 
+/** Entry of the ZMS lookup index */
+struct zms_lookup_index_entry {
+	/** ZMS ID, `0xFFFFFFFF` for a free entry */
+	uint32_t id;
+	/** Sector of the most recent ATE of the ID */
+	uint32_t sector;
+	/** Offset of the most recent ATE of the ID in its sector */
+	uint32_t offset;
+};
+
 /** Zephyr Memory Storage file system structure */
 struct zms_fs {
 	/** File system offset in flash */
@@ -65,6 +75,28 @@ struct zms_fs {
 	/** Lookup table used to cache ATE addresses of written IDs */
 	uint64_t lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_ZMS_LOOKUP_INDEX
+	/** Number of IDs in the lookup index */
+	uint32_t lookup_index_count;
+	/** Flag indicating that some IDs did not fit in the lookup index */
+	bool lookup_index_partial;
+	/** Open-addressing table of the most recent ATE of the written IDs */
+	struct zms_lookup_index_entry lookup_index[CONFIG_ZMS_LOOKUP_INDEX_SIZE];
+#endif
+#if CONFIG_ZMS_BACKGROUND_GC
+	/** Work running the garbage collection in the background */
+	struct k_work gc_work;
+	/** Address of the next ATE walked by the garbage collection */
+	uint64_t gc_addr;
+	/** Address of the last ATE walked by the garbage collection */
+	uint64_t gc_stop_addr;
+	/** Offset of the end of the data of the ATEs left to walk */
+	uint32_t gc_data_end;
+	/** Cycle counter of the sector walked by the garbage collection */
+	uint8_t gc_cycle;
+	/** State of the garbage collection */
+	uint8_t gc_state;
+#endif
 };
 
 /**
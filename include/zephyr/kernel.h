@@ -3222,6 +3222,7 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
 
 struct k_sem {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 	unsigned int count;
 	unsigned int limit;
 
@@ -5332,12 +5333,33 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define Z_MEM_SLAB_CPU_CACHE_ALIGN CONFIG_DCACHE_LINE_SIZE
+#else
+#define Z_MEM_SLAB_CPU_CACHE_ALIGN 64
+#endif
+
+/* Free blocks set aside for one CPU, on a cache line of its own */
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t num_free;
+} __aligned(Z_MEM_SLAB_CPU_CACHE_ALIGN);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* One per CPU, or NULL if the slab isn't cached */
+	struct k_mem_slab_cpu_cache *cpu_cache;
+	/* Caches are bypassed while threads may be waiting for a block */
+	bool uncached;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5346,16 +5368,35 @@ struct k_mem_slab {
 #endif
 };
 
-#define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
-			       _slab_num_blocks)                      \
+#define Z_MEM_SLAB_CACHED_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
+				      _slab_num_blocks, _slab_cpu_cache)      \
 	{                                                             \
 	.wait_q = Z_WAIT_Q_INIT(&(_slab).wait_q),                     \
 	.lock = {},                                                   \
 	.buffer = _slab_buffer,                                       \
 	.free_list = NULL,                                            \
-	.info = {_slab_num_blocks, _slab_block_size, 0}               \
+	.info = {_slab_num_blocks, _slab_block_size, 0},              \
+	IF_ENABLED(CONFIG_MEM_SLAB_CPU_CACHE,                         \
+		   (.cpu_cache = _slab_cpu_cache,))                   \
 	}
 
+#define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
+			       _slab_num_blocks)                      \
+	Z_MEM_SLAB_CACHED_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
+				      _slab_num_blocks, NULL)
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define Z_MEM_SLAB_CPU_CACHE_DEFINE(name) \
+	static struct k_mem_slab_cpu_cache \
+		_k_mem_slab_cache_##name[CONFIG_MP_MAX_NUM_CPUS];
+#define Z_MEM_SLAB_CPU_CACHE(name) _k_mem_slab_cache_##name
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+#else
+#define Z_MEM_SLAB_CPU_CACHE_DEFINE(name)
+#define Z_MEM_SLAB_CPU_CACHE(name) NULL
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -5394,9 +5435,11 @@ struct k_mem_slab {
 	char __noinit_named(k_mem_slab_buf_##name) \
 	   __aligned(WB_UP(slab_align)) \
 	   _k_mem_slab_buf_##name[(slab_num_blocks) * WB_UP(slab_block_size)]; \
+	Z_MEM_SLAB_CPU_CACHE_DEFINE(name) \
 	STRUCT_SECTION_ITERABLE(k_mem_slab, name) = \
-		Z_MEM_SLAB_INITIALIZER(name, _k_mem_slab_buf_##name, \
-					WB_UP(slab_block_size), slab_num_blocks)
+		Z_MEM_SLAB_CACHED_INITIALIZER(name, _k_mem_slab_buf_##name, \
+					      WB_UP(slab_block_size), slab_num_blocks, \
+					      Z_MEM_SLAB_CPU_CACHE(name))
 
 /**
  * @brief Statically define and initialize a memory slab in a private (static) scope.
@@ -5416,9 +5459,11 @@ struct k_mem_slab {
 	static char __noinit_named(k_mem_slab_buf_##name) \
 	   __aligned(WB_UP(slab_align)) \
 	   _k_mem_slab_buf_##name[(slab_num_blocks) * WB_UP(slab_block_size)]; \
+	Z_MEM_SLAB_CPU_CACHE_DEFINE(name) \
 	static STRUCT_SECTION_ITERABLE(k_mem_slab, name) = \
-		Z_MEM_SLAB_INITIALIZER(name, _k_mem_slab_buf_##name, \
-					WB_UP(slab_block_size), slab_num_blocks)
+		Z_MEM_SLAB_CACHED_INITIALIZER(name, _k_mem_slab_buf_##name, \
+					      WB_UP(slab_block_size), slab_num_blocks, \
+					      Z_MEM_SLAB_CPU_CACHE(name))
 
 /**
  * @brief Initialize a memory slab.
@@ -5492,7 +5537,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5527,7 +5576,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5566,10 +5615,27 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_HEAP_ARENAS
+struct k_heap_arena {
+	struct sys_heap heap;
+	struct k_spinlock lock;
+	/* Blocks freed from other CPUs, not given back to the heap yet */
+	atomic_ptr_t returned;
+	/* End of the arena's memory, arenas are laid out in address order */
+	uintptr_t end;
+};
+#endif /* CONFIG_HEAP_ARENAS */
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_ARENAS
+	/* One per CPU, or NULL if the heap is too small to be split */
+	struct k_heap_arena *arenas;
+	unsigned int num_arenas;
+	atomic_t waiters;
+#endif /* CONFIG_HEAP_ARENAS */
 };
 
 /**
@@ -5698,10 +5764,78 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the memory stats for a k_heap
+ *
+ * This routine gets the runtime memory usage stats for the heap @a h,
+ * summed over all its arenas with CONFIG_HEAP_ARENAS.  The maximum
+ * allocated bytes is then the sum of the maximum of each arena, which
+ * may not have been reached at the same time.
+ *
+ * @param h Address of the heap
+ * @param stats Pointer to memory into which to copy memory usage statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any parameter points to NULL
+ */
+int k_heap_runtime_stats_get(struct k_heap *h, struct sys_memory_stats *stats);
+
+/**
+ * @brief Reset the maximum memory usage for a k_heap
+ *
+ * This routine resets the maximum memory usage for the heap @a h, and
+ * for each of its arenas, to its current usage.
+ *
+ * @param h Address of the heap
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Heap is NULL
+ */
+int k_heap_runtime_stats_reset_max(struct k_heap *h);
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS || __DOXYGEN__ */
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* The size class list heads make the heap metadata in the first chunk
+ * too big for fixed sizes.  The first chunk also holds one bucket per
+ * doubling of the heap size, which two passes over the bucket count
+ * settle for every CONFIG_SYS_HEAP_SIZE_CLASS_MAX.  The heap code checks
+ * that these mirror CHUNK_UNIT and struct z_heap from lib/heap/heap.h.
+ */
+#define Z_HEAP_CHUNK_UNIT 8U
+#define Z_HEAP_SIZE_CLASS_MAX_CHUNKS \
+	((CONFIG_SYS_HEAP_SIZE_CLASS_MAX + 8U + Z_HEAP_CHUNK_UNIT - 1U) / Z_HEAP_CHUNK_UNIT)
+
+struct z_heap_min_size_hdr {
+	uint32_t chunk0_hdr[2];
+	uint32_t end_chunk;
+	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	size_t stats[3];
+#endif
+	uint32_t size_classes[Z_HEAP_SIZE_CLASS_MAX_CHUNKS + 1];
+};
+
+#define Z_HEAP_CHUNK0(chunks)							\
+	DIV_ROUND_UP(sizeof(struct z_heap_min_size_hdr) +			\
+		     sizeof(uint32_t) * (LOG2((chunks) + 1) + 1), Z_HEAP_CHUNK_UNIT)
+#define Z_HEAP_CHUNK0_SIZE							\
+	Z_HEAP_CHUNK0(Z_HEAP_CHUNK0(DIV_ROUND_UP(sizeof(struct z_heap_min_size_hdr), \
+						 Z_HEAP_CHUNK_UNIT)))
+/* Past the first chunk, a 1-byte allocation takes two chunks behind the
+ * big chunk headers of 64-bit targets and one otherwise, and the end
+ * marker takes one more chunk header.
+ */
+#define Z_HEAP_MIN_SIZE								\
+	((sizeof(void *) > 4) ?							\
+	 (Z_HEAP_CHUNK0_SIZE + 2) * Z_HEAP_CHUNK_UNIT + Z_HEAP_CHUNK_UNIT :	\
+	 (Z_HEAP_CHUNK0_SIZE + 1) * Z_HEAP_CHUNK_UNIT + sizeof(uint32_t))
+#else
 #define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASSES */
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -140,6 +140,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* number of threads in runq, used to pick a queue to steal from */
+	unsigned int num_ready;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -157,7 +162,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -213,7 +218,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -317,6 +322,10 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* CPU whose timeout queue this was last armed on */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -76,7 +76,7 @@ struct llext_symbol {
 /**
  * @brief A symbol table
  *
- * An array of symbols
+ * An array of symbols, sorted by name so that it can be binary searched.
  */
 struct llext_symtable {
 	/** Number of symbols in the table */
@@ -214,6 +214,12 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE_T	= BIT(22),
+
+	/** TCP segmentation offload. The driver accepts TCP packets larger
+	 * than the MTU and splits them into segments of net_pkt_gso_size()
+	 * bytes of payload, filling in the IP and TCP checksums of each.
+	 */
+	ETHERNET_HW_TSO			= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -168,6 +168,32 @@ typedef void (*net_context_connect_cb_t)(struct net_context *context,
 					 int status,
 					 void *user_data);
 
+/**
+ * @typedef net_context_zerocopy_cb_t
+ * @brief Zero-copy transmit completion callback.
+ *
+ * @details The callback is called when the network stack has dropped its
+ * last reference to application data that was passed to a zero-copy send,
+ * i.e. after the data was acknowledged (TCP), transmitted (UDP) or dropped
+ * because of an error. The application may reuse or free the data only
+ * after this callback. It is called from the network stack thread (or the
+ * driver context releasing the packet), so it must not block.
+ *
+ * @param data Start of the data range that was released.
+ * @param len Length of the data range that was released.
+ * @param user_data The user data set together with the callback.
+ */
+typedef void (*net_context_zerocopy_cb_t)(const void *data, size_t len,
+					  void *user_data);
+
+/** @brief Value of the NET_OPT_ZEROCOPY context option. */
+struct net_context_zerocopy {
+	/** Completion callback, zero-copy sending is disabled if NULL */
+	net_context_zerocopy_cb_t cb;
+	/** User data passed to the callback */
+	void *user_data;
+};
+
 /* The net_pkt_get_slab_func_t is here in order to avoid circular
  * dependency between net_pkt.h and net_context.h
  */
@@ -309,6 +335,10 @@ __net_socket struct net_context {
 		/** When to send the packet out */
 		bool txtime;
 #endif
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+		/** Zero-copy transmit completion notification */
+		struct net_context_zerocopy zerocopy;
+#endif
 #if defined(CONFIG_SOCKS)
 		/** Socks proxy address */
 		struct {
@@ -1221,6 +1251,10 @@ int net_context_sendto(struct net_context *context,
  * connected socket the msg_name should be set to NULL, and msg_namelen to 0.
  * After the network buffer is sent, a caller-supplied callback is called.
  * Note that the callback might be called after this function has returned.
+ * If ZSOCK_MSG_ZEROCOPY is set in @p flags and a NET_OPT_ZEROCOPY callback
+ * is installed, the iovec data is referenced instead of copied, see
+ * @ref net_context_zerocopy_cb_t. The call returns -ENOBUFS if there are
+ * not enough zero-copy descriptors, the data is never copied instead.
  *
  * @param context The network context to use.
  * @param msghdr The data to send
@@ -1325,6 +1359,7 @@ enum net_context_option {
 	NET_OPT_MCAST_IFINDEX     = 19, /**< IPv6 multicast output network interface index */
 	NET_OPT_MTU               = 20, /**< IPv4 socket path MTU */
 	NET_OPT_LOCAL_PORT_RANGE  = 21, /**< Clamp local port range */
+	NET_OPT_ZEROCOPY          = 22, /**< Zero-copy transmit completion */
 };
 
 /**
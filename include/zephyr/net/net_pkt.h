@@ -273,6 +273,22 @@ struct net_pkt {
 	};
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Segment size of a TCP super-packet that still needs to be
+	 * segmented before it goes out, 0 for a regular packet.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_NATIVE_IP)
+	/* Sum of the last payload_chksum_len bytes of the packet, computed
+	 * while they were written with net_pkt_write_chksum(), so that the
+	 * transport checksum only has to sum the headers up.
+	 */
+	uint16_t payload_chksum;
+	uint16_t payload_chksum_len;
+#endif /* CONFIG_NET_NATIVE_IP */
+
 #if defined(CONFIG_NET_IPV6)
 	/* Where is the start of the last header before payload data
 	 * in IPv6 packet. This is offset value from start of the IPv6
@@ -988,6 +1004,75 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt,
+					uint16_t gso_size)
+{
+	pkt->gso_size = gso_size;
+}
+#else /* CONFIG_NET_TCP_GSO */
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt,
+					uint16_t gso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(gso_size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#if defined(CONFIG_NET_NATIVE_IP)
+static inline uint16_t net_pkt_payload_chksum(struct net_pkt *pkt)
+{
+	return pkt->payload_chksum;
+}
+
+static inline uint16_t net_pkt_payload_chksum_len(struct net_pkt *pkt)
+{
+	return pkt->payload_chksum_len;
+}
+
+/* A length of 0 drops the payload sum, the whole packet is then summed */
+static inline void net_pkt_set_payload_chksum(struct net_pkt *pkt,
+					      uint16_t sum, uint16_t len)
+{
+	pkt->payload_chksum = sum;
+	pkt->payload_chksum_len = len;
+}
+#else /* CONFIG_NET_NATIVE_IP */
+static inline uint16_t net_pkt_payload_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline uint16_t net_pkt_payload_chksum_len(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_payload_chksum(struct net_pkt *pkt,
+					      uint16_t sum, uint16_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+	ARG_UNUSED(len);
+}
+#endif /* CONFIG_NET_NATIVE_IP */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -2369,6 +2454,27 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt and add it to a checksum
+ *
+ * @details Works like net_pkt_write(), but also sums the data up for the
+ *          Internet checksum while copying it, so that it does not have
+ *          to be read again from the packet afterwards. The data is
+ *          summed as if it started at an even offset of the checksummed
+ *          area, so a sum carried over several writes requires all but
+ *          the last one to be of an even length.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ * @param sum    One's complement sum, in host byte order, the data is
+ *               added to. Only the data actually written is added.
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *sum);
+
 /**
  * @brief Write a byte (uint8_t) data to a net_pkt
  *
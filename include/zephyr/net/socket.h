@@ -76,8 +76,34 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_sendmsg: Reference the iovec data instead of copying it, see @ref SO_ZEROCOPY */
+#define ZSOCK_MSG_ZEROCOPY 0x4000000
 /** @} */
 
+/**
+ * @brief Zero-copy send completion callback
+ *
+ * Called once the network stack no longer references data passed to
+ * zsock_sendmsg() with ZSOCK_MSG_ZEROCOPY, i.e. after it was acknowledged
+ * (stream sockets), transmitted (datagram sockets) or dropped. Every range
+ * of data accepted by a successful send is reported exactly once; nothing
+ * is reported for a failed send. The callback runs in network stack or
+ * driver context and must not block.
+ *
+ * @param data Start of the released data range
+ * @param len Length of the released data range
+ * @param user_data User data from struct zsock_zerocopy
+ */
+typedef void (*zsock_zerocopy_cb_t)(const void *data, size_t len, void *user_data);
+
+/** @brief Option value of @ref SO_ZEROCOPY */
+struct zsock_zerocopy {
+	/** Completion callback, NULL disables zero-copy sending */
+	zsock_zerocopy_cb_t cb;
+	/** User data passed to @ref zsock_zerocopy::cb */
+	void *user_data;
+};
+
 /**
  * @name Options for shutdown() function
  * @{
@@ -516,6 +542,43 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data by borrowing the network buffers
+ *
+ * @details
+ * Instead of copying the received data into a user buffer, hand over the
+ * fragment chain of the next received packet (datagram sockets) or of the
+ * next queued segment (stream sockets). The payload starts at the data
+ * pointer of the first fragment, and the fragments hold exactly the
+ * returned number of bytes. The caller owns the chain and must release it
+ * with @ref zsock_recvbuf_release. Borrowed buffers come from the network
+ * RX pool, so holding on to them for long will stall reception.
+ *
+ * Only ZSOCK_MSG_DONTWAIT is supported in @p flags. This function is only
+ * available with @kconfig{CONFIG_NET_CONTEXT_ZEROCOPY} and cannot be
+ * called from user mode.
+ *
+ * @param sock Socket
+ * @param buf Set to the borrowed fragment chain, or NULL at end of stream
+ * @param flags Receive flags
+ * @param src_addr Source address of the data (optional, datagram sockets)
+ * @param addrlen Value-result length of @p src_addr
+ *
+ * @return Number of bytes in @p buf, 0 at end of stream, -1 on error with
+ * errno set
+ */
+ssize_t zsock_recvbuf(int sock, struct net_buf **buf, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Release a fragment chain borrowed with @ref zsock_recvbuf
+ *
+ * @param buf Fragment chain, may be NULL
+ */
+void zsock_recvbuf_release(struct net_buf *buf);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -895,6 +958,17 @@ struct ifreq {
 /** Socket TX time (same as SO_TXTIME) */
 #define SCM_TXTIME SO_TXTIME
 
+/**
+ * Enable zero-copy sending with ZSOCK_MSG_ZEROCOPY. The option value is a
+ * struct zsock_zerocopy. Unlike on Linux, completions are delivered through
+ * the callback in the option value instead of the socket error queue, and
+ * a send never falls back to copying: when the
+ * @kconfig{CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT} descriptors run out, it
+ * fails with ENOBUFS, or a stream socket only accepts the data queued so far.
+ * Zephyr specific, as the Linux value is used by SO_SOCKS5.
+ */
+#define SO_ZEROCOPY 62
+
 /** Timestamp generation flags */
 
 /** Request RX timestamps generated by network adapter. */
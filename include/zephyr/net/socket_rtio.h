@@ -0,0 +1,205 @@
+/**
+ * @file
+ * @brief RTIO socket operations
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+
+/**
+ * @brief RTIO socket operations
+ * @defgroup bsd_socket_rtio RTIO socket operations
+ * @since 4.2
+ * @version 0.1.0
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RTIO iodev performing socket operations
+ *
+ * Socket operations are submitted to this iodev with the prepare functions
+ * below, which store the socket descriptor in the submission. A dispatcher
+ * thread tries each operation as soon as it is submitted and, if the socket is
+ * not ready, waits for the socket with epoll and tries it again. Many sockets
+ * can so be served by batches of submissions from a single thread, without a
+ * blocking call or a poll() per socket.
+ *
+ * Operations on a socket are done in submission order, separately for the
+ * receives and accepts on one side, and the sends and connects on the other.
+ * They should all be completed or canceled before the socket is closed. A
+ * canceled operation which waits for its socket is completed at the next
+ * submission or socket event.
+ *
+ * Accepts and connects switch the socket to non-blocking mode. A send completes
+ * with the number of bytes sent, which may be less than requested.
+ *
+ * User mode threads need access to this iodev to submit socket operations. The
+ * access of a user mode thread to each socket is checked when its submissions
+ * are copied in, those on a socket it has no access to completing with -EBADF.
+ * The socket accepted for a user mode thread is granted to it.
+ */
+extern struct rtio_iodev net_socket_rtio_iodev;
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Check a submission copied in from user mode, called by the RTIO syscall handlers */
+void z_net_socket_rtio_vrfy_sqe(struct rtio_sqe *sqe);
+
+/** @endcond */
+
+/**
+ * @brief Prepare a socket receive submission
+ *
+ * The submission completes with the number of bytes received, 0 once the peer
+ * has closed the connection, or a negative errno code.
+ *
+ * @param sqe Submission to prepare
+ * @param sock Socket descriptor
+ * @param buf Buffer receiving the data
+ * @param len Size of @p buf
+ * @param userdata Userdata of the completion
+ */
+static inline void net_socket_rtio_prep_recv(struct rtio_sqe *sqe, int sock, uint8_t *buf,
+					     uint32_t len, void *userdata)
+{
+	rtio_sqe_prep_read(sqe, &net_socket_rtio_iodev, RTIO_PRIO_NORM, buf, len, userdata);
+	sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(sock);
+}
+
+/**
+ * @brief Prepare a socket receive submission into the RTIO memory pool
+ *
+ * The buffer is only taken from the memory pool of the RTIO context once data
+ * can be received, and is retrieved with rtio_cqe_get_mempool_buffer().
+ *
+ * @see net_socket_rtio_prep_recv()
+ */
+static inline void net_socket_rtio_prep_recv_with_pool(struct rtio_sqe *sqe, int sock,
+						       void *userdata)
+{
+	rtio_sqe_prep_read_with_pool(sqe, &net_socket_rtio_iodev, RTIO_PRIO_NORM, userdata);
+	sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(sock);
+}
+
+/**
+ * @brief Prepare a multishot socket receive submission into the RTIO memory pool
+ *
+ * The submission completes each time data is received, until the peer closes
+ * the connection, an error occurs or it is canceled with rtio_sqe_cancel(). It
+ * must not be chained.
+ *
+ * @see net_socket_rtio_prep_recv_with_pool()
+ */
+static inline void net_socket_rtio_prep_recv_multishot(struct rtio_sqe *sqe, int sock,
+						       void *userdata)
+{
+	rtio_sqe_prep_read_multishot(sqe, &net_socket_rtio_iodev, RTIO_PRIO_NORM, userdata);
+	sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(sock);
+}
+
+/**
+ * @brief Prepare a socket send submission
+ *
+ * @param sqe Submission to prepare
+ * @param sock Socket descriptor
+ * @param buf Data to send
+ * @param len Number of bytes to send
+ * @param userdata Userdata of the completion
+ */
+static inline void net_socket_rtio_prep_send(struct rtio_sqe *sqe, int sock, const uint8_t *buf,
+					     uint32_t len, void *userdata)
+{
+	rtio_sqe_prep_write(sqe, &net_socket_rtio_iodev, RTIO_PRIO_NORM, buf, len, userdata);
+	sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(sock);
+}
+
+/**
+ * @brief Prepare a submission sending the data received by the previous one
+ *
+ * The previous submission must be a socket receive chained to this one. The
+ * bytes it received are sent from its buffer, so a buffer taken from the
+ * memory pool must only be released once this submission has completed. If
+ * nothing was received, this submission completes with -ECANCELED.
+ *
+ * @param sqe Submission to prepare
+ * @param sock Socket descriptor
+ * @param userdata Userdata of the completion
+ */
+static inline void net_socket_rtio_prep_send_received(struct rtio_sqe *sqe, int sock,
+						      void *userdata)
+{
+	net_socket_rtio_prep_send(sqe, sock, NULL, 0, userdata);
+	sqe->iodev_flags |= RTIO_IODEV_SOCK_SEND_RECEIVED;
+}
+
+/**
+ * @brief Prepare a socket accept submission
+ *
+ * The submission completes with the descriptor of the accepted socket or a
+ * negative errno code.
+ *
+ * @param sqe Submission to prepare
+ * @param sock Listening socket descriptor
+ * @param addr Buffer receiving the peer address, may be NULL
+ * @param addrlen Size of @p addr
+ * @param userdata Userdata of the completion
+ */
+static inline void net_socket_rtio_prep_accept(struct rtio_sqe *sqe, int sock, void *addr,
+					       uint32_t addrlen, void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_SOCK_ACCEPT;
+	sqe->prio = RTIO_PRIO_NORM;
+	sqe->iodev = &net_socket_rtio_iodev;
+	sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(sock);
+	sqe->accept.addr = addr;
+	sqe->accept.addrlen = addrlen;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a socket connect submission
+ *
+ * The submission completes with 0 once connected or a negative errno code.
+ *
+ * @param sqe Submission to prepare
+ * @param sock Socket descriptor
+ * @param addr Address to connect to, which must outlive the submission
+ * @param addrlen Size of @p addr
+ * @param userdata Userdata of the completion
+ */
+static inline void net_socket_rtio_prep_connect(struct rtio_sqe *sqe, int sock, const void *addr,
+						uint32_t addrlen, void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_SOCK_CONNECT;
+	sqe->prio = RTIO_PRIO_NORM;
+	sqe->iodev = &net_socket_rtio_iodev;
+	sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(sock);
+	sqe->connect.addr = addr;
+	sqe->connect.addrlen = addrlen;
+	sqe->userdata = userdata;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_ */
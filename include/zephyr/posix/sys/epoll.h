@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+#define ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+
+#include <zephyr/zvfs/epoll.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EPOLLIN      ZVFS_EPOLLIN
+#define EPOLLPRI     ZVFS_EPOLLPRI
+#define EPOLLOUT     ZVFS_EPOLLOUT
+#define EPOLLERR     ZVFS_EPOLLERR
+#define EPOLLHUP     ZVFS_EPOLLHUP
+#define EPOLLONESHOT ZVFS_EPOLLONESHOT
+#define EPOLLET      ZVFS_EPOLLET
+
+#define EPOLL_CTL_ADD ZVFS_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZVFS_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZVFS_EPOLL_CTL_MOD
+
+/* Accepted for compatibility; there is no exec() in Zephyr */
+#define EPOLL_CLOEXEC 02000000
+
+typedef union zvfs_epoll_data epoll_data_t;
+
+#define epoll_event zvfs_epoll_event
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @param size Ignored, but must be greater than zero
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create(int size);
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @param flags 0 or EPOLL_CLOEXEC
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create1(int flags);
+
+/**
+ * @brief Add, modify or remove an entry in the interest list of an epoll instance
+ *
+ * See @ref zvfs_epoll_ctl for the semantics of EPOLLET and EPOLLONESHOT.
+ *
+ * @return 0 on success, -1 on error
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @param timeout Timeout in milliseconds, or -1 to wait forever
+ *
+ * @return Number of ready entries stored in @p events (0 on timeout), -1 on error
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_ */
@@ -261,6 +261,28 @@ extern "C" {
 #define RTIO_IODEV_I3C_HDR_CMD_CODE_GET(flags) \
 	FIELD_GET(RTIO_IODEV_I3C_HDR_CMD_CODE_MASK, flags)
 
+/**
+ * @brief Socket descriptor mask of the socket operations
+ */
+#define RTIO_IODEV_SOCK_FD_MASK GENMASK(15, 0)
+
+/**
+ * @brief Set the socket descriptor of a socket operation
+ */
+#define RTIO_IODEV_SOCK_FD_SET(fd) \
+	FIELD_PREP(RTIO_IODEV_SOCK_FD_MASK, fd)
+
+/**
+ * @brief Get the socket descriptor of a socket operation
+ */
+#define RTIO_IODEV_SOCK_FD_GET(flags) \
+	FIELD_GET(RTIO_IODEV_SOCK_FD_MASK, flags)
+
+/**
+ * @brief Send the bytes received by the previous chained socket receive
+ */
+#define RTIO_IODEV_SOCK_SEND_RECEIVED BIT(16)
+
 /** @cond ignore */
 struct rtio;
 struct rtio_cqe;
@@ -349,12 +371,52 @@ struct rtio_sqe {
 		/** OP_I3C_CCC */
 		/* struct i3c_ccc_payload *ccc_payload; */
 		void *ccc_payload;
+
+		/** OP_SOCK_ACCEPT */
+		struct {
+			uint32_t addrlen; /**< Size of the peer address buffer */
+			/* struct sockaddr *addr; */
+			void *addr; /**< Buffer receiving the peer address, may be NULL */
+			/** User thread granted the accepted socket, set on copy in */
+			struct k_thread *owner;
+		} accept;
+
+		/** OP_SOCK_CONNECT */
+		struct {
+			uint32_t addrlen; /**< Size of the address */
+			/* const struct sockaddr *addr; */
+			const void *addr; /**< Address to connect to */
+		} connect;
+
+		/** OP_RX, OP_TX and OP_ERASE of storage devices, compatible with rx and tx */
+		struct {
+			uint32_t buf_len; /**< Length of buffer, or of the area to erase */
+			uint8_t *buf; /**< Buffer to read into or write from */
+			uint32_t offset; /**< Offset on the device, in device specific units */
+		} storage;
+
+		/** OP_DELAY and OP_LINK_TIMEOUT */
+		struct {
+			/** Relative timeout in ticks, RTIO_SQE_DELAY_FOREVER for K_FOREVER */
+			uint32_t ticks;
+		} delay;
 	};
 };
 
 /** @cond ignore */
 /* Ensure the rtio_sqe never grows beyond a common cacheline size of 64 bytes */
 BUILD_ASSERT(sizeof(struct rtio_sqe) <= 64);
+/* Storage operations are read and write operations with an offset */
+BUILD_ASSERT(offsetof(struct rtio_sqe, storage.buf) == offsetof(struct rtio_sqe, rx.buf));
+BUILD_ASSERT(offsetof(struct rtio_sqe, storage.buf) == offsetof(struct rtio_sqe, tx.buf));
+/* The storage offset must not grow the submission beyond txrx */
+BUILD_ASSERT(SIZEOF_FIELD(struct rtio_sqe, storage) <= SIZEOF_FIELD(struct rtio_sqe, txrx));
+/* No member of the union, through its size or its alignment, may grow the
+ * submission beyond txrx
+ */
+BUILD_ASSERT(sizeof(struct rtio_sqe) ==
+	     ROUND_UP(offsetof(struct rtio_sqe, txrx) + SIZEOF_FIELD(struct rtio_sqe, txrx),
+		      sizeof(void *)));
 /** @endcond */
 
 /**
@@ -494,6 +556,13 @@ struct rtio_iodev_sqe {
 	struct mpsc_node q;
 	struct rtio_iodev_sqe *next;
 	struct rtio *r;
+#ifdef CONFIG_RTIO_TIMEOUT
+	/** @cond INTERNAL_HIDDEN */
+	struct _timeout timeout; /* Timeout of a delay or linked timeout */
+	struct rtio_iodev_sqe *link_timeout; /* Linked timeout bounding this submission */
+	uint8_t timeout_state; /* State of a linked timeout */
+	/** @endcond */
+#endif
 };
 
 /**
@@ -555,6 +624,26 @@ struct rtio_iodev {
 /** An operation to sends I3C CCC */
 #define RTIO_OP_I3C_CCC (RTIO_OP_I3C_CONFIGURE+1)
 
+/** An operation that accepts a connection on a listening socket */
+#define RTIO_OP_SOCK_ACCEPT (RTIO_OP_I3C_CCC+1)
+
+/** An operation that connects a socket */
+#define RTIO_OP_SOCK_CONNECT (RTIO_OP_SOCK_ACCEPT+1)
+
+/** An operation that erases an area of a storage device */
+#define RTIO_OP_ERASE (RTIO_OP_SOCK_CONNECT+1)
+
+/** @cond ignore */
+/* Delay of a submission prepared with K_FOREVER, rejected on submit */
+#define RTIO_SQE_DELAY_FOREVER UINT32_MAX
+/** @endcond */
+
+/** An operation that completes after a delay */
+#define RTIO_OP_DELAY (RTIO_OP_ERASE+1)
+
+/** An operation that bounds the duration of the operations chained to it */
+#define RTIO_OP_LINK_TIMEOUT (RTIO_OP_DELAY+1)
+
 /**
  * @brief Prepare a nop (no op) submission
  */
@@ -717,6 +806,110 @@ static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a delay op submission
+ *
+ * The submission completes after the given timeout, which must be relative and
+ * not K_FOREVER. Timeouts longer than UINT32_MAX - 1 ticks are cut to it.
+ * Chained to other submissions, it delays the next ones. Canceling it while it
+ * is waiting completes it right away, without a completion.
+ *
+ * Requires CONFIG_RTIO_TIMEOUT.
+ */
+static inline void rtio_sqe_prep_delay(struct rtio_sqe *sqe,
+				       k_timeout_t timeout,
+				       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_DELAY;
+	sqe->prio = 0;
+	sqe->iodev = NULL;
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		sqe->delay.ticks = RTIO_SQE_DELAY_FOREVER;
+	} else {
+		sqe->delay.ticks = (uint32_t)CLAMP((int64_t)timeout.ticks, 0,
+						 (int64_t)RTIO_SQE_DELAY_FOREVER - 1);
+	}
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a linked timeout op submission
+ *
+ * The submission is chained to the submissions it bounds, up to the end of the
+ * chain, which are started right away. If they have not all completed when the
+ * timeout expires, the submission completes with -ETIMEDOUT and the ones not
+ * started yet complete with -ECANCELED. The one in progress is not interrupted,
+ * but may be canceled with rtio_sqe_cancel(). Otherwise the submission completes
+ * with 0 after the last one.
+ *
+ * The timeout must be relative and not K_FOREVER, as for rtio_sqe_prep_delay(),
+ * and linked timeouts must not be nested.
+ *
+ * Requires CONFIG_RTIO_TIMEOUT.
+ */
+static inline void rtio_sqe_prep_link_timeout(struct rtio_sqe *sqe,
+					      k_timeout_t timeout,
+					      void *userdata)
+{
+	rtio_sqe_prep_delay(sqe, timeout, userdata);
+	sqe->op = RTIO_OP_LINK_TIMEOUT;
+	sqe->flags = RTIO_SQE_CHAINED;
+}
+
+/**
+ * @brief Prepare a read op submission at an offset of a storage device
+ *
+ * @see rtio_sqe_prep_read()
+ */
+static inline void rtio_sqe_prep_read_at(struct rtio_sqe *sqe,
+					 const struct rtio_iodev *iodev,
+					 int8_t prio,
+					 uint32_t offset,
+					 uint8_t *buf,
+					 uint32_t len,
+					 void *userdata)
+{
+	rtio_sqe_prep_read(sqe, iodev, prio, buf, len, userdata);
+	sqe->storage.offset = offset;
+}
+
+/**
+ * @brief Prepare a write op submission at an offset of a storage device
+ *
+ * @see rtio_sqe_prep_write()
+ */
+static inline void rtio_sqe_prep_write_at(struct rtio_sqe *sqe,
+					  const struct rtio_iodev *iodev,
+					  int8_t prio,
+					  uint32_t offset,
+					  const uint8_t *buf,
+					  uint32_t len,
+					  void *userdata)
+{
+	rtio_sqe_prep_write(sqe, iodev, prio, buf, len, userdata);
+	sqe->storage.offset = offset;
+}
+
+/**
+ * @brief Prepare an erase op submission of an area of a storage device
+ */
+static inline void rtio_sqe_prep_erase(struct rtio_sqe *sqe,
+				       const struct rtio_iodev *iodev,
+				       int8_t prio,
+				       uint32_t offset,
+				       uint32_t len,
+				       void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_ERASE;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->storage.buf_len = len;
+	sqe->storage.offset = offset;
+	sqe->userdata = userdata;
+}
+
 static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *pool)
 {
 	struct mpsc_node *node = mpsc_pop(&pool->free_q);
@@ -1208,6 +1401,9 @@ static inline int z_impl_rtio_cqe_get_mempool_buffer(const struct rtio *r, struc
 void rtio_executor_submit(struct rtio *r);
 void rtio_executor_ok(struct rtio_iodev_sqe *iodev_sqe, int result);
 void rtio_executor_err(struct rtio_iodev_sqe *iodev_sqe, int result);
+#ifdef CONFIG_RTIO_TIMEOUT
+void rtio_executor_cancel_delay(struct rtio_iodev_sqe *iodev_sqe);
+#endif
 
 /**
  * @brief Inform the executor of a submission completion with success
@@ -1404,6 +1600,11 @@ static inline int z_impl_rtio_sqe_cancel(struct rtio_sqe *sqe)
 		iodev_sqe = rtio_iodev_sqe_next(iodev_sqe);
 	} while (iodev_sqe != NULL);
 
+#ifdef CONFIG_RTIO_TIMEOUT
+	/* A waiting delay would only complete once expired */
+	rtio_executor_cancel_delay(CONTAINER_OF(sqe, struct rtio_iodev_sqe, sqe));
+#endif
+
 	return 0;
 }
 
@@ -10,6 +10,8 @@
 #include <stdint.h>
 #include <zephyr/device.h>
 #include <zephyr/rtio/rtio.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/mpsc_lockfree.h>
 #include <zephyr/sys/p4wq.h>
 
 #ifdef __cplusplus
@@ -23,6 +25,36 @@ extern "C" {
  */
 typedef void (*rtio_work_submit_t)(struct rtio_iodev_sqe *iodev_sqe);
 
+/**
+ * @brief RTIO Work queue of a device.
+ *
+ * Submissions to a device whose operations must neither overlap nor be
+ * reordered, like a flash device, are handled one after the other, in
+ * submission order, by a single RTIO Work request draining this queue.
+ * However many submissions are pending, the device only uses one item of
+ * the pool.
+ */
+struct rtio_work_queue {
+	/** Protects the pending submissions and the busy state. */
+	struct k_spinlock lock;
+
+	/** Submissions waiting to be handled. */
+	struct mpsc pending;
+
+	/** True while a work request drains the queue. */
+	bool busy;
+};
+
+/**
+ * @brief Statically initialize an RTIO Work queue.
+ *
+ * @param _name Name of the initialized queue.
+ */
+#define RTIO_WORK_QUEUE_INIT(_name)						\
+	{									\
+		.pending = MPSC_INIT((_name).pending),				\
+	}
+
 /**
  * @brief RTIO Work request.
  *
@@ -42,6 +74,11 @@ struct rtio_work_req {
 	 * This is filled inside @ref rtio_work_req_submit.
 	 */
 	rtio_work_submit_t handler;
+
+	/** Queue drained by this request, if any.
+	 * This is filled inside @ref rtio_work_queue_submit.
+	 */
+	struct rtio_work_queue *queue;
 };
 
 /**
@@ -66,6 +103,22 @@ void rtio_work_req_submit(struct rtio_work_req *req,
 			  struct rtio_iodev_sqe *iodev_sqe,
 			  rtio_work_submit_t handler);
 
+/**
+ * @brief Submit an operation through an RTIO Work queue.
+ *
+ * @details The handler is called for each submission of the queue in
+ * submission order, from a work request allocated when the queue is idle.
+ * The submission is completed with -ENOMEM if no request can be allocated.
+ * All the submissions through a queue must use the same handler.
+ *
+ * @param queue Work queue of the device.
+ * @param iodev_sqe RTIO Operation information.
+ * @param handler Callback to handler where work operation is performed.
+ */
+void rtio_work_queue_submit(struct rtio_work_queue *queue,
+			    struct rtio_iodev_sqe *iodev_sqe,
+			    rtio_work_submit_t handler);
+
 /**
  * @brief Obtain number of currently used items from the pre-allocated pool.
  *
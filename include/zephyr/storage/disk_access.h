@@ -31,6 +31,10 @@
 
 #include <zephyr/drivers/disk.h>
 
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+#include <zephyr/rtio/work.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -113,6 +117,45 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief Data of a disk iodev defined by DISK_ACCESS_IODEV_DEFINE
+ */
+struct disk_access_iodev_data {
+	/** Disk name */
+	const char *pdrv;
+	/** Work queue serializing the operations on the disk */
+	struct rtio_work_queue queue;
+};
+
+extern const struct rtio_iodev_api disk_access_iodev_api;
+
+/**
+ * @brief Define an iodev for a disk
+ *
+ * Read and write submissions prepared with rtio_sqe_prep_read_at() and
+ * rtio_sqe_prep_write_at() are done with disk_access_read() and
+ * disk_access_write(). The offset of a submission is its start sector, and
+ * its length must be a multiple of the sector size. Erase submissions are
+ * not supported. The submissions are done on the RTIO work queue one after
+ * the other, in submission order. The submissions of a transaction are
+ * completed together, and the first failing one fails the transaction.
+ *
+ * The disk must have been initialized with @ref DISK_IOCTL_CTRL_INIT.
+ *
+ * @param name Symbolic name of the iodev to define
+ * @param _pdrv Disk name
+ */
+#define DISK_ACCESS_IODEV_DEFINE(name, _pdrv)					\
+	static struct disk_access_iodev_data _disk_access_iodev_data_##name = {	\
+		.pdrv = (_pdrv),						\
+		.queue = RTIO_WORK_QUEUE_INIT(_disk_access_iodev_data_##name.queue), \
+	};									\
+	RTIO_IODEV_DEFINE(name, &disk_access_iodev_api, &_disk_access_iodev_data_##name)
+
+#endif /* CONFIG_DISK_ACCESS_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,7 +37,9 @@ extern "C" {
  * sample of the smallest bucket that might fit, falling back rapidly
  * to the smallest block guaranteed to fit.  Split memory remaining in
  * the chunk is always returned immediately to the heap for other
- * allocation.
+ * allocation.  With CONFIG_SYS_HEAP_SIZE_CLASSES small freed blocks
+ * are instead kept on per-size lists for constant time reuse, and only
+ * merged once the heap can't satisfy an allocation otherwise.
  *
  * Excellent performance with firmly bounded runtime.  All operations
  * are constant time (though there is a search of the smallest bucket
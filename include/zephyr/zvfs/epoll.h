@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN  ZVFS_POLLIN
+#define ZVFS_EPOLLPRI ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT ZVFS_POLLOUT
+#define ZVFS_EPOLLERR ZVFS_POLLERR
+#define ZVFS_EPOLLHUP ZVFS_POLLHUP
+
+#define ZVFS_EPOLLONESHOT BIT(30)
+#define ZVFS_EPOLLET      BIT(31)
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	union zvfs_epoll_data data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a persistent interest list of file descriptors.
+ * Readiness of each registered descriptor is tracked in the background, so
+ * that @ref zvfs_epoll_wait only has to visit descriptors which have
+ * signalled an event since the previous call, rather than preparing and
+ * tearing down every descriptor like @ref zvfs_poll does.
+ *
+ * The returned file descriptor may itself be polled for ZVFS_POLLIN.
+ *
+ * @param flags Must be 0
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove an entry in the interest list of an epoll instance
+ *
+ * By default, entries are level-triggered: a ready descriptor is reported by
+ * every call to @ref zvfs_epoll_wait until it is no longer ready. With
+ * ZVFS_EPOLLET, a descriptor is reported once and is then re-armed, so it is
+ * only reported again after a new wakeup from the underlying object. Since
+ * Zephyr readiness sources are level-based, a descriptor that has not been
+ * drained may be reported again. With ZVFS_EPOLLONESHOT, the entry is
+ * disabled after one report until it is re-enabled with ZVFS_EPOLL_CTL_MOD.
+ *
+ * Descriptors are removed from all interest lists when they are closed.
+ *
+ * @param epfd ZVFS epoll file descriptor
+ * @param op One of ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd Target file descriptor
+ * @param event Requested events and user data (ignored for ZVFS_EPOLL_CTL_DEL)
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @param epfd ZVFS epoll file descriptor
+ * @param events Array receiving the ready events
+ * @param maxevents Number of entries in @p events
+ * @param timeout Maximum time to wait for an event
+ *
+ * @return Number of ready entries stored in @p events (0 on timeout), -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents,
+		    k_timeout_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
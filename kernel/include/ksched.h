@@ -38,13 +38,40 @@ BUILD_ASSERT(K_LOWEST_APPLICATION_THREAD_PRIO
 #define Z_ASSERT_VALID_PRIO(prio, entry_point) __ASSERT((prio) == -1, "")
 #endif /* CONFIG_MULTITHREADING */
 
+/* Number of locks wait queues are hashed onto, must be a power of two */
+#ifdef CONFIG_SMP
+#define Z_WAITQ_LOCKS 32
+#else
+#define Z_WAITQ_LOCKS 1
+#endif
+
 #if (CONFIG_MP_MAX_NUM_CPUS == 1)
 #define LOCK_SCHED_SPINLOCK
+#define LOCK_WAITQ_SPINLOCK(wait_q)
 #else
 #define LOCK_SCHED_SPINLOCK   K_SPINLOCK(&_sched_spinlock)
+#define LOCK_WAITQ_SPINLOCK(wait_q)   K_SPINLOCK(z_waitq_lock(wait_q))
 #endif
 
+/*
+ * _sched_spinlock protects the run queue and thread state.  Wait queues
+ * are protected by a lock picked by hashing their address, so that
+ * threads pending on unrelated objects don't serialize on the scheduler
+ * lock.  Locks nest as: object lock, wait queue lock, _sched_spinlock.
+ *
+ * Pending or unpending a thread changes its state, so it is done with
+ * both the wait queue lock and _sched_spinlock held; looking up or
+ * walking a wait queue only needs the former.  The join and halt queues
+ * embedded in threads are private to the scheduler and only ever used
+ * with _sched_spinlock held.
+ */
 extern struct k_spinlock _sched_spinlock;
+extern struct k_spinlock _waitq_spinlocks[Z_WAITQ_LOCKS];
+
+static ALWAYS_INLINE struct k_spinlock *z_waitq_lock(_wait_q_t *wait_q)
+{
+	return &_waitq_spinlocks[((uintptr_t)wait_q >> 3) & (Z_WAITQ_LOCKS - 1)];
+}
 
 extern struct k_thread _thread_dummy;
 
@@ -155,7 +182,7 @@ static ALWAYS_INLINE _wait_q_t *pended_on_thread(struct k_thread *thread)
 	return thread->base.pended_on;
 }
 
-
+/* The wait queue lock and _sched_spinlock must be held */
 static inline void unpend_thread_no_timeout(struct k_thread *thread)
 {
 	_priq_wait_remove(&pended_on_thread(thread)->waitq, thread);
@@ -164,10 +191,11 @@ static inline void unpend_thread_no_timeout(struct k_thread *thread)
 }
 
 /*
- * In a multiprocessor system, z_unpend_first_thread() must lock the scheduler
- * spinlock _sched_spinlock. However, in a uniprocessor system, that is not
- * necessary as the caller has already taken precautions (in the form of
- * locking interrupts).
+ * In a multiprocessor system, z_unpend_first_thread() must lock the wait
+ * queue, and the scheduler spinlock _sched_spinlock if there is a thread
+ * to unpend. However, in a uniprocessor system, that is not necessary as
+ * the caller has already taken precautions (in the form of locking
+ * interrupts).
  */
 static ALWAYS_INLINE struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
 {
@@ -176,10 +204,12 @@ static ALWAYS_INLINE struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
 	__ASSERT_EVAL(, int key = arch_irq_lock(); arch_irq_unlock(key),
 		      !arch_irq_unlocked(key), "");
 
-	LOCK_SCHED_SPINLOCK {
+	LOCK_WAITQ_SPINLOCK(wait_q) {
 		thread = _priq_wait_best(&wait_q->waitq);
 		if (unlikely(thread != NULL)) {
-			unpend_thread_no_timeout(thread);
+			LOCK_SCHED_SPINLOCK {
+				unpend_thread_no_timeout(thread);
+			}
 			z_abort_thread_timeout(thread);
 		}
 	}
@@ -203,8 +233,9 @@ static ALWAYS_INLINE struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
  * Given a wait_q, wake up the highest priority thread on the queue. If the
  * queue was empty just return false.
  *
- * Otherwise, do the following, in order,  holding _sched_spinlock the entire
- * time so that the thread state is guaranteed not to change:
+ * Otherwise, do the following, in order, holding the wait queue lock and
+ * _sched_spinlock the entire time so that the thread state is guaranteed
+ * not to change:
  * - Set the thread's swap return values to swap_retval and swap_data
  * - un-pend and ready the thread, but do not invoke the scheduler.
  *
@@ -289,13 +320,15 @@ int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
  * @brief Walks the wait queue invoking the callback on each waiting thread
  *
  * This function walks the wait queue invoking the callback function on each
- * waiting thread while holding _sched_spinlock. This can be useful for routines
- * that need to operate on multiple waiting threads.
+ * waiting thread while holding the wait queue lock. This can be useful for
+ * routines that need to operate on multiple waiting threads. The callback
+ * must not pend or unpend threads.
  *
- * CAUTION! As a wait queue is of indeterminate length, the scheduler will be
- * locked for an indeterminate amount of time. This may impact system
- * performance. As such, care must be taken when using both this function and
- * the specified callback.
+ * CAUTION! As a wait queue is of indeterminate length, the wait queue lock,
+ * which may be shared with other wait queues, will be held for an
+ * indeterminate amount of time. This may impact system performance. As such,
+ * care must be taken when using both this function and the specified
+ * callback.
  *
  * @param wait_q Identifies the wait queue to walk
  * @param func   Callback to invoke on each waiting thread
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+#define ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+
+/**
+ * @file
+ * @brief Hierarchical timing wheel backend for the kernel timeout queue
+ *
+ * The wheel is made of CONFIG_TIMEOUT_WHEEL_LEVELS levels of
+ * Z_TIMEOUT_WHEEL_SLOTS slots each.  A slot at level N covers
+ * Z_TIMEOUT_WHEEL_SLOTS^N ticks.  Timeouts are hashed by their absolute
+ * expiry into the lowest level able to represent them, and cascaded down
+ * one level each time the wheel reaches the start of their slot.
+ * Timeouts too far away for the top level are parked on an overflow list
+ * that is re-examined each time the top level advances by one slot.
+ *
+ * Insertion and removal are O(1).  Finding the next point in time at
+ * which the wheel needs servicing is O(levels).
+ *
+ * In this mode the dticks field of struct _timeout holds the absolute
+ * expiry tick of the timeout rather than a delta to its predecessor.
+ *
+ * None of these functions do any locking: the caller owns the wheel.
+ */
+
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define Z_TIMEOUT_WHEEL_SLOT_BITS 6
+#define Z_TIMEOUT_WHEEL_SLOTS     (1U << Z_TIMEOUT_WHEEL_SLOT_BITS)
+
+struct z_timeout_wheel {
+	/* Tick the wheel has been advanced to */
+	uint64_t now;
+
+	/* One bit per non-empty slot, per level */
+	uint64_t occupied[CONFIG_TIMEOUT_WHEEL_LEVELS];
+
+	sys_dlist_t slots[CONFIG_TIMEOUT_WHEEL_LEVELS][Z_TIMEOUT_WHEEL_SLOTS];
+
+	/* Timeouts beyond the reach of the top level */
+	sys_dlist_t overflow;
+};
+
+/**
+ * @brief Static initializer for an empty wheel starting at tick 0
+ *
+ * Slot lists are only initialized when they first become occupied, so
+ * only the overflow list needs setting up.
+ */
+#define Z_TIMEOUT_WHEEL_INITIALIZER(obj)                                                          \
+	{                                                                                          \
+		.overflow = SYS_DLIST_STATIC_INIT(&(obj).overflow),                                \
+	}
+
+/**
+ * @brief Initialize an empty wheel
+ *
+ * @param wheel Wheel to initialize
+ * @param now Current tick
+ */
+void z_timeout_wheel_init(struct z_timeout_wheel *wheel, uint64_t now);
+
+/**
+ * @brief Add a timeout to the wheel
+ *
+ * @param wheel Wheel to add to
+ * @param to Timeout, whose dticks field holds its absolute expiry tick.
+ *           The expiry must not be earlier than the wheel's current tick.
+ */
+void z_timeout_wheel_add(struct z_timeout_wheel *wheel, struct _timeout *to);
+
+/**
+ * @brief Remove a timeout from the wheel
+ *
+ * @param wheel Wheel holding the timeout
+ * @param to Linked timeout to remove
+ */
+void z_timeout_wheel_remove(struct z_timeout_wheel *wheel, struct _timeout *to);
+
+/**
+ * @brief Next tick at which the wheel needs servicing
+ *
+ * This is the exact expiry of the earliest timeout if it is already
+ * sitting in the lowest level, or the tick at which a higher level slot
+ * has to be cascaded otherwise.  It is never later than the earliest
+ * expiry.
+ *
+ * @param wheel Wheel to query
+ * @return Absolute tick, or UINT64_MAX if the wheel is empty
+ */
+uint64_t z_timeout_wheel_next(struct z_timeout_wheel *wheel);
+
+/**
+ * @brief Advance the wheel and pop an expired timeout
+ *
+ * Moves the wheel forward to @a tick, cascading higher level slots as
+ * needed, then unlinks and returns one timeout expiring at @a tick, if
+ * any.  @a tick must not be later than z_timeout_wheel_next().
+ *
+ * @param wheel Wheel to advance
+ * @param tick Tick to advance to
+ * @return Expired timeout, or NULL if none expires at @a tick
+ */
+struct _timeout *z_timeout_wheel_advance(struct z_timeout_wheel *wheel, uint64_t tick);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_ */
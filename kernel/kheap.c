@@ -12,10 +12,65 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_HEAP_ARENAS
+/*
+ * Each arena is a sys_heap of its own, covering an equal share of the
+ * heap memory, with the arena descriptors themselves at its start.
+ * heap->lock is only used to sleep on the wait queue: arena locks are
+ * taken inside it when retrying allocations before pending.
+ */
+static bool arenas_init(struct k_heap *heap, void *mem, size_t bytes)
+{
+	unsigned int n = CONFIG_MP_MAX_NUM_CPUS;
+	uintptr_t start = ROUND_UP(mem, 8);
+	uintptr_t base = ROUND_UP(start + n * sizeof(struct k_heap_arena), 8);
+	uintptr_t end = (uintptr_t)mem + bytes;
+	size_t part;
+
+	heap->arenas = NULL;
+	heap->num_arenas = 0U;
+
+	if (end <= base) {
+		return false;
+	}
+
+	part = ROUND_DOWN((end - base) / n, 8);
+	if (part < CONFIG_HEAP_ARENA_MIN_SIZE) {
+		return false;
+	}
+
+	heap->arenas = (struct k_heap_arena *)start;
+	heap->num_arenas = n;
+	atomic_clear(&heap->waiters);
+
+	for (unsigned int i = 0; i < n; i++) {
+		struct k_heap_arena *arena = &heap->arenas[i];
+		uintptr_t arena_start = base + i * part;
+
+		/* The last arena gets the rounding leftovers */
+		arena->end = (i == (n - 1)) ? end : (arena_start + part);
+		arena->lock = (struct k_spinlock) {};
+		atomic_ptr_clear(&arena->returned);
+		sys_heap_init(&arena->heap, (void *)arena_start, arena->end - arena_start);
+	}
+
+	/* No single sys_heap covers the arenas, leave none to misuse */
+	heap->heap.heap = NULL;
+
+	return true;
+}
+#endif /* CONFIG_HEAP_ARENAS */
+
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	heap->lock = (struct k_spinlock) {};
+#ifdef CONFIG_HEAP_ARENAS
+	if (arenas_init(heap, mem, bytes)) {
+		SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
+		return;
+	}
+#endif /* CONFIG_HEAP_ARENAS */
 	sys_heap_init(&heap->heap, mem, bytes);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
@@ -63,9 +118,229 @@ SYS_INIT_NAMED(statics_init_pre, statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_
 SYS_INIT_NAMED(statics_init_post, statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
+#ifdef CONFIG_HEAP_ARENAS
+static unsigned int arena_index(struct k_heap *heap, struct k_heap_arena *arena)
+{
+	return arena - heap->arenas;
+}
+
+/*
+ * Lock the arena of the current CPU.  The ID read before taking the lock
+ * may be stale if the thread migrates, it is checked again once the lock
+ * keeps the thread on its CPU.
+ */
+static struct k_heap_arena *local_arena_lock(struct k_heap *heap, k_spinlock_key_t *key)
+{
+	struct k_heap_arena *arena;
+
+	while (true) {
+		arena = &heap->arenas[arch_curr_cpu()->id % heap->num_arenas];
+		*key = k_spin_lock(&arena->lock);
+
+		if (arena_index(heap, arena) == (arch_curr_cpu()->id % heap->num_arenas)) {
+			return arena;
+		}
+
+		k_spin_unlock(&arena->lock, *key);
+	}
+}
+
+static struct k_heap_arena *arena_of(struct k_heap *heap, void *mem)
+{
+	unsigned int i;
+
+	for (i = 0; i < (heap->num_arenas - 1); i++) {
+		if ((uintptr_t)mem < heap->arenas[i].end) {
+			break;
+		}
+	}
+
+	return &heap->arenas[i];
+}
+
+/* Give blocks freed from other CPUs back to the heap, arena lock held */
+static void arena_reclaim(struct k_heap_arena *arena)
+{
+	void *mem = atomic_ptr_set(&arena->returned, NULL);
+
+	while (mem != NULL) {
+		void *next = *(void **)mem;
+
+		sys_heap_free(&arena->heap, mem);
+		mem = next;
+	}
+}
+
+/*
+ * Blocks freed from other CPUs hold the link of the returned list, so every
+ * block must fit a pointer at pointer alignment.  Alignments carrying a
+ * rewind (see sys_heap_aligned_alloc()) come from k_malloc(), whose rewind
+ * is a pointer already.
+ */
+static void arena_block_fixup(size_t *align, size_t *bytes)
+{
+	if ((*align & (*align - 1)) == 0) {
+		*align = MAX(*align, sizeof(void *));
+	}
+
+	*bytes = MAX(*bytes, sizeof(void *));
+}
+
+/* Try the local arena first, then steal from the others in turn */
+static void *arenas_alloc(struct k_heap *heap, size_t align, size_t bytes)
+{
+	struct k_heap_arena *arena;
+	k_spinlock_key_t key;
+	unsigned int first;
+	void *ret;
+
+	arena_block_fixup(&align, &bytes);
+
+	arena = local_arena_lock(heap, &key);
+	first = arena_index(heap, arena);
+	arena_reclaim(arena);
+	ret = sys_heap_aligned_alloc(&arena->heap, align, bytes);
+	k_spin_unlock(&arena->lock, key);
+
+	for (unsigned int i = 1; (i < heap->num_arenas) && (ret == NULL); i++) {
+		arena = &heap->arenas[(first + i) % heap->num_arenas];
+
+		K_SPINLOCK(&arena->lock) {
+			arena_reclaim(arena);
+			ret = sys_heap_aligned_alloc(&arena->heap, align, bytes);
+		}
+	}
+
+	return ret;
+}
+
+static void *arenas_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
+				  k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	void *ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	ret = arenas_alloc(heap, align, bytes);
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && (ret == NULL) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_heap, aligned_alloc, heap, timeout);
+
+		/*
+		 * Announce ourselves before retrying: a free that doesn't
+		 * see us yet completed early enough for the retry to find
+		 * its block.
+		 */
+		key = k_spin_lock(&heap->lock);
+		atomic_inc(&heap->waiters);
+
+		while (ret == NULL) {
+			ret = arenas_alloc(heap, align, bytes);
+			timeout = sys_timepoint_timeout(end);
+
+			if ((ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				break;
+			}
+
+			(void) z_pend_curr(&heap->lock, key, &heap->wait_q, timeout);
+			key = k_spin_lock(&heap->lock);
+		}
+
+		atomic_dec(&heap->waiters);
+		k_spin_unlock(&heap->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+
+	return ret;
+}
+
+static void arenas_free(struct k_heap *heap, void *mem)
+{
+	struct k_heap_arena *arena = arena_of(heap, mem);
+	unsigned int index = arena_index(heap, arena);
+	k_spinlock_key_t key;
+	bool local;
+	void *head;
+
+	/* The arena lock keeps the thread on its CPU while checking it */
+	key = k_spin_lock(&arena->lock);
+	local = (arch_curr_cpu()->id % heap->num_arenas) == index;
+	if (local) {
+		sys_heap_free(&arena->heap, mem);
+	}
+	k_spin_unlock(&arena->lock, key);
+
+	if (!local) {
+		do {
+			head = atomic_ptr_get(&arena->returned);
+			*(void **)mem = head;
+		} while (!atomic_ptr_cas(&arena->returned, head, mem));
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && (atomic_get(&heap->waiters) != 0)) {
+		key = k_spin_lock(&heap->lock);
+		if (z_unpend_all(&heap->wait_q) != 0) {
+			z_reschedule(&heap->lock, key);
+		} else {
+			k_spin_unlock(&heap->lock, key);
+		}
+	}
+}
+
+static void *arenas_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t timeout)
+{
+	struct k_heap_arena *arena;
+	size_t align = sizeof(void *);
+	size_t old_bytes = 0;
+	void *ret = NULL;
+
+	if (ptr == NULL) {
+		return arenas_aligned_alloc(heap, sizeof(void *), bytes, timeout);
+	}
+	if (bytes == 0U) {
+		arenas_free(heap, ptr);
+		return NULL;
+	}
+
+	arena_block_fixup(&align, &bytes);
+
+	/* Resize within the owning arena if possible, move otherwise */
+	arena = arena_of(heap, ptr);
+	K_SPINLOCK(&arena->lock) {
+		arena_reclaim(arena);
+		old_bytes = sys_heap_usable_size(&arena->heap, ptr);
+		ret = sys_heap_aligned_realloc(&arena->heap, ptr, align, bytes);
+	}
+
+	if (ret == NULL) {
+		ret = arenas_aligned_alloc(heap, sizeof(void *), bytes, timeout);
+		if (ret != NULL) {
+			memcpy(ret, ptr, MIN(old_bytes, bytes));
+			arenas_free(heap, ptr);
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_HEAP_ARENAS */
+
 void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
+#ifdef CONFIG_HEAP_ARENAS
+	if (heap->arenas != NULL) {
+		return arenas_aligned_alloc(heap, align, bytes, timeout);
+	}
+#endif /* CONFIG_HEAP_ARENAS */
+
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
@@ -138,6 +413,18 @@ void *k_heap_calloc(struct k_heap *heap, size_t num, size_t size, k_timeout_t ti
 
 void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t timeout)
 {
+#ifdef CONFIG_HEAP_ARENAS
+	if (heap->arenas != NULL) {
+		void *ret;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, realloc, heap, ptr, bytes, timeout);
+		ret = arenas_realloc(heap, ptr, bytes, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, realloc, heap, ptr, bytes, timeout, ret);
+
+		return ret;
+	}
+#endif /* CONFIG_HEAP_ARENAS */
+
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
@@ -168,6 +455,15 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_HEAP_ARENAS
+	if (heap->arenas != NULL) {
+		if (mem != NULL) {
+			arenas_free(heap, mem);
+		}
+		return;
+	}
+#endif /* CONFIG_HEAP_ARENAS */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
@@ -179,3 +475,69 @@ void k_heap_free(struct k_heap *heap, void *mem)
 		k_spin_unlock(&heap->lock, key);
 	}
 }
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *heap, struct sys_memory_stats *stats)
+{
+	struct sys_memory_stats arena_stats;
+
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_HEAP_ARENAS
+	if (heap->arenas != NULL) {
+		*stats = (struct sys_memory_stats) {};
+
+		for (unsigned int i = 0; i < heap->num_arenas; i++) {
+			struct k_heap_arena *arena = &heap->arenas[i];
+
+			/* Blocks freed from other CPUs count as free */
+			K_SPINLOCK(&arena->lock) {
+				arena_reclaim(arena);
+				(void) sys_heap_runtime_stats_get(&arena->heap, &arena_stats);
+			}
+
+			stats->free_bytes += arena_stats.free_bytes;
+			stats->allocated_bytes += arena_stats.allocated_bytes;
+			stats->max_allocated_bytes += arena_stats.max_allocated_bytes;
+		}
+
+		return 0;
+	}
+#endif /* CONFIG_HEAP_ARENAS */
+
+	K_SPINLOCK(&heap->lock) {
+		(void) sys_heap_runtime_stats_get(&heap->heap, &arena_stats);
+	}
+
+	*stats = arena_stats;
+
+	return 0;
+}
+
+int k_heap_runtime_stats_reset_max(struct k_heap *heap)
+{
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_HEAP_ARENAS
+	if (heap->arenas != NULL) {
+		for (unsigned int i = 0; i < heap->num_arenas; i++) {
+			K_SPINLOCK(&heap->arenas[i].lock) {
+				(void) sys_heap_runtime_stats_reset_max(&heap->arenas[i].heap);
+			}
+		}
+
+		return 0;
+	}
+#endif /* CONFIG_HEAP_ARENAS */
+
+	K_SPINLOCK(&heap->lock) {
+		(void) sys_heap_runtime_stats_reset_max(&heap->heap);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
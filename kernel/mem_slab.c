@@ -18,6 +18,257 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
+{
+	if (!IS_ENABLED(CONFIG_MEM_SLAB_POINTER_VALIDATE)) {
+		return true;
+	}
+
+	const char *p = ptr;
+	ptrdiff_t offset = p - slab->buffer;
+
+	return (offset >= 0) &&
+	       (offset < (slab->info.block_size * slab->info.num_blocks)) &&
+	       ((offset % slab->info.block_size) == 0);
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define CACHE_SIZE  CONFIG_MEM_SLAB_CPU_CACHE_SIZE
+#define CACHE_BATCH (CACHE_SIZE / 2)
+
+/*
+ * Blocks sitting in a CPU cache are not on the shared free list, so
+ * slab->info.num_used counts them as used.  The real figure is that
+ * minus whatever the caches hold.
+ *
+ * A cache is normally only touched by its own CPU, with interrupts
+ * locked, so its lock is never contended.  Other CPUs only take it to
+ * drain the cache when the shared free list runs dry.  Cache locks are
+ * always taken before the slab lock, in CPU order when several of them
+ * are needed.
+ */
+
+static k_spinlock_key_t lock_all(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key;
+
+	if (slab->cpu_cache == NULL) {
+		return k_spin_lock(&slab->lock);
+	}
+
+	key = k_spin_lock(&slab->cpu_cache[0].lock);
+	for (unsigned int i = 1; i < arch_num_cpus(); i++) {
+		(void)k_spin_lock(&slab->cpu_cache[i].lock);
+	}
+	(void)k_spin_lock(&slab->lock);
+
+	return key;
+}
+
+/* Drop the cache locks taken by lock_all(), keeping the slab lock */
+static void release_caches(struct k_mem_slab *slab)
+{
+	if (slab->cpu_cache != NULL) {
+		for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+			k_spin_release(&slab->cpu_cache[i].lock);
+		}
+	}
+}
+
+static void unlock_all(struct k_mem_slab *slab, k_spinlock_key_t key)
+{
+	release_caches(slab);
+	k_spin_unlock(&slab->lock, key);
+}
+
+/* Must be called with lock_all() held */
+static uint32_t num_used(struct k_mem_slab *slab)
+{
+	uint32_t used = slab->info.num_used;
+
+	if (slab->cpu_cache != NULL) {
+		for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+			used -= slab->cpu_cache[i].num_free;
+		}
+	}
+
+	return used;
+}
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = lock_all(slab);
+	uint32_t used = num_used(slab);
+
+	unlock_all(slab, key);
+
+	return used;
+}
+
+/* Take up to CACHE_BATCH blocks off the free list, cache lock held */
+static void cache_refill(struct k_mem_slab *slab, struct k_mem_slab_cpu_cache *cache)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	char *last = slab->free_list;
+	uint32_t n = 1U;
+
+	if (last != NULL) {
+		while ((n < CACHE_BATCH) && (*(char **)last != NULL)) {
+			last = *(char **)last;
+			n++;
+		}
+
+		cache->free_list = slab->free_list;
+		cache->num_free = n;
+		slab->free_list = *(char **)last;
+		slab->info.num_used += n;
+		*(char **)last = NULL;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+/*
+ * Give the CACHE_BATCH least recently freed blocks of a full cache back
+ * to the free list, cache lock held.  The list is split and walked
+ * before taking the slab lock so that only the splice happens under it.
+ */
+static void cache_flush(struct k_mem_slab *slab, struct k_mem_slab_cpu_cache *cache)
+{
+	k_spinlock_key_t key;
+	char *keep = cache->free_list;
+	char *head;
+	char *tail;
+
+	for (unsigned int i = 1U; i < (CACHE_SIZE - CACHE_BATCH); i++) {
+		keep = *(char **)keep;
+	}
+	head = *(char **)keep;
+	tail = head;
+	for (unsigned int i = 1U; i < CACHE_BATCH; i++) {
+		tail = *(char **)tail;
+	}
+	*(char **)keep = NULL;
+	cache->num_free -= CACHE_BATCH;
+
+	key = k_spin_lock(&slab->lock);
+	*(char **)tail = slab->free_list;
+	slab->free_list = head;
+	slab->info.num_used -= CACHE_BATCH;
+	k_spin_unlock(&slab->lock, key);
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct k_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	bool found = false;
+
+	/* Stay on this CPU while using its cache */
+	irq_key = arch_irq_lock();
+	cache = &slab->cpu_cache[_current_cpu->id];
+	key = k_spin_lock(&cache->lock);
+
+	if ((cache->free_list == NULL) && !slab->uncached) {
+		cache_refill(slab, cache);
+	}
+
+	if (cache->free_list != NULL) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)(cache->free_list);
+		cache->num_free--;
+		__ASSERT((cache->free_list == NULL) ||
+			 slab_ptr_is_good(slab, cache->free_list),
+			 "slab corruption detected");
+		found = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return found;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct k_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	bool cached = false;
+
+	irq_key = arch_irq_lock();
+	cache = &slab->cpu_cache[_current_cpu->id];
+	key = k_spin_lock(&cache->lock);
+
+	/* Waiting threads must see the block, it goes through the slab */
+	if (!slab->uncached) {
+		if (cache->num_free == CACHE_SIZE) {
+			cache_flush(slab, cache);
+		}
+
+		*(char **)mem = cache->free_list;
+		cache->free_list = (char *)mem;
+		cache->num_free++;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return cached;
+}
+
+/*
+ * Move every cached block back to the free list and stop caching until
+ * a block is freed with nobody waiting for it.  Called when the free
+ * list runs dry, so that allocations only fail or wait when the slab
+ * really is exhausted, and so that threads about to wait are woken by
+ * the next free on any CPU.  Returns with only the slab lock held.
+ */
+static k_spinlock_key_t drain_caches(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = lock_all(slab);
+
+	slab->uncached = true;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		char *tail = cache->free_list;
+
+		if (tail != NULL) {
+			while (*(char **)tail != NULL) {
+				tail = *(char **)tail;
+			}
+			*(char **)tail = slab->free_list;
+			slab->free_list = cache->free_list;
+			slab->info.num_used -= cache->num_free;
+			cache->free_list = NULL;
+			cache->num_free = 0U;
+		}
+	}
+
+	release_caches(slab);
+
+	return key;
+}
+#else
+static inline k_spinlock_key_t lock_all(struct k_mem_slab *slab)
+{
+	return k_spin_lock(&slab->lock);
+}
+
+static inline void unlock_all(struct k_mem_slab *slab, k_spinlock_key_t key)
+{
+	k_spin_unlock(&slab->lock, key);
+}
+
+static inline uint32_t num_used(struct k_mem_slab *slab)
+{
+	return slab->info.num_used;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -31,9 +282,10 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	k_spinlock_key_t   key;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
-	key = k_spin_lock(&slab->lock);
+	key = lock_all(slab);
 	memcpy(stats, &slab->info, sizeof(slab->info));
-	k_spin_unlock(&slab->lock, key);
+	((struct k_mem_slab_info *)stats)->num_used = num_used(slab);
+	unlock_all(slab, key);
 
 	return 0;
 }
@@ -45,18 +297,19 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	struct k_mem_slab *slab;
 	k_spinlock_key_t   key;
 	struct sys_memory_stats *ptr = stats;
+	uint32_t used;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
-	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	key = lock_all(slab);
+	used = num_used(slab);
+	ptr->free_bytes = (slab->info.num_blocks - used) * slab->info.block_size;
+	ptr->allocated_bytes = used * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
 	ptr->max_allocated_bytes = 0;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
-	k_spin_unlock(&slab->lock, key);
+	unlock_all(slab, key);
 
 	return 0;
 }
@@ -178,6 +431,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->buffer = buffer;
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->cpu_cache = NULL;
+	slab->uncached = false;
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
@@ -204,27 +461,30 @@ out:
 	return rc;
 }
 
-static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
-{
-	if (!IS_ENABLED(CONFIG_MEM_SLAB_POINTER_VALIDATE)) {
-		return true;
-	}
-
-	const char *p = ptr;
-	ptrdiff_t offset = p - slab->buffer;
-
-	return (offset >= 0) &&
-	       (offset < (slab->info.block_size * slab->info.num_blocks)) &&
-	       ((offset % slab->info.block_size) == 0);
-}
-
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if ((slab->cpu_cache != NULL) && cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if ((slab->free_list == NULL) && (slab->cpu_cache != NULL) && !slab->uncached) {
+		k_spin_unlock(&slab->lock, key);
+		key = drain_caches(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -275,6 +535,14 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if ((slab->cpu_cache != NULL) && cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -293,6 +561,10 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 	*(char **) mem = slab->free_list;
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Nobody is waiting for a block, caches can be used again */
+	slab->uncached = false;
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -305,11 +577,11 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 		return -EINVAL;
 	}
 
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key = lock_all(slab);
+	uint32_t used = num_used(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - used) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -317,7 +589,7 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	stats->max_allocated_bytes = 0;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
-	k_spin_unlock(&slab->lock, key);
+	unlock_all(slab, key);
 
 	return 0;
 }
@@ -99,14 +99,14 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 
 	/*
 	 * Attempt a direct data copy to waiting readers if any.
-	 * The copy has to be done under the scheduler lock to ensure all the
+	 * The copy has to be done under the wait queue lock to ensure all the
 	 * needed data is copied to the target thread whose buffer spec lives
 	 * on that thread's stack, and then the thread unpended only if it
 	 * received all the data it wanted, without racing with a potential
-	 * thread timeout/cancellation event.
+	 * thread timeout/cancellation event, which unpends under the same lock.
 	 */
 	do {
-		LOCK_SCHED_SPINLOCK {
+		LOCK_WAITQ_SPINLOCK(&pipe->data) {
 			reader = _priq_wait_best(&pipe->data.waitq);
 			if (reader == NULL) {
 				K_SPINLOCK_BREAK;
@@ -127,14 +127,16 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 				/*
 				 * This reader has received all the data
 				 * it was waiting for: wake it up with
-				 * the scheduler lock still held.
+				 * the wait queue lock still held.
 				 */
-				unpend_thread_no_timeout(reader);
+				LOCK_SCHED_SPINLOCK {
+					unpend_thread_no_timeout(reader);
+				}
 				z_abort_thread_timeout(reader);
 			}
 		}
 		if (reader != NULL) {
-			/* rest of thread wake-up outside the scheduler lock */
+			/* rest of thread wake-up outside the wait queue lock */
 			z_thread_return_value_set_with_data(reader, 0, NULL);
 			z_ready_thread(reader);
 			*need_resched = true;
@@ -29,6 +29,7 @@ extern struct k_thread *pending_current;
 #endif
 
 struct k_spinlock _sched_spinlock;
+struct k_spinlock _waitq_spinlocks[Z_WAITQ_LOCKS];
 
 /* Storage to "complete" the context switch from an invalid/incomplete thread
  * context (ex: exiting an ISR that aborted _current)
@@ -59,6 +60,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -67,17 +70,59 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+static ALWAYS_INLINE bool thread_runs_on(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0U;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cpu);
+	return true;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+/* Threads are queued on the CPU they last ran on to keep their cache
+ * footprint, falling back to the CPU making them ready and then to the
+ * first CPU their mask allows.  Other CPUs pull them over in runq_best().
+ */
+static ALWAYS_INLINE int runq_home_cpu(struct k_thread *thread)
+{
+	int cpu = thread->base.cpu;
+
+	if (!thread_runs_on(thread, cpu)) {
+		cpu = _current_cpu->id;
+	}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (!thread_runs_on(thread, cpu)) {
+		uint32_t m = thread->base.cpu_mask;
+
+		/* Same masked-off edge case as in thread_runq() above */
+		cpu = (m == 0U) ? 0 : u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return cpu;
 }
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread->base.runq_cpu = runq_home_cpu(thread);
+	_kernel.cpus[thread->base.runq_cpu].ready_q.num_ready++;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -85,6 +130,10 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	_kernel.cpus[thread->base.runq_cpu].ready_q.num_ready--;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	_priq_run_remove(thread_runq(thread), thread);
 }
 
@@ -93,9 +142,53 @@ static ALWAYS_INLINE void runq_yield(void)
 	_priq_run_yield(curr_cpu_runq());
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Best thread for this CPU across all run queues.  The local queue wins
+ * ties; a peer queue is stolen from only when it holds a strictly better
+ * thread allowed to run here, and among equally good peers the one with
+ * the most ready threads is picked.  Only each peer's best thread is
+ * considered, so a peer whose best thread is masked off this CPU is
+ * skipped even if it holds other candidates.
+ */
+static struct k_thread *runq_best_stealing(void)
+{
+	struct _cpu *local = _current_cpu;
+	struct k_thread *best = _priq_run_best(&local->ready_q.runq);
+	unsigned int busiest = 0;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+		struct k_thread *thread;
+		int32_t cmp;
+
+		if ((i == local->id) || (rq->num_ready == 0U)) {
+			continue;
+		}
+
+		thread = _priq_run_best(&rq->runq);
+		if ((thread == NULL) || !thread_runs_on(thread, local->id)) {
+			continue;
+		}
+
+		cmp = (best == NULL) ? 1 : z_sched_prio_cmp(thread, best);
+		if ((cmp > 0) || ((cmp == 0) && (busiest != 0U) && (rq->num_ready > busiest))) {
+			best = thread;
+			busiest = rq->num_ready;
+		}
+	}
+
+	return best;
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	return runq_best_stealing();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -529,7 +622,9 @@ static void unready_thread(struct k_thread *thread)
 	update_cache(thread == _current);
 }
 
-/* _sched_spinlock must be held */
+/* _sched_spinlock and, unless it is a join or halt queue, the wait queue
+ * lock must be held
+ */
 static void add_to_waitq_locked(struct k_thread *thread, _wait_q_t *wait_q)
 {
 	unready_thread(thread);
@@ -537,7 +632,12 @@ static void add_to_waitq_locked(struct k_thread *thread, _wait_q_t *wait_q)
 
 	SYS_PORT_TRACING_FUNC(k_thread, sched_pend, thread);
 
-	if (wait_q != NULL) {
+	/* A thread flagged for abort while still running gets halted by
+	 * the context switch that follows, with only _sched_spinlock held.
+	 * Keep it off the wait queue so that halt_thread() doesn't need
+	 * the wait queue lock.
+	 */
+	if ((wait_q != NULL) && !is_aborting(thread)) {
 		thread->base.pended_on = wait_q;
 		_priq_wait_add(&wait_q->waitq, thread);
 	}
@@ -560,50 +660,94 @@ static void pend_locked(struct k_thread *thread, _wait_q_t *wait_q,
 	add_thread_timeout(thread, timeout);
 }
 
+static void pended_unlock(_wait_q_t *wait_q, k_spinlock_key_t key)
+{
+	if (wait_q != NULL) {
+		k_spin_release(&_sched_spinlock);
+		k_spin_unlock(z_waitq_lock(wait_q), key);
+	} else {
+		k_spin_unlock(&_sched_spinlock, key);
+	}
+}
+
+/* Takes the lock of the wait queue the thread is pended on, if any, then
+ * _sched_spinlock.  The thread can get unpended while we wait for the wait
+ * queue lock, in which case we start over.  Returns the wait queue, whose
+ * lock must be released along with _sched_spinlock by pended_unlock().
+ */
+static _wait_q_t *pended_lock(struct k_thread *thread, k_spinlock_key_t *key)
+{
+	_wait_q_t *wait_q;
+
+	while (true) {
+		wait_q = thread->base.pended_on;
+
+		if (wait_q != NULL) {
+			*key = k_spin_lock(z_waitq_lock(wait_q));
+			(void)k_spin_lock(&_sched_spinlock);
+		} else {
+			*key = k_spin_lock(&_sched_spinlock);
+		}
+
+		if (thread->base.pended_on == wait_q) {
+			return wait_q;
+		}
+
+		pended_unlock(wait_q, *key);
+	}
+}
+
 void z_pend_thread(struct k_thread *thread, _wait_q_t *wait_q,
 		   k_timeout_t timeout)
 {
 	__ASSERT_NO_MSG(thread == _current || is_thread_dummy(thread));
-	K_SPINLOCK(&_sched_spinlock) {
+	K_SPINLOCK(z_waitq_lock(wait_q)) {
+		(void)k_spin_lock(&_sched_spinlock);
 		pend_locked(thread, wait_q, timeout);
+		k_spin_release(&_sched_spinlock);
 	}
 }
 
 void z_unpend_thread_no_timeout(struct k_thread *thread)
 {
-	K_SPINLOCK(&_sched_spinlock) {
-		if (thread->base.pended_on != NULL) {
-			unpend_thread_no_timeout(thread);
-		}
+	k_spinlock_key_t key;
+	_wait_q_t *wait_q = pended_lock(thread, &key);
+
+	if (wait_q != NULL) {
+		unpend_thread_no_timeout(thread);
 	}
+
+	pended_unlock(wait_q, key);
 }
 
 void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
 {
-	K_SPINLOCK(&_sched_spinlock) {
-		bool killed = (thread->base.thread_state &
-				(_THREAD_DEAD | _THREAD_ABORTING));
+	k_spinlock_key_t key;
+	_wait_q_t *wait_q = pended_lock(thread, &key);
+	bool killed = (thread->base.thread_state &
+			(_THREAD_DEAD | _THREAD_ABORTING));
 
 #ifdef CONFIG_EVENTS
-		bool do_nothing = thread->no_wake_on_timeout && is_timeout;
+	bool do_nothing = thread->no_wake_on_timeout && is_timeout;
 
-		thread->no_wake_on_timeout = false;
+	thread->no_wake_on_timeout = false;
 
-		if (do_nothing) {
-			continue;
-		}
+	if (do_nothing) {
+		pended_unlock(wait_q, key);
+		return;
+	}
 #endif /* CONFIG_EVENTS */
 
-		if (!killed) {
-			/* The thread is not being killed */
-			if (thread->base.pended_on != NULL) {
-				unpend_thread_no_timeout(thread);
-			}
-			z_mark_thread_as_not_sleeping(thread);
-			ready_thread(thread);
+	if (!killed) {
+		/* The thread is not being killed */
+		if (wait_q != NULL) {
+			unpend_thread_no_timeout(thread);
 		}
+		z_mark_thread_as_not_sleeping(thread);
+		ready_thread(thread);
 	}
 
+	pended_unlock(wait_q, key);
 }
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
@@ -631,10 +775,17 @@ int z_pend_curr(struct k_spinlock *lock, k_spinlock_key_t key,
 	 * masked until we reach the context switch.  z_swap() itself
 	 * has similar code; the duplication is because it's a legacy
 	 * API that doesn't expect to be called with scheduler lock
-	 * held.
+	 * held.  The wait queue lock is only needed until the thread
+	 * is on the queue.
 	 */
+	if (wait_q != NULL) {
+		(void) k_spin_lock(z_waitq_lock(wait_q));
+	}
 	(void) k_spin_lock(&_sched_spinlock);
 	pend_locked(_current, wait_q, timeout);
+	if (wait_q != NULL) {
+		k_spin_release(z_waitq_lock(wait_q));
+	}
 	k_spin_release(lock);
 	return z_swap(&_sched_spinlock, key);
 }
@@ -643,11 +794,13 @@ struct k_thread *z_unpend1_no_timeout(_wait_q_t *wait_q)
 {
 	struct k_thread *thread = NULL;
 
-	K_SPINLOCK(&_sched_spinlock) {
+	K_SPINLOCK(z_waitq_lock(wait_q)) {
 		thread = _priq_wait_best(&wait_q->waitq);
 
 		if (thread != NULL) {
+			(void)k_spin_lock(&_sched_spinlock);
 			unpend_thread_no_timeout(thread);
+			k_spin_release(&_sched_spinlock);
 		}
 	}
 
@@ -921,10 +1074,16 @@ int z_unpend_all(_wait_q_t *wait_q)
 	int need_sched = 0;
 	struct k_thread *thread;
 
-	for (thread = z_waitq_head(wait_q); thread != NULL; thread = z_waitq_head(wait_q)) {
-		z_unpend_thread(thread);
-		z_ready_thread(thread);
-		need_sched = 1;
+	K_SPINLOCK(z_waitq_lock(wait_q)) {
+		for (thread = z_waitq_head(wait_q); thread != NULL;
+		     thread = z_waitq_head(wait_q)) {
+			(void)k_spin_lock(&_sched_spinlock);
+			unpend_thread_no_timeout(thread);
+			z_abort_thread_timeout(thread);
+			ready_thread(thread);
+			k_spin_release(&_sched_spinlock);
+			need_sched = 1;
+		}
 	}
 
 	return need_sched;
@@ -937,13 +1096,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1201,6 +1360,7 @@ static inline k_tid_t z_vrfy_k_sched_current_thread_query(void)
 #include <zephyr/syscalls/k_sched_current_thread_query_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* For the join and halt queues, which only need _sched_spinlock */
 static inline void unpend_all(_wait_q_t *wait_q)
 {
 	struct k_thread *thread;
@@ -1230,7 +1390,8 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 	bool dummify = false;
 
 	/* We hold the lock, and the thread is known not to be running
-	 * anywhere.
+	 * anywhere.  If it is pended, it is on a join or halt queue, or
+	 * the caller holds the wait queue lock too.
 	 */
 	if ((thread->base.thread_state & new_state) == 0U) {
 		thread->base.thread_state |= new_state;
@@ -1322,13 +1483,23 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 void z_thread_abort(struct k_thread *thread)
 {
 	bool essential = z_is_thread_essential(thread);
-	k_spinlock_key_t key = k_spin_lock(&_sched_spinlock);
+	k_spinlock_key_t key;
+	_wait_q_t *wait_q = pended_lock(thread, &key);
 
 	if ((thread->base.thread_state & _THREAD_DEAD) != 0U) {
-		k_spin_unlock(&_sched_spinlock, key);
+		pended_unlock(wait_q, key);
 		return;
 	}
 
+	/* A pended thread isn't running anywhere.  Take it off its wait
+	 * queue while we hold the lock, as the halt only holds
+	 * _sched_spinlock.
+	 */
+	if (wait_q != NULL) {
+		unpend_thread_no_timeout(thread);
+		k_spin_release(z_waitq_lock(wait_q));
+	}
+
 	z_thread_halt(thread, key, true);
 
 	if (essential) {
@@ -1444,16 +1615,18 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	struct k_thread *thread;
 	bool ret = false;
 
-	K_SPINLOCK(&_sched_spinlock) {
+	K_SPINLOCK(z_waitq_lock(wait_q)) {
 		thread = _priq_wait_best(&wait_q->waitq);
 
 		if (thread != NULL) {
 			z_thread_return_value_set_with_data(thread,
 							    swap_retval,
 							    swap_data);
+			(void)k_spin_lock(&_sched_spinlock);
 			unpend_thread_no_timeout(thread);
 			z_abort_thread_timeout(thread);
 			ready_thread(thread);
+			k_spin_release(&_sched_spinlock);
 			ret = true;
 		}
 	}
@@ -1478,7 +1651,7 @@ int z_sched_waitq_walk(_wait_q_t  *wait_q,
 	struct k_thread *thread;
 	int  status = 0;
 
-	K_SPINLOCK(&_sched_spinlock) {
+	K_SPINLOCK(z_waitq_lock(wait_q)) {
 		_WAIT_Q_FOR_EACH(wait_q, thread) {
 
 			/*
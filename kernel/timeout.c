@@ -8,13 +8,38 @@
 #include <zephyr/spinlock.h>
 #include <ksched.h>
 #include <timeout_q.h>
+#include <timeout_wheel.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
 
 static uint64_t curr_tick;
 
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU)
+/*
+ * Each CPU arms timeouts on its own wheel, under its own lock.  The
+ * global timeout_lock only serializes sys_clock_announce() and the
+ * programming of the system timer, and must be taken before any of the
+ * queue locks.  curr_tick, announce_remaining and programmed_tick are
+ * only modified with timeout_lock held, inside tick_seq write sections,
+ * so that the arming path can sample them without taking it.
+ */
+struct timeout_queue {
+	struct k_spinlock lock;
+	struct z_timeout_wheel wheel;
+};
+
+static struct timeout_queue timeout_queues[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Absolute tick of the event the system timer was last programmed for */
+static uint64_t programmed_tick = UINT64_MAX;
+
+static atomic_t tick_seq;
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+static struct z_timeout_wheel timeout_wheel = Z_TIMEOUT_WHEEL_INITIALIZER(timeout_wheel);
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
@@ -40,6 +65,127 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU)
+static int init_timeout_queues(void)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		z_timeout_wheel_init(&timeout_queues[i].wheel, 0);
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_timeout_queues, EARLY, 0);
+
+static inline void tick_write_begin(void)
+{
+	(void)atomic_inc(&tick_seq);
+}
+
+static inline void tick_write_end(void)
+{
+	(void)atomic_inc(&tick_seq);
+}
+
+struct tick_state {
+	uint64_t tick;
+	uint64_t programmed;
+	/* Ticks elapsed since tick, 0 while announcing, see elapsed() */
+	int32_t elapsed;
+	bool announcing;
+};
+
+/*
+ * Consistent lockless snapshot of the global tick state.  The elapsed
+ * ticks are only read on request, inside the same read section, so that
+ * they can't be paired with a curr_tick an announcement has since moved.
+ */
+static void tick_state_get(struct tick_state *state, bool with_elapsed)
+{
+	atomic_val_t seq;
+
+	do {
+		seq = atomic_get(&tick_seq);
+		state->tick = curr_tick;
+		state->programmed = programmed_tick;
+		state->announcing = (announce_remaining != 0);
+		state->elapsed = (with_elapsed && !state->announcing) ? sys_clock_elapsed() : 0;
+		barrier_dmem_fence_full();
+	} while (((seq & 1) != 0) || (seq != atomic_get(&tick_seq)));
+}
+
+/*
+ * Lock the queue a timeout was last armed on.  The owner can only change
+ * while the timeout is unlinked, under the new owner's lock, so recheck it
+ * once the lock is held.
+ */
+static struct timeout_queue *timeout_queue_lock(const struct _timeout *to,
+						k_spinlock_key_t *key)
+{
+	struct timeout_queue *q;
+
+	for (;;) {
+		q = &timeout_queues[to->cpu];
+		*key = k_spin_lock(&q->lock);
+		if (q == &timeout_queues[to->cpu]) {
+			return q;
+		}
+		k_spin_unlock(&q->lock, *key);
+	}
+}
+
+/* Queue holding the earliest event of all, timeout_lock must be held */
+static struct timeout_queue *earliest_queue(uint64_t *next)
+{
+	struct timeout_queue *earliest = NULL;
+	unsigned int num_cpus = arch_num_cpus();
+
+	*next = UINT64_MAX;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+		uint64_t n = UINT64_MAX;
+
+		K_SPINLOCK(&q->lock) {
+			n = z_timeout_wheel_next(&q->wheel);
+		}
+
+		if (n < *next) {
+			*next = n;
+			earliest = q;
+		}
+	}
+
+	return earliest;
+}
+
+static k_ticks_t next_event_ticks(void)
+{
+	uint64_t next;
+
+	(void)earliest_queue(&next);
+
+	if (next == UINT64_MAX) {
+		return K_TICKS_FOREVER;
+	}
+
+	/* A timeout armed concurrently with an announcement may be late */
+	return (next > curr_tick) ? (k_ticks_t)(next - curr_tick) : 0;
+}
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+/* In wheel mode, dticks holds the absolute expiry tick */
+static k_ticks_t next_event_ticks(void)
+{
+	uint64_t next = z_timeout_wheel_next(&timeout_wheel);
+
+	return (next == UINT64_MAX) ? K_TICKS_FOREVER : (k_ticks_t)(next - curr_tick);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	z_timeout_wheel_remove(&timeout_wheel, t);
+}
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -63,6 +209,14 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static k_ticks_t next_event_ticks(void)
+{
+	struct _timeout *to = first();
+
+	return (to == NULL) ? K_TICKS_FOREVER : to->dticks;
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -86,23 +240,51 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t dticks = next_event_ticks();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((dticks == K_TICKS_FOREVER) ||
+	    ((int64_t)(dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dticks - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* timeout_lock must be held */
+static void program_next(void)
+{
+	uint64_t next;
+
+	/* Anyone arming a timeout until the new deadline is published will
+	 * see UINT64_MAX and come here to reprogram the timer themselves.
+	 */
+	tick_write_begin();
+	programmed_tick = UINT64_MAX;
+	tick_write_end();
+
+	(void)earliest_queue(&next);
+
+	tick_write_begin();
+	programmed_tick = next;
+	tick_write_end();
+
+	sys_clock_set_timeout(next_timeout(), false);
+}
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
+	struct timeout_queue *q;
+	struct tick_state state;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	uint64_t expiry;
+
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return;
 	}
@@ -114,9 +296,124 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+	/* Stay on this CPU until the timeout sits on its queue */
+	irq_key = arch_irq_lock();
+	q = &timeout_queues[_current_cpu->id];
+	key = k_spin_lock(&q->lock);
+
+	tick_state_get(&state, Z_TICK_ABS(timeout.ticks) < 0);
+
+	if (Z_TICK_ABS(timeout.ticks) >= 0) {
+		k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - state.tick;
+
+		expiry = state.tick + MAX(1, ticks);
+	} else {
+		expiry = state.tick + timeout.ticks + 1 + state.elapsed;
+	}
+
+	to->dticks = expiry;
+	to->cpu = _current_cpu->id;
+	z_timeout_wheel_add(&q->wheel, to);
+
+	k_spin_unlock(&q->lock, key);
+	arch_irq_unlock(irq_key);
+
+	/* sys_clock_announce() reprograms the timer once done */
+	if (!state.announcing && (expiry < state.programmed)) {
+		K_SPINLOCK(&timeout_lock) {
+			if (announce_remaining == 0) {
+				program_next();
+			}
+		}
+	}
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	struct timeout_queue *q;
+	struct tick_state state;
+	k_spinlock_key_t key;
+	bool is_first = false;
+	int ret = -EINVAL;
+
+	q = timeout_queue_lock(to, &key);
+
+	if (sys_dnode_is_linked(&to->node)) {
+		tick_state_get(&state, false);
+		is_first = ((uint64_t)to->dticks == state.programmed) && !state.announcing;
+		z_timeout_wheel_remove(&q->wheel, to);
+		ret = 0;
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	if (is_first) {
+		K_SPINLOCK(&timeout_lock) {
+			if (announce_remaining == 0) {
+				program_next();
+			}
+		}
+	}
+
+	return ret;
+}
 
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	struct tick_state state;
+	k_spinlock_key_t key;
+	struct timeout_queue *q;
+	k_ticks_t ticks = 0;
+
+	q = timeout_queue_lock(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		tick_state_get(&state, true);
+		ticks = timeout->dticks - state.tick - state.elapsed;
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	struct tick_state state;
+	k_spinlock_key_t key;
+	struct timeout_queue *q;
+	k_ticks_t ticks;
+
+	q = timeout_queue_lock(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks = timeout->dticks;
+	} else {
+		tick_state_get(&state, false);
+		ticks = state.tick;
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+#else
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	K_SPINLOCK(&timeout_lock) {
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -126,6 +423,19 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		uint64_t prev_next = z_timeout_wheel_next(&timeout_wheel);
+
+		to->dticks += curr_tick;
+		z_timeout_wheel_add(&timeout_wheel, to);
+
+		if ((z_timeout_wheel_next(&timeout_wheel) < prev_next) &&
+		    (announce_remaining == 0)) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+#else
+		struct _timeout *t;
+
 		for (t = first(); t != NULL; t = next(t)) {
 			if (t->dticks > to->dticks) {
 				t->dticks -= to->dticks;
@@ -142,6 +452,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first() && announce_remaining == 0) {
 			sys_clock_set_timeout(next_timeout(), false);
 		}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 	}
 }
 
@@ -151,9 +462,16 @@ int z_abort_timeout(struct _timeout *to)
 
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+			uint64_t prev_next = z_timeout_wheel_next(&timeout_wheel);
+
+			remove_timeout(to);
+			bool is_first = (z_timeout_wheel_next(&timeout_wheel) != prev_next);
+#else
 			bool is_first = (to == first());
 
 			remove_timeout(to);
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 			ret = 0;
 			if (is_first) {
 				sys_clock_set_timeout(next_timeout(), false);
@@ -167,6 +485,9 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	return timeout->dticks - curr_tick;
+#else
 	k_ticks_t ticks = 0;
 
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
@@ -177,6 +498,7 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 	}
 
 	return ticks;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -206,6 +528,8 @@ k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 	return ticks;
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 int32_t z_get_next_timeout_expiry(void)
 {
 	int32_t ret = (int32_t) K_TICKS_FOREVER;
@@ -216,6 +540,83 @@ int32_t z_get_next_timeout_expiry(void)
 	return ret;
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+void sys_clock_announce(int32_t ticks)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+
+	/* Only one CPU at a time runs the expiry loop, see below */
+	if (announce_remaining != 0) {
+		announce_remaining += ticks;
+		k_spin_unlock(&timeout_lock, key);
+		return;
+	}
+
+	tick_write_begin();
+	announce_remaining = ticks;
+	tick_write_end();
+
+	/* Expire timeouts in order across all the CPU queues, by always
+	 * servicing the queue with the earliest pending event.  Queues
+	 * that are not serviced simply lag behind curr_tick.
+	 */
+	for (;;) {
+		struct timeout_queue *q;
+		struct _timeout *t;
+		k_spinlock_key_t q_key;
+		uint64_t next;
+		k_ticks_t dt;
+
+		q = earliest_queue(&next);
+		if ((q == NULL) ||
+		    ((next > curr_tick) && ((next - curr_tick) > (uint64_t)announce_remaining))) {
+			break;
+		}
+
+		q_key = k_spin_lock(&q->lock);
+
+		/* The queue owner may have armed or aborted something since */
+		next = z_timeout_wheel_next(&q->wheel);
+		if ((next > curr_tick) && ((next - curr_tick) > (uint64_t)announce_remaining)) {
+			k_spin_unlock(&q->lock, q_key);
+			continue;
+		}
+
+		dt = (next > curr_tick) ? (k_ticks_t)(next - curr_tick) : 0;
+
+		tick_write_begin();
+		curr_tick += dt;
+		tick_write_end();
+
+		t = z_timeout_wheel_advance(&q->wheel, next);
+		k_spin_unlock(&q->lock, q_key);
+
+		if (t != NULL) {
+			t->dticks = 0;
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+
+		tick_write_begin();
+		announce_remaining -= dt;
+		tick_write_end();
+	}
+
+	tick_write_begin();
+	curr_tick += announce_remaining;
+	announce_remaining = 0;
+	tick_write_end();
+
+	program_next();
+
+	k_spin_unlock(&timeout_lock, key);
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+}
+#else
 void sys_clock_announce(int32_t ticks)
 {
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
@@ -234,6 +635,31 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	k_ticks_t dt;
+
+	/* Walk the wheel one service point at a time; not every one of
+	 * them has a timeout due, some only cascade higher level slots.
+	 */
+	while (((dt = next_event_ticks()) != K_TICKS_FOREVER) &&
+	       (dt <= announce_remaining)) {
+		struct _timeout *t;
+
+		curr_tick += dt;
+		t = z_timeout_wheel_advance(&timeout_wheel, curr_tick);
+
+		if (t != NULL) {
+			t->dticks = 0;
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+		announce_remaining -= dt;
+	}
+
+	curr_tick += announce_remaining;
+	(void)z_timeout_wheel_advance(&timeout_wheel, curr_tick);
+#else
 	struct _timeout *t;
 
 	for (t = first();
@@ -256,6 +682,7 @@ void sys_clock_announce(int32_t ticks)
 	}
 
 	curr_tick += announce_remaining;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(), false);
@@ -266,6 +693,7 @@ void sys_clock_announce(int32_t ticks)
 	z_time_slice();
 #endif /* CONFIG_TIMESLICING */
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 int64_t sys_clock_tick_get(void)
 {
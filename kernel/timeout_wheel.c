@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
+#include <timeout_wheel.h>
+
+#define LEVELS    CONFIG_TIMEOUT_WHEEL_LEVELS
+#define SLOT_BITS Z_TIMEOUT_WHEEL_SLOT_BITS
+#define SLOTS     Z_TIMEOUT_WHEEL_SLOTS
+#define SLOT_MASK (SLOTS - 1U)
+
+BUILD_ASSERT(SLOTS == 64, "slot bitmaps are 64 bits wide");
+BUILD_ASSERT(LEVELS * SLOT_BITS < 64, "wheel span must fit in a tick count");
+
+static inline uint64_t expiry_of(const struct _timeout *to)
+{
+	return (uint64_t)to->dticks;
+}
+
+/* Slot-sized window of the given level that a tick falls into */
+static inline uint64_t window(uint64_t tick, int level)
+{
+	return tick >> (level * SLOT_BITS);
+}
+
+static inline unsigned int slot_idx(uint64_t tick, int level)
+{
+	return (unsigned int)(window(tick, level) & SLOT_MASK);
+}
+
+/*
+ * First set bit of a slot bitmap at or after position 'from', walking
+ * circularly.  Returns the distance from 'from', or -1 if the bitmap is
+ * empty.
+ */
+static int next_occupied(uint64_t bitmap, unsigned int from)
+{
+	uint64_t rot;
+
+	if (bitmap == 0U) {
+		return -1;
+	}
+
+	rot = (from == 0U) ? bitmap : ((bitmap >> from) | (bitmap << (SLOTS - from)));
+
+	return u64_count_trailing_zeros(rot);
+}
+
+void z_timeout_wheel_init(struct z_timeout_wheel *wheel, uint64_t now)
+{
+	wheel->now = now;
+	for (int l = 0; l < LEVELS; l++) {
+		wheel->occupied[l] = 0U;
+	}
+	sys_dlist_init(&wheel->overflow);
+}
+
+void z_timeout_wheel_add(struct z_timeout_wheel *wheel, struct _timeout *to)
+{
+	uint64_t expiry = expiry_of(to);
+
+	__ASSERT_NO_MSG(expiry >= wheel->now);
+
+	/*
+	 * Use the lowest level where the timeout lands less than one full
+	 * revolution away.  Above level 0 this also guarantees that it never
+	 * lands in the slot the wheel is currently in, so slot indexes are
+	 * never ambiguous.
+	 */
+	for (int l = 0; l < LEVELS; l++) {
+		if ((window(expiry, l) - window(wheel->now, l)) < SLOTS) {
+			unsigned int s = slot_idx(expiry, l);
+
+			/* Slot lists are only valid while their bit is set */
+			if ((wheel->occupied[l] & BIT64(s)) == 0U) {
+				sys_dlist_init(&wheel->slots[l][s]);
+				wheel->occupied[l] |= BIT64(s);
+			}
+			sys_dlist_append(&wheel->slots[l][s], &to->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&wheel->overflow, &to->node);
+}
+
+void z_timeout_wheel_remove(struct z_timeout_wheel *wheel, struct _timeout *to)
+{
+	sys_dnode_t *node = &to->node;
+
+	/*
+	 * The slot a timeout lives in can't be recomputed from its expiry as
+	 * the wheel may have turned since it was inserted.  If the node is
+	 * the only one on its list both neighbors are the list head, which
+	 * identifies the slot whose occupancy bit must be cleared.
+	 */
+	if ((node->next == node->prev) && (node->next != &wheel->overflow)) {
+		size_t i = (sys_dlist_t *)node->next - &wheel->slots[0][0];
+
+		__ASSERT_NO_MSG(i < (LEVELS * SLOTS));
+		wheel->occupied[i / SLOTS] &= ~BIT64(i % SLOTS);
+	}
+
+	sys_dlist_remove(node);
+}
+
+uint64_t z_timeout_wheel_next(struct z_timeout_wheel *wheel)
+{
+	uint64_t next = UINT64_MAX;
+	int off;
+
+	off = next_occupied(wheel->occupied[0], slot_idx(wheel->now, 0));
+	if (off >= 0) {
+		next = wheel->now + off;
+	}
+
+	/*
+	 * Higher level slots never contain the current window, start the
+	 * search one slot after it.  The earliest anything in there can
+	 * expire is the start of that slot's window.
+	 */
+	for (int l = 1; l < LEVELS; l++) {
+		off = next_occupied(wheel->occupied[l],
+				    (slot_idx(wheel->now, l) + 1U) & SLOT_MASK);
+		if (off >= 0) {
+			uint64_t start = (window(wheel->now, l) + off + 1U) << (l * SLOT_BITS);
+
+			next = MIN(next, start);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel->overflow)) {
+		uint64_t top = (window(wheel->now, LEVELS - 1) + 1U) << ((LEVELS - 1) * SLOT_BITS);
+
+		next = MIN(next, top);
+	}
+
+	return next;
+}
+
+/* Re-add everything on a list relative to the wheel's new position */
+static void cascade(struct z_timeout_wheel *wheel, sys_dlist_t *list)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+
+	if (sys_dlist_is_empty(list)) {
+		return;
+	}
+
+	/* Move the whole list aside first, timeouts may land back on it */
+	pending.head = list->head;
+	pending.tail = list->tail;
+	pending.head->prev = &pending;
+	pending.tail->next = &pending;
+	sys_dlist_init(list);
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		z_timeout_wheel_add(wheel, CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+struct _timeout *z_timeout_wheel_advance(struct z_timeout_wheel *wheel, uint64_t tick)
+{
+	uint64_t prev = wheel->now;
+	struct _timeout *to;
+	unsigned int s;
+
+	__ASSERT_NO_MSG((tick >= prev) && (tick <= z_timeout_wheel_next(wheel)));
+
+	wheel->now = tick;
+
+	if (tick != prev) {
+		/*
+		 * Since tick is not past the next service point, at most the
+		 * one slot whose window starts at tick can need cascading
+		 * on each level: anything in an earlier window would have
+		 * been a service point of its own.
+		 */
+		if (window(tick, LEVELS - 1) != window(prev, LEVELS - 1)) {
+			cascade(wheel, &wheel->overflow);
+		}
+
+		for (int l = LEVELS - 1; l > 0; l--) {
+			s = slot_idx(tick, l);
+			if ((window(tick, l) != window(prev, l)) &&
+			    ((wheel->occupied[l] & BIT64(s)) != 0U)) {
+				wheel->occupied[l] &= ~BIT64(s);
+				cascade(wheel, &wheel->slots[l][s]);
+			}
+		}
+	}
+
+	s = slot_idx(tick, 0);
+	if ((wheel->occupied[0] & BIT64(s)) == 0U) {
+		return NULL;
+	}
+
+	to = CONTAINER_OF(sys_dlist_peek_head(&wheel->slots[0][s]), struct _timeout, node);
+
+	__ASSERT_NO_MSG(expiry_of(to) == tick);
+	z_timeout_wheel_remove(wheel, to);
+
+	return to;
+}
@@ -6,6 +6,10 @@
 
 #include <zephyr/sys/crc.h>
 
+#if defined(CONFIG_CRC_SPEED_OPTIMIZED)
+#include "crc_internal.h"
+#endif
+
 uint16_t crc16(uint16_t poly, uint16_t seed, const uint8_t *src, size_t len)
 {
 	uint16_t crc = seed;
@@ -49,6 +53,49 @@ uint16_t crc16_reflect(uint16_t poly, uint16_t seed, const uint8_t *src, size_t
 }
 
 
+#if defined(CONFIG_CRC_SPEED_OPTIMIZED)
+uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
+{
+	const uint16_t (*table)[256] = crc16_ccitt_slice_table;
+
+	/* Reflected, the register overlaps the first two bytes */
+	for (; len >= 8; len -= 8, src += 8) {
+		uint16_t lo = seed ^ sys_get_le16(src);
+
+		seed = table[7][lo & 0xff] ^ table[6][lo >> 8] ^
+		       table[5][src[2]] ^ table[4][src[3]] ^
+		       table[3][src[4]] ^ table[2][src[5]] ^
+		       table[1][src[6]] ^ table[0][src[7]];
+	}
+
+	for (; len > 0; len--, src++) {
+		seed = (seed >> 8) ^ table[0][(seed ^ *src) & 0xff];
+	}
+
+	return seed;
+}
+
+uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
+{
+	const uint16_t (*table)[256] = crc16_itu_t_slice_table;
+
+	/* MSB first, the register overlaps the first two bytes */
+	for (; len >= 8; len -= 8, src += 8) {
+		uint16_t hi = seed ^ sys_get_be16(src);
+
+		seed = table[7][hi >> 8] ^ table[6][hi & 0xff] ^
+		       table[5][src[2]] ^ table[4][src[3]] ^
+		       table[3][src[4]] ^ table[2][src[5]] ^
+		       table[1][src[6]] ^ table[0][src[7]];
+	}
+
+	for (; len > 0; len--, src++) {
+		seed = (seed << 8) ^ table[0][(seed >> 8) ^ *src];
+	}
+
+	return seed;
+}
+#else
 uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 {
 	for (; len > 0; len--) {
@@ -76,3 +123,4 @@ uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 
 	return seed;
 }
+#endif /* CONFIG_CRC_SPEED_OPTIMIZED */
@@ -6,11 +6,28 @@
 
 #include <zephyr/sys/crc.h>
 
+#if defined(CONFIG_CRC_SPEED_OPTIMIZED)
+#include "crc_internal.h"
+#endif
+
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
 }
 
+#if defined(CONFIG_CRC_SPEED_OPTIMIZED)
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	size_t done;
+
+	crc = ~crc;
+
+	done = crc32_ieee_hw(&crc, data, len);
+	crc = crc32_slice8(crc32_ieee_slice_table, crc, data + done, len - done);
+
+	return (~crc);
+}
+#else
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
 	/* crc table generated from polynomial 0xedb88320 */
@@ -32,3 +49,4 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 
 	return (~crc);
 }
+#endif /* CONFIG_CRC_SPEED_OPTIMIZED */
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CRC-32 and CRC-32C with the instructions the compiler targets:
+ *
+ * - ARMv8 CRC32 extension: both polynomials, eight bytes per instruction.
+ * - x86 SSE4.2 crc32: CRC-32C only, four or eight bytes per instruction.
+ * - x86 PCLMULQDQ: both polynomials, by folding 64 bytes at a time with
+ *   carry-less multiplies and a final Barrett reduction, as described in
+ *   Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+ *   Instruction".
+ */
+
+#include "crc_internal.h"
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#elif defined(__SSE4_2__) || (defined(__PCLMUL__) && defined(__SSE4_1__))
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+
+size_t crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	uint32_t c = *crc;
+
+	for (size_t i = 0; i < len / 8; i++) {
+		c = __crc32d(c, sys_get_le64(data + i * 8));
+	}
+
+	*crc = c;
+
+	return len & ~(size_t)7;
+}
+
+size_t crc32c_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	uint32_t c = *crc;
+
+	for (size_t i = 0; i < len / 8; i++) {
+		c = __crc32cd(c, sys_get_le64(data + i * 8));
+	}
+
+	*crc = c;
+
+	return len & ~(size_t)7;
+}
+
+#else /* x86 */
+
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+
+/* Shortest data worth folding, there must be at least one 64 byte block */
+#define CRC_CLMUL_MIN_LEN 64
+
+/* Bit reflected x^n mod P constants and the Barrett reduction constants */
+struct crc_clmul_consts {
+	uint64_t k1k2[2];
+	uint64_t k3k4[2];
+	uint64_t k5k0[2];
+	uint64_t poly[2];
+};
+
+#if defined(CRC32_IEEE_HW)
+static const struct crc_clmul_consts crc32_ieee_consts __aligned(16) = {
+	.k1k2 = { 0x0154442bd4, 0x01c6e41596 },
+	.k3k4 = { 0x01751997d0, 0x00ccaa009e },
+	.k5k0 = { 0x0163cd6124, 0x0000000000 },
+	.poly = { 0x01db710641, 0x01f7011641 },
+};
+#endif
+
+#if !defined(__SSE4_2__)
+static const struct crc_clmul_consts crc32c_consts __aligned(16) = {
+	.k1k2 = { 0x00740eef02, 0x009e4addf8 },
+	.k3k4 = { 0x00f20c0dfe, 0x014cd00bd6 },
+	.k5k0 = { 0x00dd45aab8, 0x0000000000 },
+	.poly = { 0x0105ec76f1, 0x00dea713f1 },
+};
+#endif
+
+/* len must be at least CRC_CLMUL_MIN_LEN and a multiple of 16 */
+static uint32_t crc32_clmul(const struct crc_clmul_consts *k, uint32_t crc,
+			    const uint8_t *data, size_t len)
+{
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+	x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+
+	data += 64;
+	len -= 64;
+
+	/* Fold four blocks in parallel */
+	x0 = _mm_load_si128((const __m128i *)k->k1k2);
+
+	for (; len >= 64; len -= 64, data += 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+				   _mm_loadu_si128((const __m128i *)(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+				   _mm_loadu_si128((const __m128i *)(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+				   _mm_loadu_si128((const __m128i *)(data + 0x30)));
+	}
+
+	/* Fold the four blocks into one */
+	x0 = _mm_load_si128((const __m128i *)k->k3k4);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	/* Fold in the remaining single blocks */
+	for (; len >= 16; len -= 16, data += 16) {
+		x2 = _mm_loadu_si128((const __m128i *)data);
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	}
+
+	/* Fold 128 bits to 64 bits */
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+	x0 = _mm_loadl_epi64((const __m128i *)k->k5k0);
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask32);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/* Barrett reduction to 32 bits */
+	x0 = _mm_load_si128((const __m128i *)k->poly);
+
+	x2 = _mm_and_si128(x1, mask32);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, mask32);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+#if defined(CRC32_IEEE_HW)
+size_t crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	if (len < CRC_CLMUL_MIN_LEN) {
+		return 0;
+	}
+
+	len &= ~(size_t)15;
+	*crc = crc32_clmul(&crc32_ieee_consts, *crc, data, len);
+
+	return len;
+}
+#endif /* CRC32_IEEE_HW */
+
+#endif /* __PCLMUL__ && __SSE4_1__ */
+
+#if defined(__SSE4_2__)
+
+size_t crc32c_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+
+#if defined(__x86_64__)
+	uint64_t c = *crc;
+
+	for (; len - i >= 8; i += 8) {
+		c = _mm_crc32_u64(c, sys_get_le64(data + i));
+	}
+#else
+	uint32_t c = *crc;
+
+	for (; len - i >= 4; i += 4) {
+		c = _mm_crc32_u32(c, sys_get_le32(data + i));
+	}
+#endif
+
+	*crc = (uint32_t)c;
+
+	return i;
+}
+
+#elif defined(CRC32C_HW)
+
+size_t crc32c_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	if (len < CRC_CLMUL_MIN_LEN) {
+		return 0;
+	}
+
+	len &= ~(size_t)15;
+	*crc = crc32_clmul(&crc32c_consts, *crc, data, len);
+
+	return len;
+}
+
+#endif /* __SSE4_2__ */
+
+#endif /* __ARM_FEATURE_CRC32 */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC_INTERNAL_H_
+#define ZEPHYR_LIB_CRC_CRC_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/byteorder.h>
+
+#define CRC_TABLE_SLICES 8
+
+extern const uint32_t crc32_ieee_slice_table[CRC_TABLE_SLICES][256];
+extern const uint32_t crc32c_slice_table[CRC_TABLE_SLICES][256];
+extern const uint16_t crc16_ccitt_slice_table[CRC_TABLE_SLICES][256];
+extern const uint16_t crc16_itu_t_slice_table[CRC_TABLE_SLICES][256];
+
+/* Which CRCs the instructions the compiler targets can calculate */
+#if defined(CONFIG_CRC_HW_ACCEL)
+#if (defined(__PCLMUL__) && defined(__SSE4_1__)) || defined(__ARM_FEATURE_CRC32)
+#define CRC32_IEEE_HW 1
+#endif
+#if defined(__SSE4_2__) || (defined(__PCLMUL__) && defined(__SSE4_1__)) || \
+	defined(__ARM_FEATURE_CRC32)
+#define CRC32C_HW 1
+#endif
+#endif /* CONFIG_CRC_HW_ACCEL */
+
+/*
+ * Update the reflected CRC-32 register crc with as much of the data as the
+ * CPU instructions handle efficiently, and return the number of bytes done.
+ * The rest is left to the tables.
+ */
+#if defined(CRC32_IEEE_HW)
+size_t crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len);
+#else
+static inline size_t crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(crc);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return 0;
+}
+#endif /* CRC32_IEEE_HW */
+
+#if defined(CRC32C_HW)
+size_t crc32c_hw(uint32_t *crc, const uint8_t *data, size_t len);
+#else
+static inline size_t crc32c_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	ARG_UNUSED(crc);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return 0;
+}
+#endif /* CRC32C_HW */
+
+/* Reflected CRC-32, eight bytes per step */
+static inline uint32_t crc32_slice8(const uint32_t table[CRC_TABLE_SLICES][256],
+				    uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (; len >= 8; len -= 8, data += 8) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *data) & 0xff];
+	}
+
+	return crc;
+}
+
+#endif /* ZEPHYR_LIB_CRC_CRC_INTERNAL_H_ */
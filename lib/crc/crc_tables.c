@@ -0,0 +1,1631 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Slicing-by-8 tables. Table 0 holds the CRC of each byte value, table k the
+ * CRC of each byte value followed by k zero bytes:
+ *
+ *   reflected:  T[k][b] = (T[k - 1][b] >> 8) ^ T[0][T[k - 1][b] & 0xff]
+ *   MSB first:  T[k][b] = (T[k - 1][b] << 8) ^ T[0][T[k - 1][b] >> (width - 8)]
+ */
+
+#include "crc_internal.h"
+
+/* Polynomial 0x04C11DB7, reflected (0xEDB88320) */
+const uint32_t crc32_ieee_slice_table[CRC_TABLE_SLICES][256] = {
+	{
+		0x00000000U, 0x77073096U, 0xee0e612cU, 0x990951baU,
+		0x076dc419U, 0x706af48fU, 0xe963a535U, 0x9e6495a3U,
+		0x0edb8832U, 0x79dcb8a4U, 0xe0d5e91eU, 0x97d2d988U,
+		0x09b64c2bU, 0x7eb17cbdU, 0xe7b82d07U, 0x90bf1d91U,
+		0x1db71064U, 0x6ab020f2U, 0xf3b97148U, 0x84be41deU,
+		0x1adad47dU, 0x6ddde4ebU, 0xf4d4b551U, 0x83d385c7U,
+		0x136c9856U, 0x646ba8c0U, 0xfd62f97aU, 0x8a65c9ecU,
+		0x14015c4fU, 0x63066cd9U, 0xfa0f3d63U, 0x8d080df5U,
+		0x3b6e20c8U, 0x4c69105eU, 0xd56041e4U, 0xa2677172U,
+		0x3c03e4d1U, 0x4b04d447U, 0xd20d85fdU, 0xa50ab56bU,
+		0x35b5a8faU, 0x42b2986cU, 0xdbbbc9d6U, 0xacbcf940U,
+		0x32d86ce3U, 0x45df5c75U, 0xdcd60dcfU, 0xabd13d59U,
+		0x26d930acU, 0x51de003aU, 0xc8d75180U, 0xbfd06116U,
+		0x21b4f4b5U, 0x56b3c423U, 0xcfba9599U, 0xb8bda50fU,
+		0x2802b89eU, 0x5f058808U, 0xc60cd9b2U, 0xb10be924U,
+		0x2f6f7c87U, 0x58684c11U, 0xc1611dabU, 0xb6662d3dU,
+		0x76dc4190U, 0x01db7106U, 0x98d220bcU, 0xefd5102aU,
+		0x71b18589U, 0x06b6b51fU, 0x9fbfe4a5U, 0xe8b8d433U,
+		0x7807c9a2U, 0x0f00f934U, 0x9609a88eU, 0xe10e9818U,
+		0x7f6a0dbbU, 0x086d3d2dU, 0x91646c97U, 0xe6635c01U,
+		0x6b6b51f4U, 0x1c6c6162U, 0x856530d8U, 0xf262004eU,
+		0x6c0695edU, 0x1b01a57bU, 0x8208f4c1U, 0xf50fc457U,
+		0x65b0d9c6U, 0x12b7e950U, 0x8bbeb8eaU, 0xfcb9887cU,
+		0x62dd1ddfU, 0x15da2d49U, 0x8cd37cf3U, 0xfbd44c65U,
+		0x4db26158U, 0x3ab551ceU, 0xa3bc0074U, 0xd4bb30e2U,
+		0x4adfa541U, 0x3dd895d7U, 0xa4d1c46dU, 0xd3d6f4fbU,
+		0x4369e96aU, 0x346ed9fcU, 0xad678846U, 0xda60b8d0U,
+		0x44042d73U, 0x33031de5U, 0xaa0a4c5fU, 0xdd0d7cc9U,
+		0x5005713cU, 0x270241aaU, 0xbe0b1010U, 0xc90c2086U,
+		0x5768b525U, 0x206f85b3U, 0xb966d409U, 0xce61e49fU,
+		0x5edef90eU, 0x29d9c998U, 0xb0d09822U, 0xc7d7a8b4U,
+		0x59b33d17U, 0x2eb40d81U, 0xb7bd5c3bU, 0xc0ba6cadU,
+		0xedb88320U, 0x9abfb3b6U, 0x03b6e20cU, 0x74b1d29aU,
+		0xead54739U, 0x9dd277afU, 0x04db2615U, 0x73dc1683U,
+		0xe3630b12U, 0x94643b84U, 0x0d6d6a3eU, 0x7a6a5aa8U,
+		0xe40ecf0bU, 0x9309ff9dU, 0x0a00ae27U, 0x7d079eb1U,
+		0xf00f9344U, 0x8708a3d2U, 0x1e01f268U, 0x6906c2feU,
+		0xf762575dU, 0x806567cbU, 0x196c3671U, 0x6e6b06e7U,
+		0xfed41b76U, 0x89d32be0U, 0x10da7a5aU, 0x67dd4accU,
+		0xf9b9df6fU, 0x8ebeeff9U, 0x17b7be43U, 0x60b08ed5U,
+		0xd6d6a3e8U, 0xa1d1937eU, 0x38d8c2c4U, 0x4fdff252U,
+		0xd1bb67f1U, 0xa6bc5767U, 0x3fb506ddU, 0x48b2364bU,
+		0xd80d2bdaU, 0xaf0a1b4cU, 0x36034af6U, 0x41047a60U,
+		0xdf60efc3U, 0xa867df55U, 0x316e8eefU, 0x4669be79U,
+		0xcb61b38cU, 0xbc66831aU, 0x256fd2a0U, 0x5268e236U,
+		0xcc0c7795U, 0xbb0b4703U, 0x220216b9U, 0x5505262fU,
+		0xc5ba3bbeU, 0xb2bd0b28U, 0x2bb45a92U, 0x5cb36a04U,
+		0xc2d7ffa7U, 0xb5d0cf31U, 0x2cd99e8bU, 0x5bdeae1dU,
+		0x9b64c2b0U, 0xec63f226U, 0x756aa39cU, 0x026d930aU,
+		0x9c0906a9U, 0xeb0e363fU, 0x72076785U, 0x05005713U,
+		0x95bf4a82U, 0xe2b87a14U, 0x7bb12baeU, 0x0cb61b38U,
+		0x92d28e9bU, 0xe5d5be0dU, 0x7cdcefb7U, 0x0bdbdf21U,
+		0x86d3d2d4U, 0xf1d4e242U, 0x68ddb3f8U, 0x1fda836eU,
+		0x81be16cdU, 0xf6b9265bU, 0x6fb077e1U, 0x18b74777U,
+		0x88085ae6U, 0xff0f6a70U, 0x66063bcaU, 0x11010b5cU,
+		0x8f659effU, 0xf862ae69U, 0x616bffd3U, 0x166ccf45U,
+		0xa00ae278U, 0xd70dd2eeU, 0x4e048354U, 0x3903b3c2U,
+		0xa7672661U, 0xd06016f7U, 0x4969474dU, 0x3e6e77dbU,
+		0xaed16a4aU, 0xd9d65adcU, 0x40df0b66U, 0x37d83bf0U,
+		0xa9bcae53U, 0xdebb9ec5U, 0x47b2cf7fU, 0x30b5ffe9U,
+		0xbdbdf21cU, 0xcabac28aU, 0x53b39330U, 0x24b4a3a6U,
+		0xbad03605U, 0xcdd70693U, 0x54de5729U, 0x23d967bfU,
+		0xb3667a2eU, 0xc4614ab8U, 0x5d681b02U, 0x2a6f2b94U,
+		0xb40bbe37U, 0xc30c8ea1U, 0x5a05df1bU, 0x2d02ef8dU,
+	},
+	{
+		0x00000000U, 0x191b3141U, 0x32366282U, 0x2b2d53c3U,
+		0x646cc504U, 0x7d77f445U, 0x565aa786U, 0x4f4196c7U,
+		0xc8d98a08U, 0xd1c2bb49U, 0xfaefe88aU, 0xe3f4d9cbU,
+		0xacb54f0cU, 0xb5ae7e4dU, 0x9e832d8eU, 0x87981ccfU,
+		0x4ac21251U, 0x53d92310U, 0x78f470d3U, 0x61ef4192U,
+		0x2eaed755U, 0x37b5e614U, 0x1c98b5d7U, 0x05838496U,
+		0x821b9859U, 0x9b00a918U, 0xb02dfadbU, 0xa936cb9aU,
+		0xe6775d5dU, 0xff6c6c1cU, 0xd4413fdfU, 0xcd5a0e9eU,
+		0x958424a2U, 0x8c9f15e3U, 0xa7b24620U, 0xbea97761U,
+		0xf1e8e1a6U, 0xe8f3d0e7U, 0xc3de8324U, 0xdac5b265U,
+		0x5d5daeaaU, 0x44469febU, 0x6f6bcc28U, 0x7670fd69U,
+		0x39316baeU, 0x202a5aefU, 0x0b07092cU, 0x121c386dU,
+		0xdf4636f3U, 0xc65d07b2U, 0xed705471U, 0xf46b6530U,
+		0xbb2af3f7U, 0xa231c2b6U, 0x891c9175U, 0x9007a034U,
+		0x179fbcfbU, 0x0e848dbaU, 0x25a9de79U, 0x3cb2ef38U,
+		0x73f379ffU, 0x6ae848beU, 0x41c51b7dU, 0x58de2a3cU,
+		0xf0794f05U, 0xe9627e44U, 0xc24f2d87U, 0xdb541cc6U,
+		0x94158a01U, 0x8d0ebb40U, 0xa623e883U, 0xbf38d9c2U,
+		0x38a0c50dU, 0x21bbf44cU, 0x0a96a78fU, 0x138d96ceU,
+		0x5ccc0009U, 0x45d73148U, 0x6efa628bU, 0x77e153caU,
+		0xbabb5d54U, 0xa3a06c15U, 0x888d3fd6U, 0x91960e97U,
+		0xded79850U, 0xc7cca911U, 0xece1fad2U, 0xf5facb93U,
+		0x7262d75cU, 0x6b79e61dU, 0x4054b5deU, 0x594f849fU,
+		0x160e1258U, 0x0f152319U, 0x243870daU, 0x3d23419bU,
+		0x65fd6ba7U, 0x7ce65ae6U, 0x57cb0925U, 0x4ed03864U,
+		0x0191aea3U, 0x188a9fe2U, 0x33a7cc21U, 0x2abcfd60U,
+		0xad24e1afU, 0xb43fd0eeU, 0x9f12832dU, 0x8609b26cU,
+		0xc94824abU, 0xd05315eaU, 0xfb7e4629U, 0xe2657768U,
+		0x2f3f79f6U, 0x362448b7U, 0x1d091b74U, 0x04122a35U,
+		0x4b53bcf2U, 0x52488db3U, 0x7965de70U, 0x607eef31U,
+		0xe7e6f3feU, 0xfefdc2bfU, 0xd5d0917cU, 0xcccba03dU,
+		0x838a36faU, 0x9a9107bbU, 0xb1bc5478U, 0xa8a76539U,
+		0x3b83984bU, 0x2298a90aU, 0x09b5fac9U, 0x10aecb88U,
+		0x5fef5d4fU, 0x46f46c0eU, 0x6dd93fcdU, 0x74c20e8cU,
+		0xf35a1243U, 0xea412302U, 0xc16c70c1U, 0xd8774180U,
+		0x9736d747U, 0x8e2de606U, 0xa500b5c5U, 0xbc1b8484U,
+		0x71418a1aU, 0x685abb5bU, 0x4377e898U, 0x5a6cd9d9U,
+		0x152d4f1eU, 0x0c367e5fU, 0x271b2d9cU, 0x3e001cddU,
+		0xb9980012U, 0xa0833153U, 0x8bae6290U, 0x92b553d1U,
+		0xddf4c516U, 0xc4eff457U, 0xefc2a794U, 0xf6d996d5U,
+		0xae07bce9U, 0xb71c8da8U, 0x9c31de6bU, 0x852aef2aU,
+		0xca6b79edU, 0xd37048acU, 0xf85d1b6fU, 0xe1462a2eU,
+		0x66de36e1U, 0x7fc507a0U, 0x54e85463U, 0x4df36522U,
+		0x02b2f3e5U, 0x1ba9c2a4U, 0x30849167U, 0x299fa026U,
+		0xe4c5aeb8U, 0xfdde9ff9U, 0xd6f3cc3aU, 0xcfe8fd7bU,
+		0x80a96bbcU, 0x99b25afdU, 0xb29f093eU, 0xab84387fU,
+		0x2c1c24b0U, 0x350715f1U, 0x1e2a4632U, 0x07317773U,
+		0x4870e1b4U, 0x516bd0f5U, 0x7a468336U, 0x635db277U,
+		0xcbfad74eU, 0xd2e1e60fU, 0xf9ccb5ccU, 0xe0d7848dU,
+		0xaf96124aU, 0xb68d230bU, 0x9da070c8U, 0x84bb4189U,
+		0x03235d46U, 0x1a386c07U, 0x31153fc4U, 0x280e0e85U,
+		0x674f9842U, 0x7e54a903U, 0x5579fac0U, 0x4c62cb81U,
+		0x8138c51fU, 0x9823f45eU, 0xb30ea79dU, 0xaa1596dcU,
+		0xe554001bU, 0xfc4f315aU, 0xd7626299U, 0xce7953d8U,
+		0x49e14f17U, 0x50fa7e56U, 0x7bd72d95U, 0x62cc1cd4U,
+		0x2d8d8a13U, 0x3496bb52U, 0x1fbbe891U, 0x06a0d9d0U,
+		0x5e7ef3ecU, 0x4765c2adU, 0x6c48916eU, 0x7553a02fU,
+		0x3a1236e8U, 0x230907a9U, 0x0824546aU, 0x113f652bU,
+		0x96a779e4U, 0x8fbc48a5U, 0xa4911b66U, 0xbd8a2a27U,
+		0xf2cbbce0U, 0xebd08da1U, 0xc0fdde62U, 0xd9e6ef23U,
+		0x14bce1bdU, 0x0da7d0fcU, 0x268a833fU, 0x3f91b27eU,
+		0x70d024b9U, 0x69cb15f8U, 0x42e6463bU, 0x5bfd777aU,
+		0xdc656bb5U, 0xc57e5af4U, 0xee530937U, 0xf7483876U,
+		0xb809aeb1U, 0xa1129ff0U, 0x8a3fcc33U, 0x9324fd72U,
+	},
+	{
+		0x00000000U, 0x01c26a37U, 0x0384d46eU, 0x0246be59U,
+		0x0709a8dcU, 0x06cbc2ebU, 0x048d7cb2U, 0x054f1685U,
+		0x0e1351b8U, 0x0fd13b8fU, 0x0d9785d6U, 0x0c55efe1U,
+		0x091af964U, 0x08d89353U, 0x0a9e2d0aU, 0x0b5c473dU,
+		0x1c26a370U, 0x1de4c947U, 0x1fa2771eU, 0x1e601d29U,
+		0x1b2f0bacU, 0x1aed619bU, 0x18abdfc2U, 0x1969b5f5U,
+		0x1235f2c8U, 0x13f798ffU, 0x11b126a6U, 0x10734c91U,
+		0x153c5a14U, 0x14fe3023U, 0x16b88e7aU, 0x177ae44dU,
+		0x384d46e0U, 0x398f2cd7U, 0x3bc9928eU, 0x3a0bf8b9U,
+		0x3f44ee3cU, 0x3e86840bU, 0x3cc03a52U, 0x3d025065U,
+		0x365e1758U, 0x379c7d6fU, 0x35dac336U, 0x3418a901U,
+		0x3157bf84U, 0x3095d5b3U, 0x32d36beaU, 0x331101ddU,
+		0x246be590U, 0x25a98fa7U, 0x27ef31feU, 0x262d5bc9U,
+		0x23624d4cU, 0x22a0277bU, 0x20e69922U, 0x2124f315U,
+		0x2a78b428U, 0x2bbade1fU, 0x29fc6046U, 0x283e0a71U,
+		0x2d711cf4U, 0x2cb376c3U, 0x2ef5c89aU, 0x2f37a2adU,
+		0x709a8dc0U, 0x7158e7f7U, 0x731e59aeU, 0x72dc3399U,
+		0x7793251cU, 0x76514f2bU, 0x7417f172U, 0x75d59b45U,
+		0x7e89dc78U, 0x7f4bb64fU, 0x7d0d0816U, 0x7ccf6221U,
+		0x798074a4U, 0x78421e93U, 0x7a04a0caU, 0x7bc6cafdU,
+		0x6cbc2eb0U, 0x6d7e4487U, 0x6f38fadeU, 0x6efa90e9U,
+		0x6bb5866cU, 0x6a77ec5bU, 0x68315202U, 0x69f33835U,
+		0x62af7f08U, 0x636d153fU, 0x612bab66U, 0x60e9c151U,
+		0x65a6d7d4U, 0x6464bde3U, 0x662203baU, 0x67e0698dU,
+		0x48d7cb20U, 0x4915a117U, 0x4b531f4eU, 0x4a917579U,
+		0x4fde63fcU, 0x4e1c09cbU, 0x4c5ab792U, 0x4d98dda5U,
+		0x46c49a98U, 0x4706f0afU, 0x45404ef6U, 0x448224c1U,
+		0x41cd3244U, 0x400f5873U, 0x4249e62aU, 0x438b8c1dU,
+		0x54f16850U, 0x55330267U, 0x5775bc3eU, 0x56b7d609U,
+		0x53f8c08cU, 0x523aaabbU, 0x507c14e2U, 0x51be7ed5U,
+		0x5ae239e8U, 0x5b2053dfU, 0x5966ed86U, 0x58a487b1U,
+		0x5deb9134U, 0x5c29fb03U, 0x5e6f455aU, 0x5fad2f6dU,
+		0xe1351b80U, 0xe0f771b7U, 0xe2b1cfeeU, 0xe373a5d9U,
+		0xe63cb35cU, 0xe7fed96bU, 0xe5b86732U, 0xe47a0d05U,
+		0xef264a38U, 0xeee4200fU, 0xeca29e56U, 0xed60f461U,
+		0xe82fe2e4U, 0xe9ed88d3U, 0xebab368aU, 0xea695cbdU,
+		0xfd13b8f0U, 0xfcd1d2c7U, 0xfe976c9eU, 0xff5506a9U,
+		0xfa1a102cU, 0xfbd87a1bU, 0xf99ec442U, 0xf85cae75U,
+		0xf300e948U, 0xf2c2837fU, 0xf0843d26U, 0xf1465711U,
+		0xf4094194U, 0xf5cb2ba3U, 0xf78d95faU, 0xf64fffcdU,
+		0xd9785d60U, 0xd8ba3757U, 0xdafc890eU, 0xdb3ee339U,
+		0xde71f5bcU, 0xdfb39f8bU, 0xddf521d2U, 0xdc374be5U,
+		0xd76b0cd8U, 0xd6a966efU, 0xd4efd8b6U, 0xd52db281U,
+		0xd062a404U, 0xd1a0ce33U, 0xd3e6706aU, 0xd2241a5dU,
+		0xc55efe10U, 0xc49c9427U, 0xc6da2a7eU, 0xc7184049U,
+		0xc25756ccU, 0xc3953cfbU, 0xc1d382a2U, 0xc011e895U,
+		0xcb4dafa8U, 0xca8fc59fU, 0xc8c97bc6U, 0xc90b11f1U,
+		0xcc440774U, 0xcd866d43U, 0xcfc0d31aU, 0xce02b92dU,
+		0x91af9640U, 0x906dfc77U, 0x922b422eU, 0x93e92819U,
+		0x96a63e9cU, 0x976454abU, 0x9522eaf2U, 0x94e080c5U,
+		0x9fbcc7f8U, 0x9e7eadcfU, 0x9c381396U, 0x9dfa79a1U,
+		0x98b56f24U, 0x99770513U, 0x9b31bb4aU, 0x9af3d17dU,
+		0x8d893530U, 0x8c4b5f07U, 0x8e0de15eU, 0x8fcf8b69U,
+		0x8a809decU, 0x8b42f7dbU, 0x89044982U, 0x88c623b5U,
+		0x839a6488U, 0x82580ebfU, 0x801eb0e6U, 0x81dcdad1U,
+		0x8493cc54U, 0x8551a663U, 0x8717183aU, 0x86d5720dU,
+		0xa9e2d0a0U, 0xa820ba97U, 0xaa6604ceU, 0xaba46ef9U,
+		0xaeeb787cU, 0xaf29124bU, 0xad6fac12U, 0xacadc625U,
+		0xa7f18118U, 0xa633eb2fU, 0xa4755576U, 0xa5b73f41U,
+		0xa0f829c4U, 0xa13a43f3U, 0xa37cfdaaU, 0xa2be979dU,
+		0xb5c473d0U, 0xb40619e7U, 0xb640a7beU, 0xb782cd89U,
+		0xb2cddb0cU, 0xb30fb13bU, 0xb1490f62U, 0xb08b6555U,
+		0xbbd72268U, 0xba15485fU, 0xb853f606U, 0xb9919c31U,
+		0xbcde8ab4U, 0xbd1ce083U, 0xbf5a5edaU, 0xbe9834edU,
+	},
+	{
+		0x00000000U, 0xb8bc6765U, 0xaa09c88bU, 0x12b5afeeU,
+		0x8f629757U, 0x37def032U, 0x256b5fdcU, 0x9dd738b9U,
+		0xc5b428efU, 0x7d084f8aU, 0x6fbde064U, 0xd7018701U,
+		0x4ad6bfb8U, 0xf26ad8ddU, 0xe0df7733U, 0x58631056U,
+		0x5019579fU, 0xe8a530faU, 0xfa109f14U, 0x42acf871U,
+		0xdf7bc0c8U, 0x67c7a7adU, 0x75720843U, 0xcdce6f26U,
+		0x95ad7f70U, 0x2d111815U, 0x3fa4b7fbU, 0x8718d09eU,
+		0x1acfe827U, 0xa2738f42U, 0xb0c620acU, 0x087a47c9U,
+		0xa032af3eU, 0x188ec85bU, 0x0a3b67b5U, 0xb28700d0U,
+		0x2f503869U, 0x97ec5f0cU, 0x8559f0e2U, 0x3de59787U,
+		0x658687d1U, 0xdd3ae0b4U, 0xcf8f4f5aU, 0x7733283fU,
+		0xeae41086U, 0x525877e3U, 0x40edd80dU, 0xf851bf68U,
+		0xf02bf8a1U, 0x48979fc4U, 0x5a22302aU, 0xe29e574fU,
+		0x7f496ff6U, 0xc7f50893U, 0xd540a77dU, 0x6dfcc018U,
+		0x359fd04eU, 0x8d23b72bU, 0x9f9618c5U, 0x272a7fa0U,
+		0xbafd4719U, 0x0241207cU, 0x10f48f92U, 0xa848e8f7U,
+		0x9b14583dU, 0x23a83f58U, 0x311d90b6U, 0x89a1f7d3U,
+		0x1476cf6aU, 0xaccaa80fU, 0xbe7f07e1U, 0x06c36084U,
+		0x5ea070d2U, 0xe61c17b7U, 0xf4a9b859U, 0x4c15df3cU,
+		0xd1c2e785U, 0x697e80e0U, 0x7bcb2f0eU, 0xc377486bU,
+		0xcb0d0fa2U, 0x73b168c7U, 0x6104c729U, 0xd9b8a04cU,
+		0x446f98f5U, 0xfcd3ff90U, 0xee66507eU, 0x56da371bU,
+		0x0eb9274dU, 0xb6054028U, 0xa4b0efc6U, 0x1c0c88a3U,
+		0x81dbb01aU, 0x3967d77fU, 0x2bd27891U, 0x936e1ff4U,
+		0x3b26f703U, 0x839a9066U, 0x912f3f88U, 0x299358edU,
+		0xb4446054U, 0x0cf80731U, 0x1e4da8dfU, 0xa6f1cfbaU,
+		0xfe92dfecU, 0x462eb889U, 0x549b1767U, 0xec277002U,
+		0x71f048bbU, 0xc94c2fdeU, 0xdbf98030U, 0x6345e755U,
+		0x6b3fa09cU, 0xd383c7f9U, 0xc1366817U, 0x798a0f72U,
+		0xe45d37cbU, 0x5ce150aeU, 0x4e54ff40U, 0xf6e89825U,
+		0xae8b8873U, 0x1637ef16U, 0x048240f8U, 0xbc3e279dU,
+		0x21e91f24U, 0x99557841U, 0x8be0d7afU, 0x335cb0caU,
+		0xed59b63bU, 0x55e5d15eU, 0x47507eb0U, 0xffec19d5U,
+		0x623b216cU, 0xda874609U, 0xc832e9e7U, 0x708e8e82U,
+		0x28ed9ed4U, 0x9051f9b1U, 0x82e4565fU, 0x3a58313aU,
+		0xa78f0983U, 0x1f336ee6U, 0x0d86c108U, 0xb53aa66dU,
+		0xbd40e1a4U, 0x05fc86c1U, 0x1749292fU, 0xaff54e4aU,
+		0x322276f3U, 0x8a9e1196U, 0x982bbe78U, 0x2097d91dU,
+		0x78f4c94bU, 0xc048ae2eU, 0xd2fd01c0U, 0x6a4166a5U,
+		0xf7965e1cU, 0x4f2a3979U, 0x5d9f9697U, 0xe523f1f2U,
+		0x4d6b1905U, 0xf5d77e60U, 0xe762d18eU, 0x5fdeb6ebU,
+		0xc2098e52U, 0x7ab5e937U, 0x680046d9U, 0xd0bc21bcU,
+		0x88df31eaU, 0x3063568fU, 0x22d6f961U, 0x9a6a9e04U,
+		0x07bda6bdU, 0xbf01c1d8U, 0xadb46e36U, 0x15080953U,
+		0x1d724e9aU, 0xa5ce29ffU, 0xb77b8611U, 0x0fc7e174U,
+		0x9210d9cdU, 0x2aacbea8U, 0x38191146U, 0x80a57623U,
+		0xd8c66675U, 0x607a0110U, 0x72cfaefeU, 0xca73c99bU,
+		0x57a4f122U, 0xef189647U, 0xfdad39a9U, 0x45115eccU,
+		0x764dee06U, 0xcef18963U, 0xdc44268dU, 0x64f841e8U,
+		0xf92f7951U, 0x41931e34U, 0x5326b1daU, 0xeb9ad6bfU,
+		0xb3f9c6e9U, 0x0b45a18cU, 0x19f00e62U, 0xa14c6907U,
+		0x3c9b51beU, 0x842736dbU, 0x96929935U, 0x2e2efe50U,
+		0x2654b999U, 0x9ee8defcU, 0x8c5d7112U, 0x34e11677U,
+		0xa9362eceU, 0x118a49abU, 0x033fe645U, 0xbb838120U,
+		0xe3e09176U, 0x5b5cf613U, 0x49e959fdU, 0xf1553e98U,
+		0x6c820621U, 0xd43e6144U, 0xc68bceaaU, 0x7e37a9cfU,
+		0xd67f4138U, 0x6ec3265dU, 0x7c7689b3U, 0xc4caeed6U,
+		0x591dd66fU, 0xe1a1b10aU, 0xf3141ee4U, 0x4ba87981U,
+		0x13cb69d7U, 0xab770eb2U, 0xb9c2a15cU, 0x017ec639U,
+		0x9ca9fe80U, 0x241599e5U, 0x36a0360bU, 0x8e1c516eU,
+		0x866616a7U, 0x3eda71c2U, 0x2c6fde2cU, 0x94d3b949U,
+		0x090481f0U, 0xb1b8e695U, 0xa30d497bU, 0x1bb12e1eU,
+		0x43d23e48U, 0xfb6e592dU, 0xe9dbf6c3U, 0x516791a6U,
+		0xccb0a91fU, 0x740cce7aU, 0x66b96194U, 0xde0506f1U,
+	},
+	{
+		0x00000000U, 0x3d6029b0U, 0x7ac05360U, 0x47a07ad0U,
+		0xf580a6c0U, 0xc8e08f70U, 0x8f40f5a0U, 0xb220dc10U,
+		0x30704bc1U, 0x0d106271U, 0x4ab018a1U, 0x77d03111U,
+		0xc5f0ed01U, 0xf890c4b1U, 0xbf30be61U, 0x825097d1U,
+		0x60e09782U, 0x5d80be32U, 0x1a20c4e2U, 0x2740ed52U,
+		0x95603142U, 0xa80018f2U, 0xefa06222U, 0xd2c04b92U,
+		0x5090dc43U, 0x6df0f5f3U, 0x2a508f23U, 0x1730a693U,
+		0xa5107a83U, 0x98705333U, 0xdfd029e3U, 0xe2b00053U,
+		0xc1c12f04U, 0xfca106b4U, 0xbb017c64U, 0x866155d4U,
+		0x344189c4U, 0x0921a074U, 0x4e81daa4U, 0x73e1f314U,
+		0xf1b164c5U, 0xccd14d75U, 0x8b7137a5U, 0xb6111e15U,
+		0x0431c205U, 0x3951ebb5U, 0x7ef19165U, 0x4391b8d5U,
+		0xa121b886U, 0x9c419136U, 0xdbe1ebe6U, 0xe681c256U,
+		0x54a11e46U, 0x69c137f6U, 0x2e614d26U, 0x13016496U,
+		0x9151f347U, 0xac31daf7U, 0xeb91a027U, 0xd6f18997U,
+		0x64d15587U, 0x59b17c37U, 0x1e1106e7U, 0x23712f57U,
+		0x58f35849U, 0x659371f9U, 0x22330b29U, 0x1f532299U,
+		0xad73fe89U, 0x9013d739U, 0xd7b3ade9U, 0xead38459U,
+		0x68831388U, 0x55e33a38U, 0x124340e8U, 0x2f236958U,
+		0x9d03b548U, 0xa0639cf8U, 0xe7c3e628U, 0xdaa3cf98U,
+		0x3813cfcbU, 0x0573e67bU, 0x42d39cabU, 0x7fb3b51bU,
+		0xcd93690bU, 0xf0f340bbU, 0xb7533a6bU, 0x8a3313dbU,
+		0x0863840aU, 0x3503adbaU, 0x72a3d76aU, 0x4fc3fedaU,
+		0xfde322caU, 0xc0830b7aU, 0x872371aaU, 0xba43581aU,
+		0x9932774dU, 0xa4525efdU, 0xe3f2242dU, 0xde920d9dU,
+		0x6cb2d18dU, 0x51d2f83dU, 0x167282edU, 0x2b12ab5dU,
+		0xa9423c8cU, 0x9422153cU, 0xd3826fecU, 0xeee2465cU,
+		0x5cc29a4cU, 0x61a2b3fcU, 0x2602c92cU, 0x1b62e09cU,
+		0xf9d2e0cfU, 0xc4b2c97fU, 0x8312b3afU, 0xbe729a1fU,
+		0x0c52460fU, 0x31326fbfU, 0x7692156fU, 0x4bf23cdfU,
+		0xc9a2ab0eU, 0xf4c282beU, 0xb362f86eU, 0x8e02d1deU,
+		0x3c220dceU, 0x0142247eU, 0x46e25eaeU, 0x7b82771eU,
+		0xb1e6b092U, 0x8c869922U, 0xcb26e3f2U, 0xf646ca42U,
+		0x44661652U, 0x79063fe2U, 0x3ea64532U, 0x03c66c82U,
+		0x8196fb53U, 0xbcf6d2e3U, 0xfb56a833U, 0xc6368183U,
+		0x74165d93U, 0x49767423U, 0x0ed60ef3U, 0x33b62743U,
+		0xd1062710U, 0xec660ea0U, 0xabc67470U, 0x96a65dc0U,
+		0x248681d0U, 0x19e6a860U, 0x5e46d2b0U, 0x6326fb00U,
+		0xe1766cd1U, 0xdc164561U, 0x9bb63fb1U, 0xa6d61601U,
+		0x14f6ca11U, 0x2996e3a1U, 0x6e369971U, 0x5356b0c1U,
+		0x70279f96U, 0x4d47b626U, 0x0ae7ccf6U, 0x3787e546U,
+		0x85a73956U, 0xb8c710e6U, 0xff676a36U, 0xc2074386U,
+		0x4057d457U, 0x7d37fde7U, 0x3a978737U, 0x07f7ae87U,
+		0xb5d77297U, 0x88b75b27U, 0xcf1721f7U, 0xf2770847U,
+		0x10c70814U, 0x2da721a4U, 0x6a075b74U, 0x576772c4U,
+		0xe547aed4U, 0xd8278764U, 0x9f87fdb4U, 0xa2e7d404U,
+		0x20b743d5U, 0x1dd76a65U, 0x5a7710b5U, 0x67173905U,
+		0xd537e515U, 0xe857cca5U, 0xaff7b675U, 0x92979fc5U,
+		0xe915e8dbU, 0xd475c16bU, 0x93d5bbbbU, 0xaeb5920bU,
+		0x1c954e1bU, 0x21f567abU, 0x66551d7bU, 0x5b3534cbU,
+		0xd965a31aU, 0xe4058aaaU, 0xa3a5f07aU, 0x9ec5d9caU,
+		0x2ce505daU, 0x11852c6aU, 0x562556baU, 0x6b457f0aU,
+		0x89f57f59U, 0xb49556e9U, 0xf3352c39U, 0xce550589U,
+		0x7c75d999U, 0x4115f029U, 0x06b58af9U, 0x3bd5a349U,
+		0xb9853498U, 0x84e51d28U, 0xc34567f8U, 0xfe254e48U,
+		0x4c059258U, 0x7165bbe8U, 0x36c5c138U, 0x0ba5e888U,
+		0x28d4c7dfU, 0x15b4ee6fU, 0x521494bfU, 0x6f74bd0fU,
+		0xdd54611fU, 0xe03448afU, 0xa794327fU, 0x9af41bcfU,
+		0x18a48c1eU, 0x25c4a5aeU, 0x6264df7eU, 0x5f04f6ceU,
+		0xed242adeU, 0xd044036eU, 0x97e479beU, 0xaa84500eU,
+		0x4834505dU, 0x755479edU, 0x32f4033dU, 0x0f942a8dU,
+		0xbdb4f69dU, 0x80d4df2dU, 0xc774a5fdU, 0xfa148c4dU,
+		0x78441b9cU, 0x4524322cU, 0x028448fcU, 0x3fe4614cU,
+		0x8dc4bd5cU, 0xb0a494ecU, 0xf704ee3cU, 0xca64c78cU,
+	},
+	{
+		0x00000000U, 0xcb5cd3a5U, 0x4dc8a10bU, 0x869472aeU,
+		0x9b914216U, 0x50cd91b3U, 0xd659e31dU, 0x1d0530b8U,
+		0xec53826dU, 0x270f51c8U, 0xa19b2366U, 0x6ac7f0c3U,
+		0x77c2c07bU, 0xbc9e13deU, 0x3a0a6170U, 0xf156b2d5U,
+		0x03d6029bU, 0xc88ad13eU, 0x4e1ea390U, 0x85427035U,
+		0x9847408dU, 0x531b9328U, 0xd58fe186U, 0x1ed33223U,
+		0xef8580f6U, 0x24d95353U, 0xa24d21fdU, 0x6911f258U,
+		0x7414c2e0U, 0xbf481145U, 0x39dc63ebU, 0xf280b04eU,
+		0x07ac0536U, 0xccf0d693U, 0x4a64a43dU, 0x81387798U,
+		0x9c3d4720U, 0x57619485U, 0xd1f5e62bU, 0x1aa9358eU,
+		0xebff875bU, 0x20a354feU, 0xa6372650U, 0x6d6bf5f5U,
+		0x706ec54dU, 0xbb3216e8U, 0x3da66446U, 0xf6fab7e3U,
+		0x047a07adU, 0xcf26d408U, 0x49b2a6a6U, 0x82ee7503U,
+		0x9feb45bbU, 0x54b7961eU, 0xd223e4b0U, 0x197f3715U,
+		0xe82985c0U, 0x23755665U, 0xa5e124cbU, 0x6ebdf76eU,
+		0x73b8c7d6U, 0xb8e41473U, 0x3e7066ddU, 0xf52cb578U,
+		0x0f580a6cU, 0xc404d9c9U, 0x4290ab67U, 0x89cc78c2U,
+		0x94c9487aU, 0x5f959bdfU, 0xd901e971U, 0x125d3ad4U,
+		0xe30b8801U, 0x28575ba4U, 0xaec3290aU, 0x659ffaafU,
+		0x789aca17U, 0xb3c619b2U, 0x35526b1cU, 0xfe0eb8b9U,
+		0x0c8e08f7U, 0xc7d2db52U, 0x4146a9fcU, 0x8a1a7a59U,
+		0x971f4ae1U, 0x5c439944U, 0xdad7ebeaU, 0x118b384fU,
+		0xe0dd8a9aU, 0x2b81593fU, 0xad152b91U, 0x6649f834U,
+		0x7b4cc88cU, 0xb0101b29U, 0x36846987U, 0xfdd8ba22U,
+		0x08f40f5aU, 0xc3a8dcffU, 0x453cae51U, 0x8e607df4U,
+		0x93654d4cU, 0x58399ee9U, 0xdeadec47U, 0x15f13fe2U,
+		0xe4a78d37U, 0x2ffb5e92U, 0xa96f2c3cU, 0x6233ff99U,
+		0x7f36cf21U, 0xb46a1c84U, 0x32fe6e2aU, 0xf9a2bd8fU,
+		0x0b220dc1U, 0xc07ede64U, 0x46eaaccaU, 0x8db67f6fU,
+		0x90b34fd7U, 0x5bef9c72U, 0xdd7beedcU, 0x16273d79U,
+		0xe7718facU, 0x2c2d5c09U, 0xaab92ea7U, 0x61e5fd02U,
+		0x7ce0cdbaU, 0xb7bc1e1fU, 0x31286cb1U, 0xfa74bf14U,
+		0x1eb014d8U, 0xd5ecc77dU, 0x5378b5d3U, 0x98246676U,
+		0x852156ceU, 0x4e7d856bU, 0xc8e9f7c5U, 0x03b52460U,
+		0xf2e396b5U, 0x39bf4510U, 0xbf2b37beU, 0x7477e41bU,
+		0x6972d4a3U, 0xa22e0706U, 0x24ba75a8U, 0xefe6a60dU,
+		0x1d661643U, 0xd63ac5e6U, 0x50aeb748U, 0x9bf264edU,
+		0x86f75455U, 0x4dab87f0U, 0xcb3ff55eU, 0x006326fbU,
+		0xf135942eU, 0x3a69478bU, 0xbcfd3525U, 0x77a1e680U,
+		0x6aa4d638U, 0xa1f8059dU, 0x276c7733U, 0xec30a496U,
+		0x191c11eeU, 0xd240c24bU, 0x54d4b0e5U, 0x9f886340U,
+		0x828d53f8U, 0x49d1805dU, 0xcf45f2f3U, 0x04192156U,
+		0xf54f9383U, 0x3e134026U, 0xb8873288U, 0x73dbe12dU,
+		0x6eded195U, 0xa5820230U, 0x2316709eU, 0xe84aa33bU,
+		0x1aca1375U, 0xd196c0d0U, 0x5702b27eU, 0x9c5e61dbU,
+		0x815b5163U, 0x4a0782c6U, 0xcc93f068U, 0x07cf23cdU,
+		0xf6999118U, 0x3dc542bdU, 0xbb513013U, 0x700de3b6U,
+		0x6d08d30eU, 0xa65400abU, 0x20c07205U, 0xeb9ca1a0U,
+		0x11e81eb4U, 0xdab4cd11U, 0x5c20bfbfU, 0x977c6c1aU,
+		0x8a795ca2U, 0x41258f07U, 0xc7b1fda9U, 0x0ced2e0cU,
+		0xfdbb9cd9U, 0x36e74f7cU, 0xb0733dd2U, 0x7b2fee77U,
+		0x662adecfU, 0xad760d6aU, 0x2be27fc4U, 0xe0beac61U,
+		0x123e1c2fU, 0xd962cf8aU, 0x5ff6bd24U, 0x94aa6e81U,
+		0x89af5e39U, 0x42f38d9cU, 0xc467ff32U, 0x0f3b2c97U,
+		0xfe6d9e42U, 0x35314de7U, 0xb3a53f49U, 0x78f9ececU,
+		0x65fcdc54U, 0xaea00ff1U, 0x28347d5fU, 0xe368aefaU,
+		0x16441b82U, 0xdd18c827U, 0x5b8cba89U, 0x90d0692cU,
+		0x8dd55994U, 0x46898a31U, 0xc01df89fU, 0x0b412b3aU,
+		0xfa1799efU, 0x314b4a4aU, 0xb7df38e4U, 0x7c83eb41U,
+		0x6186dbf9U, 0xaada085cU, 0x2c4e7af2U, 0xe712a957U,
+		0x15921919U, 0xdececabcU, 0x585ab812U, 0x93066bb7U,
+		0x8e035b0fU, 0x455f88aaU, 0xc3cbfa04U, 0x089729a1U,
+		0xf9c19b74U, 0x329d48d1U, 0xb4093a7fU, 0x7f55e9daU,
+		0x6250d962U, 0xa90c0ac7U, 0x2f987869U, 0xe4c4abccU,
+	},
+	{
+		0x00000000U, 0xa6770bb4U, 0x979f1129U, 0x31e81a9dU,
+		0xf44f2413U, 0x52382fa7U, 0x63d0353aU, 0xc5a73e8eU,
+		0x33ef4e67U, 0x959845d3U, 0xa4705f4eU, 0x020754faU,
+		0xc7a06a74U, 0x61d761c0U, 0x503f7b5dU, 0xf64870e9U,
+		0x67de9cceU, 0xc1a9977aU, 0xf0418de7U, 0x56368653U,
+		0x9391b8ddU, 0x35e6b369U, 0x040ea9f4U, 0xa279a240U,
+		0x5431d2a9U, 0xf246d91dU, 0xc3aec380U, 0x65d9c834U,
+		0xa07ef6baU, 0x0609fd0eU, 0x37e1e793U, 0x9196ec27U,
+		0xcfbd399cU, 0x69ca3228U, 0x582228b5U, 0xfe552301U,
+		0x3bf21d8fU, 0x9d85163bU, 0xac6d0ca6U, 0x0a1a0712U,
+		0xfc5277fbU, 0x5a257c4fU, 0x6bcd66d2U, 0xcdba6d66U,
+		0x081d53e8U, 0xae6a585cU, 0x9f8242c1U, 0x39f54975U,
+		0xa863a552U, 0x0e14aee6U, 0x3ffcb47bU, 0x998bbfcfU,
+		0x5c2c8141U, 0xfa5b8af5U, 0xcbb39068U, 0x6dc49bdcU,
+		0x9b8ceb35U, 0x3dfbe081U, 0x0c13fa1cU, 0xaa64f1a8U,
+		0x6fc3cf26U, 0xc9b4c492U, 0xf85cde0fU, 0x5e2bd5bbU,
+		0x440b7579U, 0xe27c7ecdU, 0xd3946450U, 0x75e36fe4U,
+		0xb044516aU, 0x16335adeU, 0x27db4043U, 0x81ac4bf7U,
+		0x77e43b1eU, 0xd19330aaU, 0xe07b2a37U, 0x460c2183U,
+		0x83ab1f0dU, 0x25dc14b9U, 0x14340e24U, 0xb2430590U,
+		0x23d5e9b7U, 0x85a2e203U, 0xb44af89eU, 0x123df32aU,
+		0xd79acda4U, 0x71edc610U, 0x4005dc8dU, 0xe672d739U,
+		0x103aa7d0U, 0xb64dac64U, 0x87a5b6f9U, 0x21d2bd4dU,
+		0xe47583c3U, 0x42028877U, 0x73ea92eaU, 0xd59d995eU,
+		0x8bb64ce5U, 0x2dc14751U, 0x1c295dccU, 0xba5e5678U,
+		0x7ff968f6U, 0xd98e6342U, 0xe86679dfU, 0x4e11726bU,
+		0xb8590282U, 0x1e2e0936U, 0x2fc613abU, 0x89b1181fU,
+		0x4c162691U, 0xea612d25U, 0xdb8937b8U, 0x7dfe3c0cU,
+		0xec68d02bU, 0x4a1fdb9fU, 0x7bf7c102U, 0xdd80cab6U,
+		0x1827f438U, 0xbe50ff8cU, 0x8fb8e511U, 0x29cfeea5U,
+		0xdf879e4cU, 0x79f095f8U, 0x48188f65U, 0xee6f84d1U,
+		0x2bc8ba5fU, 0x8dbfb1ebU, 0xbc57ab76U, 0x1a20a0c2U,
+		0x8816eaf2U, 0x2e61e146U, 0x1f89fbdbU, 0xb9fef06fU,
+		0x7c59cee1U, 0xda2ec555U, 0xebc6dfc8U, 0x4db1d47cU,
+		0xbbf9a495U, 0x1d8eaf21U, 0x2c66b5bcU, 0x8a11be08U,
+		0x4fb68086U, 0xe9c18b32U, 0xd82991afU, 0x7e5e9a1bU,
+		0xefc8763cU, 0x49bf7d88U, 0x78576715U, 0xde206ca1U,
+		0x1b87522fU, 0xbdf0599bU, 0x8c184306U, 0x2a6f48b2U,
+		0xdc27385bU, 0x7a5033efU, 0x4bb82972U, 0xedcf22c6U,
+		0x28681c48U, 0x8e1f17fcU, 0xbff70d61U, 0x198006d5U,
+		0x47abd36eU, 0xe1dcd8daU, 0xd034c247U, 0x7643c9f3U,
+		0xb3e4f77dU, 0x1593fcc9U, 0x247be654U, 0x820cede0U,
+		0x74449d09U, 0xd23396bdU, 0xe3db8c20U, 0x45ac8794U,
+		0x800bb91aU, 0x267cb2aeU, 0x1794a833U, 0xb1e3a387U,
+		0x20754fa0U, 0x86024414U, 0xb7ea5e89U, 0x119d553dU,
+		0xd43a6bb3U, 0x724d6007U, 0x43a57a9aU, 0xe5d2712eU,
+		0x139a01c7U, 0xb5ed0a73U, 0x840510eeU, 0x22721b5aU,
+		0xe7d525d4U, 0x41a22e60U, 0x704a34fdU, 0xd63d3f49U,
+		0xcc1d9f8bU, 0x6a6a943fU, 0x5b828ea2U, 0xfdf58516U,
+		0x3852bb98U, 0x9e25b02cU, 0xafcdaab1U, 0x09baa105U,
+		0xfff2d1ecU, 0x5985da58U, 0x686dc0c5U, 0xce1acb71U,
+		0x0bbdf5ffU, 0xadcafe4bU, 0x9c22e4d6U, 0x3a55ef62U,
+		0xabc30345U, 0x0db408f1U, 0x3c5c126cU, 0x9a2b19d8U,
+		0x5f8c2756U, 0xf9fb2ce2U, 0xc813367fU, 0x6e643dcbU,
+		0x982c4d22U, 0x3e5b4696U, 0x0fb35c0bU, 0xa9c457bfU,
+		0x6c636931U, 0xca146285U, 0xfbfc7818U, 0x5d8b73acU,
+		0x03a0a617U, 0xa5d7ada3U, 0x943fb73eU, 0x3248bc8aU,
+		0xf7ef8204U, 0x519889b0U, 0x6070932dU, 0xc6079899U,
+		0x304fe870U, 0x9638e3c4U, 0xa7d0f959U, 0x01a7f2edU,
+		0xc400cc63U, 0x6277c7d7U, 0x539fdd4aU, 0xf5e8d6feU,
+		0x647e3ad9U, 0xc209316dU, 0xf3e12bf0U, 0x55962044U,
+		0x90311ecaU, 0x3646157eU, 0x07ae0fe3U, 0xa1d90457U,
+		0x579174beU, 0xf1e67f0aU, 0xc00e6597U, 0x66796e23U,
+		0xa3de50adU, 0x05a95b19U, 0x34414184U, 0x92364a30U,
+	},
+	{
+		0x00000000U, 0xccaa009eU, 0x4225077dU, 0x8e8f07e3U,
+		0x844a0efaU, 0x48e00e64U, 0xc66f0987U, 0x0ac50919U,
+		0xd3e51bb5U, 0x1f4f1b2bU, 0x91c01cc8U, 0x5d6a1c56U,
+		0x57af154fU, 0x9b0515d1U, 0x158a1232U, 0xd92012acU,
+		0x7cbb312bU, 0xb01131b5U, 0x3e9e3656U, 0xf23436c8U,
+		0xf8f13fd1U, 0x345b3f4fU, 0xbad438acU, 0x767e3832U,
+		0xaf5e2a9eU, 0x63f42a00U, 0xed7b2de3U, 0x21d12d7dU,
+		0x2b142464U, 0xe7be24faU, 0x69312319U, 0xa59b2387U,
+		0xf9766256U, 0x35dc62c8U, 0xbb53652bU, 0x77f965b5U,
+		0x7d3c6cacU, 0xb1966c32U, 0x3f196bd1U, 0xf3b36b4fU,
+		0x2a9379e3U, 0xe639797dU, 0x68b67e9eU, 0xa41c7e00U,
+		0xaed97719U, 0x62737787U, 0xecfc7064U, 0x205670faU,
+		0x85cd537dU, 0x496753e3U, 0xc7e85400U, 0x0b42549eU,
+		0x01875d87U, 0xcd2d5d19U, 0x43a25afaU, 0x8f085a64U,
+		0x562848c8U, 0x9a824856U, 0x140d4fb5U, 0xd8a74f2bU,
+		0xd2624632U, 0x1ec846acU, 0x9047414fU, 0x5ced41d1U,
+		0x299dc2edU, 0xe537c273U, 0x6bb8c590U, 0xa712c50eU,
+		0xadd7cc17U, 0x617dcc89U, 0xeff2cb6aU, 0x2358cbf4U,
+		0xfa78d958U, 0x36d2d9c6U, 0xb85dde25U, 0x74f7debbU,
+		0x7e32d7a2U, 0xb298d73cU, 0x3c17d0dfU, 0xf0bdd041U,
+		0x5526f3c6U, 0x998cf358U, 0x1703f4bbU, 0xdba9f425U,
+		0xd16cfd3cU, 0x1dc6fda2U, 0x9349fa41U, 0x5fe3fadfU,
+		0x86c3e873U, 0x4a69e8edU, 0xc4e6ef0eU, 0x084cef90U,
+		0x0289e689U, 0xce23e617U, 0x40ace1f4U, 0x8c06e16aU,
+		0xd0eba0bbU, 0x1c41a025U, 0x92cea7c6U, 0x5e64a758U,
+		0x54a1ae41U, 0x980baedfU, 0x1684a93cU, 0xda2ea9a2U,
+		0x030ebb0eU, 0xcfa4bb90U, 0x412bbc73U, 0x8d81bcedU,
+		0x8744b5f4U, 0x4beeb56aU, 0xc561b289U, 0x09cbb217U,
+		0xac509190U, 0x60fa910eU, 0xee7596edU, 0x22df9673U,
+		0x281a9f6aU, 0xe4b09ff4U, 0x6a3f9817U, 0xa6959889U,
+		0x7fb58a25U, 0xb31f8abbU, 0x3d908d58U, 0xf13a8dc6U,
+		0xfbff84dfU, 0x37558441U, 0xb9da83a2U, 0x7570833cU,
+		0x533b85daU, 0x9f918544U, 0x111e82a7U, 0xddb48239U,
+		0xd7718b20U, 0x1bdb8bbeU, 0x95548c5dU, 0x59fe8cc3U,
+		0x80de9e6fU, 0x4c749ef1U, 0xc2fb9912U, 0x0e51998cU,
+		0x04949095U, 0xc83e900bU, 0x46b197e8U, 0x8a1b9776U,
+		0x2f80b4f1U, 0xe32ab46fU, 0x6da5b38cU, 0xa10fb312U,
+		0xabcaba0bU, 0x6760ba95U, 0xe9efbd76U, 0x2545bde8U,
+		0xfc65af44U, 0x30cfafdaU, 0xbe40a839U, 0x72eaa8a7U,
+		0x782fa1beU, 0xb485a120U, 0x3a0aa6c3U, 0xf6a0a65dU,
+		0xaa4de78cU, 0x66e7e712U, 0xe868e0f1U, 0x24c2e06fU,
+		0x2e07e976U, 0xe2ade9e8U, 0x6c22ee0bU, 0xa088ee95U,
+		0x79a8fc39U, 0xb502fca7U, 0x3b8dfb44U, 0xf727fbdaU,
+		0xfde2f2c3U, 0x3148f25dU, 0xbfc7f5beU, 0x736df520U,
+		0xd6f6d6a7U, 0x1a5cd639U, 0x94d3d1daU, 0x5879d144U,
+		0x52bcd85dU, 0x9e16d8c3U, 0x1099df20U, 0xdc33dfbeU,
+		0x0513cd12U, 0xc9b9cd8cU, 0x4736ca6fU, 0x8b9ccaf1U,
+		0x8159c3e8U, 0x4df3c376U, 0xc37cc495U, 0x0fd6c40bU,
+		0x7aa64737U, 0xb60c47a9U, 0x3883404aU, 0xf42940d4U,
+		0xfeec49cdU, 0x32464953U, 0xbcc94eb0U, 0x70634e2eU,
+		0xa9435c82U, 0x65e95c1cU, 0xeb665bffU, 0x27cc5b61U,
+		0x2d095278U, 0xe1a352e6U, 0x6f2c5505U, 0xa386559bU,
+		0x061d761cU, 0xcab77682U, 0x44387161U, 0x889271ffU,
+		0x825778e6U, 0x4efd7878U, 0xc0727f9bU, 0x0cd87f05U,
+		0xd5f86da9U, 0x19526d37U, 0x97dd6ad4U, 0x5b776a4aU,
+		0x51b26353U, 0x9d1863cdU, 0x1397642eU, 0xdf3d64b0U,
+		0x83d02561U, 0x4f7a25ffU, 0xc1f5221cU, 0x0d5f2282U,
+		0x079a2b9bU, 0xcb302b05U, 0x45bf2ce6U, 0x89152c78U,
+		0x50353ed4U, 0x9c9f3e4aU, 0x121039a9U, 0xdeba3937U,
+		0xd47f302eU, 0x18d530b0U, 0x965a3753U, 0x5af037cdU,
+		0xff6b144aU, 0x33c114d4U, 0xbd4e1337U, 0x71e413a9U,
+		0x7b211ab0U, 0xb78b1a2eU, 0x39041dcdU, 0xf5ae1d53U,
+		0x2c8e0fffU, 0xe0240f61U, 0x6eab0882U, 0xa201081cU,
+		0xa8c40105U, 0x646e019bU, 0xeae10678U, 0x264b06e6U,
+	},
+};
+
+/* Polynomial 0x1EDC6F41 (Castagnoli), reflected (0x82F63B78) */
+const uint32_t crc32c_slice_table[CRC_TABLE_SLICES][256] = {
+	{
+		0x00000000U, 0xf26b8303U, 0xe13b70f7U, 0x1350f3f4U,
+		0xc79a971fU, 0x35f1141cU, 0x26a1e7e8U, 0xd4ca64ebU,
+		0x8ad958cfU, 0x78b2dbccU, 0x6be22838U, 0x9989ab3bU,
+		0x4d43cfd0U, 0xbf284cd3U, 0xac78bf27U, 0x5e133c24U,
+		0x105ec76fU, 0xe235446cU, 0xf165b798U, 0x030e349bU,
+		0xd7c45070U, 0x25afd373U, 0x36ff2087U, 0xc494a384U,
+		0x9a879fa0U, 0x68ec1ca3U, 0x7bbcef57U, 0x89d76c54U,
+		0x5d1d08bfU, 0xaf768bbcU, 0xbc267848U, 0x4e4dfb4bU,
+		0x20bd8edeU, 0xd2d60dddU, 0xc186fe29U, 0x33ed7d2aU,
+		0xe72719c1U, 0x154c9ac2U, 0x061c6936U, 0xf477ea35U,
+		0xaa64d611U, 0x580f5512U, 0x4b5fa6e6U, 0xb93425e5U,
+		0x6dfe410eU, 0x9f95c20dU, 0x8cc531f9U, 0x7eaeb2faU,
+		0x30e349b1U, 0xc288cab2U, 0xd1d83946U, 0x23b3ba45U,
+		0xf779deaeU, 0x05125dadU, 0x1642ae59U, 0xe4292d5aU,
+		0xba3a117eU, 0x4851927dU, 0x5b016189U, 0xa96ae28aU,
+		0x7da08661U, 0x8fcb0562U, 0x9c9bf696U, 0x6ef07595U,
+		0x417b1dbcU, 0xb3109ebfU, 0xa0406d4bU, 0x522bee48U,
+		0x86e18aa3U, 0x748a09a0U, 0x67dafa54U, 0x95b17957U,
+		0xcba24573U, 0x39c9c670U, 0x2a993584U, 0xd8f2b687U,
+		0x0c38d26cU, 0xfe53516fU, 0xed03a29bU, 0x1f682198U,
+		0x5125dad3U, 0xa34e59d0U, 0xb01eaa24U, 0x42752927U,
+		0x96bf4dccU, 0x64d4cecfU, 0x77843d3bU, 0x85efbe38U,
+		0xdbfc821cU, 0x2997011fU, 0x3ac7f2ebU, 0xc8ac71e8U,
+		0x1c661503U, 0xee0d9600U, 0xfd5d65f4U, 0x0f36e6f7U,
+		0x61c69362U, 0x93ad1061U, 0x80fde395U, 0x72966096U,
+		0xa65c047dU, 0x5437877eU, 0x4767748aU, 0xb50cf789U,
+		0xeb1fcbadU, 0x197448aeU, 0x0a24bb5aU, 0xf84f3859U,
+		0x2c855cb2U, 0xdeeedfb1U, 0xcdbe2c45U, 0x3fd5af46U,
+		0x7198540dU, 0x83f3d70eU, 0x90a324faU, 0x62c8a7f9U,
+		0xb602c312U, 0x44694011U, 0x5739b3e5U, 0xa55230e6U,
+		0xfb410cc2U, 0x092a8fc1U, 0x1a7a7c35U, 0xe811ff36U,
+		0x3cdb9bddU, 0xceb018deU, 0xdde0eb2aU, 0x2f8b6829U,
+		0x82f63b78U, 0x709db87bU, 0x63cd4b8fU, 0x91a6c88cU,
+		0x456cac67U, 0xb7072f64U, 0xa457dc90U, 0x563c5f93U,
+		0x082f63b7U, 0xfa44e0b4U, 0xe9141340U, 0x1b7f9043U,
+		0xcfb5f4a8U, 0x3dde77abU, 0x2e8e845fU, 0xdce5075cU,
+		0x92a8fc17U, 0x60c37f14U, 0x73938ce0U, 0x81f80fe3U,
+		0x55326b08U, 0xa759e80bU, 0xb4091bffU, 0x466298fcU,
+		0x1871a4d8U, 0xea1a27dbU, 0xf94ad42fU, 0x0b21572cU,
+		0xdfeb33c7U, 0x2d80b0c4U, 0x3ed04330U, 0xccbbc033U,
+		0xa24bb5a6U, 0x502036a5U, 0x4370c551U, 0xb11b4652U,
+		0x65d122b9U, 0x97baa1baU, 0x84ea524eU, 0x7681d14dU,
+		0x2892ed69U, 0xdaf96e6aU, 0xc9a99d9eU, 0x3bc21e9dU,
+		0xef087a76U, 0x1d63f975U, 0x0e330a81U, 0xfc588982U,
+		0xb21572c9U, 0x407ef1caU, 0x532e023eU, 0xa145813dU,
+		0x758fe5d6U, 0x87e466d5U, 0x94b49521U, 0x66df1622U,
+		0x38cc2a06U, 0xcaa7a905U, 0xd9f75af1U, 0x2b9cd9f2U,
+		0xff56bd19U, 0x0d3d3e1aU, 0x1e6dcdeeU, 0xec064eedU,
+		0xc38d26c4U, 0x31e6a5c7U, 0x22b65633U, 0xd0ddd530U,
+		0x0417b1dbU, 0xf67c32d8U, 0xe52cc12cU, 0x1747422fU,
+		0x49547e0bU, 0xbb3ffd08U, 0xa86f0efcU, 0x5a048dffU,
+		0x8ecee914U, 0x7ca56a17U, 0x6ff599e3U, 0x9d9e1ae0U,
+		0xd3d3e1abU, 0x21b862a8U, 0x32e8915cU, 0xc083125fU,
+		0x144976b4U, 0xe622f5b7U, 0xf5720643U, 0x07198540U,
+		0x590ab964U, 0xab613a67U, 0xb831c993U, 0x4a5a4a90U,
+		0x9e902e7bU, 0x6cfbad78U, 0x7fab5e8cU, 0x8dc0dd8fU,
+		0xe330a81aU, 0x115b2b19U, 0x020bd8edU, 0xf0605beeU,
+		0x24aa3f05U, 0xd6c1bc06U, 0xc5914ff2U, 0x37faccf1U,
+		0x69e9f0d5U, 0x9b8273d6U, 0x88d28022U, 0x7ab90321U,
+		0xae7367caU, 0x5c18e4c9U, 0x4f48173dU, 0xbd23943eU,
+		0xf36e6f75U, 0x0105ec76U, 0x12551f82U, 0xe03e9c81U,
+		0x34f4f86aU, 0xc69f7b69U, 0xd5cf889dU, 0x27a40b9eU,
+		0x79b737baU, 0x8bdcb4b9U, 0x988c474dU, 0x6ae7c44eU,
+		0xbe2da0a5U, 0x4c4623a6U, 0x5f16d052U, 0xad7d5351U,
+	},
+	{
+		0x00000000U, 0x13a29877U, 0x274530eeU, 0x34e7a899U,
+		0x4e8a61dcU, 0x5d28f9abU, 0x69cf5132U, 0x7a6dc945U,
+		0x9d14c3b8U, 0x8eb65bcfU, 0xba51f356U, 0xa9f36b21U,
+		0xd39ea264U, 0xc03c3a13U, 0xf4db928aU, 0xe7790afdU,
+		0x3fc5f181U, 0x2c6769f6U, 0x1880c16fU, 0x0b225918U,
+		0x714f905dU, 0x62ed082aU, 0x560aa0b3U, 0x45a838c4U,
+		0xa2d13239U, 0xb173aa4eU, 0x859402d7U, 0x96369aa0U,
+		0xec5b53e5U, 0xfff9cb92U, 0xcb1e630bU, 0xd8bcfb7cU,
+		0x7f8be302U, 0x6c297b75U, 0x58ced3ecU, 0x4b6c4b9bU,
+		0x310182deU, 0x22a31aa9U, 0x1644b230U, 0x05e62a47U,
+		0xe29f20baU, 0xf13db8cdU, 0xc5da1054U, 0xd6788823U,
+		0xac154166U, 0xbfb7d911U, 0x8b507188U, 0x98f2e9ffU,
+		0x404e1283U, 0x53ec8af4U, 0x670b226dU, 0x74a9ba1aU,
+		0x0ec4735fU, 0x1d66eb28U, 0x298143b1U, 0x3a23dbc6U,
+		0xdd5ad13bU, 0xcef8494cU, 0xfa1fe1d5U, 0xe9bd79a2U,
+		0x93d0b0e7U, 0x80722890U, 0xb4958009U, 0xa737187eU,
+		0xff17c604U, 0xecb55e73U, 0xd852f6eaU, 0xcbf06e9dU,
+		0xb19da7d8U, 0xa23f3fafU, 0x96d89736U, 0x857a0f41U,
+		0x620305bcU, 0x71a19dcbU, 0x45463552U, 0x56e4ad25U,
+		0x2c896460U, 0x3f2bfc17U, 0x0bcc548eU, 0x186eccf9U,
+		0xc0d23785U, 0xd370aff2U, 0xe797076bU, 0xf4359f1cU,
+		0x8e585659U, 0x9dface2eU, 0xa91d66b7U, 0xbabffec0U,
+		0x5dc6f43dU, 0x4e646c4aU, 0x7a83c4d3U, 0x69215ca4U,
+		0x134c95e1U, 0x00ee0d96U, 0x3409a50fU, 0x27ab3d78U,
+		0x809c2506U, 0x933ebd71U, 0xa7d915e8U, 0xb47b8d9fU,
+		0xce1644daU, 0xddb4dcadU, 0xe9537434U, 0xfaf1ec43U,
+		0x1d88e6beU, 0x0e2a7ec9U, 0x3acdd650U, 0x296f4e27U,
+		0x53028762U, 0x40a01f15U, 0x7447b78cU, 0x67e52ffbU,
+		0xbf59d487U, 0xacfb4cf0U, 0x981ce469U, 0x8bbe7c1eU,
+		0xf1d3b55bU, 0xe2712d2cU, 0xd69685b5U, 0xc5341dc2U,
+		0x224d173fU, 0x31ef8f48U, 0x050827d1U, 0x16aabfa6U,
+		0x6cc776e3U, 0x7f65ee94U, 0x4b82460dU, 0x5820de7aU,
+		0xfbc3faf9U, 0xe861628eU, 0xdc86ca17U, 0xcf245260U,
+		0xb5499b25U, 0xa6eb0352U, 0x920cabcbU, 0x81ae33bcU,
+		0x66d73941U, 0x7575a136U, 0x419209afU, 0x523091d8U,
+		0x285d589dU, 0x3bffc0eaU, 0x0f186873U, 0x1cbaf004U,
+		0xc4060b78U, 0xd7a4930fU, 0xe3433b96U, 0xf0e1a3e1U,
+		0x8a8c6aa4U, 0x992ef2d3U, 0xadc95a4aU, 0xbe6bc23dU,
+		0x5912c8c0U, 0x4ab050b7U, 0x7e57f82eU, 0x6df56059U,
+		0x1798a91cU, 0x043a316bU, 0x30dd99f2U, 0x237f0185U,
+		0x844819fbU, 0x97ea818cU, 0xa30d2915U, 0xb0afb162U,
+		0xcac27827U, 0xd960e050U, 0xed8748c9U, 0xfe25d0beU,
+		0x195cda43U, 0x0afe4234U, 0x3e19eaadU, 0x2dbb72daU,
+		0x57d6bb9fU, 0x447423e8U, 0x70938b71U, 0x63311306U,
+		0xbb8de87aU, 0xa82f700dU, 0x9cc8d894U, 0x8f6a40e3U,
+		0xf50789a6U, 0xe6a511d1U, 0xd242b948U, 0xc1e0213fU,
+		0x26992bc2U, 0x353bb3b5U, 0x01dc1b2cU, 0x127e835bU,
+		0x68134a1eU, 0x7bb1d269U, 0x4f567af0U, 0x5cf4e287U,
+		0x04d43cfdU, 0x1776a48aU, 0x23910c13U, 0x30339464U,
+		0x4a5e5d21U, 0x59fcc556U, 0x6d1b6dcfU, 0x7eb9f5b8U,
+		0x99c0ff45U, 0x8a626732U, 0xbe85cfabU, 0xad2757dcU,
+		0xd74a9e99U, 0xc4e806eeU, 0xf00fae77U, 0xe3ad3600U,
+		0x3b11cd7cU, 0x28b3550bU, 0x1c54fd92U, 0x0ff665e5U,
+		0x759baca0U, 0x663934d7U, 0x52de9c4eU, 0x417c0439U,
+		0xa6050ec4U, 0xb5a796b3U, 0x81403e2aU, 0x92e2a65dU,
+		0xe88f6f18U, 0xfb2df76fU, 0xcfca5ff6U, 0xdc68c781U,
+		0x7b5fdfffU, 0x68fd4788U, 0x5c1aef11U, 0x4fb87766U,
+		0x35d5be23U, 0x26772654U, 0x12908ecdU, 0x013216baU,
+		0xe64b1c47U, 0xf5e98430U, 0xc10e2ca9U, 0xd2acb4deU,
+		0xa8c17d9bU, 0xbb63e5ecU, 0x8f844d75U, 0x9c26d502U,
+		0x449a2e7eU, 0x5738b609U, 0x63df1e90U, 0x707d86e7U,
+		0x0a104fa2U, 0x19b2d7d5U, 0x2d557f4cU, 0x3ef7e73bU,
+		0xd98eedc6U, 0xca2c75b1U, 0xfecbdd28U, 0xed69455fU,
+		0x97048c1aU, 0x84a6146dU, 0xb041bcf4U, 0xa3e32483U,
+	},
+	{
+		0x00000000U, 0xa541927eU, 0x4f6f520dU, 0xea2ec073U,
+		0x9edea41aU, 0x3b9f3664U, 0xd1b1f617U, 0x74f06469U,
+		0x38513ec5U, 0x9d10acbbU, 0x773e6cc8U, 0xd27ffeb6U,
+		0xa68f9adfU, 0x03ce08a1U, 0xe9e0c8d2U, 0x4ca15aacU,
+		0x70a27d8aU, 0xd5e3eff4U, 0x3fcd2f87U, 0x9a8cbdf9U,
+		0xee7cd990U, 0x4b3d4beeU, 0xa1138b9dU, 0x045219e3U,
+		0x48f3434fU, 0xedb2d131U, 0x079c1142U, 0xa2dd833cU,
+		0xd62de755U, 0x736c752bU, 0x9942b558U, 0x3c032726U,
+		0xe144fb14U, 0x4405696aU, 0xae2ba919U, 0x0b6a3b67U,
+		0x7f9a5f0eU, 0xdadbcd70U, 0x30f50d03U, 0x95b49f7dU,
+		0xd915c5d1U, 0x7c5457afU, 0x967a97dcU, 0x333b05a2U,
+		0x47cb61cbU, 0xe28af3b5U, 0x08a433c6U, 0xade5a1b8U,
+		0x91e6869eU, 0x34a714e0U, 0xde89d493U, 0x7bc846edU,
+		0x0f382284U, 0xaa79b0faU, 0x40577089U, 0xe516e2f7U,
+		0xa9b7b85bU, 0x0cf62a25U, 0xe6d8ea56U, 0x43997828U,
+		0x37691c41U, 0x92288e3fU, 0x78064e4cU, 0xdd47dc32U,
+		0xc76580d9U, 0x622412a7U, 0x880ad2d4U, 0x2d4b40aaU,
+		0x59bb24c3U, 0xfcfab6bdU, 0x16d476ceU, 0xb395e4b0U,
+		0xff34be1cU, 0x5a752c62U, 0xb05bec11U, 0x151a7e6fU,
+		0x61ea1a06U, 0xc4ab8878U, 0x2e85480bU, 0x8bc4da75U,
+		0xb7c7fd53U, 0x12866f2dU, 0xf8a8af5eU, 0x5de93d20U,
+		0x29195949U, 0x8c58cb37U, 0x66760b44U, 0xc337993aU,
+		0x8f96c396U, 0x2ad751e8U, 0xc0f9919bU, 0x65b803e5U,
+		0x1148678cU, 0xb409f5f2U, 0x5e273581U, 0xfb66a7ffU,
+		0x26217bcdU, 0x8360e9b3U, 0x694e29c0U, 0xcc0fbbbeU,
+		0xb8ffdfd7U, 0x1dbe4da9U, 0xf7908ddaU, 0x52d11fa4U,
+		0x1e704508U, 0xbb31d776U, 0x511f1705U, 0xf45e857bU,
+		0x80aee112U, 0x25ef736cU, 0xcfc1b31fU, 0x6a802161U,
+		0x56830647U, 0xf3c29439U, 0x19ec544aU, 0xbcadc634U,
+		0xc85da25dU, 0x6d1c3023U, 0x8732f050U, 0x2273622eU,
+		0x6ed23882U, 0xcb93aafcU, 0x21bd6a8fU, 0x84fcf8f1U,
+		0xf00c9c98U, 0x554d0ee6U, 0xbf63ce95U, 0x1a225cebU,
+		0x8b277743U, 0x2e66e53dU, 0xc448254eU, 0x6109b730U,
+		0x15f9d359U, 0xb0b84127U, 0x5a968154U, 0xffd7132aU,
+		0xb3764986U, 0x1637dbf8U, 0xfc191b8bU, 0x595889f5U,
+		0x2da8ed9cU, 0x88e97fe2U, 0x62c7bf91U, 0xc7862defU,
+		0xfb850ac9U, 0x5ec498b7U, 0xb4ea58c4U, 0x11abcabaU,
+		0x655baed3U, 0xc01a3cadU, 0x2a34fcdeU, 0x8f756ea0U,
+		0xc3d4340cU, 0x6695a672U, 0x8cbb6601U, 0x29faf47fU,
+		0x5d0a9016U, 0xf84b0268U, 0x1265c21bU, 0xb7245065U,
+		0x6a638c57U, 0xcf221e29U, 0x250cde5aU, 0x804d4c24U,
+		0xf4bd284dU, 0x51fcba33U, 0xbbd27a40U, 0x1e93e83eU,
+		0x5232b292U, 0xf77320ecU, 0x1d5de09fU, 0xb81c72e1U,
+		0xccec1688U, 0x69ad84f6U, 0x83834485U, 0x26c2d6fbU,
+		0x1ac1f1ddU, 0xbf8063a3U, 0x55aea3d0U, 0xf0ef31aeU,
+		0x841f55c7U, 0x215ec7b9U, 0xcb7007caU, 0x6e3195b4U,
+		0x2290cf18U, 0x87d15d66U, 0x6dff9d15U, 0xc8be0f6bU,
+		0xbc4e6b02U, 0x190ff97cU, 0xf321390fU, 0x5660ab71U,
+		0x4c42f79aU, 0xe90365e4U, 0x032da597U, 0xa66c37e9U,
+		0xd29c5380U, 0x77ddc1feU, 0x9df3018dU, 0x38b293f3U,
+		0x7413c95fU, 0xd1525b21U, 0x3b7c9b52U, 0x9e3d092cU,
+		0xeacd6d45U, 0x4f8cff3bU, 0xa5a23f48U, 0x00e3ad36U,
+		0x3ce08a10U, 0x99a1186eU, 0x738fd81dU, 0xd6ce4a63U,
+		0xa23e2e0aU, 0x077fbc74U, 0xed517c07U, 0x4810ee79U,
+		0x04b1b4d5U, 0xa1f026abU, 0x4bdee6d8U, 0xee9f74a6U,
+		0x9a6f10cfU, 0x3f2e82b1U, 0xd50042c2U, 0x7041d0bcU,
+		0xad060c8eU, 0x08479ef0U, 0xe2695e83U, 0x4728ccfdU,
+		0x33d8a894U, 0x96993aeaU, 0x7cb7fa99U, 0xd9f668e7U,
+		0x9557324bU, 0x3016a035U, 0xda386046U, 0x7f79f238U,
+		0x0b899651U, 0xaec8042fU, 0x44e6c45cU, 0xe1a75622U,
+		0xdda47104U, 0x78e5e37aU, 0x92cb2309U, 0x378ab177U,
+		0x437ad51eU, 0xe63b4760U, 0x0c158713U, 0xa954156dU,
+		0xe5f54fc1U, 0x40b4ddbfU, 0xaa9a1dccU, 0x0fdb8fb2U,
+		0x7b2bebdbU, 0xde6a79a5U, 0x3444b9d6U, 0x91052ba8U,
+	},
+	{
+		0x00000000U, 0xdd45aab8U, 0xbf672381U, 0x62228939U,
+		0x7b2231f3U, 0xa6679b4bU, 0xc4451272U, 0x1900b8caU,
+		0xf64463e6U, 0x2b01c95eU, 0x49234067U, 0x9466eadfU,
+		0x8d665215U, 0x5023f8adU, 0x32017194U, 0xef44db2cU,
+		0xe964b13dU, 0x34211b85U, 0x560392bcU, 0x8b463804U,
+		0x924680ceU, 0x4f032a76U, 0x2d21a34fU, 0xf06409f7U,
+		0x1f20d2dbU, 0xc2657863U, 0xa047f15aU, 0x7d025be2U,
+		0x6402e328U, 0xb9474990U, 0xdb65c0a9U, 0x06206a11U,
+		0xd725148bU, 0x0a60be33U, 0x6842370aU, 0xb5079db2U,
+		0xac072578U, 0x71428fc0U, 0x136006f9U, 0xce25ac41U,
+		0x2161776dU, 0xfc24ddd5U, 0x9e0654ecU, 0x4343fe54U,
+		0x5a43469eU, 0x8706ec26U, 0xe524651fU, 0x3861cfa7U,
+		0x3e41a5b6U, 0xe3040f0eU, 0x81268637U, 0x5c632c8fU,
+		0x45639445U, 0x98263efdU, 0xfa04b7c4U, 0x27411d7cU,
+		0xc805c650U, 0x15406ce8U, 0x7762e5d1U, 0xaa274f69U,
+		0xb327f7a3U, 0x6e625d1bU, 0x0c40d422U, 0xd1057e9aU,
+		0xaba65fe7U, 0x76e3f55fU, 0x14c17c66U, 0xc984d6deU,
+		0xd0846e14U, 0x0dc1c4acU, 0x6fe34d95U, 0xb2a6e72dU,
+		0x5de23c01U, 0x80a796b9U, 0xe2851f80U, 0x3fc0b538U,
+		0x26c00df2U, 0xfb85a74aU, 0x99a72e73U, 0x44e284cbU,
+		0x42c2eedaU, 0x9f874462U, 0xfda5cd5bU, 0x20e067e3U,
+		0x39e0df29U, 0xe4a57591U, 0x8687fca8U, 0x5bc25610U,
+		0xb4868d3cU, 0x69c32784U, 0x0be1aebdU, 0xd6a40405U,
+		0xcfa4bccfU, 0x12e11677U, 0x70c39f4eU, 0xad8635f6U,
+		0x7c834b6cU, 0xa1c6e1d4U, 0xc3e468edU, 0x1ea1c255U,
+		0x07a17a9fU, 0xdae4d027U, 0xb8c6591eU, 0x6583f3a6U,
+		0x8ac7288aU, 0x57828232U, 0x35a00b0bU, 0xe8e5a1b3U,
+		0xf1e51979U, 0x2ca0b3c1U, 0x4e823af8U, 0x93c79040U,
+		0x95e7fa51U, 0x48a250e9U, 0x2a80d9d0U, 0xf7c57368U,
+		0xeec5cba2U, 0x3380611aU, 0x51a2e823U, 0x8ce7429bU,
+		0x63a399b7U, 0xbee6330fU, 0xdcc4ba36U, 0x0181108eU,
+		0x1881a844U, 0xc5c402fcU, 0xa7e68bc5U, 0x7aa3217dU,
+		0x52a0c93fU, 0x8fe56387U, 0xedc7eabeU, 0x30824006U,
+		0x2982f8ccU, 0xf4c75274U, 0x96e5db4dU, 0x4ba071f5U,
+		0xa4e4aad9U, 0x79a10061U, 0x1b838958U, 0xc6c623e0U,
+		0xdfc69b2aU, 0x02833192U, 0x60a1b8abU, 0xbde41213U,
+		0xbbc47802U, 0x6681d2baU, 0x04a35b83U, 0xd9e6f13bU,
+		0xc0e649f1U, 0x1da3e349U, 0x7f816a70U, 0xa2c4c0c8U,
+		0x4d801be4U, 0x90c5b15cU, 0xf2e73865U, 0x2fa292ddU,
+		0x36a22a17U, 0xebe780afU, 0x89c50996U, 0x5480a32eU,
+		0x8585ddb4U, 0x58c0770cU, 0x3ae2fe35U, 0xe7a7548dU,
+		0xfea7ec47U, 0x23e246ffU, 0x41c0cfc6U, 0x9c85657eU,
+		0x73c1be52U, 0xae8414eaU, 0xcca69dd3U, 0x11e3376bU,
+		0x08e38fa1U, 0xd5a62519U, 0xb784ac20U, 0x6ac10698U,
+		0x6ce16c89U, 0xb1a4c631U, 0xd3864f08U, 0x0ec3e5b0U,
+		0x17c35d7aU, 0xca86f7c2U, 0xa8a47efbU, 0x75e1d443U,
+		0x9aa50f6fU, 0x47e0a5d7U, 0x25c22ceeU, 0xf8878656U,
+		0xe1873e9cU, 0x3cc29424U, 0x5ee01d1dU, 0x83a5b7a5U,
+		0xf90696d8U, 0x24433c60U, 0x4661b559U, 0x9b241fe1U,
+		0x8224a72bU, 0x5f610d93U, 0x3d4384aaU, 0xe0062e12U,
+		0x0f42f53eU, 0xd2075f86U, 0xb025d6bfU, 0x6d607c07U,
+		0x7460c4cdU, 0xa9256e75U, 0xcb07e74cU, 0x16424df4U,
+		0x106227e5U, 0xcd278d5dU, 0xaf050464U, 0x7240aedcU,
+		0x6b401616U, 0xb605bcaeU, 0xd4273597U, 0x09629f2fU,
+		0xe6264403U, 0x3b63eebbU, 0x59416782U, 0x8404cd3aU,
+		0x9d0475f0U, 0x4041df48U, 0x22635671U, 0xff26fcc9U,
+		0x2e238253U, 0xf36628ebU, 0x9144a1d2U, 0x4c010b6aU,
+		0x5501b3a0U, 0x88441918U, 0xea669021U, 0x37233a99U,
+		0xd867e1b5U, 0x05224b0dU, 0x6700c234U, 0xba45688cU,
+		0xa345d046U, 0x7e007afeU, 0x1c22f3c7U, 0xc167597fU,
+		0xc747336eU, 0x1a0299d6U, 0x782010efU, 0xa565ba57U,
+		0xbc65029dU, 0x6120a825U, 0x0302211cU, 0xde478ba4U,
+		0x31035088U, 0xec46fa30U, 0x8e647309U, 0x5321d9b1U,
+		0x4a21617bU, 0x9764cbc3U, 0xf54642faU, 0x2803e842U,
+	},
+	{
+		0x00000000U, 0x38116facU, 0x7022df58U, 0x4833b0f4U,
+		0xe045beb0U, 0xd854d11cU, 0x906761e8U, 0xa8760e44U,
+		0xc5670b91U, 0xfd76643dU, 0xb545d4c9U, 0x8d54bb65U,
+		0x2522b521U, 0x1d33da8dU, 0x55006a79U, 0x6d1105d5U,
+		0x8f2261d3U, 0xb7330e7fU, 0xff00be8bU, 0xc711d127U,
+		0x6f67df63U, 0x5776b0cfU, 0x1f45003bU, 0x27546f97U,
+		0x4a456a42U, 0x725405eeU, 0x3a67b51aU, 0x0276dab6U,
+		0xaa00d4f2U, 0x9211bb5eU, 0xda220baaU, 0xe2336406U,
+		0x1ba8b557U, 0x23b9dafbU, 0x6b8a6a0fU, 0x539b05a3U,
+		0xfbed0be7U, 0xc3fc644bU, 0x8bcfd4bfU, 0xb3debb13U,
+		0xdecfbec6U, 0xe6ded16aU, 0xaeed619eU, 0x96fc0e32U,
+		0x3e8a0076U, 0x069b6fdaU, 0x4ea8df2eU, 0x76b9b082U,
+		0x948ad484U, 0xac9bbb28U, 0xe4a80bdcU, 0xdcb96470U,
+		0x74cf6a34U, 0x4cde0598U, 0x04edb56cU, 0x3cfcdac0U,
+		0x51eddf15U, 0x69fcb0b9U, 0x21cf004dU, 0x19de6fe1U,
+		0xb1a861a5U, 0x89b90e09U, 0xc18abefdU, 0xf99bd151U,
+		0x37516aaeU, 0x0f400502U, 0x4773b5f6U, 0x7f62da5aU,
+		0xd714d41eU, 0xef05bbb2U, 0xa7360b46U, 0x9f2764eaU,
+		0xf236613fU, 0xca270e93U, 0x8214be67U, 0xba05d1cbU,
+		0x1273df8fU, 0x2a62b023U, 0x625100d7U, 0x5a406f7bU,
+		0xb8730b7dU, 0x806264d1U, 0xc851d425U, 0xf040bb89U,
+		0x5836b5cdU, 0x6027da61U, 0x28146a95U, 0x10050539U,
+		0x7d1400ecU, 0x45056f40U, 0x0d36dfb4U, 0x3527b018U,
+		0x9d51be5cU, 0xa540d1f0U, 0xed736104U, 0xd5620ea8U,
+		0x2cf9dff9U, 0x14e8b055U, 0x5cdb00a1U, 0x64ca6f0dU,
+		0xccbc6149U, 0xf4ad0ee5U, 0xbc9ebe11U, 0x848fd1bdU,
+		0xe99ed468U, 0xd18fbbc4U, 0x99bc0b30U, 0xa1ad649cU,
+		0x09db6ad8U, 0x31ca0574U, 0x79f9b580U, 0x41e8da2cU,
+		0xa3dbbe2aU, 0x9bcad186U, 0xd3f96172U, 0xebe80edeU,
+		0x439e009aU, 0x7b8f6f36U, 0x33bcdfc2U, 0x0badb06eU,
+		0x66bcb5bbU, 0x5eadda17U, 0x169e6ae3U, 0x2e8f054fU,
+		0x86f90b0bU, 0xbee864a7U, 0xf6dbd453U, 0xcecabbffU,
+		0x6ea2d55cU, 0x56b3baf0U, 0x1e800a04U, 0x269165a8U,
+		0x8ee76becU, 0xb6f60440U, 0xfec5b4b4U, 0xc6d4db18U,
+		0xabc5decdU, 0x93d4b161U, 0xdbe70195U, 0xe3f66e39U,
+		0x4b80607dU, 0x73910fd1U, 0x3ba2bf25U, 0x03b3d089U,
+		0xe180b48fU, 0xd991db23U, 0x91a26bd7U, 0xa9b3047bU,
+		0x01c50a3fU, 0x39d46593U, 0x71e7d567U, 0x49f6bacbU,
+		0x24e7bf1eU, 0x1cf6d0b2U, 0x54c56046U, 0x6cd40feaU,
+		0xc4a201aeU, 0xfcb36e02U, 0xb480def6U, 0x8c91b15aU,
+		0x750a600bU, 0x4d1b0fa7U, 0x0528bf53U, 0x3d39d0ffU,
+		0x954fdebbU, 0xad5eb117U, 0xe56d01e3U, 0xdd7c6e4fU,
+		0xb06d6b9aU, 0x887c0436U, 0xc04fb4c2U, 0xf85edb6eU,
+		0x5028d52aU, 0x6839ba86U, 0x200a0a72U, 0x181b65deU,
+		0xfa2801d8U, 0xc2396e74U, 0x8a0ade80U, 0xb21bb12cU,
+		0x1a6dbf68U, 0x227cd0c4U, 0x6a4f6030U, 0x525e0f9cU,
+		0x3f4f0a49U, 0x075e65e5U, 0x4f6dd511U, 0x777cbabdU,
+		0xdf0ab4f9U, 0xe71bdb55U, 0xaf286ba1U, 0x9739040dU,
+		0x59f3bff2U, 0x61e2d05eU, 0x29d160aaU, 0x11c00f06U,
+		0xb9b60142U, 0x81a76eeeU, 0xc994de1aU, 0xf185b1b6U,
+		0x9c94b463U, 0xa485dbcfU, 0xecb66b3bU, 0xd4a70497U,
+		0x7cd10ad3U, 0x44c0657fU, 0x0cf3d58bU, 0x34e2ba27U,
+		0xd6d1de21U, 0xeec0b18dU, 0xa6f30179U, 0x9ee26ed5U,
+		0x36946091U, 0x0e850f3dU, 0x46b6bfc9U, 0x7ea7d065U,
+		0x13b6d5b0U, 0x2ba7ba1cU, 0x63940ae8U, 0x5b856544U,
+		0xf3f36b00U, 0xcbe204acU, 0x83d1b458U, 0xbbc0dbf4U,
+		0x425b0aa5U, 0x7a4a6509U, 0x3279d5fdU, 0x0a68ba51U,
+		0xa21eb415U, 0x9a0fdbb9U, 0xd23c6b4dU, 0xea2d04e1U,
+		0x873c0134U, 0xbf2d6e98U, 0xf71ede6cU, 0xcf0fb1c0U,
+		0x6779bf84U, 0x5f68d028U, 0x175b60dcU, 0x2f4a0f70U,
+		0xcd796b76U, 0xf56804daU, 0xbd5bb42eU, 0x854adb82U,
+		0x2d3cd5c6U, 0x152dba6aU, 0x5d1e0a9eU, 0x650f6532U,
+		0x081e60e7U, 0x300f0f4bU, 0x783cbfbfU, 0x402dd013U,
+		0xe85bde57U, 0xd04ab1fbU, 0x9879010fU, 0xa0686ea3U,
+	},
+	{
+		0x00000000U, 0xef306b19U, 0xdb8ca0c3U, 0x34bccbdaU,
+		0xb2f53777U, 0x5dc55c6eU, 0x697997b4U, 0x8649fcadU,
+		0x6006181fU, 0x8f367306U, 0xbb8ab8dcU, 0x54bad3c5U,
+		0xd2f32f68U, 0x3dc34471U, 0x097f8fabU, 0xe64fe4b2U,
+		0xc00c303eU, 0x2f3c5b27U, 0x1b8090fdU, 0xf4b0fbe4U,
+		0x72f90749U, 0x9dc96c50U, 0xa975a78aU, 0x4645cc93U,
+		0xa00a2821U, 0x4f3a4338U, 0x7b8688e2U, 0x94b6e3fbU,
+		0x12ff1f56U, 0xfdcf744fU, 0xc973bf95U, 0x2643d48cU,
+		0x85f4168dU, 0x6ac47d94U, 0x5e78b64eU, 0xb148dd57U,
+		0x370121faU, 0xd8314ae3U, 0xec8d8139U, 0x03bdea20U,
+		0xe5f20e92U, 0x0ac2658bU, 0x3e7eae51U, 0xd14ec548U,
+		0x570739e5U, 0xb83752fcU, 0x8c8b9926U, 0x63bbf23fU,
+		0x45f826b3U, 0xaac84daaU, 0x9e748670U, 0x7144ed69U,
+		0xf70d11c4U, 0x183d7addU, 0x2c81b107U, 0xc3b1da1eU,
+		0x25fe3eacU, 0xcace55b5U, 0xfe729e6fU, 0x1142f576U,
+		0x970b09dbU, 0x783b62c2U, 0x4c87a918U, 0xa3b7c201U,
+		0x0e045bebU, 0xe13430f2U, 0xd588fb28U, 0x3ab89031U,
+		0xbcf16c9cU, 0x53c10785U, 0x677dcc5fU, 0x884da746U,
+		0x6e0243f4U, 0x813228edU, 0xb58ee337U, 0x5abe882eU,
+		0xdcf77483U, 0x33c71f9aU, 0x077bd440U, 0xe84bbf59U,
+		0xce086bd5U, 0x213800ccU, 0x1584cb16U, 0xfab4a00fU,
+		0x7cfd5ca2U, 0x93cd37bbU, 0xa771fc61U, 0x48419778U,
+		0xae0e73caU, 0x413e18d3U, 0x7582d309U, 0x9ab2b810U,
+		0x1cfb44bdU, 0xf3cb2fa4U, 0xc777e47eU, 0x28478f67U,
+		0x8bf04d66U, 0x64c0267fU, 0x507ceda5U, 0xbf4c86bcU,
+		0x39057a11U, 0xd6351108U, 0xe289dad2U, 0x0db9b1cbU,
+		0xebf65579U, 0x04c63e60U, 0x307af5baU, 0xdf4a9ea3U,
+		0x5903620eU, 0xb6330917U, 0x828fc2cdU, 0x6dbfa9d4U,
+		0x4bfc7d58U, 0xa4cc1641U, 0x9070dd9bU, 0x7f40b682U,
+		0xf9094a2fU, 0x16392136U, 0x2285eaecU, 0xcdb581f5U,
+		0x2bfa6547U, 0xc4ca0e5eU, 0xf076c584U, 0x1f46ae9dU,
+		0x990f5230U, 0x763f3929U, 0x4283f2f3U, 0xadb399eaU,
+		0x1c08b7d6U, 0xf338dccfU, 0xc7841715U, 0x28b47c0cU,
+		0xaefd80a1U, 0x41cdebb8U, 0x75712062U, 0x9a414b7bU,
+		0x7c0eafc9U, 0x933ec4d0U, 0xa7820f0aU, 0x48b26413U,
+		0xcefb98beU, 0x21cbf3a7U, 0x1577387dU, 0xfa475364U,
+		0xdc0487e8U, 0x3334ecf1U, 0x0788272bU, 0xe8b84c32U,
+		0x6ef1b09fU, 0x81c1db86U, 0xb57d105cU, 0x5a4d7b45U,
+		0xbc029ff7U, 0x5332f4eeU, 0x678e3f34U, 0x88be542dU,
+		0x0ef7a880U, 0xe1c7c399U, 0xd57b0843U, 0x3a4b635aU,
+		0x99fca15bU, 0x76ccca42U, 0x42700198U, 0xad406a81U,
+		0x2b09962cU, 0xc439fd35U, 0xf08536efU, 0x1fb55df6U,
+		0xf9fab944U, 0x16cad25dU, 0x22761987U, 0xcd46729eU,
+		0x4b0f8e33U, 0xa43fe52aU, 0x90832ef0U, 0x7fb345e9U,
+		0x59f09165U, 0xb6c0fa7cU, 0x827c31a6U, 0x6d4c5abfU,
+		0xeb05a612U, 0x0435cd0bU, 0x308906d1U, 0xdfb96dc8U,
+		0x39f6897aU, 0xd6c6e263U, 0xe27a29b9U, 0x0d4a42a0U,
+		0x8b03be0dU, 0x6433d514U, 0x508f1eceU, 0xbfbf75d7U,
+		0x120cec3dU, 0xfd3c8724U, 0xc9804cfeU, 0x26b027e7U,
+		0xa0f9db4aU, 0x4fc9b053U, 0x7b757b89U, 0x94451090U,
+		0x720af422U, 0x9d3a9f3bU, 0xa98654e1U, 0x46b63ff8U,
+		0xc0ffc355U, 0x2fcfa84cU, 0x1b736396U, 0xf443088fU,
+		0xd200dc03U, 0x3d30b71aU, 0x098c7cc0U, 0xe6bc17d9U,
+		0x60f5eb74U, 0x8fc5806dU, 0xbb794bb7U, 0x544920aeU,
+		0xb206c41cU, 0x5d36af05U, 0x698a64dfU, 0x86ba0fc6U,
+		0x00f3f36bU, 0xefc39872U, 0xdb7f53a8U, 0x344f38b1U,
+		0x97f8fab0U, 0x78c891a9U, 0x4c745a73U, 0xa344316aU,
+		0x250dcdc7U, 0xca3da6deU, 0xfe816d04U, 0x11b1061dU,
+		0xf7fee2afU, 0x18ce89b6U, 0x2c72426cU, 0xc3422975U,
+		0x450bd5d8U, 0xaa3bbec1U, 0x9e87751bU, 0x71b71e02U,
+		0x57f4ca8eU, 0xb8c4a197U, 0x8c786a4dU, 0x63480154U,
+		0xe501fdf9U, 0x0a3196e0U, 0x3e8d5d3aU, 0xd1bd3623U,
+		0x37f2d291U, 0xd8c2b988U, 0xec7e7252U, 0x034e194bU,
+		0x8507e5e6U, 0x6a378effU, 0x5e8b4525U, 0xb1bb2e3cU,
+	},
+	{
+		0x00000000U, 0x68032cc8U, 0xd0065990U, 0xb8057558U,
+		0xa5e0c5d1U, 0xcde3e919U, 0x75e69c41U, 0x1de5b089U,
+		0x4e2dfd53U, 0x262ed19bU, 0x9e2ba4c3U, 0xf628880bU,
+		0xebcd3882U, 0x83ce144aU, 0x3bcb6112U, 0x53c84ddaU,
+		0x9c5bfaa6U, 0xf458d66eU, 0x4c5da336U, 0x245e8ffeU,
+		0x39bb3f77U, 0x51b813bfU, 0xe9bd66e7U, 0x81be4a2fU,
+		0xd27607f5U, 0xba752b3dU, 0x02705e65U, 0x6a7372adU,
+		0x7796c224U, 0x1f95eeecU, 0xa7909bb4U, 0xcf93b77cU,
+		0x3d5b83bdU, 0x5558af75U, 0xed5dda2dU, 0x855ef6e5U,
+		0x98bb466cU, 0xf0b86aa4U, 0x48bd1ffcU, 0x20be3334U,
+		0x73767eeeU, 0x1b755226U, 0xa370277eU, 0xcb730bb6U,
+		0xd696bb3fU, 0xbe9597f7U, 0x0690e2afU, 0x6e93ce67U,
+		0xa100791bU, 0xc90355d3U, 0x7106208bU, 0x19050c43U,
+		0x04e0bccaU, 0x6ce39002U, 0xd4e6e55aU, 0xbce5c992U,
+		0xef2d8448U, 0x872ea880U, 0x3f2bddd8U, 0x5728f110U,
+		0x4acd4199U, 0x22ce6d51U, 0x9acb1809U, 0xf2c834c1U,
+		0x7ab7077aU, 0x12b42bb2U, 0xaab15eeaU, 0xc2b27222U,
+		0xdf57c2abU, 0xb754ee63U, 0x0f519b3bU, 0x6752b7f3U,
+		0x349afa29U, 0x5c99d6e1U, 0xe49ca3b9U, 0x8c9f8f71U,
+		0x917a3ff8U, 0xf9791330U, 0x417c6668U, 0x297f4aa0U,
+		0xe6ecfddcU, 0x8eefd114U, 0x36eaa44cU, 0x5ee98884U,
+		0x430c380dU, 0x2b0f14c5U, 0x930a619dU, 0xfb094d55U,
+		0xa8c1008fU, 0xc0c22c47U, 0x78c7591fU, 0x10c475d7U,
+		0x0d21c55eU, 0x6522e996U, 0xdd279cceU, 0xb524b006U,
+		0x47ec84c7U, 0x2fefa80fU, 0x97eadd57U, 0xffe9f19fU,
+		0xe20c4116U, 0x8a0f6ddeU, 0x320a1886U, 0x5a09344eU,
+		0x09c17994U, 0x61c2555cU, 0xd9c72004U, 0xb1c40cccU,
+		0xac21bc45U, 0xc422908dU, 0x7c27e5d5U, 0x1424c91dU,
+		0xdbb77e61U, 0xb3b452a9U, 0x0bb127f1U, 0x63b20b39U,
+		0x7e57bbb0U, 0x16549778U, 0xae51e220U, 0xc652cee8U,
+		0x959a8332U, 0xfd99affaU, 0x459cdaa2U, 0x2d9ff66aU,
+		0x307a46e3U, 0x58796a2bU, 0xe07c1f73U, 0x887f33bbU,
+		0xf56e0ef4U, 0x9d6d223cU, 0x25685764U, 0x4d6b7bacU,
+		0x508ecb25U, 0x388de7edU, 0x808892b5U, 0xe88bbe7dU,
+		0xbb43f3a7U, 0xd340df6fU, 0x6b45aa37U, 0x034686ffU,
+		0x1ea33676U, 0x76a01abeU, 0xcea56fe6U, 0xa6a6432eU,
+		0x6935f452U, 0x0136d89aU, 0xb933adc2U, 0xd130810aU,
+		0xccd53183U, 0xa4d61d4bU, 0x1cd36813U, 0x74d044dbU,
+		0x27180901U, 0x4f1b25c9U, 0xf71e5091U, 0x9f1d7c59U,
+		0x82f8ccd0U, 0xeafbe018U, 0x52fe9540U, 0x3afdb988U,
+		0xc8358d49U, 0xa036a181U, 0x1833d4d9U, 0x7030f811U,
+		0x6dd54898U, 0x05d66450U, 0xbdd31108U, 0xd5d03dc0U,
+		0x8618701aU, 0xee1b5cd2U, 0x561e298aU, 0x3e1d0542U,
+		0x23f8b5cbU, 0x4bfb9903U, 0xf3feec5bU, 0x9bfdc093U,
+		0x546e77efU, 0x3c6d5b27U, 0x84682e7fU, 0xec6b02b7U,
+		0xf18eb23eU, 0x998d9ef6U, 0x2188ebaeU, 0x498bc766U,
+		0x1a438abcU, 0x7240a674U, 0xca45d32cU, 0xa246ffe4U,
+		0xbfa34f6dU, 0xd7a063a5U, 0x6fa516fdU, 0x07a63a35U,
+		0x8fd9098eU, 0xe7da2546U, 0x5fdf501eU, 0x37dc7cd6U,
+		0x2a39cc5fU, 0x423ae097U, 0xfa3f95cfU, 0x923cb907U,
+		0xc1f4f4ddU, 0xa9f7d815U, 0x11f2ad4dU, 0x79f18185U,
+		0x6414310cU, 0x0c171dc4U, 0xb412689cU, 0xdc114454U,
+		0x1382f328U, 0x7b81dfe0U, 0xc384aab8U, 0xab878670U,
+		0xb66236f9U, 0xde611a31U, 0x66646f69U, 0x0e6743a1U,
+		0x5daf0e7bU, 0x35ac22b3U, 0x8da957ebU, 0xe5aa7b23U,
+		0xf84fcbaaU, 0x904ce762U, 0x2849923aU, 0x404abef2U,
+		0xb2828a33U, 0xda81a6fbU, 0x6284d3a3U, 0x0a87ff6bU,
+		0x17624fe2U, 0x7f61632aU, 0xc7641672U, 0xaf673abaU,
+		0xfcaf7760U, 0x94ac5ba8U, 0x2ca92ef0U, 0x44aa0238U,
+		0x594fb2b1U, 0x314c9e79U, 0x8949eb21U, 0xe14ac7e9U,
+		0x2ed97095U, 0x46da5c5dU, 0xfedf2905U, 0x96dc05cdU,
+		0x8b39b544U, 0xe33a998cU, 0x5b3fecd4U, 0x333cc01cU,
+		0x60f48dc6U, 0x08f7a10eU, 0xb0f2d456U, 0xd8f1f89eU,
+		0xc5144817U, 0xad1764dfU, 0x15121187U, 0x7d113d4fU,
+	},
+	{
+		0x00000000U, 0x493c7d27U, 0x9278fa4eU, 0xdb448769U,
+		0x211d826dU, 0x6821ff4aU, 0xb3657823U, 0xfa590504U,
+		0x423b04daU, 0x0b0779fdU, 0xd043fe94U, 0x997f83b3U,
+		0x632686b7U, 0x2a1afb90U, 0xf15e7cf9U, 0xb86201deU,
+		0x847609b4U, 0xcd4a7493U, 0x160ef3faU, 0x5f328eddU,
+		0xa56b8bd9U, 0xec57f6feU, 0x37137197U, 0x7e2f0cb0U,
+		0xc64d0d6eU, 0x8f717049U, 0x5435f720U, 0x1d098a07U,
+		0xe7508f03U, 0xae6cf224U, 0x7528754dU, 0x3c14086aU,
+		0x0d006599U, 0x443c18beU, 0x9f789fd7U, 0xd644e2f0U,
+		0x2c1de7f4U, 0x65219ad3U, 0xbe651dbaU, 0xf759609dU,
+		0x4f3b6143U, 0x06071c64U, 0xdd439b0dU, 0x947fe62aU,
+		0x6e26e32eU, 0x271a9e09U, 0xfc5e1960U, 0xb5626447U,
+		0x89766c2dU, 0xc04a110aU, 0x1b0e9663U, 0x5232eb44U,
+		0xa86bee40U, 0xe1579367U, 0x3a13140eU, 0x732f6929U,
+		0xcb4d68f7U, 0x827115d0U, 0x593592b9U, 0x1009ef9eU,
+		0xea50ea9aU, 0xa36c97bdU, 0x782810d4U, 0x31146df3U,
+		0x1a00cb32U, 0x533cb615U, 0x8878317cU, 0xc1444c5bU,
+		0x3b1d495fU, 0x72213478U, 0xa965b311U, 0xe059ce36U,
+		0x583bcfe8U, 0x1107b2cfU, 0xca4335a6U, 0x837f4881U,
+		0x79264d85U, 0x301a30a2U, 0xeb5eb7cbU, 0xa262caecU,
+		0x9e76c286U, 0xd74abfa1U, 0x0c0e38c8U, 0x453245efU,
+		0xbf6b40ebU, 0xf6573dccU, 0x2d13baa5U, 0x642fc782U,
+		0xdc4dc65cU, 0x9571bb7bU, 0x4e353c12U, 0x07094135U,
+		0xfd504431U, 0xb46c3916U, 0x6f28be7fU, 0x2614c358U,
+		0x1700aeabU, 0x5e3cd38cU, 0x857854e5U, 0xcc4429c2U,
+		0x361d2cc6U, 0x7f2151e1U, 0xa465d688U, 0xed59abafU,
+		0x553baa71U, 0x1c07d756U, 0xc743503fU, 0x8e7f2d18U,
+		0x7426281cU, 0x3d1a553bU, 0xe65ed252U, 0xaf62af75U,
+		0x9376a71fU, 0xda4ada38U, 0x010e5d51U, 0x48322076U,
+		0xb26b2572U, 0xfb575855U, 0x2013df3cU, 0x692fa21bU,
+		0xd14da3c5U, 0x9871dee2U, 0x4335598bU, 0x0a0924acU,
+		0xf05021a8U, 0xb96c5c8fU, 0x6228dbe6U, 0x2b14a6c1U,
+		0x34019664U, 0x7d3deb43U, 0xa6796c2aU, 0xef45110dU,
+		0x151c1409U, 0x5c20692eU, 0x8764ee47U, 0xce589360U,
+		0x763a92beU, 0x3f06ef99U, 0xe44268f0U, 0xad7e15d7U,
+		0x572710d3U, 0x1e1b6df4U, 0xc55fea9dU, 0x8c6397baU,
+		0xb0779fd0U, 0xf94be2f7U, 0x220f659eU, 0x6b3318b9U,
+		0x916a1dbdU, 0xd856609aU, 0x0312e7f3U, 0x4a2e9ad4U,
+		0xf24c9b0aU, 0xbb70e62dU, 0x60346144U, 0x29081c63U,
+		0xd3511967U, 0x9a6d6440U, 0x4129e329U, 0x08159e0eU,
+		0x3901f3fdU, 0x703d8edaU, 0xab7909b3U, 0xe2457494U,
+		0x181c7190U, 0x51200cb7U, 0x8a648bdeU, 0xc358f6f9U,
+		0x7b3af727U, 0x32068a00U, 0xe9420d69U, 0xa07e704eU,
+		0x5a27754aU, 0x131b086dU, 0xc85f8f04U, 0x8163f223U,
+		0xbd77fa49U, 0xf44b876eU, 0x2f0f0007U, 0x66337d20U,
+		0x9c6a7824U, 0xd5560503U, 0x0e12826aU, 0x472eff4dU,
+		0xff4cfe93U, 0xb67083b4U, 0x6d3404ddU, 0x240879faU,
+		0xde517cfeU, 0x976d01d9U, 0x4c2986b0U, 0x0515fb97U,
+		0x2e015d56U, 0x673d2071U, 0xbc79a718U, 0xf545da3fU,
+		0x0f1cdf3bU, 0x4620a21cU, 0x9d642575U, 0xd4585852U,
+		0x6c3a598cU, 0x250624abU, 0xfe42a3c2U, 0xb77edee5U,
+		0x4d27dbe1U, 0x041ba6c6U, 0xdf5f21afU, 0x96635c88U,
+		0xaa7754e2U, 0xe34b29c5U, 0x380faeacU, 0x7133d38bU,
+		0x8b6ad68fU, 0xc256aba8U, 0x19122cc1U, 0x502e51e6U,
+		0xe84c5038U, 0xa1702d1fU, 0x7a34aa76U, 0x3308d751U,
+		0xc951d255U, 0x806daf72U, 0x5b29281bU, 0x1215553cU,
+		0x230138cfU, 0x6a3d45e8U, 0xb179c281U, 0xf845bfa6U,
+		0x021cbaa2U, 0x4b20c785U, 0x906440ecU, 0xd9583dcbU,
+		0x613a3c15U, 0x28064132U, 0xf342c65bU, 0xba7ebb7cU,
+		0x4027be78U, 0x091bc35fU, 0xd25f4436U, 0x9b633911U,
+		0xa777317bU, 0xee4b4c5cU, 0x350fcb35U, 0x7c33b612U,
+		0x866ab316U, 0xcf56ce31U, 0x14124958U, 0x5d2e347fU,
+		0xe54c35a1U, 0xac704886U, 0x7734cfefU, 0x3e08b2c8U,
+		0xc451b7ccU, 0x8d6dcaebU, 0x56294d82U, 0x1f1530a5U,
+	},
+};
+
+/* Polynomial 0x1021, reflected (0x8408) */
+const uint16_t crc16_ccitt_slice_table[CRC_TABLE_SLICES][256] = {
+	{
+		0x0000U, 0x1189U, 0x2312U, 0x329bU, 0x4624U, 0x57adU, 0x6536U, 0x74bfU,
+		0x8c48U, 0x9dc1U, 0xaf5aU, 0xbed3U, 0xca6cU, 0xdbe5U, 0xe97eU, 0xf8f7U,
+		0x1081U, 0x0108U, 0x3393U, 0x221aU, 0x56a5U, 0x472cU, 0x75b7U, 0x643eU,
+		0x9cc9U, 0x8d40U, 0xbfdbU, 0xae52U, 0xdaedU, 0xcb64U, 0xf9ffU, 0xe876U,
+		0x2102U, 0x308bU, 0x0210U, 0x1399U, 0x6726U, 0x76afU, 0x4434U, 0x55bdU,
+		0xad4aU, 0xbcc3U, 0x8e58U, 0x9fd1U, 0xeb6eU, 0xfae7U, 0xc87cU, 0xd9f5U,
+		0x3183U, 0x200aU, 0x1291U, 0x0318U, 0x77a7U, 0x662eU, 0x54b5U, 0x453cU,
+		0xbdcbU, 0xac42U, 0x9ed9U, 0x8f50U, 0xfbefU, 0xea66U, 0xd8fdU, 0xc974U,
+		0x4204U, 0x538dU, 0x6116U, 0x709fU, 0x0420U, 0x15a9U, 0x2732U, 0x36bbU,
+		0xce4cU, 0xdfc5U, 0xed5eU, 0xfcd7U, 0x8868U, 0x99e1U, 0xab7aU, 0xbaf3U,
+		0x5285U, 0x430cU, 0x7197U, 0x601eU, 0x14a1U, 0x0528U, 0x37b3U, 0x263aU,
+		0xdecdU, 0xcf44U, 0xfddfU, 0xec56U, 0x98e9U, 0x8960U, 0xbbfbU, 0xaa72U,
+		0x6306U, 0x728fU, 0x4014U, 0x519dU, 0x2522U, 0x34abU, 0x0630U, 0x17b9U,
+		0xef4eU, 0xfec7U, 0xcc5cU, 0xddd5U, 0xa96aU, 0xb8e3U, 0x8a78U, 0x9bf1U,
+		0x7387U, 0x620eU, 0x5095U, 0x411cU, 0x35a3U, 0x242aU, 0x16b1U, 0x0738U,
+		0xffcfU, 0xee46U, 0xdcddU, 0xcd54U, 0xb9ebU, 0xa862U, 0x9af9U, 0x8b70U,
+		0x8408U, 0x9581U, 0xa71aU, 0xb693U, 0xc22cU, 0xd3a5U, 0xe13eU, 0xf0b7U,
+		0x0840U, 0x19c9U, 0x2b52U, 0x3adbU, 0x4e64U, 0x5fedU, 0x6d76U, 0x7cffU,
+		0x9489U, 0x8500U, 0xb79bU, 0xa612U, 0xd2adU, 0xc324U, 0xf1bfU, 0xe036U,
+		0x18c1U, 0x0948U, 0x3bd3U, 0x2a5aU, 0x5ee5U, 0x4f6cU, 0x7df7U, 0x6c7eU,
+		0xa50aU, 0xb483U, 0x8618U, 0x9791U, 0xe32eU, 0xf2a7U, 0xc03cU, 0xd1b5U,
+		0x2942U, 0x38cbU, 0x0a50U, 0x1bd9U, 0x6f66U, 0x7eefU, 0x4c74U, 0x5dfdU,
+		0xb58bU, 0xa402U, 0x9699U, 0x8710U, 0xf3afU, 0xe226U, 0xd0bdU, 0xc134U,
+		0x39c3U, 0x284aU, 0x1ad1U, 0x0b58U, 0x7fe7U, 0x6e6eU, 0x5cf5U, 0x4d7cU,
+		0xc60cU, 0xd785U, 0xe51eU, 0xf497U, 0x8028U, 0x91a1U, 0xa33aU, 0xb2b3U,
+		0x4a44U, 0x5bcdU, 0x6956U, 0x78dfU, 0x0c60U, 0x1de9U, 0x2f72U, 0x3efbU,
+		0xd68dU, 0xc704U, 0xf59fU, 0xe416U, 0x90a9U, 0x8120U, 0xb3bbU, 0xa232U,
+		0x5ac5U, 0x4b4cU, 0x79d7U, 0x685eU, 0x1ce1U, 0x0d68U, 0x3ff3U, 0x2e7aU,
+		0xe70eU, 0xf687U, 0xc41cU, 0xd595U, 0xa12aU, 0xb0a3U, 0x8238U, 0x93b1U,
+		0x6b46U, 0x7acfU, 0x4854U, 0x59ddU, 0x2d62U, 0x3cebU, 0x0e70U, 0x1ff9U,
+		0xf78fU, 0xe606U, 0xd49dU, 0xc514U, 0xb1abU, 0xa022U, 0x92b9U, 0x8330U,
+		0x7bc7U, 0x6a4eU, 0x58d5U, 0x495cU, 0x3de3U, 0x2c6aU, 0x1ef1U, 0x0f78U,
+	},
+	{
+		0x0000U, 0x19d8U, 0x33b0U, 0x2a68U, 0x6760U, 0x7eb8U, 0x54d0U, 0x4d08U,
+		0xcec0U, 0xd718U, 0xfd70U, 0xe4a8U, 0xa9a0U, 0xb078U, 0x9a10U, 0x83c8U,
+		0x9591U, 0x8c49U, 0xa621U, 0xbff9U, 0xf2f1U, 0xeb29U, 0xc141U, 0xd899U,
+		0x5b51U, 0x4289U, 0x68e1U, 0x7139U, 0x3c31U, 0x25e9U, 0x0f81U, 0x1659U,
+		0x2333U, 0x3aebU, 0x1083U, 0x095bU, 0x4453U, 0x5d8bU, 0x77e3U, 0x6e3bU,
+		0xedf3U, 0xf42bU, 0xde43U, 0xc79bU, 0x8a93U, 0x934bU, 0xb923U, 0xa0fbU,
+		0xb6a2U, 0xaf7aU, 0x8512U, 0x9ccaU, 0xd1c2U, 0xc81aU, 0xe272U, 0xfbaaU,
+		0x7862U, 0x61baU, 0x4bd2U, 0x520aU, 0x1f02U, 0x06daU, 0x2cb2U, 0x356aU,
+		0x4666U, 0x5fbeU, 0x75d6U, 0x6c0eU, 0x2106U, 0x38deU, 0x12b6U, 0x0b6eU,
+		0x88a6U, 0x917eU, 0xbb16U, 0xa2ceU, 0xefc6U, 0xf61eU, 0xdc76U, 0xc5aeU,
+		0xd3f7U, 0xca2fU, 0xe047U, 0xf99fU, 0xb497U, 0xad4fU, 0x8727U, 0x9effU,
+		0x1d37U, 0x04efU, 0x2e87U, 0x375fU, 0x7a57U, 0x638fU, 0x49e7U, 0x503fU,
+		0x6555U, 0x7c8dU, 0x56e5U, 0x4f3dU, 0x0235U, 0x1bedU, 0x3185U, 0x285dU,
+		0xab95U, 0xb24dU, 0x9825U, 0x81fdU, 0xccf5U, 0xd52dU, 0xff45U, 0xe69dU,
+		0xf0c4U, 0xe91cU, 0xc374U, 0xdaacU, 0x97a4U, 0x8e7cU, 0xa414U, 0xbdccU,
+		0x3e04U, 0x27dcU, 0x0db4U, 0x146cU, 0x5964U, 0x40bcU, 0x6ad4U, 0x730cU,
+		0x8cccU, 0x9514U, 0xbf7cU, 0xa6a4U, 0xebacU, 0xf274U, 0xd81cU, 0xc1c4U,
+		0x420cU, 0x5bd4U, 0x71bcU, 0x6864U, 0x256cU, 0x3cb4U, 0x16dcU, 0x0f04U,
+		0x195dU, 0x0085U, 0x2aedU, 0x3335U, 0x7e3dU, 0x67e5U, 0x4d8dU, 0x5455U,
+		0xd79dU, 0xce45U, 0xe42dU, 0xfdf5U, 0xb0fdU, 0xa925U, 0x834dU, 0x9a95U,
+		0xafffU, 0xb627U, 0x9c4fU, 0x8597U, 0xc89fU, 0xd147U, 0xfb2fU, 0xe2f7U,
+		0x613fU, 0x78e7U, 0x528fU, 0x4b57U, 0x065fU, 0x1f87U, 0x35efU, 0x2c37U,
+		0x3a6eU, 0x23b6U, 0x09deU, 0x1006U, 0x5d0eU, 0x44d6U, 0x6ebeU, 0x7766U,
+		0xf4aeU, 0xed76U, 0xc71eU, 0xdec6U, 0x93ceU, 0x8a16U, 0xa07eU, 0xb9a6U,
+		0xcaaaU, 0xd372U, 0xf91aU, 0xe0c2U, 0xadcaU, 0xb412U, 0x9e7aU, 0x87a2U,
+		0x046aU, 0x1db2U, 0x37daU, 0x2e02U, 0x630aU, 0x7ad2U, 0x50baU, 0x4962U,
+		0x5f3bU, 0x46e3U, 0x6c8bU, 0x7553U, 0x385bU, 0x2183U, 0x0bebU, 0x1233U,
+		0x91fbU, 0x8823U, 0xa24bU, 0xbb93U, 0xf69bU, 0xef43U, 0xc52bU, 0xdcf3U,
+		0xe999U, 0xf041U, 0xda29U, 0xc3f1U, 0x8ef9U, 0x9721U, 0xbd49U, 0xa491U,
+		0x2759U, 0x3e81U, 0x14e9U, 0x0d31U, 0x4039U, 0x59e1U, 0x7389U, 0x6a51U,
+		0x7c08U, 0x65d0U, 0x4fb8U, 0x5660U, 0x1b68U, 0x02b0U, 0x28d8U, 0x3100U,
+		0xb2c8U, 0xab10U, 0x8178U, 0x98a0U, 0xd5a8U, 0xcc70U, 0xe618U, 0xffc0U,
+	},
+	{
+		0x0000U, 0x5adcU, 0xb5b8U, 0xef64U, 0x6361U, 0x39bdU, 0xd6d9U, 0x8c05U,
+		0xc6c2U, 0x9c1eU, 0x737aU, 0x29a6U, 0xa5a3U, 0xff7fU, 0x101bU, 0x4ac7U,
+		0x8595U, 0xdf49U, 0x302dU, 0x6af1U, 0xe6f4U, 0xbc28U, 0x534cU, 0x0990U,
+		0x4357U, 0x198bU, 0xf6efU, 0xac33U, 0x2036U, 0x7aeaU, 0x958eU, 0xcf52U,
+		0x033bU, 0x59e7U, 0xb683U, 0xec5fU, 0x605aU, 0x3a86U, 0xd5e2U, 0x8f3eU,
+		0xc5f9U, 0x9f25U, 0x7041U, 0x2a9dU, 0xa698U, 0xfc44U, 0x1320U, 0x49fcU,
+		0x86aeU, 0xdc72U, 0x3316U, 0x69caU, 0xe5cfU, 0xbf13U, 0x5077U, 0x0aabU,
+		0x406cU, 0x1ab0U, 0xf5d4U, 0xaf08U, 0x230dU, 0x79d1U, 0x96b5U, 0xcc69U,
+		0x0676U, 0x5caaU, 0xb3ceU, 0xe912U, 0x6517U, 0x3fcbU, 0xd0afU, 0x8a73U,
+		0xc0b4U, 0x9a68U, 0x750cU, 0x2fd0U, 0xa3d5U, 0xf909U, 0x166dU, 0x4cb1U,
+		0x83e3U, 0xd93fU, 0x365bU, 0x6c87U, 0xe082U, 0xba5eU, 0x553aU, 0x0fe6U,
+		0x4521U, 0x1ffdU, 0xf099U, 0xaa45U, 0x2640U, 0x7c9cU, 0x93f8U, 0xc924U,
+		0x054dU, 0x5f91U, 0xb0f5U, 0xea29U, 0x662cU, 0x3cf0U, 0xd394U, 0x8948U,
+		0xc38fU, 0x9953U, 0x7637U, 0x2cebU, 0xa0eeU, 0xfa32U, 0x1556U, 0x4f8aU,
+		0x80d8U, 0xda04U, 0x3560U, 0x6fbcU, 0xe3b9U, 0xb965U, 0x5601U, 0x0cddU,
+		0x461aU, 0x1cc6U, 0xf3a2U, 0xa97eU, 0x257bU, 0x7fa7U, 0x90c3U, 0xca1fU,
+		0x0cecU, 0x5630U, 0xb954U, 0xe388U, 0x6f8dU, 0x3551U, 0xda35U, 0x80e9U,
+		0xca2eU, 0x90f2U, 0x7f96U, 0x254aU, 0xa94fU, 0xf393U, 0x1cf7U, 0x462bU,
+		0x8979U, 0xd3a5U, 0x3cc1U, 0x661dU, 0xea18U, 0xb0c4U, 0x5fa0U, 0x057cU,
+		0x4fbbU, 0x1567U, 0xfa03U, 0xa0dfU, 0x2cdaU, 0x7606U, 0x9962U, 0xc3beU,
+		0x0fd7U, 0x550bU, 0xba6fU, 0xe0b3U, 0x6cb6U, 0x366aU, 0xd90eU, 0x83d2U,
+		0xc915U, 0x93c9U, 0x7cadU, 0x2671U, 0xaa74U, 0xf0a8U, 0x1fccU, 0x4510U,
+		0x8a42U, 0xd09eU, 0x3ffaU, 0x6526U, 0xe923U, 0xb3ffU, 0x5c9bU, 0x0647U,
+		0x4c80U, 0x165cU, 0xf938U, 0xa3e4U, 0x2fe1U, 0x753dU, 0x9a59U, 0xc085U,
+		0x0a9aU, 0x5046U, 0xbf22U, 0xe5feU, 0x69fbU, 0x3327U, 0xdc43U, 0x869fU,
+		0xcc58U, 0x9684U, 0x79e0U, 0x233cU, 0xaf39U, 0xf5e5U, 0x1a81U, 0x405dU,
+		0x8f0fU, 0xd5d3U, 0x3ab7U, 0x606bU, 0xec6eU, 0xb6b2U, 0x59d6U, 0x030aU,
+		0x49cdU, 0x1311U, 0xfc75U, 0xa6a9U, 0x2aacU, 0x7070U, 0x9f14U, 0xc5c8U,
+		0x09a1U, 0x537dU, 0xbc19U, 0xe6c5U, 0x6ac0U, 0x301cU, 0xdf78U, 0x85a4U,
+		0xcf63U, 0x95bfU, 0x7adbU, 0x2007U, 0xac02U, 0xf6deU, 0x19baU, 0x4366U,
+		0x8c34U, 0xd6e8U, 0x398cU, 0x6350U, 0xef55U, 0xb589U, 0x5aedU, 0x0031U,
+		0x4af6U, 0x102aU, 0xff4eU, 0xa592U, 0x2997U, 0x734bU, 0x9c2fU, 0xc6f3U,
+	},
+	{
+		0x0000U, 0x1cbbU, 0x3976U, 0x25cdU, 0x72ecU, 0x6e57U, 0x4b9aU, 0x5721U,
+		0xe5d8U, 0xf963U, 0xdcaeU, 0xc015U, 0x9734U, 0x8b8fU, 0xae42U, 0xb2f9U,
+		0xc3a1U, 0xdf1aU, 0xfad7U, 0xe66cU, 0xb14dU, 0xadf6U, 0x883bU, 0x9480U,
+		0x2679U, 0x3ac2U, 0x1f0fU, 0x03b4U, 0x5495U, 0x482eU, 0x6de3U, 0x7158U,
+		0x8f53U, 0x93e8U, 0xb625U, 0xaa9eU, 0xfdbfU, 0xe104U, 0xc4c9U, 0xd872U,
+		0x6a8bU, 0x7630U, 0x53fdU, 0x4f46U, 0x1867U, 0x04dcU, 0x2111U, 0x3daaU,
+		0x4cf2U, 0x5049U, 0x7584U, 0x693fU, 0x3e1eU, 0x22a5U, 0x0768U, 0x1bd3U,
+		0xa92aU, 0xb591U, 0x905cU, 0x8ce7U, 0xdbc6U, 0xc77dU, 0xe2b0U, 0xfe0bU,
+		0x16b7U, 0x0a0cU, 0x2fc1U, 0x337aU, 0x645bU, 0x78e0U, 0x5d2dU, 0x4196U,
+		0xf36fU, 0xefd4U, 0xca19U, 0xd6a2U, 0x8183U, 0x9d38U, 0xb8f5U, 0xa44eU,
+		0xd516U, 0xc9adU, 0xec60U, 0xf0dbU, 0xa7faU, 0xbb41U, 0x9e8cU, 0x8237U,
+		0x30ceU, 0x2c75U, 0x09b8U, 0x1503U, 0x4222U, 0x5e99U, 0x7b54U, 0x67efU,
+		0x99e4U, 0x855fU, 0xa092U, 0xbc29U, 0xeb08U, 0xf7b3U, 0xd27eU, 0xcec5U,
+		0x7c3cU, 0x6087U, 0x454aU, 0x59f1U, 0x0ed0U, 0x126bU, 0x37a6U, 0x2b1dU,
+		0x5a45U, 0x46feU, 0x6333U, 0x7f88U, 0x28a9U, 0x3412U, 0x11dfU, 0x0d64U,
+		0xbf9dU, 0xa326U, 0x86ebU, 0x9a50U, 0xcd71U, 0xd1caU, 0xf407U, 0xe8bcU,
+		0x2d6eU, 0x31d5U, 0x1418U, 0x08a3U, 0x5f82U, 0x4339U, 0x66f4U, 0x7a4fU,
+		0xc8b6U, 0xd40dU, 0xf1c0U, 0xed7bU, 0xba5aU, 0xa6e1U, 0x832cU, 0x9f97U,
+		0xeecfU, 0xf274U, 0xd7b9U, 0xcb02U, 0x9c23U, 0x8098U, 0xa555U, 0xb9eeU,
+		0x0b17U, 0x17acU, 0x3261U, 0x2edaU, 0x79fbU, 0x6540U, 0x408dU, 0x5c36U,
+		0xa23dU, 0xbe86U, 0x9b4bU, 0x87f0U, 0xd0d1U, 0xcc6aU, 0xe9a7U, 0xf51cU,
+		0x47e5U, 0x5b5eU, 0x7e93U, 0x6228U, 0x3509U, 0x29b2U, 0x0c7fU, 0x10c4U,
+		0x619cU, 0x7d27U, 0x58eaU, 0x4451U, 0x1370U, 0x0fcbU, 0x2a06U, 0x36bdU,
+		0x8444U, 0x98ffU, 0xbd32U, 0xa189U, 0xf6a8U, 0xea13U, 0xcfdeU, 0xd365U,
+		0x3bd9U, 0x2762U, 0x02afU, 0x1e14U, 0x4935U, 0x558eU, 0x7043U, 0x6cf8U,
+		0xde01U, 0xc2baU, 0xe777U, 0xfbccU, 0xacedU, 0xb056U, 0x959bU, 0x8920U,
+		0xf878U, 0xe4c3U, 0xc10eU, 0xddb5U, 0x8a94U, 0x962fU, 0xb3e2U, 0xaf59U,
+		0x1da0U, 0x011bU, 0x24d6U, 0x386dU, 0x6f4cU, 0x73f7U, 0x563aU, 0x4a81U,
+		0xb48aU, 0xa831U, 0x8dfcU, 0x9147U, 0xc666U, 0xdaddU, 0xff10U, 0xe3abU,
+		0x5152U, 0x4de9U, 0x6824U, 0x749fU, 0x23beU, 0x3f05U, 0x1ac8U, 0x0673U,
+		0x772bU, 0x6b90U, 0x4e5dU, 0x52e6U, 0x05c7U, 0x197cU, 0x3cb1U, 0x200aU,
+		0x92f3U, 0x8e48U, 0xab85U, 0xb73eU, 0xe01fU, 0xfca4U, 0xd969U, 0xc5d2U,
+	},
+	{
+		0x0000U, 0x0b44U, 0x1688U, 0x1dccU, 0x2d10U, 0x2654U, 0x3b98U, 0x30dcU,
+		0x5a20U, 0x5164U, 0x4ca8U, 0x47ecU, 0x7730U, 0x7c74U, 0x61b8U, 0x6afcU,
+		0xb440U, 0xbf04U, 0xa2c8U, 0xa98cU, 0x9950U, 0x9214U, 0x8fd8U, 0x849cU,
+		0xee60U, 0xe524U, 0xf8e8U, 0xf3acU, 0xc370U, 0xc834U, 0xd5f8U, 0xdebcU,
+		0x6091U, 0x6bd5U, 0x7619U, 0x7d5dU, 0x4d81U, 0x46c5U, 0x5b09U, 0x504dU,
+		0x3ab1U, 0x31f5U, 0x2c39U, 0x277dU, 0x17a1U, 0x1ce5U, 0x0129U, 0x0a6dU,
+		0xd4d1U, 0xdf95U, 0xc259U, 0xc91dU, 0xf9c1U, 0xf285U, 0xef49U, 0xe40dU,
+		0x8ef1U, 0x85b5U, 0x9879U, 0x933dU, 0xa3e1U, 0xa8a5U, 0xb569U, 0xbe2dU,
+		0xc122U, 0xca66U, 0xd7aaU, 0xdceeU, 0xec32U, 0xe776U, 0xfabaU, 0xf1feU,
+		0x9b02U, 0x9046U, 0x8d8aU, 0x86ceU, 0xb612U, 0xbd56U, 0xa09aU, 0xabdeU,
+		0x7562U, 0x7e26U, 0x63eaU, 0x68aeU, 0x5872U, 0x5336U, 0x4efaU, 0x45beU,
+		0x2f42U, 0x2406U, 0x39caU, 0x328eU, 0x0252U, 0x0916U, 0x14daU, 0x1f9eU,
+		0xa1b3U, 0xaaf7U, 0xb73bU, 0xbc7fU, 0x8ca3U, 0x87e7U, 0x9a2bU, 0x916fU,
+		0xfb93U, 0xf0d7U, 0xed1bU, 0xe65fU, 0xd683U, 0xddc7U, 0xc00bU, 0xcb4fU,
+		0x15f3U, 0x1eb7U, 0x037bU, 0x083fU, 0x38e3U, 0x33a7U, 0x2e6bU, 0x252fU,
+		0x4fd3U, 0x4497U, 0x595bU, 0x521fU, 0x62c3U, 0x6987U, 0x744bU, 0x7f0fU,
+		0x8a55U, 0x8111U, 0x9cddU, 0x9799U, 0xa745U, 0xac01U, 0xb1cdU, 0xba89U,
+		0xd075U, 0xdb31U, 0xc6fdU, 0xcdb9U, 0xfd65U, 0xf621U, 0xebedU, 0xe0a9U,
+		0x3e15U, 0x3551U, 0x289dU, 0x23d9U, 0x1305U, 0x1841U, 0x058dU, 0x0ec9U,
+		0x6435U, 0x6f71U, 0x72bdU, 0x79f9U, 0x4925U, 0x4261U, 0x5fadU, 0x54e9U,
+		0xeac4U, 0xe180U, 0xfc4cU, 0xf708U, 0xc7d4U, 0xcc90U, 0xd15cU, 0xda18U,
+		0xb0e4U, 0xbba0U, 0xa66cU, 0xad28U, 0x9df4U, 0x96b0U, 0x8b7cU, 0x8038U,
+		0x5e84U, 0x55c0U, 0x480cU, 0x4348U, 0x7394U, 0x78d0U, 0x651cU, 0x6e58U,
+		0x04a4U, 0x0fe0U, 0x122cU, 0x1968U, 0x29b4U, 0x22f0U, 0x3f3cU, 0x3478U,
+		0x4b77U, 0x4033U, 0x5dffU, 0x56bbU, 0x6667U, 0x6d23U, 0x70efU, 0x7babU,
+		0x1157U, 0x1a13U, 0x07dfU, 0x0c9bU, 0x3c47U, 0x3703U, 0x2acfU, 0x218bU,
+		0xff37U, 0xf473U, 0xe9bfU, 0xe2fbU, 0xd227U, 0xd963U, 0xc4afU, 0xcfebU,
+		0xa517U, 0xae53U, 0xb39fU, 0xb8dbU, 0x8807U, 0x8343U, 0x9e8fU, 0x95cbU,
+		0x2be6U, 0x20a2U, 0x3d6eU, 0x362aU, 0x06f6U, 0x0db2U, 0x107eU, 0x1b3aU,
+		0x71c6U, 0x7a82U, 0x674eU, 0x6c0aU, 0x5cd6U, 0x5792U, 0x4a5eU, 0x411aU,
+		0x9fa6U, 0x94e2U, 0x892eU, 0x826aU, 0xb2b6U, 0xb9f2U, 0xa43eU, 0xaf7aU,
+		0xc586U, 0xcec2U, 0xd30eU, 0xd84aU, 0xe896U, 0xe3d2U, 0xfe1eU, 0xf55aU,
+	},
+	{
+		0x0000U, 0x042bU, 0x0856U, 0x0c7dU, 0x10acU, 0x1487U, 0x18faU, 0x1cd1U,
+		0x2158U, 0x2573U, 0x290eU, 0x2d25U, 0x31f4U, 0x35dfU, 0x39a2U, 0x3d89U,
+		0x42b0U, 0x469bU, 0x4ae6U, 0x4ecdU, 0x521cU, 0x5637U, 0x5a4aU, 0x5e61U,
+		0x63e8U, 0x67c3U, 0x6bbeU, 0x6f95U, 0x7344U, 0x776fU, 0x7b12U, 0x7f39U,
+		0x8560U, 0x814bU, 0x8d36U, 0x891dU, 0x95ccU, 0x91e7U, 0x9d9aU, 0x99b1U,
+		0xa438U, 0xa013U, 0xac6eU, 0xa845U, 0xb494U, 0xb0bfU, 0xbcc2U, 0xb8e9U,
+		0xc7d0U, 0xc3fbU, 0xcf86U, 0xcbadU, 0xd77cU, 0xd357U, 0xdf2aU, 0xdb01U,
+		0xe688U, 0xe2a3U, 0xeedeU, 0xeaf5U, 0xf624U, 0xf20fU, 0xfe72U, 0xfa59U,
+		0x02d1U, 0x06faU, 0x0a87U, 0x0eacU, 0x127dU, 0x1656U, 0x1a2bU, 0x1e00U,
+		0x2389U, 0x27a2U, 0x2bdfU, 0x2ff4U, 0x3325U, 0x370eU, 0x3b73U, 0x3f58U,
+		0x4061U, 0x444aU, 0x4837U, 0x4c1cU, 0x50cdU, 0x54e6U, 0x589bU, 0x5cb0U,
+		0x6139U, 0x6512U, 0x696fU, 0x6d44U, 0x7195U, 0x75beU, 0x79c3U, 0x7de8U,
+		0x87b1U, 0x839aU, 0x8fe7U, 0x8bccU, 0x971dU, 0x9336U, 0x9f4bU, 0x9b60U,
+		0xa6e9U, 0xa2c2U, 0xaebfU, 0xaa94U, 0xb645U, 0xb26eU, 0xbe13U, 0xba38U,
+		0xc501U, 0xc12aU, 0xcd57U, 0xc97cU, 0xd5adU, 0xd186U, 0xddfbU, 0xd9d0U,
+		0xe459U, 0xe072U, 0xec0fU, 0xe824U, 0xf4f5U, 0xf0deU, 0xfca3U, 0xf888U,
+		0x05a2U, 0x0189U, 0x0df4U, 0x09dfU, 0x150eU, 0x1125U, 0x1d58U, 0x1973U,
+		0x24faU, 0x20d1U, 0x2cacU, 0x2887U, 0x3456U, 0x307dU, 0x3c00U, 0x382bU,
+		0x4712U, 0x4339U, 0x4f44U, 0x4b6fU, 0x57beU, 0x5395U, 0x5fe8U, 0x5bc3U,
+		0x664aU, 0x6261U, 0x6e1cU, 0x6a37U, 0x76e6U, 0x72cdU, 0x7eb0U, 0x7a9bU,
+		0x80c2U, 0x84e9U, 0x8894U, 0x8cbfU, 0x906eU, 0x9445U, 0x9838U, 0x9c13U,
+		0xa19aU, 0xa5b1U, 0xa9ccU, 0xade7U, 0xb136U, 0xb51dU, 0xb960U, 0xbd4bU,
+		0xc272U, 0xc659U, 0xca24U, 0xce0fU, 0xd2deU, 0xd6f5U, 0xda88U, 0xdea3U,
+		0xe32aU, 0xe701U, 0xeb7cU, 0xef57U, 0xf386U, 0xf7adU, 0xfbd0U, 0xfffbU,
+		0x0773U, 0x0358U, 0x0f25U, 0x0b0eU, 0x17dfU, 0x13f4U, 0x1f89U, 0x1ba2U,
+		0x262bU, 0x2200U, 0x2e7dU, 0x2a56U, 0x3687U, 0x32acU, 0x3ed1U, 0x3afaU,
+		0x45c3U, 0x41e8U, 0x4d95U, 0x49beU, 0x556fU, 0x5144U, 0x5d39U, 0x5912U,
+		0x649bU, 0x60b0U, 0x6ccdU, 0x68e6U, 0x7437U, 0x701cU, 0x7c61U, 0x784aU,
+		0x8213U, 0x8638U, 0x8a45U, 0x8e6eU, 0x92bfU, 0x9694U, 0x9ae9U, 0x9ec2U,
+		0xa34bU, 0xa760U, 0xab1dU, 0xaf36U, 0xb3e7U, 0xb7ccU, 0xbbb1U, 0xbf9aU,
+		0xc0a3U, 0xc488U, 0xc8f5U, 0xccdeU, 0xd00fU, 0xd424U, 0xd859U, 0xdc72U,
+		0xe1fbU, 0xe5d0U, 0xe9adU, 0xed86U, 0xf157U, 0xf57cU, 0xf901U, 0xfd2aU,
+	},
+	{
+		0x0000U, 0x9fd5U, 0x37bbU, 0xa86eU, 0x6f76U, 0xf0a3U, 0x58cdU, 0xc718U,
+		0xdeecU, 0x4139U, 0xe957U, 0x7682U, 0xb19aU, 0x2e4fU, 0x8621U, 0x19f4U,
+		0xb5c9U, 0x2a1cU, 0x8272U, 0x1da7U, 0xdabfU, 0x456aU, 0xed04U, 0x72d1U,
+		0x6b25U, 0xf4f0U, 0x5c9eU, 0xc34bU, 0x0453U, 0x9b86U, 0x33e8U, 0xac3dU,
+		0x6383U, 0xfc56U, 0x5438U, 0xcbedU, 0x0cf5U, 0x9320U, 0x3b4eU, 0xa49bU,
+		0xbd6fU, 0x22baU, 0x8ad4U, 0x1501U, 0xd219U, 0x4dccU, 0xe5a2U, 0x7a77U,
+		0xd64aU, 0x499fU, 0xe1f1U, 0x7e24U, 0xb93cU, 0x26e9U, 0x8e87U, 0x1152U,
+		0x08a6U, 0x9773U, 0x3f1dU, 0xa0c8U, 0x67d0U, 0xf805U, 0x506bU, 0xcfbeU,
+		0xc706U, 0x58d3U, 0xf0bdU, 0x6f68U, 0xa870U, 0x37a5U, 0x9fcbU, 0x001eU,
+		0x19eaU, 0x863fU, 0x2e51U, 0xb184U, 0x769cU, 0xe949U, 0x4127U, 0xdef2U,
+		0x72cfU, 0xed1aU, 0x4574U, 0xdaa1U, 0x1db9U, 0x826cU, 0x2a02U, 0xb5d7U,
+		0xac23U, 0x33f6U, 0x9b98U, 0x044dU, 0xc355U, 0x5c80U, 0xf4eeU, 0x6b3bU,
+		0xa485U, 0x3b50U, 0x933eU, 0x0cebU, 0xcbf3U, 0x5426U, 0xfc48U, 0x639dU,
+		0x7a69U, 0xe5bcU, 0x4dd2U, 0xd207U, 0x151fU, 0x8acaU, 0x22a4U, 0xbd71U,
+		0x114cU, 0x8e99U, 0x26f7U, 0xb922U, 0x7e3aU, 0xe1efU, 0x4981U, 0xd654U,
+		0xcfa0U, 0x5075U, 0xf81bU, 0x67ceU, 0xa0d6U, 0x3f03U, 0x976dU, 0x08b8U,
+		0x861dU, 0x19c8U, 0xb1a6U, 0x2e73U, 0xe96bU, 0x76beU, 0xded0U, 0x4105U,
+		0x58f1U, 0xc724U, 0x6f4aU, 0xf09fU, 0x3787U, 0xa852U, 0x003cU, 0x9fe9U,
+		0x33d4U, 0xac01U, 0x046fU, 0x9bbaU, 0x5ca2U, 0xc377U, 0x6b19U, 0xf4ccU,
+		0xed38U, 0x72edU, 0xda83U, 0x4556U, 0x824eU, 0x1d9bU, 0xb5f5U, 0x2a20U,
+		0xe59eU, 0x7a4bU, 0xd225U, 0x4df0U, 0x8ae8U, 0x153dU, 0xbd53U, 0x2286U,
+		0x3b72U, 0xa4a7U, 0x0cc9U, 0x931cU, 0x5404U, 0xcbd1U, 0x63bfU, 0xfc6aU,
+		0x5057U, 0xcf82U, 0x67ecU, 0xf839U, 0x3f21U, 0xa0f4U, 0x089aU, 0x974fU,
+		0x8ebbU, 0x116eU, 0xb900U, 0x26d5U, 0xe1cdU, 0x7e18U, 0xd676U, 0x49a3U,
+		0x411bU, 0xdeceU, 0x76a0U, 0xe975U, 0x2e6dU, 0xb1b8U, 0x19d6U, 0x8603U,
+		0x9ff7U, 0x0022U, 0xa84cU, 0x3799U, 0xf081U, 0x6f54U, 0xc73aU, 0x58efU,
+		0xf4d2U, 0x6b07U, 0xc369U, 0x5cbcU, 0x9ba4U, 0x0471U, 0xac1fU, 0x33caU,
+		0x2a3eU, 0xb5ebU, 0x1d85U, 0x8250U, 0x4548U, 0xda9dU, 0x72f3U, 0xed26U,
+		0x2298U, 0xbd4dU, 0x1523U, 0x8af6U, 0x4deeU, 0xd23bU, 0x7a55U, 0xe580U,
+		0xfc74U, 0x63a1U, 0xcbcfU, 0x541aU, 0x9302U, 0x0cd7U, 0xa4b9U, 0x3b6cU,
+		0x9751U, 0x0884U, 0xa0eaU, 0x3f3fU, 0xf827U, 0x67f2U, 0xcf9cU, 0x5049U,
+		0x49bdU, 0xd668U, 0x7e06U, 0xe1d3U, 0x26cbU, 0xb91eU, 0x1170U, 0x8ea5U,
+	},
+	{
+		0x0000U, 0x81bfU, 0x0b6fU, 0x8ad0U, 0x16deU, 0x9761U, 0x1db1U, 0x9c0eU,
+		0x2dbcU, 0xac03U, 0x26d3U, 0xa76cU, 0x3b62U, 0xbaddU, 0x300dU, 0xb1b2U,
+		0x5b78U, 0xdac7U, 0x5017U, 0xd1a8U, 0x4da6U, 0xcc19U, 0x46c9U, 0xc776U,
+		0x76c4U, 0xf77bU, 0x7dabU, 0xfc14U, 0x601aU, 0xe1a5U, 0x6b75U, 0xeacaU,
+		0xb6f0U, 0x374fU, 0xbd9fU, 0x3c20U, 0xa02eU, 0x2191U, 0xab41U, 0x2afeU,
+		0x9b4cU, 0x1af3U, 0x9023U, 0x119cU, 0x8d92U, 0x0c2dU, 0x86fdU, 0x0742U,
+		0xed88U, 0x6c37U, 0xe6e7U, 0x6758U, 0xfb56U, 0x7ae9U, 0xf039U, 0x7186U,
+		0xc034U, 0x418bU, 0xcb5bU, 0x4ae4U, 0xd6eaU, 0x5755U, 0xdd85U, 0x5c3aU,
+		0x65f1U, 0xe44eU, 0x6e9eU, 0xef21U, 0x732fU, 0xf290U, 0x7840U, 0xf9ffU,
+		0x484dU, 0xc9f2U, 0x4322U, 0xc29dU, 0x5e93U, 0xdf2cU, 0x55fcU, 0xd443U,
+		0x3e89U, 0xbf36U, 0x35e6U, 0xb459U, 0x2857U, 0xa9e8U, 0x2338U, 0xa287U,
+		0x1335U, 0x928aU, 0x185aU, 0x99e5U, 0x05ebU, 0x8454U, 0x0e84U, 0x8f3bU,
+		0xd301U, 0x52beU, 0xd86eU, 0x59d1U, 0xc5dfU, 0x4460U, 0xceb0U, 0x4f0fU,
+		0xfebdU, 0x7f02U, 0xf5d2U, 0x746dU, 0xe863U, 0x69dcU, 0xe30cU, 0x62b3U,
+		0x8879U, 0x09c6U, 0x8316U, 0x02a9U, 0x9ea7U, 0x1f18U, 0x95c8U, 0x1477U,
+		0xa5c5U, 0x247aU, 0xaeaaU, 0x2f15U, 0xb31bU, 0x32a4U, 0xb874U, 0x39cbU,
+		0xcbe2U, 0x4a5dU, 0xc08dU, 0x4132U, 0xdd3cU, 0x5c83U, 0xd653U, 0x57ecU,
+		0xe65eU, 0x67e1U, 0xed31U, 0x6c8eU, 0xf080U, 0x713fU, 0xfbefU, 0x7a50U,
+		0x909aU, 0x1125U, 0x9bf5U, 0x1a4aU, 0x8644U, 0x07fbU, 0x8d2bU, 0x0c94U,
+		0xbd26U, 0x3c99U, 0xb649U, 0x37f6U, 0xabf8U, 0x2a47U, 0xa097U, 0x2128U,
+		0x7d12U, 0xfcadU, 0x767dU, 0xf7c2U, 0x6bccU, 0xea73U, 0x60a3U, 0xe11cU,
+		0x50aeU, 0xd111U, 0x5bc1U, 0xda7eU, 0x4670U, 0xc7cfU, 0x4d1fU, 0xcca0U,
+		0x266aU, 0xa7d5U, 0x2d05U, 0xacbaU, 0x30b4U, 0xb10bU, 0x3bdbU, 0xba64U,
+		0x0bd6U, 0x8a69U, 0x00b9U, 0x8106U, 0x1d08U, 0x9cb7U, 0x1667U, 0x97d8U,
+		0xae13U, 0x2facU, 0xa57cU, 0x24c3U, 0xb8cdU, 0x3972U, 0xb3a2U, 0x321dU,
+		0x83afU, 0x0210U, 0x88c0U, 0x097fU, 0x9571U, 0x14ceU, 0x9e1eU, 0x1fa1U,
+		0xf56bU, 0x74d4U, 0xfe04U, 0x7fbbU, 0xe3b5U, 0x620aU, 0xe8daU, 0x6965U,
+		0xd8d7U, 0x5968U, 0xd3b8U, 0x5207U, 0xce09U, 0x4fb6U, 0xc566U, 0x44d9U,
+		0x18e3U, 0x995cU, 0x138cU, 0x9233U, 0x0e3dU, 0x8f82U, 0x0552U, 0x84edU,
+		0x355fU, 0xb4e0U, 0x3e30U, 0xbf8fU, 0x2381U, 0xa23eU, 0x28eeU, 0xa951U,
+		0x439bU, 0xc224U, 0x48f4U, 0xc94bU, 0x5545U, 0xd4faU, 0x5e2aU, 0xdf95U,
+		0x6e27U, 0xef98U, 0x6548U, 0xe4f7U, 0x78f9U, 0xf946U, 0x7396U, 0xf229U,
+	},
+};
+
+/* Polynomial 0x1021, MSB first */
+const uint16_t crc16_itu_t_slice_table[CRC_TABLE_SLICES][256] = {
+	{
+		0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50a5U, 0x60c6U, 0x70e7U,
+		0x8108U, 0x9129U, 0xa14aU, 0xb16bU, 0xc18cU, 0xd1adU, 0xe1ceU, 0xf1efU,
+		0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52b5U, 0x4294U, 0x72f7U, 0x62d6U,
+		0x9339U, 0x8318U, 0xb37bU, 0xa35aU, 0xd3bdU, 0xc39cU, 0xf3ffU, 0xe3deU,
+		0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64e6U, 0x74c7U, 0x44a4U, 0x5485U,
+		0xa56aU, 0xb54bU, 0x8528U, 0x9509U, 0xe5eeU, 0xf5cfU, 0xc5acU, 0xd58dU,
+		0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76d7U, 0x66f6U, 0x5695U, 0x46b4U,
+		0xb75bU, 0xa77aU, 0x9719U, 0x8738U, 0xf7dfU, 0xe7feU, 0xd79dU, 0xc7bcU,
+		0x48c4U, 0x58e5U, 0x6886U, 0x78a7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+		0xc9ccU, 0xd9edU, 0xe98eU, 0xf9afU, 0x8948U, 0x9969U, 0xa90aU, 0xb92bU,
+		0x5af5U, 0x4ad4U, 0x7ab7U, 0x6a96U, 0x1a71U, 0x0a50U, 0x3a33U, 0x2a12U,
+		0xdbfdU, 0xcbdcU, 0xfbbfU, 0xeb9eU, 0x9b79U, 0x8b58U, 0xbb3bU, 0xab1aU,
+		0x6ca6U, 0x7c87U, 0x4ce4U, 0x5cc5U, 0x2c22U, 0x3c03U, 0x0c60U, 0x1c41U,
+		0xedaeU, 0xfd8fU, 0xcdecU, 0xddcdU, 0xad2aU, 0xbd0bU, 0x8d68U, 0x9d49U,
+		0x7e97U, 0x6eb6U, 0x5ed5U, 0x4ef4U, 0x3e13U, 0x2e32U, 0x1e51U, 0x0e70U,
+		0xff9fU, 0xefbeU, 0xdfddU, 0xcffcU, 0xbf1bU, 0xaf3aU, 0x9f59U, 0x8f78U,
+		0x9188U, 0x81a9U, 0xb1caU, 0xa1ebU, 0xd10cU, 0xc12dU, 0xf14eU, 0xe16fU,
+		0x1080U, 0x00a1U, 0x30c2U, 0x20e3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+		0x83b9U, 0x9398U, 0xa3fbU, 0xb3daU, 0xc33dU, 0xd31cU, 0xe37fU, 0xf35eU,
+		0x02b1U, 0x1290U, 0x22f3U, 0x32d2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+		0xb5eaU, 0xa5cbU, 0x95a8U, 0x8589U, 0xf56eU, 0xe54fU, 0xd52cU, 0xc50dU,
+		0x34e2U, 0x24c3U, 0x14a0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+		0xa7dbU, 0xb7faU, 0x8799U, 0x97b8U, 0xe75fU, 0xf77eU, 0xc71dU, 0xd73cU,
+		0x26d3U, 0x36f2U, 0x0691U, 0x16b0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+		0xd94cU, 0xc96dU, 0xf90eU, 0xe92fU, 0x99c8U, 0x89e9U, 0xb98aU, 0xa9abU,
+		0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18c0U, 0x08e1U, 0x3882U, 0x28a3U,
+		0xcb7dU, 0xdb5cU, 0xeb3fU, 0xfb1eU, 0x8bf9U, 0x9bd8U, 0xabbbU, 0xbb9aU,
+		0x4a75U, 0x5a54U, 0x6a37U, 0x7a16U, 0x0af1U, 0x1ad0U, 0x2ab3U, 0x3a92U,
+		0xfd2eU, 0xed0fU, 0xdd6cU, 0xcd4dU, 0xbdaaU, 0xad8bU, 0x9de8U, 0x8dc9U,
+		0x7c26U, 0x6c07U, 0x5c64U, 0x4c45U, 0x3ca2U, 0x2c83U, 0x1ce0U, 0x0cc1U,
+		0xef1fU, 0xff3eU, 0xcf5dU, 0xdf7cU, 0xaf9bU, 0xbfbaU, 0x8fd9U, 0x9ff8U,
+		0x6e17U, 0x7e36U, 0x4e55U, 0x5e74U, 0x2e93U, 0x3eb2U, 0x0ed1U, 0x1ef0U,
+	},
+	{
+		0x0000U, 0x3331U, 0x6662U, 0x5553U, 0xccc4U, 0xfff5U, 0xaaa6U, 0x9997U,
+		0x89a9U, 0xba98U, 0xefcbU, 0xdcfaU, 0x456dU, 0x765cU, 0x230fU, 0x103eU,
+		0x0373U, 0x3042U, 0x6511U, 0x5620U, 0xcfb7U, 0xfc86U, 0xa9d5U, 0x9ae4U,
+		0x8adaU, 0xb9ebU, 0xecb8U, 0xdf89U, 0x461eU, 0x752fU, 0x207cU, 0x134dU,
+		0x06e6U, 0x35d7U, 0x6084U, 0x53b5U, 0xca22U, 0xf913U, 0xac40U, 0x9f71U,
+		0x8f4fU, 0xbc7eU, 0xe92dU, 0xda1cU, 0x438bU, 0x70baU, 0x25e9U, 0x16d8U,
+		0x0595U, 0x36a4U, 0x63f7U, 0x50c6U, 0xc951U, 0xfa60U, 0xaf33U, 0x9c02U,
+		0x8c3cU, 0xbf0dU, 0xea5eU, 0xd96fU, 0x40f8U, 0x73c9U, 0x269aU, 0x15abU,
+		0x0dccU, 0x3efdU, 0x6baeU, 0x589fU, 0xc108U, 0xf239U, 0xa76aU, 0x945bU,
+		0x8465U, 0xb754U, 0xe207U, 0xd136U, 0x48a1U, 0x7b90U, 0x2ec3U, 0x1df2U,
+		0x0ebfU, 0x3d8eU, 0x68ddU, 0x5becU, 0xc27bU, 0xf14aU, 0xa419U, 0x9728U,
+		0x8716U, 0xb427U, 0xe174U, 0xd245U, 0x4bd2U, 0x78e3U, 0x2db0U, 0x1e81U,
+		0x0b2aU, 0x381bU, 0x6d48U, 0x5e79U, 0xc7eeU, 0xf4dfU, 0xa18cU, 0x92bdU,
+		0x8283U, 0xb1b2U, 0xe4e1U, 0xd7d0U, 0x4e47U, 0x7d76U, 0x2825U, 0x1b14U,
+		0x0859U, 0x3b68U, 0x6e3bU, 0x5d0aU, 0xc49dU, 0xf7acU, 0xa2ffU, 0x91ceU,
+		0x81f0U, 0xb2c1U, 0xe792U, 0xd4a3U, 0x4d34U, 0x7e05U, 0x2b56U, 0x1867U,
+		0x1b98U, 0x28a9U, 0x7dfaU, 0x4ecbU, 0xd75cU, 0xe46dU, 0xb13eU, 0x820fU,
+		0x9231U, 0xa100U, 0xf453U, 0xc762U, 0x5ef5U, 0x6dc4U, 0x3897U, 0x0ba6U,
+		0x18ebU, 0x2bdaU, 0x7e89U, 0x4db8U, 0xd42fU, 0xe71eU, 0xb24dU, 0x817cU,
+		0x9142U, 0xa273U, 0xf720U, 0xc411U, 0x5d86U, 0x6eb7U, 0x3be4U, 0x08d5U,
+		0x1d7eU, 0x2e4fU, 0x7b1cU, 0x482dU, 0xd1baU, 0xe28bU, 0xb7d8U, 0x84e9U,
+		0x94d7U, 0xa7e6U, 0xf2b5U, 0xc184U, 0x5813U, 0x6b22U, 0x3e71U, 0x0d40U,
+		0x1e0dU, 0x2d3cU, 0x786fU, 0x4b5eU, 0xd2c9U, 0xe1f8U, 0xb4abU, 0x879aU,
+		0x97a4U, 0xa495U, 0xf1c6U, 0xc2f7U, 0x5b60U, 0x6851U, 0x3d02U, 0x0e33U,
+		0x1654U, 0x2565U, 0x7036U, 0x4307U, 0xda90U, 0xe9a1U, 0xbcf2U, 0x8fc3U,
+		0x9ffdU, 0xacccU, 0xf99fU, 0xcaaeU, 0x5339U, 0x6008U, 0x355bU, 0x066aU,
+		0x1527U, 0x2616U, 0x7345U, 0x4074U, 0xd9e3U, 0xead2U, 0xbf81U, 0x8cb0U,
+		0x9c8eU, 0xafbfU, 0xfaecU, 0xc9ddU, 0x504aU, 0x637bU, 0x3628U, 0x0519U,
+		0x10b2U, 0x2383U, 0x76d0U, 0x45e1U, 0xdc76U, 0xef47U, 0xba14U, 0x8925U,
+		0x991bU, 0xaa2aU, 0xff79U, 0xcc48U, 0x55dfU, 0x66eeU, 0x33bdU, 0x008cU,
+		0x13c1U, 0x20f0U, 0x75a3U, 0x4692U, 0xdf05U, 0xec34U, 0xb967U, 0x8a56U,
+		0x9a68U, 0xa959U, 0xfc0aU, 0xcf3bU, 0x56acU, 0x659dU, 0x30ceU, 0x03ffU,
+	},
+	{
+		0x0000U, 0x3730U, 0x6e60U, 0x5950U, 0xdcc0U, 0xebf0U, 0xb2a0U, 0x8590U,
+		0xa9a1U, 0x9e91U, 0xc7c1U, 0xf0f1U, 0x7561U, 0x4251U, 0x1b01U, 0x2c31U,
+		0x4363U, 0x7453U, 0x2d03U, 0x1a33U, 0x9fa3U, 0xa893U, 0xf1c3U, 0xc6f3U,
+		0xeac2U, 0xddf2U, 0x84a2U, 0xb392U, 0x3602U, 0x0132U, 0x5862U, 0x6f52U,
+		0x86c6U, 0xb1f6U, 0xe8a6U, 0xdf96U, 0x5a06U, 0x6d36U, 0x3466U, 0x0356U,
+		0x2f67U, 0x1857U, 0x4107U, 0x7637U, 0xf3a7U, 0xc497U, 0x9dc7U, 0xaaf7U,
+		0xc5a5U, 0xf295U, 0xabc5U, 0x9cf5U, 0x1965U, 0x2e55U, 0x7705U, 0x4035U,
+		0x6c04U, 0x5b34U, 0x0264U, 0x3554U, 0xb0c4U, 0x87f4U, 0xdea4U, 0xe994U,
+		0x1dadU, 0x2a9dU, 0x73cdU, 0x44fdU, 0xc16dU, 0xf65dU, 0xaf0dU, 0x983dU,
+		0xb40cU, 0x833cU, 0xda6cU, 0xed5cU, 0x68ccU, 0x5ffcU, 0x06acU, 0x319cU,
+		0x5eceU, 0x69feU, 0x30aeU, 0x079eU, 0x820eU, 0xb53eU, 0xec6eU, 0xdb5eU,
+		0xf76fU, 0xc05fU, 0x990fU, 0xae3fU, 0x2bafU, 0x1c9fU, 0x45cfU, 0x72ffU,
+		0x9b6bU, 0xac5bU, 0xf50bU, 0xc23bU, 0x47abU, 0x709bU, 0x29cbU, 0x1efbU,
+		0x32caU, 0x05faU, 0x5caaU, 0x6b9aU, 0xee0aU, 0xd93aU, 0x806aU, 0xb75aU,
+		0xd808U, 0xef38U, 0xb668U, 0x8158U, 0x04c8U, 0x33f8U, 0x6aa8U, 0x5d98U,
+		0x71a9U, 0x4699U, 0x1fc9U, 0x28f9U, 0xad69U, 0x9a59U, 0xc309U, 0xf439U,
+		0x3b5aU, 0x0c6aU, 0x553aU, 0x620aU, 0xe79aU, 0xd0aaU, 0x89faU, 0xbecaU,
+		0x92fbU, 0xa5cbU, 0xfc9bU, 0xcbabU, 0x4e3bU, 0x790bU, 0x205bU, 0x176bU,
+		0x7839U, 0x4f09U, 0x1659U, 0x2169U, 0xa4f9U, 0x93c9U, 0xca99U, 0xfda9U,
+		0xd198U, 0xe6a8U, 0xbff8U, 0x88c8U, 0x0d58U, 0x3a68U, 0x6338U, 0x5408U,
+		0xbd9cU, 0x8aacU, 0xd3fcU, 0xe4ccU, 0x615cU, 0x566cU, 0x0f3cU, 0x380cU,
+		0x143dU, 0x230dU, 0x7a5dU, 0x4d6dU, 0xc8fdU, 0xffcdU, 0xa69dU, 0x91adU,
+		0xfeffU, 0xc9cfU, 0x909fU, 0xa7afU, 0x223fU, 0x150fU, 0x4c5fU, 0x7b6fU,
+		0x575eU, 0x606eU, 0x393eU, 0x0e0eU, 0x8b9eU, 0xbcaeU, 0xe5feU, 0xd2ceU,
+		0x26f7U, 0x11c7U, 0x4897U, 0x7fa7U, 0xfa37U, 0xcd07U, 0x9457U, 0xa367U,
+		0x8f56U, 0xb866U, 0xe136U, 0xd606U, 0x5396U, 0x64a6U, 0x3df6U, 0x0ac6U,
+		0x6594U, 0x52a4U, 0x0bf4U, 0x3cc4U, 0xb954U, 0x8e64U, 0xd734U, 0xe004U,
+		0xcc35U, 0xfb05U, 0xa255U, 0x9565U, 0x10f5U, 0x27c5U, 0x7e95U, 0x49a5U,
+		0xa031U, 0x9701U, 0xce51U, 0xf961U, 0x7cf1U, 0x4bc1U, 0x1291U, 0x25a1U,
+		0x0990U, 0x3ea0U, 0x67f0U, 0x50c0U, 0xd550U, 0xe260U, 0xbb30U, 0x8c00U,
+		0xe352U, 0xd462U, 0x8d32U, 0xba02U, 0x3f92U, 0x08a2U, 0x51f2U, 0x66c2U,
+		0x4af3U, 0x7dc3U, 0x2493U, 0x13a3U, 0x9633U, 0xa103U, 0xf853U, 0xcf63U,
+	},
+	{
+		0x0000U, 0x76b4U, 0xed68U, 0x9bdcU, 0xcaf1U, 0xbc45U, 0x2799U, 0x512dU,
+		0x85c3U, 0xf377U, 0x68abU, 0x1e1fU, 0x4f32U, 0x3986U, 0xa25aU, 0xd4eeU,
+		0x1ba7U, 0x6d13U, 0xf6cfU, 0x807bU, 0xd156U, 0xa7e2U, 0x3c3eU, 0x4a8aU,
+		0x9e64U, 0xe8d0U, 0x730cU, 0x05b8U, 0x5495U, 0x2221U, 0xb9fdU, 0xcf49U,
+		0x374eU, 0x41faU, 0xda26U, 0xac92U, 0xfdbfU, 0x8b0bU, 0x10d7U, 0x6663U,
+		0xb28dU, 0xc439U, 0x5fe5U, 0x2951U, 0x787cU, 0x0ec8U, 0x9514U, 0xe3a0U,
+		0x2ce9U, 0x5a5dU, 0xc181U, 0xb735U, 0xe618U, 0x90acU, 0x0b70U, 0x7dc4U,
+		0xa92aU, 0xdf9eU, 0x4442U, 0x32f6U, 0x63dbU, 0x156fU, 0x8eb3U, 0xf807U,
+		0x6e9cU, 0x1828U, 0x83f4U, 0xf540U, 0xa46dU, 0xd2d9U, 0x4905U, 0x3fb1U,
+		0xeb5fU, 0x9debU, 0x0637U, 0x7083U, 0x21aeU, 0x571aU, 0xccc6U, 0xba72U,
+		0x753bU, 0x038fU, 0x9853U, 0xeee7U, 0xbfcaU, 0xc97eU, 0x52a2U, 0x2416U,
+		0xf0f8U, 0x864cU, 0x1d90U, 0x6b24U, 0x3a09U, 0x4cbdU, 0xd761U, 0xa1d5U,
+		0x59d2U, 0x2f66U, 0xb4baU, 0xc20eU, 0x9323U, 0xe597U, 0x7e4bU, 0x08ffU,
+		0xdc11U, 0xaaa5U, 0x3179U, 0x47cdU, 0x16e0U, 0x6054U, 0xfb88U, 0x8d3cU,
+		0x4275U, 0x34c1U, 0xaf1dU, 0xd9a9U, 0x8884U, 0xfe30U, 0x65ecU, 0x1358U,
+		0xc7b6U, 0xb102U, 0x2adeU, 0x5c6aU, 0x0d47U, 0x7bf3U, 0xe02fU, 0x969bU,
+		0xdd38U, 0xab8cU, 0x3050U, 0x46e4U, 0x17c9U, 0x617dU, 0xfaa1U, 0x8c15U,
+		0x58fbU, 0x2e4fU, 0xb593U, 0xc327U, 0x920aU, 0xe4beU, 0x7f62U, 0x09d6U,
+		0xc69fU, 0xb02bU, 0x2bf7U, 0x5d43U, 0x0c6eU, 0x7adaU, 0xe106U, 0x97b2U,
+		0x435cU, 0x35e8U, 0xae34U, 0xd880U, 0x89adU, 0xff19U, 0x64c5U, 0x1271U,
+		0xea76U, 0x9cc2U, 0x071eU, 0x71aaU, 0x2087U, 0x5633U, 0xcdefU, 0xbb5bU,
+		0x6fb5U, 0x1901U, 0x82ddU, 0xf469U, 0xa544U, 0xd3f0U, 0x482cU, 0x3e98U,
+		0xf1d1U, 0x8765U, 0x1cb9U, 0x6a0dU, 0x3b20U, 0x4d94U, 0xd648U, 0xa0fcU,
+		0x7412U, 0x02a6U, 0x997aU, 0xefceU, 0xbee3U, 0xc857U, 0x538bU, 0x253fU,
+		0xb3a4U, 0xc510U, 0x5eccU, 0x2878U, 0x7955U, 0x0fe1U, 0x943dU, 0xe289U,
+		0x3667U, 0x40d3U, 0xdb0fU, 0xadbbU, 0xfc96U, 0x8a22U, 0x11feU, 0x674aU,
+		0xa803U, 0xdeb7U, 0x456bU, 0x33dfU, 0x62f2U, 0x1446U, 0x8f9aU, 0xf92eU,
+		0x2dc0U, 0x5b74U, 0xc0a8U, 0xb61cU, 0xe731U, 0x9185U, 0x0a59U, 0x7cedU,
+		0x84eaU, 0xf25eU, 0x6982U, 0x1f36U, 0x4e1bU, 0x38afU, 0xa373U, 0xd5c7U,
+		0x0129U, 0x779dU, 0xec41U, 0x9af5U, 0xcbd8U, 0xbd6cU, 0x26b0U, 0x5004U,
+		0x9f4dU, 0xe9f9U, 0x7225U, 0x0491U, 0x55bcU, 0x2308U, 0xb8d4U, 0xce60U,
+		0x1a8eU, 0x6c3aU, 0xf7e6U, 0x8152U, 0xd07fU, 0xa6cbU, 0x3d17U, 0x4ba3U,
+	},
+	{
+		0x0000U, 0xaa51U, 0x4483U, 0xeed2U, 0x8906U, 0x2357U, 0xcd85U, 0x67d4U,
+		0x022dU, 0xa87cU, 0x46aeU, 0xecffU, 0x8b2bU, 0x217aU, 0xcfa8U, 0x65f9U,
+		0x045aU, 0xae0bU, 0x40d9U, 0xea88U, 0x8d5cU, 0x270dU, 0xc9dfU, 0x638eU,
+		0x0677U, 0xac26U, 0x42f4U, 0xe8a5U, 0x8f71U, 0x2520U, 0xcbf2U, 0x61a3U,
+		0x08b4U, 0xa2e5U, 0x4c37U, 0xe666U, 0x81b2U, 0x2be3U, 0xc531U, 0x6f60U,
+		0x0a99U, 0xa0c8U, 0x4e1aU, 0xe44bU, 0x839fU, 0x29ceU, 0xc71cU, 0x6d4dU,
+		0x0ceeU, 0xa6bfU, 0x486dU, 0xe23cU, 0x85e8U, 0x2fb9U, 0xc16bU, 0x6b3aU,
+		0x0ec3U, 0xa492U, 0x4a40U, 0xe011U, 0x87c5U, 0x2d94U, 0xc346U, 0x6917U,
+		0x1168U, 0xbb39U, 0x55ebU, 0xffbaU, 0x986eU, 0x323fU, 0xdcedU, 0x76bcU,
+		0x1345U, 0xb914U, 0x57c6U, 0xfd97U, 0x9a43U, 0x3012U, 0xdec0U, 0x7491U,
+		0x1532U, 0xbf63U, 0x51b1U, 0xfbe0U, 0x9c34U, 0x3665U, 0xd8b7U, 0x72e6U,
+		0x171fU, 0xbd4eU, 0x539cU, 0xf9cdU, 0x9e19U, 0x3448U, 0xda9aU, 0x70cbU,
+		0x19dcU, 0xb38dU, 0x5d5fU, 0xf70eU, 0x90daU, 0x3a8bU, 0xd459U, 0x7e08U,
+		0x1bf1U, 0xb1a0U, 0x5f72U, 0xf523U, 0x92f7U, 0x38a6U, 0xd674U, 0x7c25U,
+		0x1d86U, 0xb7d7U, 0x5905U, 0xf354U, 0x9480U, 0x3ed1U, 0xd003U, 0x7a52U,
+		0x1fabU, 0xb5faU, 0x5b28U, 0xf179U, 0x96adU, 0x3cfcU, 0xd22eU, 0x787fU,
+		0x22d0U, 0x8881U, 0x6653U, 0xcc02U, 0xabd6U, 0x0187U, 0xef55U, 0x4504U,
+		0x20fdU, 0x8aacU, 0x647eU, 0xce2fU, 0xa9fbU, 0x03aaU, 0xed78U, 0x4729U,
+		0x268aU, 0x8cdbU, 0x6209U, 0xc858U, 0xaf8cU, 0x05ddU, 0xeb0fU, 0x415eU,
+		0x24a7U, 0x8ef6U, 0x6024U, 0xca75U, 0xada1U, 0x07f0U, 0xe922U, 0x4373U,
+		0x2a64U, 0x8035U, 0x6ee7U, 0xc4b6U, 0xa362U, 0x0933U, 0xe7e1U, 0x4db0U,
+		0x2849U, 0x8218U, 0x6ccaU, 0xc69bU, 0xa14fU, 0x0b1eU, 0xe5ccU, 0x4f9dU,
+		0x2e3eU, 0x846fU, 0x6abdU, 0xc0ecU, 0xa738U, 0x0d69U, 0xe3bbU, 0x49eaU,
+		0x2c13U, 0x8642U, 0x6890U, 0xc2c1U, 0xa515U, 0x0f44U, 0xe196U, 0x4bc7U,
+		0x33b8U, 0x99e9U, 0x773bU, 0xdd6aU, 0xbabeU, 0x10efU, 0xfe3dU, 0x546cU,
+		0x3195U, 0x9bc4U, 0x7516U, 0xdf47U, 0xb893U, 0x12c2U, 0xfc10U, 0x5641U,
+		0x37e2U, 0x9db3U, 0x7361U, 0xd930U, 0xbee4U, 0x14b5U, 0xfa67U, 0x5036U,
+		0x35cfU, 0x9f9eU, 0x714cU, 0xdb1dU, 0xbcc9U, 0x1698U, 0xf84aU, 0x521bU,
+		0x3b0cU, 0x915dU, 0x7f8fU, 0xd5deU, 0xb20aU, 0x185bU, 0xf689U, 0x5cd8U,
+		0x3921U, 0x9370U, 0x7da2U, 0xd7f3U, 0xb027U, 0x1a76U, 0xf4a4U, 0x5ef5U,
+		0x3f56U, 0x9507U, 0x7bd5U, 0xd184U, 0xb650U, 0x1c01U, 0xf2d3U, 0x5882U,
+		0x3d7bU, 0x972aU, 0x79f8U, 0xd3a9U, 0xb47dU, 0x1e2cU, 0xf0feU, 0x5aafU,
+	},
+	{
+		0x0000U, 0x45a0U, 0x8b40U, 0xcee0U, 0x06a1U, 0x4301U, 0x8de1U, 0xc841U,
+		0x0d42U, 0x48e2U, 0x8602U, 0xc3a2U, 0x0be3U, 0x4e43U, 0x80a3U, 0xc503U,
+		0x1a84U, 0x5f24U, 0x91c4U, 0xd464U, 0x1c25U, 0x5985U, 0x9765U, 0xd2c5U,
+		0x17c6U, 0x5266U, 0x9c86U, 0xd926U, 0x1167U, 0x54c7U, 0x9a27U, 0xdf87U,
+		0x3508U, 0x70a8U, 0xbe48U, 0xfbe8U, 0x33a9U, 0x7609U, 0xb8e9U, 0xfd49U,
+		0x384aU, 0x7deaU, 0xb30aU, 0xf6aaU, 0x3eebU, 0x7b4bU, 0xb5abU, 0xf00bU,
+		0x2f8cU, 0x6a2cU, 0xa4ccU, 0xe16cU, 0x292dU, 0x6c8dU, 0xa26dU, 0xe7cdU,
+		0x22ceU, 0x676eU, 0xa98eU, 0xec2eU, 0x246fU, 0x61cfU, 0xaf2fU, 0xea8fU,
+		0x6a10U, 0x2fb0U, 0xe150U, 0xa4f0U, 0x6cb1U, 0x2911U, 0xe7f1U, 0xa251U,
+		0x6752U, 0x22f2U, 0xec12U, 0xa9b2U, 0x61f3U, 0x2453U, 0xeab3U, 0xaf13U,
+		0x7094U, 0x3534U, 0xfbd4U, 0xbe74U, 0x7635U, 0x3395U, 0xfd75U, 0xb8d5U,
+		0x7dd6U, 0x3876U, 0xf696U, 0xb336U, 0x7b77U, 0x3ed7U, 0xf037U, 0xb597U,
+		0x5f18U, 0x1ab8U, 0xd458U, 0x91f8U, 0x59b9U, 0x1c19U, 0xd2f9U, 0x9759U,
+		0x525aU, 0x17faU, 0xd91aU, 0x9cbaU, 0x54fbU, 0x115bU, 0xdfbbU, 0x9a1bU,
+		0x459cU, 0x003cU, 0xcedcU, 0x8b7cU, 0x433dU, 0x069dU, 0xc87dU, 0x8dddU,
+		0x48deU, 0x0d7eU, 0xc39eU, 0x863eU, 0x4e7fU, 0x0bdfU, 0xc53fU, 0x809fU,
+		0xd420U, 0x9180U, 0x5f60U, 0x1ac0U, 0xd281U, 0x9721U, 0x59c1U, 0x1c61U,
+		0xd962U, 0x9cc2U, 0x5222U, 0x1782U, 0xdfc3U, 0x9a63U, 0x5483U, 0x1123U,
+		0xcea4U, 0x8b04U, 0x45e4U, 0x0044U, 0xc805U, 0x8da5U, 0x4345U, 0x06e5U,
+		0xc3e6U, 0x8646U, 0x48a6U, 0x0d06U, 0xc547U, 0x80e7U, 0x4e07U, 0x0ba7U,
+		0xe128U, 0xa488U, 0x6a68U, 0x2fc8U, 0xe789U, 0xa229U, 0x6cc9U, 0x2969U,
+		0xec6aU, 0xa9caU, 0x672aU, 0x228aU, 0xeacbU, 0xaf6bU, 0x618bU, 0x242bU,
+		0xfbacU, 0xbe0cU, 0x70ecU, 0x354cU, 0xfd0dU, 0xb8adU, 0x764dU, 0x33edU,
+		0xf6eeU, 0xb34eU, 0x7daeU, 0x380eU, 0xf04fU, 0xb5efU, 0x7b0fU, 0x3eafU,
+		0xbe30U, 0xfb90U, 0x3570U, 0x70d0U, 0xb891U, 0xfd31U, 0x33d1U, 0x7671U,
+		0xb372U, 0xf6d2U, 0x3832U, 0x7d92U, 0xb5d3U, 0xf073U, 0x3e93U, 0x7b33U,
+		0xa4b4U, 0xe114U, 0x2ff4U, 0x6a54U, 0xa215U, 0xe7b5U, 0x2955U, 0x6cf5U,
+		0xa9f6U, 0xec56U, 0x22b6U, 0x6716U, 0xaf57U, 0xeaf7U, 0x2417U, 0x61b7U,
+		0x8b38U, 0xce98U, 0x0078U, 0x45d8U, 0x8d99U, 0xc839U, 0x06d9U, 0x4379U,
+		0x867aU, 0xc3daU, 0x0d3aU, 0x489aU, 0x80dbU, 0xc57bU, 0x0b9bU, 0x4e3bU,
+		0x91bcU, 0xd41cU, 0x1afcU, 0x5f5cU, 0x971dU, 0xd2bdU, 0x1c5dU, 0x59fdU,
+		0x9cfeU, 0xd95eU, 0x17beU, 0x521eU, 0x9a5fU, 0xdfffU, 0x111fU, 0x54bfU,
+	},
+	{
+		0x0000U, 0xb861U, 0x60e3U, 0xd882U, 0xc1c6U, 0x79a7U, 0xa125U, 0x1944U,
+		0x93adU, 0x2bccU, 0xf34eU, 0x4b2fU, 0x526bU, 0xea0aU, 0x3288U, 0x8ae9U,
+		0x377bU, 0x8f1aU, 0x5798U, 0xeff9U, 0xf6bdU, 0x4edcU, 0x965eU, 0x2e3fU,
+		0xa4d6U, 0x1cb7U, 0xc435U, 0x7c54U, 0x6510U, 0xdd71U, 0x05f3U, 0xbd92U,
+		0x6ef6U, 0xd697U, 0x0e15U, 0xb674U, 0xaf30U, 0x1751U, 0xcfd3U, 0x77b2U,
+		0xfd5bU, 0x453aU, 0x9db8U, 0x25d9U, 0x3c9dU, 0x84fcU, 0x5c7eU, 0xe41fU,
+		0x598dU, 0xe1ecU, 0x396eU, 0x810fU, 0x984bU, 0x202aU, 0xf8a8U, 0x40c9U,
+		0xca20U, 0x7241U, 0xaac3U, 0x12a2U, 0x0be6U, 0xb387U, 0x6b05U, 0xd364U,
+		0xddecU, 0x658dU, 0xbd0fU, 0x056eU, 0x1c2aU, 0xa44bU, 0x7cc9U, 0xc4a8U,
+		0x4e41U, 0xf620U, 0x2ea2U, 0x96c3U, 0x8f87U, 0x37e6U, 0xef64U, 0x5705U,
+		0xea97U, 0x52f6U, 0x8a74U, 0x3215U, 0x2b51U, 0x9330U, 0x4bb2U, 0xf3d3U,
+		0x793aU, 0xc15bU, 0x19d9U, 0xa1b8U, 0xb8fcU, 0x009dU, 0xd81fU, 0x607eU,
+		0xb31aU, 0x0b7bU, 0xd3f9U, 0x6b98U, 0x72dcU, 0xcabdU, 0x123fU, 0xaa5eU,
+		0x20b7U, 0x98d6U, 0x4054U, 0xf835U, 0xe171U, 0x5910U, 0x8192U, 0x39f3U,
+		0x8461U, 0x3c00U, 0xe482U, 0x5ce3U, 0x45a7U, 0xfdc6U, 0x2544U, 0x9d25U,
+		0x17ccU, 0xafadU, 0x772fU, 0xcf4eU, 0xd60aU, 0x6e6bU, 0xb6e9U, 0x0e88U,
+		0xabf9U, 0x1398U, 0xcb1aU, 0x737bU, 0x6a3fU, 0xd25eU, 0x0adcU, 0xb2bdU,
+		0x3854U, 0x8035U, 0x58b7U, 0xe0d6U, 0xf992U, 0x41f3U, 0x9971U, 0x2110U,
+		0x9c82U, 0x24e3U, 0xfc61U, 0x4400U, 0x5d44U, 0xe525U, 0x3da7U, 0x85c6U,
+		0x0f2fU, 0xb74eU, 0x6fccU, 0xd7adU, 0xcee9U, 0x7688U, 0xae0aU, 0x166bU,
+		0xc50fU, 0x7d6eU, 0xa5ecU, 0x1d8dU, 0x04c9U, 0xbca8U, 0x642aU, 0xdc4bU,
+		0x56a2U, 0xeec3U, 0x3641U, 0x8e20U, 0x9764U, 0x2f05U, 0xf787U, 0x4fe6U,
+		0xf274U, 0x4a15U, 0x9297U, 0x2af6U, 0x33b2U, 0x8bd3U, 0x5351U, 0xeb30U,
+		0x61d9U, 0xd9b8U, 0x013aU, 0xb95bU, 0xa01fU, 0x187eU, 0xc0fcU, 0x789dU,
+		0x7615U, 0xce74U, 0x16f6U, 0xae97U, 0xb7d3U, 0x0fb2U, 0xd730U, 0x6f51U,
+		0xe5b8U, 0x5dd9U, 0x855bU, 0x3d3aU, 0x247eU, 0x9c1fU, 0x449dU, 0xfcfcU,
+		0x416eU, 0xf90fU, 0x218dU, 0x99ecU, 0x80a8U, 0x38c9U, 0xe04bU, 0x582aU,
+		0xd2c3U, 0x6aa2U, 0xb220U, 0x0a41U, 0x1305U, 0xab64U, 0x73e6U, 0xcb87U,
+		0x18e3U, 0xa082U, 0x7800U, 0xc061U, 0xd925U, 0x6144U, 0xb9c6U, 0x01a7U,
+		0x8b4eU, 0x332fU, 0xebadU, 0x53ccU, 0x4a88U, 0xf2e9U, 0x2a6bU, 0x920aU,
+		0x2f98U, 0x97f9U, 0x4f7bU, 0xf71aU, 0xee5eU, 0x563fU, 0x8ebdU, 0x36dcU,
+		0xbc35U, 0x0454U, 0xdcd6U, 0x64b7U, 0x7df3U, 0xc592U, 0x1d10U, 0xa571U,
+	},
+	{
+		0x0000U, 0x47d3U, 0x8fa6U, 0xc875U, 0x0f6dU, 0x48beU, 0x80cbU, 0xc718U,
+		0x1edaU, 0x5909U, 0x917cU, 0xd6afU, 0x11b7U, 0x5664U, 0x9e11U, 0xd9c2U,
+		0x3db4U, 0x7a67U, 0xb212U, 0xf5c1U, 0x32d9U, 0x750aU, 0xbd7fU, 0xfaacU,
+		0x236eU, 0x64bdU, 0xacc8U, 0xeb1bU, 0x2c03U, 0x6bd0U, 0xa3a5U, 0xe476U,
+		0x7b68U, 0x3cbbU, 0xf4ceU, 0xb31dU, 0x7405U, 0x33d6U, 0xfba3U, 0xbc70U,
+		0x65b2U, 0x2261U, 0xea14U, 0xadc7U, 0x6adfU, 0x2d0cU, 0xe579U, 0xa2aaU,
+		0x46dcU, 0x010fU, 0xc97aU, 0x8ea9U, 0x49b1U, 0x0e62U, 0xc617U, 0x81c4U,
+		0x5806U, 0x1fd5U, 0xd7a0U, 0x9073U, 0x576bU, 0x10b8U, 0xd8cdU, 0x9f1eU,
+		0xf6d0U, 0xb103U, 0x7976U, 0x3ea5U, 0xf9bdU, 0xbe6eU, 0x761bU, 0x31c8U,
+		0xe80aU, 0xafd9U, 0x67acU, 0x207fU, 0xe767U, 0xa0b4U, 0x68c1U, 0x2f12U,
+		0xcb64U, 0x8cb7U, 0x44c2U, 0x0311U, 0xc409U, 0x83daU, 0x4bafU, 0x0c7cU,
+		0xd5beU, 0x926dU, 0x5a18U, 0x1dcbU, 0xdad3U, 0x9d00U, 0x5575U, 0x12a6U,
+		0x8db8U, 0xca6bU, 0x021eU, 0x45cdU, 0x82d5U, 0xc506U, 0x0d73U, 0x4aa0U,
+		0x9362U, 0xd4b1U, 0x1cc4U, 0x5b17U, 0x9c0fU, 0xdbdcU, 0x13a9U, 0x547aU,
+		0xb00cU, 0xf7dfU, 0x3faaU, 0x7879U, 0xbf61U, 0xf8b2U, 0x30c7U, 0x7714U,
+		0xaed6U, 0xe905U, 0x2170U, 0x66a3U, 0xa1bbU, 0xe668U, 0x2e1dU, 0x69ceU,
+		0xfd81U, 0xba52U, 0x7227U, 0x35f4U, 0xf2ecU, 0xb53fU, 0x7d4aU, 0x3a99U,
+		0xe35bU, 0xa488U, 0x6cfdU, 0x2b2eU, 0xec36U, 0xabe5U, 0x6390U, 0x2443U,
+		0xc035U, 0x87e6U, 0x4f93U, 0x0840U, 0xcf58U, 0x888bU, 0x40feU, 0x072dU,
+		0xdeefU, 0x993cU, 0x5149U, 0x169aU, 0xd182U, 0x9651U, 0x5e24U, 0x19f7U,
+		0x86e9U, 0xc13aU, 0x094fU, 0x4e9cU, 0x8984U, 0xce57U, 0x0622U, 0x41f1U,
+		0x9833U, 0xdfe0U, 0x1795U, 0x5046U, 0x975eU, 0xd08dU, 0x18f8U, 0x5f2bU,
+		0xbb5dU, 0xfc8eU, 0x34fbU, 0x7328U, 0xb430U, 0xf3e3U, 0x3b96U, 0x7c45U,
+		0xa587U, 0xe254U, 0x2a21U, 0x6df2U, 0xaaeaU, 0xed39U, 0x254cU, 0x629fU,
+		0x0b51U, 0x4c82U, 0x84f7U, 0xc324U, 0x043cU, 0x43efU, 0x8b9aU, 0xcc49U,
+		0x158bU, 0x5258U, 0x9a2dU, 0xddfeU, 0x1ae6U, 0x5d35U, 0x9540U, 0xd293U,
+		0x36e5U, 0x7136U, 0xb943U, 0xfe90U, 0x3988U, 0x7e5bU, 0xb62eU, 0xf1fdU,
+		0x283fU, 0x6fecU, 0xa799U, 0xe04aU, 0x2752U, 0x6081U, 0xa8f4U, 0xef27U,
+		0x7039U, 0x37eaU, 0xff9fU, 0xb84cU, 0x7f54U, 0x3887U, 0xf0f2U, 0xb721U,
+		0x6ee3U, 0x2930U, 0xe145U, 0xa696U, 0x618eU, 0x265dU, 0xee28U, 0xa9fbU,
+		0x4d8dU, 0x0a5eU, 0xc22bU, 0x85f8U, 0x42e0U, 0x0533U, 0xcd46U, 0x8a95U,
+		0x5357U, 0x1484U, 0xdcf1U, 0x9b22U, 0x5c3aU, 0x1be9U, 0xd39cU, 0x944fU,
+	},
+};
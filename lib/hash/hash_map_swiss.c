@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*
+ * The buckets are allocated as one region, starting with one control byte per bucket followed
+ * by the entries. A control byte is either EMPTY or holds the upper 7 bits of the hash of the
+ * key in the bucket, which selects the candidates of a lookup without touching the entries.
+ *
+ * The lower bits of the hash select the group of GROUP_WIDTH buckets that a key is placed in.
+ * Full groups are skipped linearly, and a key is always placed in the first group of its probe
+ * sequence that has an empty bucket. Lookups therefore end at the first group that has an empty
+ * bucket, and removal refills buckets instead of leaving tombstones behind.
+ */
+
+#define GROUP_WIDTH 16
+#define CTRL_EMPTY  0x80
+
+struct swiss_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+/*
+ * Group matching: each function returns a mask with one bit set for each matching bucket of
+ * the group, bucket i being at bit (i << GROUP_MASK_SHIFT).
+ */
+
+#if defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__SSE2__)
+
+typedef uint32_t group_mask_t;
+#define GROUP_MASK_SHIFT 0
+
+static inline group_mask_t group_match(const uint8_t *group, uint8_t h2)
+{
+	__m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+
+	return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *group)
+{
+	/* only EMPTY has the top bit set */
+	return (uint16_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+
+static inline group_mask_t group_match_full(const uint8_t *group)
+{
+	return group_match_empty(group) ^ 0xffff;
+}
+
+#elif defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+
+typedef uint64_t group_mask_t;
+#define GROUP_MASK_SHIFT 2
+
+/* Narrow the 0x00 / 0xff lanes to one nibble per bucket and keep one bit of each nibble */
+static inline group_mask_t neon_mask(uint8x16_t match)
+{
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(match), 4);
+
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+}
+
+static inline group_mask_t group_match(const uint8_t *group, uint8_t h2)
+{
+	return neon_mask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(h2)));
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *group)
+{
+	return neon_mask(vtstq_u8(vld1q_u8(group), vdupq_n_u8(CTRL_EMPTY)));
+}
+
+static inline group_mask_t group_match_full(const uint8_t *group)
+{
+	return group_match_empty(group) ^ 0x8888888888888888ULL;
+}
+
+#else
+
+/* Portable fallback, a machine word of control bytes at a time */
+
+typedef uint32_t group_mask_t;
+#define GROUP_MASK_SHIFT 0
+
+#if defined(CONFIG_64BIT)
+typedef uint64_t swar_t;
+#define SWAR_LOAD(_p)	  sys_get_le64(_p)
+/* gather the top bit of each byte into the top byte, then shift it down */
+#define SWAR_COMPRESS(_x) ((group_mask_t)((((_x) >> 7) * 0x0102040810204080ULL) >> 56))
+#else
+typedef uint32_t swar_t;
+#define SWAR_LOAD(_p)	  sys_get_le32(_p)
+#define SWAR_COMPRESS(_x) ((group_mask_t)((((_x) >> 7) * 0x01020408U) >> 24))
+#endif
+
+#define SWAR_LSB ((swar_t)0x0101010101010101ULL)
+#define SWAR_MSB ((swar_t)0x8080808080808080ULL)
+
+static inline group_mask_t group_match(const uint8_t *group, uint8_t h2)
+{
+	group_mask_t mask = 0;
+	swar_t x;
+
+	for (size_t i = 0; i < GROUP_WIDTH; i += sizeof(swar_t)) {
+		x = SWAR_LOAD(&group[i]) ^ (SWAR_LSB * h2);
+		/* exact zero byte detection, sets the top bit of the bytes that are 0 */
+		x = ~(((x & ~SWAR_MSB) + ~SWAR_MSB) | x | ~SWAR_MSB);
+		mask |= SWAR_COMPRESS(x) << i;
+	}
+
+	return mask;
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *group)
+{
+	group_mask_t mask = 0;
+
+	for (size_t i = 0; i < GROUP_WIDTH; i += sizeof(swar_t)) {
+		mask |= SWAR_COMPRESS(SWAR_LOAD(&group[i]) & SWAR_MSB) << i;
+	}
+
+	return mask;
+}
+
+static inline group_mask_t group_match_full(const uint8_t *group)
+{
+	return group_match_empty(group) ^ 0xffff;
+}
+
+#endif
+
+static inline size_t group_mask_first(group_mask_t mask)
+{
+	if (sizeof(group_mask_t) == sizeof(uint64_t)) {
+		return u64_count_trailing_zeros(mask) >> GROUP_MASK_SHIFT;
+	}
+
+	return u32_count_trailing_zeros((uint32_t)mask) >> GROUP_MASK_SHIFT;
+}
+
+static inline uint8_t *swiss_ctrl(const struct sys_hashmap_data *data)
+{
+	return data->buckets;
+}
+
+static inline struct swiss_entry *swiss_entries(const struct sys_hashmap_data *data)
+{
+	/* n_buckets is a multiple of GROUP_WIDTH, so the entries remain aligned */
+	return (struct swiss_entry *)((uint8_t *)data->buckets + data->n_buckets);
+}
+
+static inline uint32_t swiss_hash(const struct sys_hashmap *map, uint64_t key)
+{
+	return map->hash_func(&key, sizeof(key));
+}
+
+static inline uint8_t swiss_h2(uint32_t hash)
+{
+	return hash >> 25;
+}
+
+static struct swiss_entry *sys_hashmap_swiss_find(const struct sys_hashmap *map, uint64_t key,
+						  uint32_t hash)
+{
+	const size_t n_groups = map->data->n_buckets / GROUP_WIDTH;
+	const uint8_t *const ctrl = swiss_ctrl(map->data);
+	struct swiss_entry *const entries = swiss_entries(map->data);
+	const uint8_t *group;
+	size_t j;
+
+	for (size_t i = 0, g = hash; i < n_groups; ++i, ++g) {
+		g &= (n_groups - 1);
+		group = &ctrl[g * GROUP_WIDTH];
+
+		for (group_mask_t m = group_match(group, swiss_h2(hash)); m != 0; m &= m - 1) {
+			j = g * GROUP_WIDTH + group_mask_first(m);
+			if (entries[j].key == key) {
+				return &entries[j];
+			}
+		}
+
+		if (group_match_empty(group) != 0) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/* Place a key that is not in the Hashmap yet */
+static void sys_hashmap_swiss_place(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint32_t hash)
+{
+	const size_t n_groups = map->data->n_buckets / GROUP_WIDTH;
+	uint8_t *const ctrl = swiss_ctrl(map->data);
+	struct swiss_entry *const entries = swiss_entries(map->data);
+	group_mask_t m;
+	size_t j;
+
+	for (size_t i = 0, g = hash; i < n_groups; ++i, ++g) {
+		g &= (n_groups - 1);
+
+		m = group_match_empty(&ctrl[g * GROUP_WIDTH]);
+		if (m != 0) {
+			j = g * GROUP_WIDTH + group_mask_first(m);
+			ctrl[j] = swiss_h2(hash);
+			entries[j].key = key;
+			entries[j].value = value;
+			++map->data->size;
+			return;
+		}
+	}
+
+	__ASSERT(false, "No empty bucket. Memory has been corrupted");
+}
+
+/*
+ * Empty the bucket at index hole. Lookups stop at the first group with an empty bucket, so
+ * unless the group of the hole had one already, the probe sequences of entries in later groups
+ * may pass through it. The hole is then refilled with such an entry, which leaves a hole in the
+ * later group, until a group that was not full is reached.
+ */
+static void sys_hashmap_swiss_erase(struct sys_hashmap *map, size_t hole)
+{
+	const size_t n_groups = map->data->n_buckets / GROUP_WIDTH;
+	uint8_t *const ctrl = swiss_ctrl(map->data);
+	struct swiss_entry *const entries = swiss_entries(map->data);
+	size_t hole_g = hole / GROUP_WIDTH;
+	bool group_full = group_match_empty(&ctrl[hole_g * GROUP_WIDTH]) == 0;
+	const uint8_t *group;
+	size_t home;
+	size_t j;
+
+	ctrl[hole] = CTRL_EMPTY;
+
+	for (size_t g = hole_g + 1; group_full; ++g) {
+		g &= (n_groups - 1);
+		if (g == hole_g) {
+			break;
+		}
+
+		group = &ctrl[g * GROUP_WIDTH];
+		group_full = group_match_empty(group) == 0;
+
+		for (group_mask_t m = group_match_full(group); m != 0; m &= m - 1) {
+			j = g * GROUP_WIDTH + group_mask_first(m);
+			home = swiss_hash(map, entries[j].key) & (n_groups - 1);
+
+			/* the probe sequence from home to g passes the hole */
+			if (((g - home) & (n_groups - 1)) >= ((g - hole_g) & (n_groups - 1))) {
+				ctrl[hole] = ctrl[j];
+				entries[hole] = entries[j];
+				ctrl[j] = CTRL_EMPTY;
+				hole = j;
+				hole_g = g;
+				break;
+			}
+		}
+	}
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, bool grow)
+{
+	size_t old_n_buckets;
+	size_t new_n_buckets = 0;
+	uint8_t *old_ctrl;
+	uint8_t *new_buckets;
+	struct swiss_entry *old_entries;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	/* the load factor check rounds down, which must not overfill the table at 100 */
+	if (!sys_hashmap_should_rehash(map, grow, 0, &new_n_buckets) &&
+	    !(grow && data->size == data->n_buckets)) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	/* whole groups, and a power of two number of them */
+	if (new_n_buckets != 0) {
+		new_n_buckets = MAX(GROUP_WIDTH, (size_t)NHPOT(new_n_buckets));
+	}
+
+	if (new_n_buckets == data->n_buckets || new_n_buckets < data->size) {
+		return 0;
+	}
+
+	new_buckets = map->alloc_func(NULL, new_n_buckets * (1 + sizeof(struct swiss_entry)));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	if (new_buckets != NULL) {
+		/* ensure all buckets are empty */
+		memset(new_buckets, CTRL_EMPTY, new_n_buckets);
+	}
+
+	old_n_buckets = data->n_buckets;
+	old_ctrl = data->buckets;
+	old_entries = swiss_entries(map->data);
+
+	data->size = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	/* re-insert all entries into the hashmap */
+	for (size_t i = 0; i < old_n_buckets; ++i) {
+		if (old_ctrl[i] != CTRL_EMPTY) {
+			sys_hashmap_swiss_place(map, old_entries[i].key, old_entries[i].value,
+						swiss_hash(map, old_entries[i].key));
+		}
+	}
+
+	/* free the old Hashmap */
+	map->alloc_func(old_ctrl, 0);
+
+	return 0;
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	const uint8_t *const ctrl = swiss_ctrl(map->data);
+	struct swiss_entry *const entries = swiss_entries(map->data);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = entries;
+	}
+
+	i = (struct swiss_entry *)it->state - entries;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if (ctrl[i] != CTRL_EMPTY) {
+			it->state = &entries[i + 1];
+			it->key = entries[i].key;
+			it->value = entries[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const uint8_t *const ctrl = swiss_ctrl(map->data);
+	struct swiss_entry *const entries = swiss_entries(map->data);
+
+	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
+		if (ctrl[i] != CTRL_EMPTY) {
+			cb(entries[i].key, entries[i].value, cookie);
+			++j;
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+}
+
+static int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+	uint32_t hash = swiss_hash(map, key);
+	struct swiss_entry *entry;
+
+	entry = sys_hashmap_swiss_find(map, key, hash);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+
+		return 0;
+	}
+
+	ret = sys_hashmap_swiss_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	sys_hashmap_swiss_place(map, key, value, hash);
+
+	return 1;
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct swiss_entry *entry;
+
+	entry = sys_hashmap_swiss_find(map, key, swiss_hash(map, key));
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	sys_hashmap_swiss_erase(map, entry - swiss_entries(map->data));
+	--map->data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_swiss_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct swiss_entry *entry;
+
+	entry = sys_hashmap_swiss_find(map, key, swiss_hash(map, key));
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
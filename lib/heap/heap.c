@@ -148,6 +148,121 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* The first chunk header holds the size class lists, see Z_HEAP_MIN_SIZE */
+BUILD_ASSERT(sizeof(struct z_heap) == sizeof(struct z_heap_min_size_hdr));
+BUILD_ASSERT(sizeof(struct z_heap_bucket) == sizeof(chunkid_t));
+BUILD_ASSERT(CHUNK_UNIT == Z_HEAP_CHUNK_UNIT);
+
+/*
+ * Parked chunks are still marked used, so that check alone can't catch
+ * them being freed again.  They are tagged with a FREE_PREV pointing to
+ * themselves, and as user data may hold the same value, only tagged
+ * chunks are looked up on their list.
+ */
+static inline bool size_class_parked(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if ((sz > SIZE_CLASS_MAX_CHUNKS) || (prev_free_chunk(h, c) != c)) {
+		return false;
+	}
+
+	for (chunkid_t p = h->size_classes[sz]; p != 0U; p = next_free_chunk(h, p)) {
+		if (p == c) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Park a chunk being freed on its size class list, if it has one */
+static bool size_class_put(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if (sz > SIZE_CLASS_MAX_CHUNKS) {
+		return false;
+	}
+
+	set_prev_free_chunk(h, c, c);
+	set_next_free_chunk(h, c, h->size_classes[sz]);
+	h->size_classes[sz] = c;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+	return true;
+}
+
+/* Pop a parked chunk of exactly this size, it is still marked used */
+static chunkid_t size_class_get(struct z_heap *h, chunksz_t sz)
+{
+	chunkid_t c;
+
+	if ((sz > SIZE_CLASS_MAX_CHUNKS) || (h->size_classes[sz] == 0U)) {
+		return 0;
+	}
+
+	c = h->size_classes[sz];
+	CHECK(chunk_used(h, c));
+	CHECK(chunk_size(h, c) == sz);
+	h->size_classes[sz] = next_free_chunk(h, c);
+	set_prev_free_chunk(h, c, 0);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+	return c;
+}
+
+/* Really free all parked chunks.  Returns false if there were none. */
+static bool size_class_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (chunksz_t sz = 1; sz <= SIZE_CLASS_MAX_CHUNKS; sz++) {
+		chunkid_t c;
+
+		while ((c = size_class_get(h, sz)) != 0U) {
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+#else
+static inline bool size_class_parked(struct z_heap *h, chunkid_t c)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+	return false;
+}
+
+static inline bool size_class_put(struct z_heap *h, chunkid_t c)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(c);
+	return false;
+}
+
+static inline chunkid_t size_class_get(struct z_heap *h, chunksz_t sz)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(sz);
+	return 0;
+}
+
+static inline bool size_class_flush(struct z_heap *h)
+{
+	ARG_UNUSED(h);
+	return false;
+}
+#endif /* CONFIG_SYS_HEAP_SIZE_CLASSES */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -172,7 +287,7 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	 * This should catch many double-free cases.
 	 * This is cheap enough so let's do it all the time.
 	 */
-	__ASSERT(chunk_used(h, c),
+	__ASSERT(chunk_used(h, c) && !size_class_parked(h, c),
 		 "unexpected heap state (double-free?) for memory at %p", mem);
 
 	/*
@@ -184,7 +299,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,7 +308,10 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
-	free_chunk(h, c);
+	if (!size_class_put(h, c)) {
+		set_chunk_used(h, c, false);
+		free_chunk(h, c);
+	}
 }
 
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
@@ -208,7 +325,7 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
-static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+static chunkid_t find_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
 	struct z_heap_bucket *b = &h->buckets[bi];
@@ -260,6 +377,18 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	chunkid_t c = find_chunk(h, sz);
+
+	/* Merge parked small chunks back into the heap as a last resort */
+	if ((c == 0U) && size_class_flush(h)) {
+		c = find_chunk(h, sz);
+	}
+
+	return c;
+}
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -270,18 +399,22 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = size_class_get(h, chunk_sz);
+
 	if (c == 0U) {
-		return NULL;
-	}
+		c = alloc_chunk(h, chunk_sz);
+		if (c == 0U) {
+			return NULL;
+		}
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
 
-	set_chunk_used(h, c, true);
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -517,6 +650,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	for (size_t i = 0; i < ARRAY_SIZE(h->size_classes); i++) {
+		h->size_classes[i] = 0;
+	}
+#endif
+
 #if CONFIG_SYS_HEAP_ARRAY_SIZE
 	sys_heap_array_save(heap);
 #endif
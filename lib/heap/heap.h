@@ -45,6 +45,12 @@
  * obviously.  This memory is part of the user's buffer when
  * allocated.
  *
+ * With CONFIG_SYS_HEAP_SIZE_CLASSES, small chunks being freed are not
+ * merged but parked on a per-size singly linked list threaded through
+ * FREE_NEXT, with a zero chunk ID terminating it.  Such chunks keep
+ * their "used" flag so that neighbors never merge with them, and are
+ * only really freed when an allocation fails otherwise.
+ *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
  * the following chunk at the top. This ordering allows for quick buffer
@@ -65,6 +71,14 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Size class lists are indexed by chunk size, up to that of a chunk
+ * holding CONFIG_SYS_HEAP_SIZE_CLASS_MAX bytes behind a big header.
+ */
+#define SIZE_CLASS_MAX_CHUNKS \
+	((CONFIG_SYS_HEAP_SIZE_CLASS_MAX + 8U + CHUNK_UNIT - 1U) / CHUNK_UNIT)
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +87,9 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	chunkid_t size_classes[SIZE_CLASS_MAX_CHUNKS + 1];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -277,6 +294,16 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Chunks parked on size class lists look used but are free */
+	for (chunksz_t sz = 1; sz <= SIZE_CLASS_MAX_CHUNKS; sz++) {
+		for (c = h->size_classes[sz]; c != 0; c = next_free_chunk(h, c)) {
+			*alloc_bytes -= chunksz_to_bytes(h, sz);
+			*free_bytes += chunksz_to_bytes(h, sz);
+		}
+	}
+#endif
 }
 
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
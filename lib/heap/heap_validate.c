@@ -85,6 +85,23 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Parked chunks must be valid, still marked used, tagged and of the
+	 * size of their list.  The count bound catches looping lists.
+	 */
+	for (chunksz_t sz = 1; sz <= SIZE_CLASS_MAX_CHUNKS; sz++) {
+		uint32_t n = 0;
+
+		for (c = h->size_classes[sz]; c != 0; c = next_free_chunk(h, c)) {
+			if ((c >= h->end_chunk) || !valid_chunk(h, c) || !chunk_used(h, c) ||
+			    (prev_free_chunk(h, c) != c) || (chunk_size(h, c) != sz) ||
+			    (++n > h->end_chunk)) {
+				return false;
+			}
+		}
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -26,6 +26,10 @@
 
 struct stat;
 
+#ifdef CONFIG_ZVFS_EPOLL
+void zvfs_epoll_remove_fd(int fd);
+#endif
+
 struct fd_entry {
 	void *obj;
 	const struct fd_op_vtable *vtable;
@@ -392,6 +396,10 @@ int zvfs_close(int fd)
 		return -1;
 	}
 
+#ifdef CONFIG_ZVFS_EPOLL
+	zvfs_epoll_remove_fd(fd);
+#endif
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 	if (fdtable[fd].vtable->close != NULL) {
 		/* close() is optional - e.g. stdinout_fd_op_vtable */
@@ -0,0 +1,579 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+#define ZVFS_EPOLL_EVENTS_MASK                                                                     \
+	(ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT | ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+int zvfs_poll_internal(struct zvfs_pollfd *fds, int nfds, k_timeout_t timeout);
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	/* node in the interest list of the owning instance */
+	sys_dnode_t node;
+	/* node in the ready list of the owning instance */
+	sys_dnode_t ready_node;
+	struct k_work_poll work;
+	struct k_poll_event pev[CONFIG_ZVFS_EPOLL_ITEM_EVENTS];
+	struct zvfs_epoll *ep;
+	struct zvfs_epoll_event event;
+	int fd;
+};
+
+struct zvfs_epoll {
+	/* serializes ctl, wait and close */
+	struct k_mutex lock;
+	/* protects the ready list, which is appended to from the system work queue */
+	struct k_spinlock ready_lock;
+	struct k_poll_signal ready_sig;
+	sys_dlist_t items;
+	sys_dlist_t ready;
+	bool in_use;
+};
+
+SYS_BITARRAY_DEFINE_STATIC(eps_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+SYS_BITARRAY_DEFINE_STATIC(items_bitarray, CONFIG_ZVFS_EPOLL_ITEMS_MAX);
+static struct zvfs_epoll eps[CONFIG_ZVFS_EPOLL_MAX];
+static struct zvfs_epoll_item items[CONFIG_ZVFS_EPOLL_ITEMS_MAX];
+/* protects allocation of instances and their in_use flag */
+static K_MUTEX_DEFINE(eps_lock);
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static void zvfs_epoll_ready(struct zvfs_epoll_item *item)
+{
+	struct zvfs_epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->ready_lock);
+
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&ep->ready, &item->ready_node);
+	}
+
+	k_poll_signal_raise(&ep->ready_sig, 0);
+
+	k_spin_unlock(&ep->ready_lock, key);
+}
+
+static void zvfs_epoll_trigger(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+	struct zvfs_epoll_item *item = CONTAINER_OF(pwork, struct zvfs_epoll_item, work);
+
+	zvfs_epoll_ready(item);
+}
+
+/*
+ * Register the poll events of an entry with a triggered work item, so that
+ * the entry is moved to the ready list as soon as one of them is signalled.
+ *
+ * Called with ep->lock held.
+ */
+static int zvfs_epoll_arm(struct zvfs_epoll_item *item)
+{
+	int ret;
+	void *ctx;
+	struct k_mutex *lock;
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = item->pev;
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->event.events & ZVFS_EPOLL_EVENTS_MASK,
+	};
+
+	if (pfd.events == 0) {
+		/* disabled, e.g. after a one-shot report */
+		return 0;
+	}
+
+	ctx = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (ctx == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->pev + ARRAY_SIZE(item->pev));
+	k_mutex_unlock(lock);
+
+	if (ret == -EALREADY) {
+		/* already readable / writable, no need to wait */
+		zvfs_epoll_ready(item);
+		return 0;
+	} else if (ret == -EXDEV) {
+		/* offloaded sockets only implement a one-shot poll() */
+		return -EOPNOTSUPP;
+	} else if (ret < 0) {
+		return ret;
+	}
+
+	if (pev == item->pev) {
+		/* nothing to wait for */
+		return 0;
+	}
+
+	return k_work_poll_submit(&item->work, item->pev, pev - item->pev, K_FOREVER);
+}
+
+/* Called with ep->lock held. */
+static void zvfs_epoll_disarm(struct zvfs_epoll_item *item)
+{
+	struct zvfs_epoll *ep = item->ep;
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	if (k_work_poll_cancel(&item->work) != 0) {
+		/* not waiting; the trigger handler may be pending or running */
+		(void)k_work_cancel_sync(&item->work.work, &sync);
+		k_work_poll_init(&item->work, zvfs_epoll_trigger);
+	}
+
+	key = k_spin_lock(&ep->ready_lock);
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+	k_spin_unlock(&ep->ready_lock, key);
+}
+
+static struct zvfs_epoll_item *zvfs_epoll_item_alloc(struct zvfs_epoll *ep, int fd,
+						     const struct zvfs_epoll_event *event)
+{
+	size_t offset;
+	struct zvfs_epoll_item *item;
+
+	if (sys_bitarray_alloc(&items_bitarray, 1, &offset) < 0) {
+		return NULL;
+	}
+
+	item = &items[offset];
+	*item = (struct zvfs_epoll_item){
+		.ep = ep,
+		.event = *event,
+		.fd = fd,
+	};
+	k_work_poll_init(&item->work, zvfs_epoll_trigger);
+	sys_dlist_append(&ep->items, &item->node);
+
+	return item;
+}
+
+/* Called with ep->lock held. */
+static void zvfs_epoll_item_free(struct zvfs_epoll_item *item)
+{
+	int err;
+
+	zvfs_epoll_disarm(item);
+	sys_dlist_remove(&item->node);
+
+	err = sys_bitarray_free(&items_bitarray, 1, item - items);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+}
+
+static struct zvfs_epoll_item *zvfs_epoll_item_find(struct zvfs_epoll *ep, int fd)
+{
+	struct zvfs_epoll_item *item;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->items, item, node) {
+		if (item->fd == fd) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Report up to maxevents entries from the ready list. Only entries that were
+ * signalled since the previous call are visited, and each of them is checked
+ * again with a non-blocking poll, since the wakeup may be stale.
+ *
+ * Called with ep->lock held.
+ */
+static int zvfs_epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events,
+			      int maxevents)
+{
+	int n = 0;
+	sys_dnode_t *node;
+	sys_dlist_t pending;
+	k_spinlock_key_t key;
+
+	sys_dlist_init(&pending);
+
+	/* level-triggered entries are put back below, so work on a snapshot */
+	key = k_spin_lock(&ep->ready_lock);
+	while ((node = sys_dlist_get(&ep->ready)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+	k_spin_unlock(&ep->ready_lock, key);
+
+	while ((n < maxevents) && ((node = sys_dlist_get(&pending)) != NULL)) {
+		struct zvfs_epoll_item *item = CONTAINER_OF(node, struct zvfs_epoll_item, ready_node);
+		struct zvfs_pollfd pfd = {
+			.fd = item->fd,
+			.events = item->event.events & ZVFS_EPOLL_EVENTS_MASK,
+		};
+		uint32_t revents;
+
+		if ((pfd.events == 0) || (zvfs_poll_internal(&pfd, 1, K_NO_WAIT) < 0)) {
+			continue;
+		}
+
+		revents = pfd.revents & (pfd.events | ZVFS_EPOLLERR | ZVFS_EPOLLHUP);
+		if (revents == 0) {
+			/* stale wakeup, or already drained by the application */
+			(void)zvfs_epoll_arm(item);
+			continue;
+		}
+
+		events[n].events = revents;
+		events[n].data = item->event.data;
+		n++;
+
+		if ((item->event.events & ZVFS_EPOLLONESHOT) != 0) {
+			item->event.events &= ~ZVFS_EPOLL_EVENTS_MASK;
+		} else if ((item->event.events & ZVFS_EPOLLET) != 0) {
+			(void)zvfs_epoll_arm(item);
+		} else {
+			/* level-triggered, checked again by the next call */
+			zvfs_epoll_ready(item);
+		}
+	}
+
+	key = k_spin_lock(&ep->ready_lock);
+
+	/* entries that did not fit go first next time */
+	while ((node = sys_dlist_peek_tail(&pending)) != NULL) {
+		sys_dlist_remove(node);
+		sys_dlist_prepend(&ep->ready, node);
+	}
+
+	if (sys_dlist_is_empty(&ep->ready)) {
+		k_poll_signal_reset(&ep->ready_sig);
+	}
+
+	k_spin_unlock(&ep->ready_lock, key);
+
+	return n;
+}
+
+static ssize_t zvfs_epoll_read_op(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t zvfs_epoll_write_op(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	int err;
+	struct zvfs_epoll *ep = obj;
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll_item *next;
+
+	(void)k_mutex_lock(&eps_lock, K_FOREVER);
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, node) {
+		zvfs_epoll_item_free(item);
+	}
+
+	ep->in_use = false;
+
+	/* wake up any thread blocked in zvfs_epoll_wait() */
+	k_poll_signal_raise(&ep->ready_sig, 0);
+
+	k_mutex_unlock(&ep->lock);
+
+	err = sys_bitarray_free(&eps_bitarray, 1, ep - eps);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	k_mutex_unlock(&eps_lock);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	struct zvfs_epoll *ep = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zvfs_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zvfs_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if ((pfd->events & ZVFS_POLLIN) != 0) {
+			if (*pev == pev_end) {
+				return -ENOMEM;
+			}
+
+			k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+					  &ep->ready_sig);
+			(*pev)++;
+		}
+
+		return 0;
+	}
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zvfs_pollfd *pfd;
+		struct k_poll_event **pev;
+		k_spinlock_key_t key;
+
+		pfd = va_arg(args, struct zvfs_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if ((pfd->events & ZVFS_POLLIN) != 0) {
+			key = k_spin_lock(&ep->ready_lock);
+			if (!sys_dlist_is_empty(&ep->ready)) {
+				pfd->revents |= ZVFS_POLLIN;
+			}
+			k_spin_unlock(&ep->ready_lock, key);
+			(*pev)++;
+		}
+
+		return 0;
+	}
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.read = zvfs_epoll_read_op,
+	.write = zvfs_epoll_write_op,
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/* Called from zvfs_close() so that closed descriptors do not linger in interest lists. */
+void zvfs_epoll_remove_fd(int fd)
+{
+	struct zvfs_epoll_item *item;
+
+	(void)k_mutex_lock(&eps_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(eps, ep) {
+		if (!ep->in_use) {
+			continue;
+		}
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+		item = zvfs_epoll_item_find(ep, fd);
+		if (item != NULL) {
+			zvfs_epoll_item_free(item);
+		}
+		k_mutex_unlock(&ep->lock);
+	}
+
+	k_mutex_unlock(&eps_lock);
+}
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	int fd;
+	size_t offset;
+	struct zvfs_epoll *ep;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&eps_lock, K_FOREVER);
+
+	if (sys_bitarray_alloc(&eps_bitarray, 1, &offset) < 0) {
+		k_mutex_unlock(&eps_lock);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &eps[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&eps_bitarray, 1, offset);
+		k_mutex_unlock(&eps_lock);
+		return -1;
+	}
+
+	k_mutex_init(&ep->lock);
+	k_poll_signal_init(&ep->ready_sig);
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	ep->in_use = true;
+
+	k_mutex_unlock(&eps_lock);
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	int ret;
+	struct zvfs_epoll *ep;
+	struct zvfs_epoll_item *item;
+	const struct fd_op_vtable *vtable;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL) == NULL) {
+		return -1;
+	}
+
+	if ((op != ZVFS_EPOLL_CTL_DEL) && (event == NULL)) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	item = zvfs_epoll_item_find(ep, fd);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item = zvfs_epoll_item_alloc(ep, fd, event);
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		ret = zvfs_epoll_arm(item);
+		if (ret < 0) {
+			zvfs_epoll_item_free(item);
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_disarm(item);
+		item->event = *event;
+
+		ret = zvfs_epoll_arm(item);
+		if (ret < 0) {
+			/* keep the entry, but disabled */
+			item->event.events &= ~ZVFS_EPOLL_EVENTS_MASK;
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_item_free(item);
+		ret = 0;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents,
+		    k_timeout_t timeout)
+{
+	int ret;
+	struct zvfs_epoll *ep;
+	struct k_poll_event pev;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	if ((events == NULL) || (maxevents <= 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	while (true) {
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		if (!ep->in_use) {
+			k_mutex_unlock(&ep->lock);
+			errno = EBADF;
+			return -1;
+		}
+
+		ret = zvfs_epoll_collect(ep, events, maxevents);
+
+		k_mutex_unlock(&ep->lock);
+
+		if ((ret > 0) || sys_timepoint_expired(end)) {
+			return ret;
+		}
+
+		/* do not hold the lock while blocking, so that zvfs_epoll_ctl() can proceed */
+		k_poll_event_init(&pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+				  &ep->ready_sig);
+
+		ret = k_poll(&pev, 1, sys_timepoint_timeout(end));
+		if (ret == -EAGAIN) {
+			return 0;
+		}
+	}
+}
@@ -17,288 +17,75 @@
 
 #include <zephyr/data/json.h>
 
-struct json_obj_key_value {
-	const char *key;
-	size_t key_len;
-	struct json_token value;
+/* Decoder states of the object or array being decoded */
+enum json_stream_state {
+	/* Closing brace, comma or key */
+	STREAM_OBJ_NEXT,
+	/* Key, after a comma */
+	STREAM_OBJ_KEY,
+	STREAM_OBJ_COLON,
+	STREAM_OBJ_VALUE,
+	/* Closing bracket, comma or value */
+	STREAM_ARR_NEXT,
+	/* Value, after a comma */
+	STREAM_ARR_VALUE,
 };
 
-static bool lexer_consume(struct json_lexer *lex, struct json_token *tok,
-			  enum json_tokens empty_token)
-{
-	if (lex->tok.type == empty_token) {
-		return false;
-	}
-
-	*tok = lex->tok;
-	lex->tok.type = empty_token;
-
-	return true;
-}
-
-static bool lexer_next(struct json_lexer *lex, struct json_token *tok)
-{
-	while (lex->state) {
-		if (lexer_consume(lex, tok, JSON_TOK_NONE)) {
-			return true;
-		}
-
-		lex->state = lex->state(lex);
-	}
-
-	return lexer_consume(lex, tok, JSON_TOK_EOF);
-}
-
-static void *lexer_json(struct json_lexer *lex);
-
-static void emit(struct json_lexer *lex, enum json_tokens token)
-{
-	lex->tok.type = token;
-	lex->tok.start = lex->start;
-	lex->tok.end = lex->pos;
-	lex->start = lex->pos;
-}
-
-static int next(struct json_lexer *lex)
-{
-	if (lex->pos >= lex->end) {
-		lex->pos = lex->end + 1;
-
-		return '\0';
-	}
-
-	return *lex->pos++;
-}
-
-static void ignore(struct json_lexer *lex)
-{
-	lex->start = lex->pos;
-}
-
-static void backup(struct json_lexer *lex)
-{
-	lex->pos--;
-}
-
-static int peek(struct json_lexer *lex)
-{
-	int chr = next(lex);
-
-	backup(lex);
-
-	return chr;
-}
-
-static void *lexer_string(struct json_lexer *lex)
-{
-	ignore(lex);
-
-	while (true) {
-		int chr = next(lex);
-
-		if (chr == '\0') {
-			emit(lex, JSON_TOK_ERROR);
-			return NULL;
-		}
-
-		if (chr == '\\') {
-			switch (next(lex)) {
-			case '"':
-			case '\\':
-			case '/':
-			case 'b':
-			case 'f':
-			case 'n':
-			case 'r':
-			case 't':
-				continue;
-			case 'u':
-				if (isxdigit(next(lex)) == 0) {
-					goto error;
-				}
-
-				if (isxdigit(next(lex)) == 0) {
-					goto error;
-				}
-
-				if (isxdigit(next(lex)) == 0) {
-					goto error;
-				}
-
-				if (isxdigit(next(lex)) == 0) {
-					goto error;
-				}
-
-				break;
-			default:
-				goto error;
-			}
-		}
-
-		if (chr == '"') {
-			backup(lex);
-			emit(lex, JSON_TOK_STRING);
-
-			next(lex);
-			ignore(lex);
-
-			return lexer_json;
-		}
-	}
-
-error:
-	emit(lex, JSON_TOK_ERROR);
-	return NULL;
-}
-
-static int accept_run(struct json_lexer *lex, const char *run)
-{
-	for (; *run; run++) {
-		if (next(lex) != *run) {
-			return -EINVAL;
-		}
-	}
-
-	return 0;
-}
-
-static void *lexer_boolean(struct json_lexer *lex)
-{
-	backup(lex);
-
-	switch (next(lex)) {
-	case 't':
-		if (!accept_run(lex, "rue")) {
-			emit(lex, JSON_TOK_TRUE);
-			return lexer_json;
-		}
-		break;
-	case 'f':
-		if (!accept_run(lex, "alse")) {
-			emit(lex, JSON_TOK_FALSE);
-			return lexer_json;
-		}
-		break;
-	}
+/* Scanner states within a string: plain characters, the character after a
+ * backslash, or the remaining hex digits of a \u escape plus one.
+ */
+#define STRING_PLAIN  0
+#define STRING_ESCAPE 1
+#define STRING_HEX(n) (1 + (n))
 
-	emit(lex, JSON_TOK_ERROR);
-	return NULL;
-}
+/* Scanner state of a number whose leading minus sign has just been read */
+#define NUMBER_SIGN 1
 
-static void *lexer_null(struct json_lexer *lex)
-{
-	if (accept_run(lex, "ull") < 0) {
-		emit(lex, JSON_TOK_ERROR);
-		return NULL;
-	}
+/* Strings are scanned a machine word at a time, looking for any byte that
+ * is a quote, a backslash or a NUL: (w - 0x01..01) & ~w & 0x80..80 is
+ * non-zero if and only if one of the bytes of w is zero.
+ */
+typedef uintptr_t json_word_t;
 
-	emit(lex, JSON_TOK_NULL);
-	return lexer_json;
-}
+#define WORD_ONES     ((json_word_t)-1 / 0xff)
+#define WORD_HIGHS    (WORD_ONES * 0x80)
+#define WORD_QUOTES   (WORD_ONES * '"')
+#define WORD_BSLASHES (WORD_ONES * '\\')
 
-static void *lexer_number(struct json_lexer *lex)
+static inline json_word_t word_has_zero(json_word_t w)
 {
-	while (true) {
-		int chr = next(lex);
-
-		if (isdigit(chr) != 0 || chr == '.') {
-			continue;
-		}
-
-		backup(lex);
-		emit(lex, JSON_TOK_NUMBER);
-
-		return lexer_json;
-	}
+	return (w - WORD_ONES) & ~w & WORD_HIGHS;
 }
 
-static void *lexer_json(struct json_lexer *lex)
+static char *find_string_special(char *pos, char *end)
 {
-	while (true) {
-		int chr = next(lex);
-
-		switch (chr) {
-		case '\0':
-			emit(lex, JSON_TOK_EOF);
-			return NULL;
-		case '}':
-		case '{':
-		case '[':
-		case ']':
-		case ',':
-		case ':':
-			emit(lex, (enum json_tokens)chr);
-			return lexer_json;
-		case '"':
-			return lexer_string;
-		case 'n':
-			return lexer_null;
-		case 't':
-		case 'f':
-			return lexer_boolean;
-		case '-':
-			if (isdigit(peek(lex)) != 0) {
-				return lexer_number;
-			}
-
-			__fallthrough;
-		default:
-			if (isspace(chr) != 0) {
-				ignore(lex);
-				continue;
-			}
+	json_word_t w;
 
-			if (isdigit(chr) != 0) {
-				return lexer_number;
-			}
+	while ((size_t)(end - pos) >= sizeof(w)) {
+		memcpy(&w, pos, sizeof(w));
 
-			emit(lex, JSON_TOK_ERROR);
-			return NULL;
+		if (word_has_zero(w ^ WORD_QUOTES) | word_has_zero(w ^ WORD_BSLASHES) |
+		    word_has_zero(w)) {
+			break;
 		}
-	}
-}
-
-static void lexer_init(struct json_lexer *lex, char *data, size_t len)
-{
-	lex->state = lexer_json;
-	lex->start = data;
-	lex->pos = data;
-	lex->end = data + len;
-	lex->tok.type = JSON_TOK_NONE;
-}
-
-static int obj_init(struct json_obj *json, char *data, size_t len)
-{
-	struct json_token tok;
 
-	lexer_init(&json->lex, data, len);
-
-	if (!lexer_next(&json->lex, &tok)) {
-		return -EINVAL;
+		pos += sizeof(w);
 	}
 
-	if (tok.type != JSON_TOK_OBJECT_START) {
-		return -EINVAL;
+	while (pos < end && *pos != '"' && *pos != '\\' && *pos != '\0') {
+		pos++;
 	}
 
-	return 0;
+	return pos;
 }
 
-static int arr_init(struct json_obj *json, char *data, size_t len)
+static char *skip_space(char *pos, char *end)
 {
-	struct json_token tok;
-
-	lexer_init(&json->lex, data, len);
-
-	if (!lexer_next(&json->lex, &tok)) {
-		return -EINVAL;
-	}
-
-	if (tok.type != JSON_TOK_ARRAY_START) {
-		return -EINVAL;
+	while (pos < end && isspace((unsigned char)*pos) != 0) {
+		pos++;
 	}
 
-	return 0;
+	return pos;
 }
 
 static int element_token(enum json_tokens token)
@@ -321,104 +108,6 @@ static int element_token(enum json_tokens token)
 	}
 }
 
-static int obj_next(struct json_obj *json,
-		    struct json_obj_key_value *kv)
-{
-	struct json_token tok;
-
-	if (!lexer_next(&json->lex, &tok)) {
-		return -EINVAL;
-	}
-
-	/* Match end of object or next key */
-	switch (tok.type) {
-	case JSON_TOK_OBJECT_END:
-		kv->key = NULL;
-		kv->key_len = 0;
-		kv->value = tok;
-
-		return 0;
-	case JSON_TOK_COMMA:
-		if (!lexer_next(&json->lex, &tok)) {
-			return -EINVAL;
-		}
-
-		if (tok.type != JSON_TOK_STRING) {
-			return -EINVAL;
-		}
-
-		__fallthrough;
-	case JSON_TOK_STRING:
-		kv->key = tok.start;
-		kv->key_len = (size_t)(tok.end - tok.start);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	/* Match : after key */
-	if (!lexer_next(&json->lex, &tok)) {
-		return -EINVAL;
-	}
-
-	if (tok.type != JSON_TOK_COLON) {
-		return -EINVAL;
-	}
-
-	/* Match value */
-	if (!lexer_next(&json->lex, &kv->value)) {
-		return -EINVAL;
-	}
-
-	return element_token(kv->value.type);
-}
-
-static int arr_next(struct json_obj *json, struct json_token *value)
-{
-	if (!lexer_next(&json->lex, value)) {
-		return -EINVAL;
-	}
-
-	if (value->type == JSON_TOK_ARRAY_END) {
-		return 0;
-	}
-
-	if (value->type == JSON_TOK_COMMA) {
-		if (!lexer_next(&json->lex, value)) {
-			return -EINVAL;
-		}
-	}
-
-	return element_token(value->type);
-}
-
-static int skip_field(struct json_obj *obj, struct json_obj_key_value *kv)
-{
-	int field_count = 1;
-
-	if (kv->value.type == JSON_TOK_OBJECT_START ||
-	    kv->value.type == JSON_TOK_ARRAY_START) {
-		while (field_count > 0 && lexer_next(&obj->lex, &kv->value)) {
-			switch (kv->value.type) {
-			case JSON_TOK_OBJECT_START:
-			case JSON_TOK_ARRAY_START:
-				field_count++;
-				break;
-			case JSON_TOK_OBJECT_END:
-			case JSON_TOK_ARRAY_END:
-				field_count--;
-				break;
-			case JSON_TOK_ERROR:
-				return -EINVAL;
-			default:
-				break;
-			}
-		}
-	}
-
-	return 0;
-}
-
 static int decode_num(const struct json_token *token, int32_t *num)
 {
 	/* FIXME: strtod() is not available in newlib/minimal libc,
@@ -523,83 +212,6 @@ static bool equivalent_types(enum json_tokens type1, enum json_tokens type2)
 	return type1 == type2;
 }
 
-static int64_t obj_parse(struct json_obj *obj,
-			 const struct json_obj_descr *descr, size_t descr_len,
-			 void *val);
-static int arr_parse(struct json_obj *obj,
-		     const struct json_obj_descr *elem_descr,
-		     size_t max_elements, void *field, void *val);
-
-static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val);
-
-static int64_t decode_value(struct json_obj *obj,
-			    const struct json_obj_descr *descr,
-			    struct json_token *value, void *field, void *val)
-{
-
-	if (!equivalent_types(value->type, descr->type)) {
-		return -EINVAL;
-	}
-
-	switch (descr->type) {
-	case JSON_TOK_OBJECT_START:
-		return obj_parse(obj, descr->object.sub_descr,
-				 descr->object.sub_descr_len,
-				 field);
-	case JSON_TOK_ARRAY_START:
-		return arr_parse(obj, descr->array.element_descr,
-				 descr->array.n_elements, field, val);
-	case JSON_TOK_OBJ_ARRAY: {
-		struct json_obj_token *obj_token = field;
-
-		obj_token->start = value->start;
-		return arr_data_parse(obj, obj_token);
-	}
-
-	case JSON_TOK_FALSE:
-	case JSON_TOK_TRUE: {
-		bool *v = field;
-
-		*v = value->type == JSON_TOK_TRUE;
-
-		return 0;
-	}
-	case JSON_TOK_NUMBER: {
-		int32_t *num = field;
-
-		return decode_num(value, num);
-	}
-	case JSON_TOK_INT64: {
-		int64_t *num = field;
-
-		return decode_int64(value, num);
-	}
-	case JSON_TOK_UINT64: {
-		uint64_t *num = field;
-
-		return decode_uint64(value, num);
-	}
-	case JSON_TOK_OPAQUE:
-	case JSON_TOK_FLOAT: {
-		struct json_obj_token *obj_token = field;
-
-		obj_token->start = value->start;
-		obj_token->length = value->end - value->start;
-		return 0;
-	}
-	case JSON_TOK_STRING: {
-		char **str = field;
-
-		*value->end = '\0';
-		*str = value->start;
-
-		return 0;
-	}
-	default:
-		return -EINVAL;
-	}
-}
-
 static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
 {
 	switch (descr->type) {
@@ -649,213 +261,811 @@ static ptrdiff_t get_elem_size(const struct json_obj_descr *descr)
 	}
 }
 
-static int arr_parse(struct json_obj *obj,
-		     const struct json_obj_descr *elem_descr,
-		     size_t max_elements, void *field, void *val)
+/* Append to the token or captured array being stored in the scratch buffer,
+ * keeping room for its NUL terminator.
+ */
+static int stream_store(struct json_stream *stream, size_t *len, const char *data,
+			size_t n)
 {
-	void *value = val;
-	size_t *elements = (size_t *)((char *)value + elem_descr->offset);
-	ptrdiff_t elem_size;
-	void *last_elem;
-	struct json_token tok;
-
-	/* For nested arrays, skip parent descriptor to get elements */
-	if (elem_descr->type == JSON_TOK_ARRAY_START) {
-		elem_descr = elem_descr->array.element_descr;
+	if (n == 0) {
+		return 0;
 	}
 
-	*elements = 0;
-	elem_size = get_elem_size(elem_descr);
-	last_elem = (char *)field + elem_size * max_elements;
+	if (stream->buf_size - stream->buf_used - *len <= n) {
+		return -ENOMEM;
+	}
 
-	__ASSERT_NO_MSG(elem_size > 0);
+	memcpy(stream->buf + stream->buf_used + *len, data, n);
+	*len += n;
 
-	while (!arr_next(obj, &tok)) {
-		if (tok.type == JSON_TOK_ARRAY_END) {
-			return 0;
-		}
+	return 0;
+}
 
-		if (field == last_elem) {
-			return -ENOSPC;
+static int stream_take(struct json_stream *stream, const char *from, const char *to)
+{
+	if (!stream->tok_store) {
+		return 0;
+	}
+
+	return stream_store(stream, &stream->tok_len, from, to - from);
+}
+
+/* Keep a decoded value in the scratch buffer */
+static void stream_keep(struct json_stream *stream, const struct json_token *value)
+{
+	if (stream->buf != NULL) {
+		*value->end = '\0';
+		stream->buf_used += value->end - value->start + 1;
+	}
+}
+
+static int stream_push_obj(struct json_stream *stream, const struct json_obj_descr *descr,
+			   size_t descr_len, void *val)
+{
+	struct json_stream_frame *frame;
+
+	if (stream->depth == ARRAY_SIZE(stream->stack)) {
+		return -ENOMEM;
+	}
+
+	frame = &stream->stack[stream->depth++];
+	frame->type = JSON_TOK_OBJECT_START;
+	frame->state = STREAM_OBJ_NEXT;
+	frame->descr = descr;
+	frame->val = val;
+	frame->obj.descr_len = descr_len;
+	frame->obj.decoded = 0;
+	frame->obj.field = -1;
+
+	return 0;
+}
+
+static int stream_push_arr(struct json_stream *stream, const struct json_obj_descr *elem_descr,
+			   size_t max_elements, void *field, void *val)
+{
+	size_t *elements = (size_t *)((char *)val + elem_descr->offset);
+	struct json_stream_frame *frame;
+	ptrdiff_t elem_size;
+
+	if (stream->depth == ARRAY_SIZE(stream->stack)) {
+		return -ENOMEM;
+	}
+
+	/* For nested arrays, skip parent descriptor to get elements */
+	if (elem_descr->type == JSON_TOK_ARRAY_START) {
+		elem_descr = elem_descr->array.element_descr;
+	}
+
+	*elements = 0;
+	elem_size = get_elem_size(elem_descr);
+
+	__ASSERT_NO_MSG(elem_size > 0);
+
+	frame = &stream->stack[stream->depth++];
+	frame->type = JSON_TOK_ARRAY_START;
+	frame->state = STREAM_ARR_NEXT;
+	frame->descr = elem_descr;
+	frame->val = val;
+	frame->arr.field = field;
+	frame->arr.last = (char *)field + elem_size * max_elements;
+	frame->arr.count = elements;
+	frame->arr.elem_size = elem_size;
+
+	return 0;
+}
+
+static int stream_pop(struct json_stream *stream)
+{
+	struct json_stream_frame *frame = &stream->stack[--stream->depth];
+
+	if (stream->depth == 0) {
+		stream->result = frame->type == JSON_TOK_OBJECT_START ? frame->obj.decoded : 0;
+	}
+
+	return 0;
+}
+
+/* Skip an array, keeping its text whole */
+static void stream_capture(struct json_stream *stream, struct json_obj_token *obj_token,
+			   const struct json_token *value)
+{
+	stream->capture = obj_token;
+	stream->capture_start = value->start;
+	stream->capture_len = 0;
+	stream->skip_depth = 1;
+}
+
+static int stream_capture_end(struct json_stream *stream, const struct json_token *value)
+{
+	struct json_obj_token *obj_token = stream->capture;
+	int ret;
+
+	stream->capture = NULL;
+
+	if (stream->buf == NULL) {
+		obj_token->start = stream->capture_start;
+		obj_token->length = value->end - stream->capture_start;
+
+		return 0;
+	}
+
+	ret = stream_store(stream, &stream->capture_len, stream->capture_start,
+			   value->end - stream->capture_start);
+	if (ret < 0) {
+		return ret;
+	}
+
+	obj_token->start = stream->buf + stream->buf_used;
+	obj_token->length = stream->capture_len;
+	obj_token->start[obj_token->length] = '\0';
+	stream->buf_used += stream->capture_len + 1;
+
+	return 0;
+}
+
+static int decode_value(struct json_stream *stream, const struct json_obj_descr *descr,
+			const struct json_token *value, void *field, void *val)
+{
+	if (!equivalent_types(value->type, descr->type)) {
+		return -EINVAL;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_OBJECT_START:
+		return stream_push_obj(stream, descr->object.sub_descr,
+				       descr->object.sub_descr_len, field);
+	case JSON_TOK_ARRAY_START:
+		return stream_push_arr(stream, descr->array.element_descr,
+				       descr->array.n_elements, field, val);
+	case JSON_TOK_OBJ_ARRAY:
+		stream_capture(stream, field, value);
+		return 0;
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE: {
+		bool *v = field;
+
+		*v = value->type == JSON_TOK_TRUE;
+
+		return 0;
+	}
+	case JSON_TOK_NUMBER: {
+		int32_t *num = field;
+
+		return decode_num(value, num);
+	}
+	case JSON_TOK_INT64: {
+		int64_t *num = field;
+
+		return decode_int64(value, num);
+	}
+	case JSON_TOK_UINT64: {
+		uint64_t *num = field;
+
+		return decode_uint64(value, num);
+	}
+	case JSON_TOK_OPAQUE:
+	case JSON_TOK_FLOAT: {
+		struct json_obj_token *obj_token = field;
+
+		obj_token->start = value->start;
+		obj_token->length = value->end - value->start;
+		stream_keep(stream, value);
+
+		return 0;
+	}
+	case JSON_TOK_STRING: {
+		char **str = field;
+
+		*value->end = '\0';
+		*str = value->start;
+		stream_keep(stream, value);
+
+		return 0;
+	}
+	default:
+		return -EINVAL;
+	}
+}
+
+static int obj_field(const struct json_stream_frame *frame, const struct json_token *key)
+{
+	size_t key_len = key->end - key->start;
+
+	for (size_t i = 0; i < frame->obj.descr_len; i++) {
+		/* Field has been decoded already, skip */
+		if (frame->obj.decoded & ((int64_t)1 << i)) {
+			continue;
 		}
 
-		/* For nested arrays, update value to current field,
-		 * so it matches descriptor's offset to length field
-		 */
-		if (elem_descr->type == JSON_TOK_ARRAY_START) {
-			value = field;
+		if (key_len == frame->descr[i].field_name_len &&
+		    memcmp(key->start, frame->descr[i].field_name, key_len) == 0) {
+			return i;
 		}
+	}
 
-		if (decode_value(obj, elem_descr, &tok, field, value) < 0) {
-			return -EINVAL;
+	return -1;
+}
+
+static int obj_value(struct json_stream *stream, struct json_stream_frame *frame,
+		     const struct json_token *value)
+{
+	const struct json_obj_descr *descr;
+	int ret;
+
+	/* Skip field, if no descriptor was found */
+	if (frame->obj.field < 0) {
+		if (value->type == JSON_TOK_OBJECT_START || value->type == JSON_TOK_ARRAY_START) {
+			stream->skip_depth = 1;
 		}
 
-		(*elements)++;
-		field = (char *)field + elem_size;
+		return 0;
+	}
+
+	descr = &frame->descr[frame->obj.field];
+
+	ret = decode_value(stream, descr, value, (char *)frame->val + descr->offset, frame->val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	frame->obj.decoded |= (int64_t)1 << frame->obj.field;
+
+	return 0;
+}
+
+static int arr_value(struct json_stream *stream, struct json_stream_frame *frame,
+		     const struct json_token *value)
+{
+	char *field = frame->arr.field;
+	void *val = frame->val;
+	int ret;
+
+	if (field == frame->arr.last) {
+		return -ENOSPC;
+	}
+
+	/* For nested arrays, update value to current field,
+	 * so it matches descriptor's offset to length field
+	 */
+	if (frame->descr->type == JSON_TOK_ARRAY_START) {
+		val = field;
 	}
 
-	return -EINVAL;
+	frame->arr.field += frame->arr.elem_size;
+	(*frame->arr.count)++;
+
+	ret = decode_value(stream, frame->descr, value, field, val);
+	if (ret < 0 && ret != -ENOMEM) {
+		return -EINVAL;
+	}
+
+	return ret;
 }
 
-static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
+static int frame_token(struct json_stream *stream, struct json_stream_frame *frame,
+		       const struct json_token *tok)
 {
-	bool string_state = false;
-	int array_in_array = 1;
+	switch (frame->state) {
+	case STREAM_OBJ_NEXT:
+		if (tok->type == JSON_TOK_OBJECT_END) {
+			return stream_pop(stream);
+		}
 
-	/* Init length to zero */
-	val->length = 0;
+		if (tok->type == JSON_TOK_COMMA) {
+			frame->state = STREAM_OBJ_KEY;
+			return 0;
+		}
 
-	while (obj->lex.pos != obj->lex.end) {
-		if (string_state) {
-			if (*obj->lex.pos == JSON_TOK_STRING) {
-				string_state = false;
+		__fallthrough;
+	case STREAM_OBJ_KEY:
+		if (tok->type != JSON_TOK_STRING) {
+			return -EINVAL;
+		}
+
+		frame->obj.field = obj_field(frame, tok);
+		frame->state = STREAM_OBJ_COLON;
+
+		return 0;
+	case STREAM_OBJ_COLON:
+		if (tok->type != JSON_TOK_COLON) {
+			return -EINVAL;
+		}
+
+		frame->state = STREAM_OBJ_VALUE;
+
+		return 0;
+	case STREAM_OBJ_VALUE:
+		frame->state = STREAM_OBJ_NEXT;
+
+		if (element_token(tok->type) < 0) {
+			return -EINVAL;
+		}
+
+		return obj_value(stream, frame, tok);
+	case STREAM_ARR_NEXT:
+		if (tok->type == JSON_TOK_ARRAY_END) {
+			return stream_pop(stream);
+		}
+
+		if (tok->type == JSON_TOK_COMMA) {
+			frame->state = STREAM_ARR_VALUE;
+			return 0;
+		}
+
+		__fallthrough;
+	case STREAM_ARR_VALUE:
+		frame->state = STREAM_ARR_NEXT;
+
+		if (element_token(tok->type) < 0) {
+			return -EINVAL;
+		}
+
+		return arr_value(stream, frame, tok);
+	default:
+		return -EINVAL;
+	}
+}
+
+static int stream_token(struct json_stream *stream, const struct json_token *tok)
+{
+	struct json_stream_frame *root = &stream->stack[0];
+	size_t top;
+	int ret;
+
+	if (stream->skip_depth > 0) {
+		switch (tok->type) {
+		case JSON_TOK_OBJECT_START:
+		case JSON_TOK_ARRAY_START:
+			stream->skip_depth++;
+			break;
+		case JSON_TOK_OBJECT_END:
+		case JSON_TOK_ARRAY_END:
+			if (--stream->skip_depth == 0 && stream->capture != NULL) {
+				return stream_capture_end(stream, tok);
 			}
-		} else {
-			if (*obj->lex.pos == JSON_TOK_ARRAY_END) {
-				array_in_array--;
-				if (array_in_array == 0) {
-					/* Set array data length + 1 object end */
-					val->length = obj->lex.pos - val->start + 1;
-					/* Init Lexer that Object Parse can be finished properly */
-					obj->lex.state = lexer_json;
-					/* Move position to before array end */
-					obj->lex.pos--;
-					obj->lex.tok.end = obj->lex.pos;
-					obj->lex.tok.start = val->start;
-					obj->lex.tok.type = JSON_TOK_NONE;
-					return 0;
-				}
-			} else if (*obj->lex.pos == JSON_TOK_STRING) {
-				string_state = true;
-			} else if (*obj->lex.pos == JSON_TOK_ARRAY_START) {
-				/* array in array update structure count */
-				array_in_array++;
+			break;
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
+	if (stream->depth == 0) {
+		if (tok->type != stream->root) {
+			return -EINVAL;
+		}
+
+		if (stream->root == JSON_TOK_OBJECT_START) {
+			return stream_push_obj(stream, root->descr, root->obj.descr_len, root->val);
+		}
+
+		return stream_push_arr(stream, root->descr->array.element_descr,
+				       root->descr->array.n_elements,
+				       (char *)root->val + root->descr->offset, root->val);
+	}
+
+	top = stream->depth - 1;
+	ret = frame_token(stream, &stream->stack[top], tok);
+
+	/* Failures to decode an array element are reported as invalid input */
+	if (ret < 0 && ret != -EINVAL && ret != -ENOMEM) {
+		for (size_t i = 0; i < top; i++) {
+			if (stream->stack[i].type == JSON_TOK_ARRAY_START) {
+				return -EINVAL;
 			}
 		}
-		obj->lex.pos++;
 	}
 
-	return -EINVAL;
+	return ret;
 }
 
-static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
-			 size_t descr_len, void *val)
+/* Whether the value starting now is decoded, rather than skipped */
+static bool stream_decoding(const struct json_stream *stream)
 {
-	struct json_obj_key_value kv;
-	int64_t decoded_fields = 0;
-	size_t i;
-	int ret;
+	const struct json_stream_frame *frame;
+
+	if (stream->skip_depth > 0) {
+		return false;
+	}
+
+	if (stream->depth == 0) {
+		return true;
+	}
 
-	while (!obj_next(obj, &kv)) {
-		if (kv.value.type == JSON_TOK_OBJECT_END) {
-			return decoded_fields;
+	frame = &stream->stack[stream->depth - 1];
+
+	return frame->state != STREAM_OBJ_VALUE || frame->obj.field >= 0;
+}
+
+static void stream_begin(struct json_stream *stream, enum json_tokens type, char *start)
+{
+	stream->tok = type;
+	stream->tok_state = 0;
+	stream->tok_start = start;
+	stream->tok_len = 0;
+	stream->tok_store = stream->buf != NULL && stream_decoding(stream);
+}
+
+/* Hand the token just scanned, ending at end, over to the decoder */
+static int stream_complete(struct json_stream *stream, char *end)
+{
+	struct json_token tok = {
+		.type = stream->tok,
+		.start = stream->tok_start,
+		.end = end,
+	};
+
+	stream->tok = JSON_TOK_NONE;
+
+	if (stream->buf != NULL) {
+		if (stream->tok_store && stream->buf_used + stream->tok_len >= stream->buf_size) {
+			return -ENOMEM;
 		}
 
-		for (i = 0; i < descr_len; i++) {
-			void *decode_field = (char *)val + descr[i].offset;
+		tok.start = stream->buf + stream->buf_used;
+		tok.end = tok.start + stream->tok_len;
+	}
+
+	return stream_token(stream, &tok);
+}
+
+static int scan_string(struct json_stream *stream, char **pos, char *end)
+{
+	char *start = *pos;
+	char *p = start;
+	int ret;
 
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
+	while (p < end) {
+		if (stream->tok_state == STRING_PLAIN) {
+			p = find_string_special(p, end);
+			if (p == end) {
+				break;
 			}
 
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
+			if (*p == '"') {
+				ret = stream_take(stream, start, p);
+				if (ret < 0) {
+					return ret;
+				}
+
+				*pos = p + 1;
+
+				return stream_complete(stream, p);
 			}
 
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
+			if (*p == '\0') {
+				return -EINVAL;
 			}
 
-			/* Store the decoded value */
-			ret = decode_value(obj, &descr[i], &kv.value,
-					   decode_field, val);
-			if (ret < 0) {
-				return ret;
+			stream->tok_state = STRING_ESCAPE;
+		} else if (stream->tok_state == STRING_ESCAPE) {
+			switch (*p) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				stream->tok_state = STRING_PLAIN;
+				break;
+			case 'u':
+				stream->tok_state = STRING_HEX(4);
+				break;
+			default:
+				return -EINVAL;
+			}
+		} else {
+			if (isxdigit((unsigned char)*p) == 0) {
+				return -EINVAL;
 			}
 
-			decoded_fields |= (int64_t)1<<i;
-			break;
+			stream->tok_state = stream->tok_state == STRING_HEX(1) ?
+					    STRING_PLAIN : stream->tok_state - 1;
 		}
 
-		/* Skip field, if no descriptor was found */
-		if (i >= descr_len) {
-			ret = skip_field(obj, &kv);
-			if (ret < 0) {
-				return ret;
-			}
+		p++;
+	}
+
+	*pos = p;
+
+	return stream_take(stream, start, p);
+}
+
+static int scan_number(struct json_stream *stream, char **pos, char *end)
+{
+	char *start = *pos;
+	char *p = start;
+	int ret;
+
+	if (stream->tok_state == NUMBER_SIGN) {
+		if (isdigit((unsigned char)*p) == 0) {
+			return -EINVAL;
+		}
+
+		stream->tok_state = 0;
+	}
+
+	while (p < end && (isdigit((unsigned char)*p) != 0 || *p == '.')) {
+		p++;
+	}
+
+	ret = stream_take(stream, start, p);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*pos = p;
+
+	if (p == end) {
+		return 0;
+	}
+
+	return stream_complete(stream, p);
+}
+
+static int scan_literal(struct json_stream *stream, char **pos, char *end)
+{
+	const char *literal;
+	char *p = *pos;
+
+	switch (stream->tok) {
+	case JSON_TOK_TRUE:
+		literal = "true";
+		break;
+	case JSON_TOK_FALSE:
+		literal = "false";
+		break;
+	default:
+		literal = "null";
+		break;
+	}
+
+	for (; p < end && literal[stream->tok_state] != '\0'; p++) {
+		if (*p != literal[stream->tok_state]) {
+			return -EINVAL;
 		}
+
+		stream->tok_state++;
+	}
+
+	*pos = p;
+
+	if (literal[stream->tok_state] != '\0') {
+		return 0;
+	}
+
+	return stream_complete(stream, p);
+}
+
+static int scan_token(struct json_stream *stream, char **pos, char *end)
+{
+	switch (stream->tok) {
+	case JSON_TOK_STRING:
+		return scan_string(stream, pos, end);
+	case JSON_TOK_NUMBER:
+		return scan_number(stream, pos, end);
+	default:
+		return scan_literal(stream, pos, end);
+	}
+}
+
+static int scan_next(struct json_stream *stream, char **pos, char *end)
+{
+	char *p = *pos;
+	struct json_token tok = {
+		.type = (enum json_tokens)*p,
+		.start = p,
+		.end = p + 1,
+	};
+
+	switch (*p) {
+	case '}':
+	case '{':
+	case '[':
+	case ']':
+	case ',':
+	case ':':
+		*pos = p + 1;
+		return stream_token(stream, &tok);
+	case '"':
+		stream_begin(stream, JSON_TOK_STRING, p + 1);
+		*pos = p + 1;
+		return 0;
+	case 'n':
+	case 't':
+	case 'f':
+		stream_begin(stream, (enum json_tokens)*p, p);
+		return 0;
+	case '-':
+		stream_begin(stream, JSON_TOK_NUMBER, p);
+		stream->tok_state = NUMBER_SIGN;
+		*pos = p + 1;
+		return stream_take(stream, p, p + 1);
+	default:
+		if (isspace((unsigned char)*p) != 0) {
+			*pos = skip_space(p, end);
+			return 0;
+		}
+
+		if (isdigit((unsigned char)*p) != 0) {
+			stream_begin(stream, JSON_TOK_NUMBER, p);
+			return 0;
+		}
+
+		return -EINVAL;
+	}
+}
+
+static int64_t stream_feed(struct json_stream *stream, char *data, size_t len,
+			   size_t *consumed)
+{
+	char *pos = data;
+	char *end = data + len;
+	int ret = 0;
+
+	/* Captured arrays are copied to the scratch buffer chunk by chunk */
+	if (stream->capture != NULL && stream->buf != NULL) {
+		stream->capture_start = data;
+	}
+
+	while (ret == 0 && pos < end && stream->result == -EAGAIN) {
+		if (stream->tok == JSON_TOK_NONE) {
+			ret = scan_next(stream, &pos, end);
+		} else {
+			ret = scan_token(stream, &pos, end);
+		}
+	}
+
+	if (ret == 0 && stream->capture != NULL && stream->buf != NULL) {
+		ret = stream_store(stream, &stream->capture_len, stream->capture_start,
+				   pos - stream->capture_start);
+	}
+
+	if (ret < 0 && stream->result == -EAGAIN) {
+		stream->result = ret;
 	}
 
-	return -EINVAL;
+	if (consumed != NULL) {
+		*consumed = pos - data;
+	}
+
+	return stream->result;
+}
+
+static void stream_init(struct json_stream *stream, enum json_tokens root,
+			const struct json_obj_descr *descr, size_t descr_len, void *val,
+			char *buf, size_t buf_size)
+{
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+	stream->buf_used = 0;
+	stream->tok = JSON_TOK_NONE;
+	stream->skip_depth = 0;
+	stream->capture = NULL;
+	stream->root = root;
+	stream->result = -EAGAIN;
+	stream->depth = 0;
+
+	/* The top-level frame is set up once its opening token is read */
+	stream->stack[0].descr = descr;
+	stream->stack[0].val = val;
+	stream->stack[0].obj.descr_len = descr_len;
+}
+
+int json_stream_obj_init(struct json_stream *stream, const struct json_obj_descr *descr,
+			 size_t descr_len, void *val, char *buf, size_t buf_size)
+{
+	if (buf == NULL || descr_len >= (sizeof(int64_t) * CHAR_BIT - 1)) {
+		return -EINVAL;
+	}
+
+	stream_init(stream, JSON_TOK_OBJECT_START, descr, descr_len, val, buf, buf_size);
+
+	return 0;
 }
 
+int json_stream_arr_init(struct json_stream *stream, const struct json_obj_descr *descr,
+			 void *val, char *buf, size_t buf_size)
+{
+	if (buf == NULL) {
+		return -EINVAL;
+	}
+
+	stream_init(stream, JSON_TOK_ARRAY_START, descr, 0, val, buf, buf_size);
+
+	return 0;
+}
+
+int64_t json_stream_feed(struct json_stream *stream, const char *data, size_t len)
+{
+	/* Nothing is written to the data when there is a scratch buffer */
+	return stream_feed(stream, (char *)data, len, NULL);
+}
+
+/* The whole-buffer parsers decode in place, without a scratch buffer: strings
+ * are NUL-terminated and tokens point into the payload.
+ */
 int64_t json_obj_parse(char *payload, size_t len,
 		       const struct json_obj_descr *descr, size_t descr_len,
 		       void *val)
 {
-	struct json_obj obj;
+	struct json_stream stream;
 	int64_t ret;
 
 	__ASSERT_NO_MSG(descr_len < (sizeof(ret) * CHAR_BIT - 1));
 
-	ret = obj_init(&obj, payload, len);
-	if (ret < 0) {
-		return ret;
-	}
+	stream_init(&stream, JSON_TOK_OBJECT_START, descr, descr_len, val, NULL, 0);
+	ret = stream_feed(&stream, payload, len, NULL);
 
-	return obj_parse(&obj, descr, descr_len, val);
+	return ret == -EAGAIN ? -EINVAL : ret;
 }
 
 int json_arr_parse(char *payload, size_t len,
 		   const struct json_obj_descr *descr, void *val)
 {
-	struct json_obj arr;
-	int ret;
-
-	ret = arr_init(&arr, payload, len);
-	if (ret < 0) {
-		return ret;
-	}
+	struct json_stream stream;
+	int64_t ret;
 
-	void *ptr = (char *)val + descr->offset;
+	stream_init(&stream, JSON_TOK_ARRAY_START, descr, 0, val, NULL, 0);
+	ret = stream_feed(&stream, payload, len, NULL);
 
-	return arr_parse(&arr, descr->array.element_descr,
-			 descr->array.n_elements, ptr, val);
+	return ret == -EAGAIN ? -EINVAL : (int)ret;
 }
 
-
 int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, size_t len)
 {
-	return arr_init(json, payload, len);
+	struct json_lexer *lex = &json->lex;
+
+	lex->state = NULL;
+	lex->start = payload;
+	lex->end = payload + len;
+	lex->pos = skip_space(payload, lex->end);
+	lex->tok.type = JSON_TOK_NONE;
+
+	if (lex->pos == lex->end || *lex->pos != JSON_TOK_ARRAY_START) {
+		return -EINVAL;
+	}
+
+	lex->pos++;
+
+	return 0;
 }
 
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 			  size_t descr_len, void *val)
 {
-	struct json_token tok;
+	struct json_lexer *lex = &json->lex;
+	struct json_stream stream;
+	size_t consumed;
+	int64_t ret;
 
-	if (!lexer_next(&json->lex, &tok)) {
+	lex->pos = skip_space(lex->pos, lex->end);
+	if (lex->pos == lex->end) {
 		return -EINVAL;
 	}
 
-	if (tok.type == JSON_TOK_ARRAY_END) {
+	if (*lex->pos == JSON_TOK_ARRAY_END) {
+		lex->pos++;
 		return 0;
-	} else if (tok.type == JSON_TOK_COMMA) {
-		if (!lexer_next(&json->lex, &tok)) {
-			return -EINVAL;
-		}
+	} else if (*lex->pos == JSON_TOK_COMMA) {
+		lex->pos = skip_space(lex->pos + 1, lex->end);
 	}
 
-	if (tok.type != JSON_TOK_OBJECT_START) {
+	if (lex->pos == lex->end || *lex->pos != JSON_TOK_OBJECT_START) {
 		return -EINVAL;
 	}
 
-	return obj_parse(json, descr, descr_len, val);
+	stream_init(&stream, JSON_TOK_OBJECT_START, descr, descr_len, val, NULL, 0);
+	ret = stream_feed(&stream, lex->pos, lex->end - lex->pos, &consumed);
+	lex->pos += consumed;
+
+	return ret == -EAGAIN ? -EINVAL : (int)ret;
 }
 
+
 static char escape_as(char chr)
 {
 	switch (chr) {
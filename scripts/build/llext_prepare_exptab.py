@@ -16,6 +16,8 @@ exports table to allow usage of binary search algorithms at runtime.
 If CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID option is enabled, SLIDs
 of all exported functions are also injected in the export table by
 this script. (In this case, the preparation process is destructive)
+Otherwise, the export table is sorted by symbol name, as enabled by
+CONFIG_LLEXT_EXPORT_BUILTINS_SORTED.
 """
 
 import llext_slidlib
@@ -56,6 +58,9 @@ def _llext_const_symbol_struct(ptr_size: int, endianness: str):
     lcs_spec = endspec + 2 * ptrspec
     return struct.Struct(lcs_spec)
 
+#ELF Shdr flag of the sections occupying memory at runtime
+SHF_ALLOC = 0x2
+
 #ELF Shdr flag applied to the export table section, to indicate
 #the section has already been prepared by this script. This is
 #mostly a security measure to prevent the script from running
@@ -148,14 +153,7 @@ class ZephyrElfExptabPreparator():
           The export table is sorted by SLID in ASCENDING order.
         """
         def read_symbol_name(name_ptr):
-            raw_name = b''
-            self.elf_fd.seek(self.expstrtab_section.offset + name_ptr)
-
-            c = self.elf_fd.read(1)
-            while c != b'\0':
-                raw_name += c
-                c = self.elf_fd.read(1)
-
+            raw_name = self._read_raw_string(self.expstrtab_section.offset + name_ptr)
             return raw_name.decode("utf-8")
 
         #1) Load the export table
@@ -216,27 +214,64 @@ class ZephyrElfExptabPreparator():
 
         return 0
 
+    def _vaddr_to_file_offset(self, vaddr):
+        """Get the file offset of the data at a virtual address, or None"""
+        for section in self.elf.iter_sections():
+            if section['sh_type'] == 'SHT_NOBITS' or not section['sh_flags'] & SHF_ALLOC:
+                continue
+
+            start = section['sh_addr']
+            if start <= vaddr < start + section['sh_size']:
+                return section['sh_offset'] + vaddr - start
+
+        return None
+
+    def _read_raw_string(self, file_offset):
+        """Read a NUL-terminated string from the ELF, as bytes"""
+        raw = b''
+        self.elf_fd.seek(file_offset)
+
+        c = self.elf_fd.read(1)
+        while c not in (b'\0', b''):
+            raw += c
+            c = self.elf_fd.read(1)
+
+        return raw
+
     def _prepare_exptab_for_str_linking(self):
-        #TODO: sort the export table by symbol
-        #      name to allow binary search too
-        #
-        # Plan of action:
-        #   1) Locate in which section the names are located
-        #   2) Load the export table and resolve names
-        #   3) Sort the exports by name
-        #       WARN: THIS MUST USE THE SAME SORTING RULES
-        #       AS LLEXT CODE OR DICHOTOMIC SEARCH WILL BREAK
-        #       Using a custom sorting function might be required.
-        #   4) Write back the updated export table
-        #
-        # N.B.: reusing part of the code in _prepare_elf_for_slid_linking
-        # might be possible and desireable.
-        #
-        # As of writing, this function will never be called as this script
-        # is only called if CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID is enabled,
-        # which makes _prepare_exptab_for_slid_linking be called instead.
-        #
-        self.log.warn(f"_prepare_exptab_for_str_linking: do nothing")
+        """
+        IMPLEMENTATION NOTES:
+          The export table is sorted by name in ASCENDING order,
+          comparing the names as unsigned bytes to match strcmp(),
+          which LLEXT uses to binary search the table.
+
+          Sorting moves the table entries around, which is only
+          possible in a fully linked ELF without relocations.
+        """
+        if self.elf['e_type'] == 'ET_REL':
+            self.log.error("cannot sort the export table of a relocatable ELF")
+            return 1
+
+        #1) Load the export table and resolve the names
+        exports_list = []
+        for (name_ptr, export_address) in self.exptab_manipulator:
+            name_offset = self._vaddr_to_file_offset(name_ptr)
+            if name_offset is None:
+                self.log.error(f"name of export at 0x{export_address:X} not found "
+                               f"(address 0x{name_ptr:X})")
+                return 1
+
+            export_name = self._read_raw_string(name_offset)
+            exports_list.append((export_name, name_ptr, export_address))
+
+        #2) Sort the export table (order specified above)
+        exports_list.sort(key=lambda export: export[0])
+
+        #3) Write the updated export table to ELF
+        for i, (export_name, name_ptr, export_address) in enumerate(exports_list):
+            self.log.debug(f"{export_name.decode('utf-8', 'replace')} -> 0x{export_address:X}")
+            self.exptab_manipulator[i] = (name_ptr, export_address)
+
         return 0
 
     def _set_prep_done_shdr_flag(self):
@@ -314,6 +349,8 @@ class ZephyrElfExptabPreparator():
         if res == 0: # Add the "prepared" flag to export table section
             self._set_prep_done_shdr_flag()
 
+        return res
+
     def prepare_elf(self):
         res = self._prepare_inner()
         self.elf_fd.close()
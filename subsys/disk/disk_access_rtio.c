@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/work.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk, CONFIG_DISK_LOG_LEVEL);
+
+static int disk_access_iodev_do(const char *pdrv, const struct rtio_sqe *sqe)
+{
+	uint32_t sector_size;
+	int rc;
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_RX:
+	case RTIO_OP_TX:
+		break;
+	case RTIO_OP_ERASE:
+		return -ENOTSUP;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EINVAL;
+	}
+
+	rc = disk_access_ioctl(pdrv, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if ((sector_size == 0U) || ((sqe->storage.buf_len % sector_size) != 0U)) {
+		return -EINVAL;
+	}
+
+	if (sqe->op == RTIO_OP_RX) {
+		return disk_access_read(pdrv, sqe->rx.buf, sqe->storage.offset,
+					sqe->rx.buf_len / sector_size);
+	}
+
+	return disk_access_write(pdrv, sqe->tx.buf, sqe->storage.offset,
+				 sqe->tx.buf_len / sector_size);
+}
+
+static void disk_access_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const struct disk_access_iodev_data *data = txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	int rc;
+
+	LOG_DBG("Sync RTIO work item for: %p", (void *)txn_first);
+
+	do {
+		rc = disk_access_iodev_do(data->pdrv, &txn_curr->sqe);
+		txn_curr = rtio_txn_next(txn_curr);
+	} while ((rc == 0) && (txn_curr != NULL));
+
+	if (rc != 0) {
+		rtio_iodev_sqe_err(txn_first, rc);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, 0);
+	}
+}
+
+static void disk_access_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct disk_access_iodev_data *data = iodev_sqe->sqe.iodev->data;
+
+	rtio_work_queue_submit(&data->queue, iodev_sqe, disk_access_iodev_submit_work_handler);
+}
+
+const struct rtio_iodev_api disk_access_iodev_api = {
+	.submit = disk_access_iodev_submit,
+};
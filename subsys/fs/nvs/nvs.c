@@ -19,9 +19,9 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_LOOKUP_INDEX)
 
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_id_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +33,16 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#endif
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -84,6 +93,190 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+/* At least one slot in eight is kept free, so that probe sequences stay short and always end */
+#define NVS_LOOKUP_INDEX_MAX_IDS                                                                   \
+	(CONFIG_NVS_LOOKUP_INDEX_SIZE - MAX(CONFIG_NVS_LOOKUP_INDEX_SIZE / 8, 1))
+
+/* Address of the IDs found deleted while rebuilding the index */
+#define NVS_LOOKUP_INDEX_DELETED NVS_LOOKUP_CACHE_NO_ADDR
+
+static inline size_t nvs_lookup_index_home(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_INDEX_SIZE;
+}
+
+static inline size_t nvs_lookup_index_next(size_t pos)
+{
+	return (pos + 1 == CONFIG_NVS_LOOKUP_INDEX_SIZE) ? 0 : pos + 1;
+}
+
+/* Return the slot holding id, or the free slot where it is to be inserted */
+static size_t nvs_lookup_index_slot(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_lookup_index_home(id);
+
+	while ((fs->lookup_index[pos].id != id) && (fs->lookup_index[pos].id != 0xFFFF)) {
+		pos = nvs_lookup_index_next(pos);
+	}
+
+	return pos;
+}
+
+/* Empty the index. It is marked partial so that lookups walk the flash until it is rebuilt. */
+static void nvs_lookup_index_reset(struct nvs_fs *fs)
+{
+	memset(fs->lookup_index, 0xff, sizeof(fs->lookup_index));
+	fs->lookup_index_count = 0;
+	fs->lookup_index_partial = true;
+}
+
+/* Remove the entry in slot pos, moving back the following entries of its probe sequence
+ * that could otherwise no longer be found.
+ */
+static void nvs_lookup_index_remove(struct nvs_fs *fs, size_t pos)
+{
+	size_t hole = pos;
+	size_t home;
+
+	while (true) {
+		pos = nvs_lookup_index_next(pos);
+		if (fs->lookup_index[pos].id == 0xFFFF) {
+			break;
+		}
+
+		/* Entries whose home slot lies cyclically in (hole, pos] must stay in place */
+		home = nvs_lookup_index_home(fs->lookup_index[pos].id);
+		if ((hole < pos) ? ((home > hole) && (home <= pos))
+				 : ((home > hole) || (home <= pos))) {
+			continue;
+		}
+
+		fs->lookup_index[hole] = fs->lookup_index[pos];
+		hole = pos;
+	}
+
+	fs->lookup_index[hole].id = 0xFFFF;
+	fs->lookup_index_count--;
+}
+
+/* Record the ATE that has just been written at addr */
+static void nvs_lookup_index_update(struct nvs_fs *fs, const struct nvs_ate *ate, uint32_t addr)
+{
+	size_t pos = nvs_lookup_index_slot(fs, ate->id);
+	struct nvs_lookup_index_entry *entry = &fs->lookup_index[pos];
+
+	if (!ate->len) {
+		/* Deleted IDs are dropped: as long as the index is not partial, IDs
+		 * missing from it do not exist.
+		 */
+		if (entry->id != 0xFFFF) {
+			nvs_lookup_index_remove(fs, pos);
+		}
+		return;
+	}
+
+	if (entry->id == 0xFFFF) {
+		if (fs->lookup_index_count == NVS_LOOKUP_INDEX_MAX_IDS) {
+			/* Out of room: this ID is now only found by walking the flash */
+			fs->lookup_index_partial = true;
+			return;
+		}
+		entry->id = ate->id;
+		fs->lookup_index_count++;
+	}
+
+	entry->addr = addr;
+}
+
+/* Return the address of the most recent ATE of id, the address to start walking the
+ * whole storage from if the index cannot tell, or NVS_LOOKUP_CACHE_NO_ADDR if id does
+ * not exist.
+ */
+static uint32_t nvs_lookup_index_find(struct nvs_fs *fs, uint16_t id)
+{
+	const struct nvs_lookup_index_entry *entry;
+
+	if (id == 0xFFFF) {
+		return fs->ate_wra;
+	}
+
+	entry = &fs->lookup_index[nvs_lookup_index_slot(fs, id)];
+	if (entry->id == 0xFFFF) {
+		return fs->lookup_index_partial ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+	}
+
+	return entry->addr;
+}
+
+static int nvs_lookup_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_lookup_index_entry *entry;
+	struct nvs_ate ate;
+	size_t pos;
+
+	nvs_lookup_index_reset(fs);
+	fs->lookup_index_partial = false;
+	addr = fs->ate_wra;
+
+	/* Walk the ATEs from the most recent one, indexing the first valid one of each ID */
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		entry = &fs->lookup_index[nvs_lookup_index_slot(fs, ate.id)];
+
+		if (ate.id != 0xFFFF && entry->id == 0xFFFF && nvs_ate_valid(fs, &ate)) {
+			if (fs->lookup_index_count == NVS_LOOKUP_INDEX_MAX_IDS) {
+				/* The older IDs do not fit */
+				fs->lookup_index_partial = true;
+				break;
+			}
+			/* Deleted IDs are kept until the end of the walk to hide their older ATEs */
+			entry->id = ate.id;
+			entry->addr = ate.len ? ate_addr : NVS_LOOKUP_INDEX_DELETED;
+			fs->lookup_index_count++;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	for (pos = 0; pos < CONFIG_NVS_LOOKUP_INDEX_SIZE; pos++) {
+		while ((fs->lookup_index[pos].id != 0xFFFF) &&
+		       (fs->lookup_index[pos].addr == NVS_LOOKUP_INDEX_DELETED)) {
+			nvs_lookup_index_remove(fs, pos);
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_lookup_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	for (size_t pos = 0; pos < CONFIG_NVS_LOOKUP_INDEX_SIZE; pos++) {
+		while ((fs->lookup_index[pos].id != 0xFFFF) &&
+		       ((fs->lookup_index[pos].addr >> ADDR_SECT_SHIFT) == sector)) {
+			/* Live ATEs are moved before their sector is erased, so this only
+			 * happens when the storage is cleared.
+			 */
+			nvs_lookup_index_remove(fs, pos);
+			fs->lookup_index_partial = true;
+		}
+	}
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -168,6 +361,12 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* 0xFFFF is a special-purpose identifier. Exclude it from the index */
+	if (!rc && entry->id != 0xFFFF) {
+		nvs_lookup_index_update(fs, entry, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -343,6 +542,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	nvs_lookup_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_flatten(fs->flash_device, offset, fs->sector_size);
 
@@ -673,7 +875,14 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_INDEX)
+		wlk_addr = nvs_lookup_index_find(fs, gc_ate.id);
+
+		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+			/* the ID has been deleted since, nothing to copy */
+			continue;
+		}
+#elif defined(CONFIG_NVS_LOOKUP_CACHE)
 		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
 
 		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
@@ -760,6 +969,11 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* Until it is rebuilt below, the index makes the lookups of gc walk the flash */
+	nvs_lookup_index_reset(fs);
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -966,6 +1180,11 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (!rc) {
+		rc = nvs_lookup_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -1090,7 +1309,13 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_INDEX)
+	wlk_addr = nvs_lookup_index_find(fs, id);
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#elif defined(CONFIG_NVS_LOOKUP_CACHE)
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
@@ -1116,7 +1341,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_LOOKUP_INDEX)
 no_cached_entry:
 #endif
 
@@ -1223,7 +1448,18 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_INDEX)
+	wlk_addr = nvs_lookup_index_find(fs, id);
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		if (!cnt) {
+			rc = -ENOENT;
+			goto err;
+		}
+		/* the history of deleted IDs is only found in flash */
+		wlk_addr = fs->ate_wra;
+	}
+#elif defined(CONFIG_NVS_LOOKUP_CACHE)
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
@@ -10,6 +10,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <zephyr/fs/zms.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/crc.h>
 #include "zms_priv.h"
 
@@ -24,9 +25,9 @@ static int zms_get_sector_header(struct zms_fs *fs, uint64_t addr, struct zms_at
 static int zms_ate_valid_different_sector(struct zms_fs *fs, const struct zms_ate *entry,
 					  uint8_t cycle_cnt);
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
+#if defined(CONFIG_ZMS_LOOKUP_CACHE) || defined(CONFIG_ZMS_LOOKUP_INDEX)
 
-static inline size_t zms_lookup_cache_pos(uint32_t id)
+static inline uint32_t zms_id_hash(uint32_t id)
 {
 	uint32_t hash;
 
@@ -38,7 +39,16 @@ static inline size_t zms_lookup_cache_pos(uint32_t id)
 	hash *= 0x846ca68bU;
 	hash ^= hash >> 16;
 
-	return hash % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#endif
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+
+static inline size_t zms_lookup_cache_pos(uint32_t id)
+{
+	return zms_id_hash(id) % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
 }
 
 static int zms_lookup_cache_rebuild(struct zms_fs *fs)
@@ -107,6 +117,222 @@ static void zms_lookup_cache_invalidate(struct zms_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_ZMS_LOOKUP_CACHE */
 
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+
+/* At least one slot in eight is kept free, so that probe sequences stay short and always end */
+#define ZMS_LOOKUP_INDEX_MAX_IDS                                                                   \
+	(CONFIG_ZMS_LOOKUP_INDEX_SIZE - MAX(CONFIG_ZMS_LOOKUP_INDEX_SIZE / 8, 1))
+
+/* Offset of the IDs found deleted while rebuilding the index, no ATE is stored there */
+#define ZMS_LOOKUP_INDEX_DELETED UINT32_MAX
+
+static inline size_t zms_lookup_index_home(uint32_t id)
+{
+	return zms_id_hash(id) % CONFIG_ZMS_LOOKUP_INDEX_SIZE;
+}
+
+static inline size_t zms_lookup_index_next(size_t pos)
+{
+	return (pos + 1 == CONFIG_ZMS_LOOKUP_INDEX_SIZE) ? 0 : pos + 1;
+}
+
+/* Return the slot holding id, or the free slot where it is to be inserted */
+static size_t zms_lookup_index_slot(struct zms_fs *fs, uint32_t id)
+{
+	size_t pos = zms_lookup_index_home(id);
+
+	while ((fs->lookup_index[pos].id != id) && (fs->lookup_index[pos].id != ZMS_HEAD_ID)) {
+		pos = zms_lookup_index_next(pos);
+	}
+
+	return pos;
+}
+
+/* Empty the index. It is marked partial so that lookups walk the flash until it is rebuilt. */
+static void zms_lookup_index_reset(struct zms_fs *fs)
+{
+	memset(fs->lookup_index, 0xff, sizeof(fs->lookup_index));
+	fs->lookup_index_count = 0;
+	fs->lookup_index_partial = true;
+}
+
+/* Remove the entry in slot pos, moving back the following entries of its probe sequence
+ * that could otherwise no longer be found.
+ */
+static void zms_lookup_index_remove(struct zms_fs *fs, size_t pos)
+{
+	size_t hole = pos;
+	size_t home;
+
+	while (true) {
+		pos = zms_lookup_index_next(pos);
+		if (fs->lookup_index[pos].id == ZMS_HEAD_ID) {
+			break;
+		}
+
+		/* Entries whose home slot lies cyclically in (hole, pos] must stay in place */
+		home = zms_lookup_index_home(fs->lookup_index[pos].id);
+		if ((hole < pos) ? ((home > hole) && (home <= pos))
+				 : ((home > hole) || (home <= pos))) {
+			continue;
+		}
+
+		fs->lookup_index[hole] = fs->lookup_index[pos];
+		hole = pos;
+	}
+
+	fs->lookup_index[hole].id = ZMS_HEAD_ID;
+	fs->lookup_index_count--;
+}
+
+/* Point the entry of id to the ATE at addr, inserting it when missing */
+static void zms_lookup_index_set(struct zms_fs *fs, uint32_t id, uint64_t addr)
+{
+	size_t pos = zms_lookup_index_slot(fs, id);
+	struct zms_lookup_index_entry *entry = &fs->lookup_index[pos];
+
+	if (entry->id == ZMS_HEAD_ID) {
+		if (fs->lookup_index_count == ZMS_LOOKUP_INDEX_MAX_IDS) {
+			/* Out of room: this ID is now only found by walking the flash */
+			fs->lookup_index_partial = true;
+			return;
+		}
+		entry->id = id;
+		fs->lookup_index_count++;
+	}
+
+	entry->sector = SECTOR_NUM(addr);
+	entry->offset = SECTOR_OFFSET(addr);
+}
+
+/* Record the ATE that has just been written at addr */
+static void zms_lookup_index_update(struct zms_fs *fs, const struct zms_ate *ate, uint64_t addr)
+{
+	size_t pos;
+
+	if (ate->len) {
+		zms_lookup_index_set(fs, ate->id, addr);
+		return;
+	}
+
+	/* Deleted IDs are dropped: as long as the index is not partial, IDs missing from it
+	 * do not exist.
+	 */
+	pos = zms_lookup_index_slot(fs, ate->id);
+	if (fs->lookup_index[pos].id != ZMS_HEAD_ID) {
+		zms_lookup_index_remove(fs, pos);
+	}
+}
+
+/* Return the address of the most recent ATE of id, the address to start walking the
+ * whole storage from if the index cannot tell, or ZMS_LOOKUP_CACHE_NO_ADDR if id does
+ * not exist.
+ */
+static uint64_t zms_lookup_index_find(struct zms_fs *fs, uint32_t id)
+{
+	const struct zms_lookup_index_entry *entry;
+
+	if (id == ZMS_HEAD_ID) {
+		return fs->ate_wra;
+	}
+
+	entry = &fs->lookup_index[zms_lookup_index_slot(fs, id)];
+	if (entry->id == ZMS_HEAD_ID) {
+		return fs->lookup_index_partial ? fs->ate_wra : ZMS_LOOKUP_CACHE_NO_ADDR;
+	}
+
+	return ((uint64_t)entry->sector << ADDR_SECT_SHIFT) | entry->offset;
+}
+
+static int zms_lookup_index_rebuild(struct zms_fs *fs)
+{
+	int rc;
+	int previous_sector_num = ZMS_INVALID_SECTOR_NUM;
+	uint64_t addr;
+	uint64_t ate_addr;
+	uint8_t current_cycle;
+	struct zms_ate ate;
+	struct zms_lookup_index_entry *entry;
+	size_t pos;
+
+	zms_lookup_index_reset(fs);
+	fs->lookup_index_partial = false;
+	addr = fs->ate_wra;
+
+	/* Walk the ATEs from the most recent one, indexing the first valid one of each ID */
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by zms_prev_ate() */
+		ate_addr = addr;
+		rc = zms_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		entry = &fs->lookup_index[zms_lookup_index_slot(fs, ate.id)];
+
+		if ((ate.id != ZMS_HEAD_ID) && (entry->id == ZMS_HEAD_ID)) {
+			/* read the ate cycle only when we change the sector
+			 * or if it is the first read
+			 */
+			if (SECTOR_NUM(ate_addr) != previous_sector_num) {
+				rc = zms_get_sector_cycle(fs, ate_addr, &current_cycle);
+				if (rc == -ENOENT) {
+					/* sector never used */
+					current_cycle = 0;
+				} else if (rc) {
+					/* bad flash read */
+					return rc;
+				}
+			}
+			if (zms_ate_valid_different_sector(fs, &ate, current_cycle)) {
+				if (fs->lookup_index_count == ZMS_LOOKUP_INDEX_MAX_IDS) {
+					/* The older IDs do not fit */
+					fs->lookup_index_partial = true;
+					break;
+				}
+				/* Deleted IDs are kept until the end of the walk to hide their
+				 * older ATEs
+				 */
+				entry->id = ate.id;
+				entry->sector = SECTOR_NUM(ate_addr);
+				entry->offset = ate.len ? SECTOR_OFFSET(ate_addr)
+							: ZMS_LOOKUP_INDEX_DELETED;
+				fs->lookup_index_count++;
+			}
+			previous_sector_num = SECTOR_NUM(ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	for (pos = 0; pos < CONFIG_ZMS_LOOKUP_INDEX_SIZE; pos++) {
+		while ((fs->lookup_index[pos].id != ZMS_HEAD_ID) &&
+		       (fs->lookup_index[pos].offset == ZMS_LOOKUP_INDEX_DELETED)) {
+			zms_lookup_index_remove(fs, pos);
+		}
+	}
+
+	return 0;
+}
+
+static void zms_lookup_index_invalidate(struct zms_fs *fs, uint32_t sector)
+{
+	for (size_t pos = 0; pos < CONFIG_ZMS_LOOKUP_INDEX_SIZE; pos++) {
+		while ((fs->lookup_index[pos].id != ZMS_HEAD_ID) &&
+		       (fs->lookup_index[pos].sector == sector)) {
+			/* Live ATEs are moved before their sector is erased, so this only
+			 * happens when the storage is cleared.
+			 */
+			zms_lookup_index_remove(fs, pos);
+			fs->lookup_index_partial = true;
+		}
+	}
+}
+
+#endif /* CONFIG_ZMS_LOOKUP_INDEX */
+
 /* Helper to compute offset given the address */
 static inline off_t zms_addr_to_offset(struct zms_fs *fs, uint64_t addr)
 {
@@ -214,6 +440,11 @@ static int zms_flash_ate_wrt(struct zms_fs *fs, const struct zms_ate *entry)
 	if (entry->id != ZMS_HEAD_ID) {
 		fs->lookup_cache[zms_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	if (entry->id != ZMS_HEAD_ID) {
+		zms_lookup_index_update(fs, entry, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= zms_al_size(fs, sizeof(struct zms_ate));
 end:
@@ -348,6 +579,9 @@ static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	zms_lookup_cache_invalidate(fs, SECTOR_NUM(addr));
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	zms_lookup_index_invalidate(fs, SECTOR_NUM(addr));
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -560,8 +794,8 @@ static int zms_recover_last_ate(struct zms_fs *fs, uint64_t *addr, uint64_t *dat
 
 	LOG_DBG("Recovering last ate from sector %llu", SECTOR_NUM(*addr));
 
-	/* skip close and empty ATE */
-	*addr -= 2 * fs->ate_size;
+	/* skip the close ATE, the empty ATE is after it */
+	*addr -= fs->ate_size;
 
 	ate_end_addr = *addr;
 	data_end_addr = *addr & ADDR_SECT_MASK;
@@ -738,6 +972,12 @@ static int zms_add_empty_ate(struct zms_fs *fs, uint64_t addr)
 	empty_ate.offset = 0U;
 	empty_ate.metadata =
 		FIELD_PREP(ZMS_MAGIC_NUMBER_MASK, ZMS_MAGIC_NUMBER) | ZMS_DEFAULT_VERSION;
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* writes may follow the ATEs moved by a garbage collection of the next sector that is
+	 * not done, which must then be resumed rather than restarted
+	 */
+	empty_ate.metadata |= ZMS_BACKGROUND_GC_FLAG;
+#endif
 
 	rc = zms_get_sector_cycle(fs, addr, &cycle_cnt);
 	if (rc == -ENOENT) {
@@ -790,6 +1030,26 @@ static int zms_get_sector_cycle(struct zms_fs *fs, uint64_t addr, uint8_t *cycle
 	return -ENOENT;
 }
 
+/* check if the sector where belongs address "addr" was erased with background garbage
+ * collection, in which case writes may follow the ATEs moved by a garbage collection
+ * that is not done.
+ */
+static int zms_sector_background_gc(struct zms_fs *fs, uint64_t addr, bool *background_gc)
+{
+	int rc;
+	struct zms_ate empty_ate;
+
+	rc = zms_flash_ate_rd(fs, zms_empty_ate_addr(fs, addr), &empty_ate);
+	if (rc) {
+		return rc;
+	}
+
+	*background_gc = zms_empty_ate_valid(fs, &empty_ate) &&
+			 (empty_ate.metadata & ZMS_BACKGROUND_GC_FLAG);
+
+	return 0;
+}
+
 static int zms_get_sector_header(struct zms_fs *fs, uint64_t addr, struct zms_ate *empty_ate,
 				 struct zms_ate *close_ate)
 {
@@ -868,26 +1128,10 @@ static int zms_find_ate_with_id(struct zms_fs *fs, uint32_t id, uint64_t start_a
 	return prev_found;
 }
 
-/* garbage collection: the address ate_wra has been updated to the new sector
- * that has just been started. The data to gc is in the sector after this new
- * sector.
- */
-static int zms_gc(struct zms_fs *fs)
+/* get the cycle counter of the sector pointed by ate_wra, which starts to be used */
+static int zms_init_write_sector(struct zms_fs *fs)
 {
 	int rc;
-	int sec_closed;
-	struct zms_ate close_ate;
-	struct zms_ate gc_ate;
-	struct zms_ate wlk_ate;
-	struct zms_ate empty_ate;
-	uint64_t sec_addr;
-	uint64_t gc_addr;
-	uint64_t gc_prev_addr;
-	uint64_t wlk_addr;
-	uint64_t wlk_prev_addr;
-	uint64_t data_addr;
-	uint64_t stop_addr;
-	uint8_t previous_cycle = 0;
 
 	rc = zms_get_sector_cycle(fs, fs->ate_wra, &fs->sector_cycle);
 	if (rc == -ENOENT) {
@@ -912,100 +1156,87 @@ static int zms_gc(struct zms_fs *fs)
 		/* bad flash read */
 		return rc;
 	}
-	previous_cycle = fs->sector_cycle;
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	zms_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - fs->ate_size;
+	return 0;
+}
 
-	/* verify if the sector is closed */
-	sec_closed = zms_validate_closed_sector(fs, gc_addr, &empty_ate, &close_ate);
-	if (sec_closed < 0) {
-		return sec_closed;
-	}
+/* check if the valid ATE gc_ate, read at gc_addr, is the most recent one with its ID, in
+ * which case it must be moved before erasing its sector.
+ * returns 1 if it must be moved, 0 if not and < 0 on error
+ */
+static int zms_gc_ate_needs_move(struct zms_fs *fs, uint64_t gc_addr, const struct zms_ate *gc_ate)
+{
+	int rc;
+	struct zms_ate wlk_ate;
+	uint64_t wlk_addr;
+	uint64_t wlk_prev_addr;
 
-	/* if the sector is not closed don't do gc */
-	if (!sec_closed) {
-		goto gc_done;
+#if defined(CONFIG_ZMS_LOOKUP_INDEX)
+	wlk_addr = zms_lookup_index_find(fs, gc_ate->id);
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		/* the ID has been deleted since, nothing to copy */
+		return 0;
 	}
+#elif defined(CONFIG_ZMS_LOOKUP_CACHE)
+	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate->id)];
 
-	/* update sector_cycle */
-	fs->sector_cycle = empty_ate.cycle_cnt;
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
 
-	/* stop_addr points to the first ATE before the header ATEs */
-	stop_addr = gc_addr - 2 * fs->ate_size;
-	/* At this step empty & close ATEs are valid.
-	 * let's start the GC
+	/* Initialize the wlk_prev_addr as if no previous ID will be found */
+	wlk_prev_addr = gc_addr;
+	/* Search for a previous valid ATE with the same ID. If it doesn't exist
+	 * then wlk_prev_addr will be equal to gc_addr.
 	 */
-	gc_addr &= ADDR_SECT_MASK;
-	gc_addr += close_ate.offset;
-
-	do {
-		gc_prev_addr = gc_addr;
-		rc = zms_prev_ate(fs, &gc_addr, &gc_ate);
-		if (rc) {
-			return rc;
-		}
+	rc = zms_find_ate_with_id(fs, gc_ate->id, wlk_addr, fs->ate_wra, &wlk_ate, &wlk_prev_addr);
+	if (rc < 0) {
+		return rc;
+	}
 
-		if (!zms_ate_valid(fs, &gc_ate) || !gc_ate.len) {
-			continue;
-		}
+	/* if walk_addr has reached the same address as gc_addr, a copy is
+	 * needed unless it is a deleted item.
+	 */
+	return wlk_prev_addr == gc_addr;
+}
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate.id)];
+/* copy the ATE gc_ate, read at gc_addr, and its data to the write sector */
+static int zms_gc_move_ate(struct zms_fs *fs, uint64_t gc_addr, struct zms_ate *gc_ate,
+			   uint8_t cycle_cnt)
+{
+	int rc;
+	uint64_t data_addr;
 
-		if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
 
-		/* Initialize the wlk_prev_addr as if no previous ID will be found */
-		wlk_prev_addr = gc_prev_addr;
-		/* Search for a previous valid ATE with the same ID. If it doesn't exist
-		 * then wlk_prev_addr will be equal to gc_prev_addr.
+	if (gc_ate->len > ZMS_DATA_IN_ATE_SIZE) {
+		/* Copy Data only when len > 8
+		 * Otherwise, Data is already inside ATE
 		 */
-		rc = zms_find_ate_with_id(fs, gc_ate.id, wlk_addr, fs->ate_wra, &wlk_ate,
-					  &wlk_prev_addr);
-		if (rc < 0) {
+		data_addr = (gc_addr & ADDR_SECT_MASK);
+		data_addr += gc_ate->offset;
+		gc_ate->offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
+
+		rc = zms_flash_block_move(fs, data_addr, gc_ate->len);
+		if (rc) {
 			return rc;
 		}
+	}
 
-		/* if walk_addr has reached the same address as gc_addr, a copy is
-		 * needed unless it is a deleted item.
-		 */
-		if (wlk_prev_addr == gc_prev_addr) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
-				/* Copy Data only when len > 8
-				 * Otherwise, Data is already inside ATE
-				 */
-				data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-				data_addr += gc_ate.offset;
-				gc_ate.offset = (uint32_t)SECTOR_OFFSET(fs->data_wra);
-
-				rc = zms_flash_block_move(fs, data_addr, gc_ate.len);
-				if (rc) {
-					return rc;
-				}
-			}
-
-			gc_ate.cycle_cnt = previous_cycle;
-			zms_ate_crc8_update(&gc_ate);
-			rc = zms_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
-		}
-	} while (gc_prev_addr != stop_addr);
+	gc_ate->cycle_cnt = cycle_cnt;
+	zms_ate_crc8_update(gc_ate);
 
-gc_done:
+	return zms_flash_ate_wrt(fs, gc_ate);
+}
 
-	/* restore the previous sector_cycle */
-	fs->sector_cycle = previous_cycle;
+/* mark the end of the garbage collection of the sector at sec_addr and erase it */
+static int zms_gc_erase_sector(struct zms_fs *fs, uint64_t sec_addr)
+{
+	int rc;
 
 	/* Write a GC_done ATE to mark the end of this operation
 	 */
@@ -1023,23 +1254,388 @@ gc_done:
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	zms_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	zms_lookup_index_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = zms_add_empty_ate(fs, sec_addr);
 
 	return rc;
 }
 
-int zms_clear(struct zms_fs *fs)
-{
-	int rc;
-	uint64_t addr;
+#ifdef CONFIG_ZMS_BACKGROUND_GC
 
-	if (!fs->ready) {
-		LOG_ERR("zms not initialized");
-		return -EACCES;
-	}
+static K_THREAD_STACK_DEFINE(zms_gc_stack, CONFIG_ZMS_BACKGROUND_GC_STACK_SIZE);
+static struct k_work_q zms_gc_work_q;
 
-	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+static inline bool zms_gc_pending(struct zms_fs *fs)
+{
+	return fs->gc_state == ZMS_GC_PENDING;
+}
+
+static inline bool zms_gc_has_work(struct zms_fs *fs)
+{
+	return zms_gc_pending(fs) ||
+	       ((fs->gc_state == ZMS_GC_RELOCATE) && (fs->gc_addr <= fs->gc_stop_addr));
+}
+
+/* Space that the pending garbage collection may still need in the write sector: every ATE
+ * left to walk moved with its data, the GC done ATE and the ATE reserved for deletion.
+ */
+static uint64_t zms_gc_reserve(struct zms_fs *fs)
+{
+	if (!zms_gc_pending(fs)) {
+		return 0;
+	}
+
+	if (fs->gc_addr > fs->gc_stop_addr) {
+		return 2 * fs->ate_size;
+	}
+
+	return fs->gc_stop_addr + 3 * fs->ate_size - fs->gc_addr + fs->gc_data_end;
+}
+
+/* prepare the walk through the ATEs of the sector at sec_addr.
+ * returns 1 if the sector is closed, 0 if there is nothing to walk and < 0 on error
+ */
+static int zms_gc_walk_init(struct zms_fs *fs, uint64_t sec_addr)
+{
+	int sec_closed;
+	struct zms_ate close_ate;
+	struct zms_ate empty_ate;
+
+	/* verify if the sector is closed */
+	sec_closed = zms_validate_closed_sector(fs, sec_addr, &empty_ate, &close_ate);
+	if (sec_closed < 0) {
+		return sec_closed;
+	}
+
+	if (!sec_closed) {
+		/* nothing to walk, the walk is already over */
+		fs->gc_stop_addr = sec_addr;
+		fs->gc_addr = sec_addr + fs->ate_size;
+		fs->gc_data_end = 0U;
+		return 0;
+	}
+
+	fs->gc_cycle = empty_ate.cycle_cnt;
+	/* gc_stop_addr points to the first ATE before the header ATEs */
+	fs->gc_stop_addr = zms_close_ate_addr(fs, sec_addr) - fs->ate_size;
+	fs->gc_addr = sec_addr + close_ate.offset;
+	/* the data of the ATEs are below the last ATE written in the sector */
+	fs->gc_data_end = close_ate.offset;
+
+	return 1;
+}
+
+/* start moving the most recent ATEs of the oldest sector to the write sector, ahead of
+ * its garbage collection when the write sector is closed
+ */
+static int zms_gc_relocate_start(struct zms_fs *fs)
+{
+	int rc;
+	uint64_t sec_addr;
+
+	fs->gc_state = ZMS_GC_IDLE;
+
+	/* the oldest sector is the one after the empty sector that follows the write sector */
+	if (fs->sector_count < 3) {
+		return 0;
+	}
+
+	sec_addr = fs->ate_wra & ADDR_SECT_MASK;
+	zms_sector_advance(fs, &sec_addr);
+	zms_sector_advance(fs, &sec_addr);
+
+	rc = zms_gc_walk_init(fs, sec_addr);
+	if (rc > 0) {
+		fs->gc_state = ZMS_GC_RELOCATE;
+		rc = 0;
+	}
+
+	return rc;
+}
+
+/* garbage collect at most max_ates ATEs of the sector being walked, and once they have all
+ * been walked, erase it if its garbage collection is pending.
+ * returns -ENOSPC if the write sector has no room left for relocating the ATEs.
+ */
+static int zms_gc_step(struct zms_fs *fs, uint32_t max_ates)
+{
+	int rc;
+	struct zms_ate gc_ate;
+	uint32_t data_offset;
+	size_t required_space;
+
+	for (uint32_t i = 0; i < max_ates; i++) {
+		if (fs->gc_addr > fs->gc_stop_addr) {
+			if (!zms_gc_pending(fs)) {
+				return 0;
+			}
+
+			rc = zms_gc_erase_sector(fs, fs->gc_stop_addr & ADDR_SECT_MASK);
+			if (rc) {
+				return rc;
+			}
+
+			return zms_gc_relocate_start(fs);
+		}
+
+		rc = zms_flash_ate_rd(fs, fs->gc_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (zms_ate_valid_different_sector(fs, &gc_ate, fs->gc_cycle) && gc_ate.len) {
+			rc = zms_gc_ate_needs_move(fs, fs->gc_addr, &gc_ate);
+			if (rc < 0) {
+				return rc;
+			}
+
+			/* unlike the garbage collection, relocating must leave room for the
+			 * writes and stop when the write sector is full
+			 */
+			required_space = fs->ate_size;
+			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
+				required_space += zms_al_size(fs, gc_ate.len);
+			}
+			if (rc && !zms_gc_pending(fs) &&
+			    (!SECTOR_OFFSET(fs->ate_wra) ||
+			     (fs->ate_wra < (fs->data_wra + required_space)) ||
+			     !SECTOR_OFFSET(fs->ate_wra - fs->ate_size))) {
+				return -ENOSPC;
+			}
+
+			data_offset = gc_ate.offset;
+			if (rc) {
+				rc = zms_gc_move_ate(fs, fs->gc_addr, &gc_ate, fs->sector_cycle);
+				if (rc) {
+					return rc;
+				}
+			}
+
+			/* the remaining ATEs are older and their data are below */
+			if (gc_ate.len > ZMS_DATA_IN_ATE_SIZE) {
+				fs->gc_data_end = data_offset;
+			}
+		}
+
+		fs->gc_addr += fs->ate_size;
+	}
+
+	return 0;
+}
+
+static void zms_gc_work_handler(struct k_work *work)
+{
+	struct zms_fs *fs = CONTAINER_OF(work, struct zms_fs, gc_work);
+	int rc;
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	if (!fs->ready || !zms_gc_has_work(fs)) {
+		goto end;
+	}
+
+	rc = zms_gc_step(fs, CONFIG_ZMS_BACKGROUND_GC_STEP);
+	if (rc == -ENOSPC) {
+		/* the garbage collection moves the rest once the write sector is closed */
+		goto end;
+	}
+	if (rc) {
+		LOG_ERR("Background garbage collection failed, returned = %d", rc);
+		goto end;
+	}
+
+	if (zms_gc_has_work(fs)) {
+		k_work_submit_to_queue(&zms_gc_work_q, &fs->gc_work);
+	}
+
+end:
+	k_mutex_unlock(&fs->zms_lock);
+}
+
+/* garbage collection: the address ate_wra has been updated to the new sector
+ * that has just been started. The data to gc is in the sector after this new
+ * sector.
+ * Only start it here, it is then done in steps by the background work, or by the
+ * writes needing the space it frees, unless the write sector was erased without
+ * background gc.
+ */
+static int zms_gc(struct zms_fs *fs)
+{
+	int rc;
+	uint64_t sec_addr;
+	bool background_gc;
+
+	rc = zms_init_write_sector(fs);
+	if (rc) {
+		return rc;
+	}
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	zms_sector_advance(fs, &sec_addr);
+
+	/* Keep the progress made when relocating this sector ahead of time */
+	if ((fs->gc_state != ZMS_GC_RELOCATE) || ((fs->gc_addr & ADDR_SECT_MASK) != sec_addr)) {
+		rc = zms_gc_walk_init(fs, sec_addr);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	fs->gc_state = ZMS_GC_PENDING;
+
+	rc = zms_sector_background_gc(fs, fs->ate_wra, &background_gc);
+	if (rc) {
+		return rc;
+	}
+
+	if (!background_gc) {
+		/* The write sector was erased without background gc, so an interrupted
+		 * gc could be restarted, discarding the writes that follow its copies:
+		 * finish it before any write.
+		 */
+		while (zms_gc_pending(fs)) {
+			rc = zms_gc_step(fs, CONFIG_ZMS_BACKGROUND_GC_STEP);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	/* the work also relocates the ATEs of the oldest sector */
+	k_work_submit_to_queue(&zms_gc_work_q, &fs->gc_work);
+
+	return 0;
+}
+
+static int zms_gc_work_q_init(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "zms_gc",
+	};
+
+	k_work_queue_start(&zms_gc_work_q, zms_gc_stack, K_THREAD_STACK_SIZEOF(zms_gc_stack),
+			   CONFIG_ZMS_BACKGROUND_GC_THREAD_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(zms_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+
+static inline bool zms_gc_pending(struct zms_fs *fs)
+{
+	return false;
+}
+
+/* garbage collection: the address ate_wra has been updated to the new sector
+ * that has just been started. The data to gc is in the sector after this new
+ * sector.
+ */
+static int zms_gc(struct zms_fs *fs)
+{
+	int rc;
+	int sec_closed;
+	struct zms_ate close_ate;
+	struct zms_ate gc_ate;
+	struct zms_ate empty_ate;
+	uint64_t sec_addr;
+	uint64_t gc_addr;
+	uint64_t gc_prev_addr;
+	uint64_t stop_addr;
+	uint8_t previous_cycle = 0;
+
+	rc = zms_init_write_sector(fs);
+	if (rc) {
+		return rc;
+	}
+	previous_cycle = fs->sector_cycle;
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	zms_sector_advance(fs, &sec_addr);
+	gc_addr = sec_addr + fs->sector_size - fs->ate_size;
+
+	/* verify if the sector is closed */
+	sec_closed = zms_validate_closed_sector(fs, gc_addr, &empty_ate, &close_ate);
+	if (sec_closed < 0) {
+		return sec_closed;
+	}
+
+	/* if the sector is not closed don't do gc */
+	if (!sec_closed) {
+		goto gc_done;
+	}
+
+	/* update sector_cycle */
+	fs->sector_cycle = empty_ate.cycle_cnt;
+
+	/* stop_addr points to the first ATE before the header ATEs */
+	stop_addr = gc_addr - 2 * fs->ate_size;
+	/* At this step empty & close ATEs are valid.
+	 * let's start the GC
+	 */
+	gc_addr &= ADDR_SECT_MASK;
+	gc_addr += close_ate.offset;
+
+	do {
+		gc_prev_addr = gc_addr;
+		rc = zms_prev_ate(fs, &gc_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!zms_ate_valid(fs, &gc_ate) || !gc_ate.len) {
+			continue;
+		}
+
+		rc = zms_gc_ate_needs_move(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			/* copy needed */
+			rc = zms_gc_move_ate(fs, gc_prev_addr, &gc_ate, previous_cycle);
+			if (rc) {
+				return rc;
+			}
+		}
+	} while (gc_prev_addr != stop_addr);
+
+gc_done:
+
+	/* restore the previous sector_cycle */
+	fs->sector_cycle = previous_cycle;
+
+	return zms_gc_erase_sector(fs, sec_addr);
+}
+
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
+
+int zms_clear(struct zms_fs *fs)
+{
+	int rc;
+	uint64_t addr;
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	struct k_work_sync sync;
+#endif
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* The work takes the lock, it can't be waited for while holding it.
+	 * Once fs->ready is cleared below, a work submitted meanwhile does nothing.
+	 */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 	for (uint32_t i = 0; i < fs->sector_count; i++) {
 		addr = (uint64_t)i << ADDR_SECT_SHIFT;
 		rc = zms_flash_erase_sector(fs, addr);
@@ -1054,6 +1650,9 @@ int zms_clear(struct zms_fs *fs)
 
 	/* zms needs to be reinitialized after clearing */
 	fs->ready = false;
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	fs->gc_state = ZMS_GC_IDLE;
+#endif
 
 end:
 	k_mutex_unlock(&fs->zms_lock);
@@ -1074,9 +1673,18 @@ static int zms_init(struct zms_fs *fs)
 	uint32_t i;
 	uint32_t closed_sectors = 0;
 	bool zms_magic_exist = false;
+	bool background_gc;
 
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	/* Until it is rebuilt below, the index makes the lookups of gc walk the flash */
+	zms_lookup_index_reset(fs);
+#endif
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	fs->gc_state = ZMS_GC_IDLE;
+#endif
+
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where zms can write.
 	 */
@@ -1276,20 +1884,33 @@ static int zms_init(struct zms_fs *fs)
 			rc = zms_add_empty_ate(fs, addr);
 			goto end;
 		}
-		LOG_INF("No GC Done marker found: restarting gc");
-		rc = zms_flash_erase_sector(fs, fs->ate_wra);
-		if (rc) {
-			goto end;
-		}
-		rc = zms_add_empty_ate(fs, fs->ate_wra);
+		rc = zms_sector_background_gc(fs, fs->ate_wra, &background_gc);
 		if (rc) {
 			goto end;
 		}
 
-		/* Let's point to the first writable position */
-		fs->ate_wra &= ADDR_SECT_MASK;
-		fs->ate_wra += (fs->sector_size - 3 * fs->ate_size);
-		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+		if (background_gc) {
+			/* Writes may have been done while the garbage collection was running,
+			 * so resume it instead of restarting it: the ATEs it already moved are
+			 * then found to have a more recent copy.
+			 */
+			LOG_INF("No GC Done marker found: resuming gc");
+		} else {
+			LOG_INF("No GC Done marker found: restarting gc");
+			rc = zms_flash_erase_sector(fs, fs->ate_wra);
+			if (rc) {
+				goto end;
+			}
+			rc = zms_add_empty_ate(fs, fs->ate_wra);
+			if (rc) {
+				goto end;
+			}
+
+			/* Let's point to the first writable position */
+			fs->ate_wra &= ADDR_SECT_MASK;
+			fs->ate_wra += (fs->sector_size - 3 * fs->ate_size);
+			fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+		}
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 		/**
 		 * At this point, the lookup cache wasn't built but the gc function need to use it.
@@ -1309,13 +1930,24 @@ end:
 	if (!rc) {
 		rc = zms_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	if (!rc) {
+		rc = zms_lookup_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
-	 * space when doing gc.
+	 * space when doing gc. A pending gc adds it when done.
 	 */
-	if ((!rc) && (SECTOR_OFFSET(fs->ate_wra) == (fs->sector_size - 3 * fs->ate_size))) {
+	if ((!rc) && !zms_gc_pending(fs) &&
+	    (SECTOR_OFFSET(fs->ate_wra) == (fs->sector_size - 3 * fs->ate_size))) {
 		rc = zms_add_gc_done_ate(fs);
 	}
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	if ((!rc) && (fs->gc_state == ZMS_GC_IDLE)) {
+		rc = zms_gc_relocate_start(fs);
+	}
+#endif
 	k_mutex_unlock(&fs->zms_lock);
 
 	return rc;
@@ -1327,6 +1959,15 @@ int zms_mount(struct zms_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	struct k_work_sync sync;
+
+	/* the work may still be queued or running, holding the lock, when
+	 * mounting again. A zeroed work item is idle on the first mount.
+	 */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	k_work_init(&fs->gc_work, zms_gc_work_handler);
+#endif
 	k_mutex_init(&fs->zms_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1382,6 +2023,10 @@ int zms_mount(struct zms_fs *fs)
 	/* zms is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	k_work_submit_to_queue(&zms_gc_work_q, &fs->gc_work);
+#endif
+
 	LOG_INF("%u Sectors of %u bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %llu, %llx", SECTOR_NUM(fs->ate_wra), SECTOR_OFFSET(fs->ate_wra));
 	LOG_INF("data wra: %llu, %llx", SECTOR_NUM(fs->data_wra), SECTOR_OFFSET(fs->data_wra));
@@ -1389,7 +2034,7 @@ int zms_mount(struct zms_fs *fs)
 	return 0;
 }
 
-ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
+static ssize_t zms_do_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 {
 	int rc;
 	size_t data_size;
@@ -1397,11 +2042,7 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	uint64_t rd_addr;
 	uint32_t gc_count;
 	uint32_t required_space = 0U; /* no space, appropriate for delete ate */
-
-	if (!fs->ready) {
-		LOG_ERR("zms not initialized");
-		return -EACCES;
-	}
+	uint64_t gc_reserve = 0U;
 
 	data_size = zms_al_size(fs, len);
 
@@ -1416,7 +2057,19 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
+#if defined(CONFIG_ZMS_LOOKUP_INDEX)
+	wlk_addr = zms_lookup_index_find(fs, id);
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+#ifdef CONFIG_ZMS_NO_DOUBLE_WRITE
+		/* skip delete entry for non-existing or already deleted entry */
+		if (len == 0) {
+			return 0;
+		}
+#endif
+		goto no_cached_entry;
+	}
+#elif defined(CONFIG_ZMS_LOOKUP_CACHE)
 	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
@@ -1473,7 +2126,7 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	}
 #endif
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
+#if defined(CONFIG_ZMS_LOOKUP_CACHE) || defined(CONFIG_ZMS_LOOKUP_INDEX)
 no_cached_entry:
 #endif
 	/* calculate required space if the entry contains data */
@@ -1498,6 +2151,11 @@ no_cached_entry:
 			goto end;
 		}
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+		/* Leave room for what the pending gc may still have to move */
+		gc_reserve = zms_gc_reserve(fs);
+#endif
+
 		/* We need to make sure that we leave the ATE at address 0x0 of the sector
 		 * empty (even for delete ATE). Otherwise, the fs->ate_wra will be decremented
 		 * after this write by ate_size and it will underflow.
@@ -1505,7 +2163,7 @@ no_cached_entry:
 		 * and the second position could be written only be a delete ATE.
 		 */
 		if ((SECTOR_OFFSET(fs->ate_wra)) &&
-		    (fs->ate_wra >= (fs->data_wra + required_space)) &&
+		    (fs->ate_wra >= (fs->data_wra + required_space + gc_reserve)) &&
 		    (SECTOR_OFFSET(fs->ate_wra - fs->ate_size) || !len)) {
 			rc = zms_flash_write_entry(fs, id, data, len);
 			if (rc) {
@@ -1513,6 +2171,17 @@ no_cached_entry:
 			}
 			break;
 		}
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+		if (zms_gc_pending(fs)) {
+			/* wait for the gc to free enough space */
+			rc = zms_gc_step(fs, CONFIG_ZMS_BACKGROUND_GC_STEP);
+			if (rc) {
+				LOG_ERR("Garbage collection failed, returned = %d", rc);
+				goto end;
+			}
+			continue;
+		}
+#endif
 		rc = zms_sector_close(fs);
 		if (rc) {
 			LOG_ERR("Failed to close the sector, returned = %d", rc);
@@ -1531,12 +2200,34 @@ end:
 	return rc;
 }
 
+ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
+{
+	ssize_t rc;
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* The lookups must not run while the background gc moves and erases ATEs */
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	rc = zms_do_write(fs, id, data, len);
+	k_mutex_unlock(&fs->zms_lock);
+#else
+	rc = zms_do_write(fs, id, data, len);
+#endif
+
+	return rc;
+}
+
 int zms_delete(struct zms_fs *fs, uint32_t id)
 {
 	return zms_write(fs, id, NULL, 0);
 }
 
-ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, uint32_t cnt)
+static ssize_t zms_do_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len,
+				uint32_t cnt)
 {
 	int rc;
 	int prev_found = 0;
@@ -1549,14 +2240,20 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 	uint32_t computed_data_crc;
 #endif
 
-	if (!fs->ready) {
-		LOG_ERR("zms not initialized");
-		return -EACCES;
-	}
-
 	cnt_his = 0U;
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
+#if defined(CONFIG_ZMS_LOOKUP_INDEX)
+	wlk_addr = zms_lookup_index_find(fs, id);
+
+	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
+		if (!cnt) {
+			rc = -ENOENT;
+			goto err;
+		}
+		/* the history of deleted IDs is only found in flash */
+		wlk_addr = fs->ate_wra;
+	}
+#elif defined(CONFIG_ZMS_LOOKUP_CACHE)
 	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
@@ -1633,6 +2330,27 @@ err:
 	return rc;
 }
 
+ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, uint32_t cnt)
+{
+	ssize_t rc;
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* The lookups must not run while the background gc moves and erases ATEs */
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	rc = zms_do_read_hist(fs, id, data, len, cnt);
+	k_mutex_unlock(&fs->zms_lock);
+#else
+	rc = zms_do_read_hist(fs, id, data, len, cnt);
+#endif
+
+	return rc;
+}
+
 ssize_t zms_read(struct zms_fs *fs, uint32_t id, void *data, size_t len)
 {
 	int rc;
@@ -1655,7 +2373,7 @@ ssize_t zms_get_data_length(struct zms_fs *fs, uint32_t id)
 	return rc;
 }
 
-ssize_t zms_calc_free_space(struct zms_fs *fs)
+static ssize_t zms_do_calc_free_space(struct zms_fs *fs)
 {
 	int rc;
 	int previous_sector_num = ZMS_INVALID_SECTOR_NUM;
@@ -1674,11 +2392,6 @@ ssize_t zms_calc_free_space(struct zms_fs *fs)
 	ssize_t free_space = 0;
 	const uint32_t second_to_last_offset = (2 * fs->ate_size);
 
-	if (!fs->ready) {
-		LOG_ERR("zms not initialized");
-		return -EACCES;
-	}
-
 	/*
 	 * There is always a closing ATE , an empty ATE, a GC_done ATE and a reserved ATE for
 	 * deletion in each sector.
@@ -1770,6 +2483,27 @@ ssize_t zms_calc_free_space(struct zms_fs *fs)
 	return free_space;
 }
 
+ssize_t zms_calc_free_space(struct zms_fs *fs)
+{
+	ssize_t rc;
+
+	if (!fs->ready) {
+		LOG_ERR("zms not initialized");
+		return -EACCES;
+	}
+
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* The background gc must not run while the sector cycle is changed here */
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	rc = zms_do_calc_free_space(fs);
+	k_mutex_unlock(&fs->zms_lock);
+#else
+	rc = zms_do_calc_free_space(fs);
+#endif
+
+	return rc;
+}
+
 size_t zms_active_sector_free_space(struct zms_fs *fs)
 {
 	if (!fs->ready) {
@@ -1791,6 +2525,16 @@ int zms_sector_use_next(struct zms_fs *fs)
 
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* the sector after the write sector must be erased before closing it */
+	while (zms_gc_pending(fs)) {
+		ret = zms_gc_step(fs, CONFIG_ZMS_BACKGROUND_GC_STEP);
+		if (ret != 0) {
+			goto end;
+		}
+	}
+#endif
+
 	ret = zms_sector_close(fs);
 	if (ret != 0) {
 		goto end;
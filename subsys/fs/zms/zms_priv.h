@@ -36,11 +36,17 @@
 #define ZMS_MAGIC_NUMBER        0x42 /* murmur3a hash of "ZMS" (MSB) */
 #define ZMS_MAGIC_NUMBER_MASK   GENMASK(15, 8)
 #define ZMS_GET_MAGIC_NUMBER(x) FIELD_GET(ZMS_MAGIC_NUMBER_MASK, x)
+#define ZMS_BACKGROUND_GC_FLAG  BIT(16) /* sector erased with background garbage collection */
 #define ZMS_MIN_ATE_NUM         5
 
 #define ZMS_INVALID_SECTOR_NUM -1
 #define ZMS_DATA_IN_ATE_SIZE   8
 
+/* Background garbage collection states */
+#define ZMS_GC_IDLE     0 /* nothing to do until the write sector is closed */
+#define ZMS_GC_RELOCATE 1 /* moving the ATEs of the oldest sector ahead of time */
+#define ZMS_GC_PENDING  2 /* the sector after the write sector must be garbage collected */
+
 /**
  * @ingroup zms_data_structures
  * ZMS Allocation Table Entry (ATE) structure
@@ -15,6 +15,7 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(llext, CONFIG_LLEXT_LOG_LEVEL);
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "llext_priv.h"
@@ -128,23 +129,49 @@ int llext_iterate(int (*fn)(struct llext *ext, void *arg), void *arg)
 	return ret;
 }
 
+#ifdef CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID
+static int llext_const_sym_slid_cmp(const void *key, const void *elem)
+{
+	uintptr_t slid = *(const uintptr_t *)key;
+	const struct llext_const_symbol *sym = elem;
+
+	return (slid > sym->slid) - (slid < sym->slid);
+}
+#elif defined(CONFIG_LLEXT_EXPORT_BUILTINS_SORTED)
+static int llext_const_sym_name_cmp(const void *key, const void *elem)
+{
+	return strcmp(key, ((const struct llext_const_symbol *)elem)->name);
+}
+#endif
+
+static int llext_sym_name_cmp(const void *key, const void *elem)
+{
+	return strcmp(key, ((const struct llext_symbol *)elem)->name);
+}
+
 const void *llext_find_sym(const struct llext_symtable *sym_table, const char *sym_name)
 {
 	if (sym_table == NULL) {
 		/* Built-in symbol table */
+#if defined(CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID) || defined(CONFIG_LLEXT_EXPORT_BUILTINS_SORTED)
+		const struct llext_const_symbol *syms;
+		const struct llext_const_symbol *sym;
+		size_t sym_cnt;
+
+		/* The table was sorted at build time by scripts/build/llext_prepare_exptab.py */
+		STRUCT_SECTION_GET(llext_const_symbol, 0, &syms);
+		STRUCT_SECTION_COUNT(llext_const_symbol, &sym_cnt);
+
 #ifdef CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID
 		/* 'sym_name' is actually a SLID to search for */
 		uintptr_t slid = (uintptr_t)sym_name;
 
-		/* TODO: perform a binary search instead of linear.
-		 * Note that - as of writing - the llext_const_symbol_area
-		 * section is sorted in ascending SLID order.
-		 * (see scripts/build/llext_prepare_exptab.py)
-		 */
-		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
-			if (slid == sym->slid) {
-				return sym->addr;
-			}
+		sym = bsearch(&slid, syms, sym_cnt, sizeof(*sym), llext_const_sym_slid_cmp);
+#else
+		sym = bsearch(sym_name, syms, sym_cnt, sizeof(*sym), llext_const_sym_name_cmp);
+#endif
+		if (sym != NULL) {
+			return sym->addr;
 		}
 #else
 		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
@@ -154,11 +181,13 @@ const void *llext_find_sym(const struct llext_symtable *sym_table, const char *s
 		}
 #endif
 	} else {
-		/* find symbols in module */
-		for (size_t i = 0; i < sym_table->sym_cnt; i++) {
-			if (strcmp(sym_table->syms[i].name, sym_name) == 0) {
-				return sym_table->syms[i].addr;
-			}
+		/* Extension symbol tables are sorted by name when loading */
+		const struct llext_symbol *sym = bsearch(sym_name, sym_table->syms,
+							 sym_table->sym_cnt, sizeof(*sym),
+							 llext_sym_name_cmp);
+
+		if (sym != NULL) {
+			return sym->addr;
 		}
 	}
 
@@ -15,6 +15,7 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(llext, CONFIG_LLEXT_LOG_LEVEL);
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "llext_priv.h"
@@ -518,6 +519,18 @@ static int llext_allocate_symtab(struct llext_loader *ldr, struct llext *ext)
 	return 0;
 }
 
+static int llext_symbol_cmp(const void *a, const void *b)
+{
+	return strcmp(((const struct llext_symbol *)a)->name,
+		      ((const struct llext_symbol *)b)->name);
+}
+
+/* Sort a symbol table by name, so that llext_find_sym() can binary search it */
+static void llext_sort_symbols(struct llext_symtable *sym_tab)
+{
+	qsort(sym_tab->syms, sym_tab->sym_cnt, sizeof(struct llext_symbol), llext_symbol_cmp);
+}
+
 static int llext_export_symbols(struct llext_loader *ldr, struct llext *ext,
 				const struct llext_load_param *ldr_parm)
 {
@@ -570,6 +583,11 @@ static int llext_export_symbols(struct llext_loader *ldr, struct llext *ext,
 		LOG_DBG("sym %p name %s", sym->addr, sym->name);
 	}
 
+	if (!IS_ENABLED(CONFIG_LLEXT_IMPORT_ALL_GLOBALS)) {
+		/* Symbols copied from the symbol table are already sorted */
+		llext_sort_symbols(exp_tab);
+	}
+
 	return 0;
 }
 
@@ -649,6 +667,10 @@ static int llext_copy_symbols(struct llext_loader *ldr, struct llext *ext,
 		}
 	}
 
+	/* Undefined symbols were counted but not copied */
+	sym_tab->sym_cnt = j;
+	llext_sort_symbols(sym_tab);
+
 	return 0;
 }
 
@@ -58,6 +58,31 @@ static void llext_init_mem_part(struct llext *ext, enum llext_mem mem_idx,
 	LOG_DBG("region %d: start 0x%zx, size %zd", mem_idx, (size_t)start, len);
 }
 
+/*
+ * Check whether a region can be used directly from read-only ELF storage:
+ * it must be written neither by the extension nor by its relocations.
+ */
+static bool llext_region_read_only(struct llext_loader *ldr, struct llext *ext,
+				   enum llext_mem mem_idx)
+{
+	if (!IS_ENABLED(CONFIG_LLEXT_STORAGE_XIP) ||
+	    mem_idx == LLEXT_MEM_DATA || mem_idx == LLEXT_MEM_BSS) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < ext->sect_cnt; i++) {
+		const elf_shdr_t *shdr = ext->sect_hdrs + i;
+
+		if ((shdr->sh_type == SHT_REL || shdr->sh_type == SHT_RELA) &&
+		    shdr->sh_info < ext->sect_cnt &&
+		    ldr->sect_map[shdr->sh_info].mem_idx == mem_idx) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
 			      enum llext_mem mem_idx, const struct llext_load_param *ldr_parm)
 {
@@ -68,7 +93,8 @@ static int llext_copy_section(struct llext_loader *ldr, struct llext *ext,
 	}
 	ext->mem_size[mem_idx] = ldr->sects[mem_idx].sh_size;
 
-	if (IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE)) {
+	if (IS_ENABLED(CONFIG_LLEXT_STORAGE_WRITABLE) ||
+	    llext_region_read_only(ldr, ext, mem_idx)) {
 		if (ldr->sects[mem_idx].sh_type != SHT_NOBITS) {
 			/* Directly use data from the ELF buffer if peek() is supported */
 			ext->mem[mem_idx] = llext_peek(ldr, ldr->sects[mem_idx].sh_offset);
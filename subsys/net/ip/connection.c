@@ -116,6 +116,70 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* UDP and TCP connection handlers are also hashed by protocol and ports,
+ * the remote port only counting if it was specified. Handlers without a
+ * local port are kept in a separate wildcard chain. All of these are
+ * protected by conn_lock.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_hash_wildcard;
+
+static inline uint32_t conn_hash_index(uint16_t proto, uint16_t local_port,
+				       uint16_t remote_port)
+{
+	uint32_t key = (((uint32_t)local_port << 16) | remote_port) ^ proto;
+
+	/* Fibonacci hashing, the top bits are the best mixed */
+	return ((key * 2654435761U) >> 16) % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static sys_slist_t *conn_hash_chain(struct net_conn *conn)
+{
+	uint16_t remote_port = 0U;
+
+	if (conn->family != AF_INET && conn->family != AF_INET6 &&
+	    conn->family != AF_UNSPEC) {
+		return NULL;
+	}
+
+	if (!(conn->flags & NET_CONN_LOCAL_PORT_SPEC)) {
+		return &conn_hash_wildcard;
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_PORT_SPEC) {
+		remote_port = net_sin(&conn->remote_addr)->sin_port;
+	}
+
+	return &conn_hash[conn_hash_index(conn->proto,
+					  net_sin(&conn->local_addr)->sin_port,
+					  remote_port)];
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_t *chain = conn_hash_chain(conn);
+
+	if (chain != NULL) {
+		sys_slist_prepend(chain, &conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held, before the ports change */
+static void conn_hash_del(struct net_conn *conn)
+{
+	sys_slist_t *chain = conn_hash_chain(conn);
+
+	if (chain != NULL) {
+		sys_slist_find_and_remove(chain, &conn->hash_node);
+	}
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +205,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -452,6 +517,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_del(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -476,10 +542,18 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+	conn_hash_del(conn);
+
 	net_conn_change_callback(conn, cb, user_data);
 
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
+	conn_hash_add(conn);
+
+	k_mutex_unlock(&conn_lock);
+
 	return ret;
 }
 
@@ -534,6 +608,122 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+static bool conn_ip_endpoints_match(struct net_conn *conn, struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && net_pkt_family(pkt) == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Same checks as done for UDP and TCP connections in net_conn_input() */
+static bool conn_ip_match(struct net_conn *conn, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr, uint8_t proto,
+			  uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	if (conn->context != NULL &&
+	    net_context_is_bound_to_iface(conn->context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		return false; /* wrong interface */
+	}
+
+	if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
+		if (!IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6) ||
+		    !(conn->family == AF_INET6 && pkt_family == AF_INET && !conn->v6only)) {
+			return false; /* wrong protocol family */
+		}
+	}
+
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	return conn_ip_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+/* Find the best match for a unicast UDP or TCP packet. Only three chains
+ * can hold matching connections: the one of handlers with both ports
+ * specified, the one of handlers with only the local port specified, and
+ * the wildcard chain. The port flags are part of the rank, so handlers
+ * from different chains never tie and the order of the chains does not
+ * matter.
+ */
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto,
+					 uint16_t src_port, uint16_t dst_port)
+{
+	sys_slist_t *chains[] = {
+		&conn_hash[conn_hash_index(proto, dst_port, src_port)],
+		&conn_hash[conn_hash_index(proto, dst_port, 0)],
+		&conn_hash_wildcard,
+	};
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+
+	for (int i = 0; i < ARRAY_SIZE(chains); i++) {
+		if (i == 1 && chains[1] == chains[0]) {
+			continue;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(chains[i], conn, hash_node) {
+			if (!conn_ip_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+				continue;
+			}
+
+			if (best_rank < NET_CONN_RANK(conn->flags)) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				best_match = conn;
+			}
+		}
+	}
+
+	return best_match;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -710,6 +900,17 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if ((pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP) && !is_mcast_pkt) {
+		/* Multicast packets go to all the matching handlers, in
+		 * registration order, so they still scan the whole list.
+		 */
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+		goto found;
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -798,43 +999,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 			/* Is the candidate connection matching the packet's TCP/UDP
 			 * address and port?
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			if (!conn_ip_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -878,6 +1044,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+#if defined(CONFIG_NET_CONN_HASH)
+found:
+#endif
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -965,6 +1134,14 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < ARRAY_SIZE(conn_hash); i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+
+	sys_slist_init(&conn_hash_wildcard);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -0,0 +1,360 @@
+/** @file
+ * @brief TCP generic receive offload
+ *
+ * In-order TCP segments of a connection arriving back to back are merged
+ * into one packet before they reach the connection handler, so that TCP
+ * processes a burst of segments only once. Each RX thread holds at most
+ * one packet per connection, and passes everything on as soon as its
+ * queue runs empty.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+#include "connection.h"
+#include "tcp_internal.h"
+#include "gro.h"
+
+struct gro_flow {
+	/* Held packet, NULL if the entry is free */
+	struct net_pkt *pkt;
+	/* Last buffer of the held packet */
+	struct net_buf *tail;
+	/* Sequence number the next segment must have */
+	uint32_t next_seq;
+	/* TCP payload collected so far */
+	uint32_t data_len;
+	/* IP and TCP header length */
+	uint16_t hdr_len;
+	/* Segments have been merged into the held packet */
+	bool merged;
+};
+
+struct gro_table {
+	k_tid_t owner;
+	uint8_t next_evict;
+	struct gro_flow flows[CONFIG_NET_TCP_GRO_FLOWS];
+};
+
+static struct gro_table gro_tables[NET_TC_RX_COUNT];
+static struct k_spinlock gro_lock;
+
+void net_gro_register_thread(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&gro_lock);
+
+	ARRAY_FOR_EACH(gro_tables, i) {
+		if (gro_tables[i].owner == NULL) {
+			gro_tables[i].owner = k_current_get();
+			break;
+		}
+	}
+
+	k_spin_unlock(&gro_lock, key);
+}
+
+static struct gro_table *gro_table_get(void)
+{
+	k_tid_t tid = k_current_get();
+
+	ARRAY_FOR_EACH(gro_tables, i) {
+		if (gro_tables[i].owner == tid) {
+			return &gro_tables[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct tcphdr *gro_tcp_hdr(struct net_pkt *pkt)
+{
+	return (struct tcphdr *)(pkt->buffer->data + net_pkt_ip_hdr_len(pkt));
+}
+
+/* Return the header length of a segment that can be coalesced, 0 if the
+ * segment must be passed on as is. Only plain data segments with the
+ * headers in the first buffer qualify.
+ */
+static size_t gro_hdr_len(struct net_pkt *pkt)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt);
+	struct net_buf *buf = pkt->buffer;
+	struct tcphdr *th;
+	size_t hdr_len;
+	size_t ip_total;
+
+	if (net_pkt_ip_opts_len(pkt) > 0 || net_pkt_is_ip_reassembled(pkt) ||
+	    buf->len < ip_len + sizeof(struct tcphdr)) {
+		return 0;
+	}
+
+	th = gro_tcp_hdr(pkt);
+	hdr_len = ip_len + th_off(th) * 4U;
+
+	if (buf->len < hdr_len || (th_flags(th) & ~PSH) != ACK) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip_total = ntohs(NET_IPV4_HDR(pkt)->len);
+	} else {
+		ip_total = ntohs(NET_IPV6_HDR(pkt)->len) + NET_IPV6H_LEN;
+	}
+
+	/* No link layer padding, and some payload */
+	if (ip_total != net_pkt_get_len(pkt) || ip_total <= hdr_len) {
+		return 0;
+	}
+
+	return hdr_len;
+}
+
+static bool gro_same_flow(struct net_pkt *held, struct net_pkt *pkt)
+{
+	if (net_pkt_iface(held) != net_pkt_iface(pkt) ||
+	    net_pkt_family(held) != net_pkt_family(pkt)) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		if (memcmp(NET_IPV4_HDR(held)->src, NET_IPV4_HDR(pkt)->src,
+			   sizeof(struct in_addr)) != 0 ||
+		    memcmp(NET_IPV4_HDR(held)->dst, NET_IPV4_HDR(pkt)->dst,
+			   sizeof(struct in_addr)) != 0) {
+			return false;
+		}
+	} else {
+		if (memcmp(NET_IPV6_HDR(held)->src, NET_IPV6_HDR(pkt)->src,
+			   sizeof(struct in6_addr)) != 0 ||
+		    memcmp(NET_IPV6_HDR(held)->dst, NET_IPV6_HDR(pkt)->dst,
+			   sizeof(struct in6_addr)) != 0) {
+			return false;
+		}
+	}
+
+	return th_sport(gro_tcp_hdr(held)) == th_sport(gro_tcp_hdr(pkt)) &&
+	       th_dport(gro_tcp_hdr(held)) == th_dport(gro_tcp_hdr(pkt));
+}
+
+static bool gro_can_merge(struct gro_flow *flow, struct net_pkt *pkt,
+			  size_t hdr_len)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt);
+	struct tcphdr *held = gro_tcp_hdr(flow->pkt);
+	struct tcphdr *th = gro_tcp_hdr(pkt);
+
+	if (hdr_len != flow->hdr_len || th_seq(th) != flow->next_seq ||
+	    flow->data_len + net_pkt_get_len(pkt) - hdr_len >
+	    CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	/* Same traffic class, acknowledgment, window and options */
+	return memcmp(flow->pkt->buffer->data, pkt->buffer->data, 2) == 0 &&
+	       th_ack(held) == th_ack(th) && th_win(held) == th_win(th) &&
+	       memcmp((uint8_t *)held + sizeof(struct tcphdr),
+		      (uint8_t *)th + sizeof(struct tcphdr),
+		      hdr_len - ip_len - sizeof(struct tcphdr)) == 0;
+}
+
+static void gro_update_ip_hdr(struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+
+#if defined(CONFIG_NET_IPV4)
+	if (net_pkt_family(pkt) == AF_INET) {
+		NET_IPV4_HDR(pkt)->len = htons(len);
+		NET_IPV4_HDR(pkt)->chksum = 0U;
+		NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+		return;
+	}
+#endif
+
+	NET_IPV6_HDR(pkt)->len = htons(len - NET_IPV6H_LEN);
+}
+
+static void gro_deliver(struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+	size_t ip_len = net_pkt_ip_hdr_len(pkt);
+	union net_proto_header proto_hdr;
+	union net_ip_header ip;
+	enum net_verdict verdict;
+
+	flow->pkt = NULL;
+
+	if (flow->merged) {
+		gro_update_ip_hdr(pkt);
+	}
+
+	/* Leave the cursor where the TCP input leaves it */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	(void)net_pkt_skip(pkt, ip_len + sizeof(struct net_tcp_hdr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip.ipv4 = NET_IPV4_HDR(pkt);
+	} else {
+		ip.ipv6 = NET_IPV6_HDR(pkt);
+	}
+
+	proto_hdr.tcp = (struct net_tcp_hdr *)gro_tcp_hdr(pkt);
+
+	verdict = net_conn_input(pkt, &ip, IPPROTO_TCP, &proto_hdr);
+	if (verdict == NET_OK) {
+		return;
+	}
+
+	if (verdict == NET_DROP) {
+		if (net_pkt_family(pkt) == AF_INET) {
+			net_stats_update_ipv4_drop(net_pkt_iface(pkt));
+		} else {
+			net_stats_update_ipv6_drop(net_pkt_iface(pkt));
+		}
+	}
+
+	NET_DBG("Dropping pkt %p", pkt);
+	net_pkt_unref(pkt);
+}
+
+static struct gro_flow *gro_flow_get(struct gro_table *table)
+{
+	struct gro_flow *flow;
+
+	ARRAY_FOR_EACH(table->flows, i) {
+		if (table->flows[i].pkt == NULL) {
+			return &table->flows[i];
+		}
+	}
+
+	/* All in use, pass one of them on */
+	flow = &table->flows[table->next_evict];
+	table->next_evict = (table->next_evict + 1) % ARRAY_SIZE(table->flows);
+
+	gro_deliver(flow);
+
+	return flow;
+}
+
+static void gro_hold(struct gro_flow *flow, struct net_pkt *pkt,
+		     size_t hdr_len)
+{
+	size_t data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	flow->pkt = pkt;
+	flow->tail = net_buf_frag_last(pkt->buffer);
+	flow->next_seq = th_seq(gro_tcp_hdr(pkt)) + data_len;
+	flow->data_len = data_len;
+	flow->hdr_len = hdr_len;
+	flow->merged = false;
+}
+
+/* Append the payload of the segment to the held packet */
+static void gro_merge(struct gro_flow *flow, struct net_pkt *pkt,
+		      size_t hdr_len)
+{
+	size_t data_len = net_pkt_get_len(pkt) - hdr_len;
+	struct tcphdr *held = gro_tcp_hdr(flow->pkt);
+	struct net_buf *buf = pkt->buffer;
+
+	if (th_flags(gro_tcp_hdr(pkt)) & PSH) {
+		UNALIGNED_PUT(th_flags(held) | PSH, &held->th_flags);
+	}
+
+	net_buf_pull(buf, hdr_len);
+	if (buf->len == 0U) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	flow->tail->frags = buf;
+	flow->tail = net_buf_frag_last(buf);
+	flow->next_seq += data_len;
+	flow->data_len += data_len;
+	flow->merged = true;
+}
+
+enum net_verdict net_gro_receive(struct net_pkt *pkt)
+{
+	struct gro_table *table = gro_table_get();
+	struct gro_flow *flow = NULL;
+	size_t hdr_len;
+	bool push;
+
+	if (table == NULL) {
+		return NET_CONTINUE;
+	}
+
+	ARRAY_FOR_EACH(table->flows, i) {
+		if (table->flows[i].pkt != NULL &&
+		    gro_same_flow(table->flows[i].pkt, pkt)) {
+			flow = &table->flows[i];
+			break;
+		}
+	}
+
+	hdr_len = gro_hdr_len(pkt);
+	if (hdr_len == 0U) {
+		/* Keep the segments of the connection in order */
+		if (flow != NULL) {
+			gro_deliver(flow);
+		}
+
+		return NET_CONTINUE;
+	}
+
+	push = th_flags(gro_tcp_hdr(pkt)) & PSH;
+
+	if (flow != NULL && gro_can_merge(flow, pkt, hdr_len)) {
+		gro_merge(flow, pkt, hdr_len);
+
+		if (push || flow->data_len >= CONFIG_NET_TCP_GRO_MAX_SIZE) {
+			gro_deliver(flow);
+		}
+
+		return NET_OK;
+	}
+
+	if (flow != NULL) {
+		gro_deliver(flow);
+	}
+
+	if (push) {
+		return NET_CONTINUE;
+	}
+
+	flow = gro_flow_get(table);
+	gro_hold(flow, pkt, hdr_len);
+
+	return NET_OK;
+}
+
+void net_gro_flush(void)
+{
+	struct gro_table *table = gro_table_get();
+
+	if (table == NULL) {
+		return;
+	}
+
+	ARRAY_FOR_EACH(table->flows, i) {
+		if (table->flows[i].pkt != NULL) {
+			gro_deliver(&table->flows[i]);
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/** @file
+ * @brief TCP generic receive offload
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GRO_H
+#define __NET_GRO_H
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Let the calling RX thread coalesce TCP segments
+ *
+ * Segments are only held by registered threads, which must call
+ * net_gro_flush() whenever they run out of packets to process.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_gro_register_thread(void);
+#else
+static inline void net_gro_register_thread(void)
+{
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+/** Offer a received TCP segment for coalescing
+ *
+ * The IP and TCP headers of the segment must have been validated, and
+ * its checksum verified.
+ *
+ * @param pkt Received TCP segment
+ *
+ * @return NET_OK if the segment was held or merged into a held one,
+ *         NET_CONTINUE if the caller has to pass it on to the connection
+ *         handler.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+enum net_verdict net_gro_receive(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_gro_receive(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+/** Pass on all the segments held by the calling thread */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_gro_flush(void);
+#else
+static inline void net_gro_flush(void)
+{
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GRO_H */
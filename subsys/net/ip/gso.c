@@ -0,0 +1,278 @@
+/** @file
+ * @brief TCP generic segmentation offload
+ *
+ * TCP hands super-packets carrying several MSS worth of data to the IP
+ * stack. They are split into MSS sized segments only right before they
+ * are queued to the network interface, unless the driver does the
+ * segmentation itself.
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+#include "gso.h"
+
+bool net_gso_supported(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return true;
+	}
+#endif
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return true;
+	}
+#endif
+
+	return false;
+}
+
+bool net_gso_hw_offload(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return !!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO);
+	}
+#endif
+
+	return false;
+}
+
+/* Cut the buffer chain of the packet right after the headers, and return
+ * the payload part. Normally TCP puts the headers in buffers of their own,
+ * if not, the buffer holding both is cloned.
+ */
+static struct net_buf *gso_split_headers(struct net_pkt *pkt, size_t hdr_len,
+					 k_timeout_t timeout)
+{
+	struct net_buf *buf = pkt->buffer;
+	struct net_buf *payload;
+
+	while (buf && hdr_len > buf->len) {
+		hdr_len -= buf->len;
+		buf = buf->frags;
+	}
+
+	if (!buf) {
+		return NULL;
+	}
+
+	if (hdr_len == buf->len) {
+		payload = buf->frags;
+	} else {
+		payload = net_buf_clone(buf, timeout);
+		if (!payload) {
+			return NULL;
+		}
+
+		net_buf_pull(payload, hdr_len);
+		payload->frags = buf->frags;
+		buf->len = hdr_len;
+	}
+
+	buf->frags = NULL;
+
+	return payload;
+}
+
+/* Move len bytes from the head of the payload chain to the end of the
+ * segment. Whole buffers are moved as is, only the leading part of a
+ * buffer straddling the end of the segment is copied.
+ */
+static int gso_move_payload(struct net_pkt *seg, struct net_buf **payload,
+			    size_t len, k_timeout_t timeout)
+{
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
+	struct net_buf *buf;
+	int ret = 0;
+
+	while (len > 0 && *payload) {
+		if ((*payload)->len <= len) {
+			buf = *payload;
+			*payload = buf->frags;
+			buf->frags = NULL;
+		} else {
+			size_t copy;
+
+			buf = net_pkt_get_frag(seg, len, timeout);
+			if (!buf) {
+				ret = -ENOBUFS;
+				break;
+			}
+
+			copy = MIN(len, net_buf_tailroom(buf));
+			net_buf_add_mem(buf, (*payload)->data, copy);
+			net_buf_pull(*payload, copy);
+		}
+
+		len -= buf->len;
+
+		if (tail) {
+			tail->frags = buf;
+		} else {
+			head = buf;
+		}
+
+		tail = buf;
+	}
+
+	if (head) {
+		net_pkt_append_buffer(seg, head);
+	}
+
+	if (ret == 0 && len > 0) {
+		ret = -EINVAL;
+	}
+
+	return ret;
+}
+
+static int gso_finalize(struct net_pkt *seg, uint32_t seq, uint8_t flags)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct tcphdr *th;
+
+	net_pkt_set_gso_size(seg, 0);
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) + net_pkt_ip_opts_len(seg))) {
+		return -ENOBUFS;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	UNALIGNED_PUT(htonl(seq), &th->th_seq);
+	UNALIGNED_PUT(flags, &th->th_flags);
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_IPV4_HDR(seg)->chksum = 0U;
+
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		return net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
+
+int net_gso_segment(struct net_pkt *pkt, net_gso_output_cb_t cb,
+		    void *user_data, k_timeout_t timeout)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_buf *payload;
+	struct tcphdr *th;
+	size_t hdr_len;
+	size_t data_len;
+	uint32_t seq;
+	uint8_t flags;
+	int ret = 0;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4U;
+	seq = th_seq(th);
+	flags = th_flags(th);
+
+	if (mss == 0U || net_pkt_get_len(pkt) <= hdr_len) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	payload = gso_split_headers(pkt, hdr_len, timeout);
+	if (!payload) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("Segmenting pkt %p, %zu bytes in %u byte segments",
+		pkt, data_len, mss);
+
+	while (data_len > 0) {
+		size_t seg_len = MIN(data_len, mss);
+		struct net_pkt *seg;
+
+		/* The super-packet holds the headers only by now */
+		seg = net_pkt_clone(pkt, timeout);
+		if (!seg) {
+			ret = -ENOBUFS;
+			break;
+		}
+
+		ret = gso_move_payload(seg, &payload, seg_len, timeout);
+		if (ret == 0) {
+			/* PSH and FIN belong to the last segment only */
+			ret = gso_finalize(seg, seq, seg_len < data_len ?
+					   flags & ~(PSH | FIN) : flags);
+		}
+
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		ret = cb(seg, user_data);
+		if (ret < 0) {
+			break;
+		}
+
+		seq += seg_len;
+		data_len -= seg_len;
+	}
+
+	if (payload) {
+		net_buf_unref(payload);
+	}
+
+	if (ret < 0) {
+		NET_DBG("Segmenting pkt %p failed (%d)", pkt, ret);
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+/** @file
+ * @brief TCP generic segmentation offload
+ */
+
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GSO_H
+#define __NET_GSO_H
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef net_gso_output_cb_t
+ * @brief Callback receiving the segments of a TCP super-packet.
+ *
+ * The callback owns the segment, also when it returns an error.
+ *
+ * @param seg Segment to send
+ * @param user_data User specified data
+ *
+ * @return 0 if ok, <0 if the segment could not be sent
+ */
+typedef int (*net_gso_output_cb_t)(struct net_pkt *seg, void *user_data);
+
+/** Check if TCP can send super-packets on the given interface
+ *
+ * @param iface Network interface
+ *
+ * @return True if super-packets can be sent, false otherwise
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+bool net_gso_supported(struct net_if *iface);
+#else
+static inline bool net_gso_supported(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/** Check if the driver of the given interface segments super-packets
+ *
+ * @param iface Network interface
+ *
+ * @return True if the driver advertises ETHERNET_HW_TSO, false otherwise
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+bool net_gso_hw_offload(struct net_if *iface);
+#else
+static inline bool net_gso_hw_offload(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/** Split a TCP super-packet into segments of net_pkt_gso_size() bytes
+ *
+ * The payload buffers of the super-packet are moved to the segments,
+ * only a buffer straddling a segment boundary is partially copied. The
+ * IP and TCP headers are copied to each segment and finalized there.
+ *
+ * @param pkt Super-packet. It is released if 0 is returned, otherwise
+ *            it is left to the caller, and any segment handed to @p cb
+ *            before the failure is not taken back.
+ * @param cb Callback receiving the segments in order
+ * @param user_data User specified data passed to @p cb
+ * @param timeout Timeout for allocating the segments
+ *
+ * @return 0 if ok, <0 if error
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_gso_segment(struct net_pkt *pkt, net_gso_output_cb_t cb,
+		    void *user_data, k_timeout_t timeout);
+#else
+static inline int net_gso_segment(struct net_pkt *pkt, net_gso_output_cb_t cb,
+				  void *user_data, k_timeout_t timeout)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+	ARG_UNUSED(timeout);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GSO_H */
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 #include "dhcpv4/dhcpv4_internal.h"
 #include "ipv4.h"
 #include "pmtu.h"
+#include "gro.h"
 
 BUILD_ASSERT(sizeof(struct in_addr) == NET_IPV4_ADDR_SIZE);
 
@@ -442,6 +443,13 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 
 	ip.ipv4 = hdr;
 
+	if (hdr->proto == IPPROTO_TCP) {
+		verdict = net_gro_receive(pkt);
+		if (verdict != NET_CONTINUE) {
+			return verdict;
+		}
+	}
+
 	verdict = net_conn_input(pkt, &ip, hdr->proto, &proto_hdr);
 	if (verdict != NET_DROP) {
 		return verdict;
@@ -41,6 +41,7 @@ LOG_MODULE_REGISTER(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "6lo.h"
 #include "route.h"
 #include "net_stats.h"
+#include "gro.h"
 
 BUILD_ASSERT(sizeof(struct in6_addr) == NET_IPV6_ADDR_SIZE);
 
@@ -818,6 +819,13 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 	ip.ipv6 = hdr;
 
+	if (current_hdr == IPPROTO_TCP) {
+		verdict = net_gro_receive(pkt);
+		if (verdict != NET_CONTINUE) {
+			return verdict;
+		}
+	}
+
 	verdict = net_conn_input(pkt, &ip, current_hdr, &proto_hdr);
 
 	NET_DBG("%s verdict %s", "Connection", net_verdict2str(verdict));
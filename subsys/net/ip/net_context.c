@@ -2033,12 +2033,195 @@ static int get_context_local_port_range(struct net_context *context,
 #endif
 }
 
+static int get_context_zerocopy(struct net_context *context,
+				void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (len == NULL || *len != sizeof(struct net_context_zerocopy)) {
+		return -EINVAL;
+	}
+
+	*((struct net_context_zerocopy *)value) = context->options.zerocopy;
+
+	return 0;
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+struct zerocopy_buf_info {
+	net_context_zerocopy_cb_t cb;
+	void *user_data;
+	const void *data;
+	size_t len;
+};
+
+static void zerocopy_buf_destroy(struct net_buf *buf);
+
+/* Descriptors only, the data itself is owned by the application */
+NET_BUF_POOL_DEFINE(zerocopy_bufs, CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT,
+		    0, sizeof(struct zerocopy_buf_info), zerocopy_buf_destroy);
+
+static void zerocopy_buf_destroy(struct net_buf *buf)
+{
+	struct zerocopy_buf_info info =
+		*(struct zerocopy_buf_info *)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+
+	if (info.cb != NULL) {
+		info.cb(info.data, info.len, info.user_data);
+	}
+}
+
+struct net_buf *net_context_zerocopy_buf_get(struct net_context *context,
+					     const void *data, size_t len)
+{
+	struct zerocopy_buf_info *info;
+	struct net_buf *buf;
+
+	buf = net_buf_alloc_with_data(&zerocopy_bufs, (void *)data, len,
+				      K_NO_WAIT);
+	if (buf == NULL) {
+		NET_DBG("Out of zero-copy buffers");
+		return NULL;
+	}
+
+	info = net_buf_user_data(buf);
+	info->cb = context->options.zerocopy.cb;
+	info->user_data = context->options.zerocopy.user_data;
+	info->data = data;
+	info->len = len;
+
+	return buf;
+}
+
+void net_context_zerocopy_disarm(struct net_buf *frags)
+{
+	for (; frags != NULL; frags = frags->frags) {
+		if (frags->pool_id == net_buf_pool_id(&zerocopy_bufs)) {
+			((struct zerocopy_buf_info *)net_buf_user_data(frags))->cb = NULL;
+		}
+	}
+}
+
+/* Wrap every iovec entry into an external net_buf. All or nothing: if the
+ * descriptor pool runs out, the partial chain is released without notifying
+ * the application, as none of its data was taken.
+ */
+static struct net_buf *context_zerocopy_frags_get(struct net_context *context,
+						  const struct msghdr *msghdr,
+						  size_t len)
+{
+	struct net_buf *head = NULL;
+	struct net_buf *frag;
+
+	for (int i = 0; i < msghdr->msg_iovlen && len > 0; i++) {
+		size_t iov_len = MIN(msghdr->msg_iov[i].iov_len, len);
+
+		if (iov_len == 0) {
+			continue;
+		}
+
+		frag = net_context_zerocopy_buf_get(context,
+						    msghdr->msg_iov[i].iov_base,
+						    iov_len);
+		if (frag == NULL) {
+			net_context_zerocopy_disarm(head);
+			net_buf_unref(head);
+			return NULL;
+		}
+
+		head = head == NULL ? frag : net_buf_frag_add(head, frag);
+		len -= iov_len;
+	}
+
+	return head;
+}
+
+static bool context_zerocopy_requested(struct net_context *context,
+				       const struct msghdr *msghdr, int flags)
+{
+	return msghdr != NULL && (flags & ZSOCK_MSG_ZEROCOPY) &&
+	       context->options.zerocopy.cb != NULL;
+}
+
+/* A zero-copy datagram must fit into one IP packet, as IP fragmentation
+ * would copy it anyway.
+ */
+static size_t context_zerocopy_udp_max_len(struct net_context *context,
+					   sa_family_t family)
+{
+	size_t mtu = net_if_get_mtu(net_context_get_iface(context));
+	size_t hdr_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		mtu = mtu ? mtu : NET_IPV6_MTU;
+		hdr_len = NET_IPV6UDPH_LEN;
+	} else {
+		mtu = mtu ? mtu : NET_IPV4_MTU;
+		hdr_len = NET_IPV4UDPH_LEN;
+	}
+
+	return mtu > hdr_len ? mtu - hdr_len : 0;
+}
+#else
+static inline struct net_buf *context_zerocopy_frags_get(struct net_context *context,
+							 const struct msghdr *msghdr,
+							 size_t len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(msghdr);
+	ARG_UNUSED(len);
+
+	return NULL;
+}
+
+static inline bool context_zerocopy_requested(struct net_context *context,
+					      const struct msghdr *msghdr,
+					      int flags)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(msghdr);
+	ARG_UNUSED(flags);
+
+	return false;
+}
+
+static inline size_t context_zerocopy_udp_max_len(struct net_context *context,
+						  sa_family_t family)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(family);
+
+	return 0;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
+/* Write data to net_pkt, summing it up for the checksum if sum is not NULL */
+static int context_write_chunk(struct net_pkt *pkt, const void *data,
+			       int len, uint16_t *sum, bool *odd)
+{
+	if (sum != NULL) {
+		return net_pkt_write_chksum_cont(pkt, data, len, sum, odd);
+	}
+
+	return net_pkt_write(pkt, data, len);
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      uint16_t *sum)
 {
+	bool odd = false;
 	int ret = 0;
 
 	if (msghdr) {
@@ -2047,8 +2230,8 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
 			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
 
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    len);
+			ret = context_write_chunk(pkt, msghdr->msg_iov[i].iov_base,
+						  len, sum, &odd);
 			if (ret < 0) {
 				break;
 			}
@@ -2059,7 +2242,7 @@ static int context_write_data(struct net_pkt *pkt, const void *buf,
 			}
 		}
 	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+		ret = context_write_chunk(pkt, buf, buf_len, sum, &odd);
 	}
 
 	return ret;
@@ -2071,6 +2254,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_buf *zc_frags,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -2110,9 +2294,31 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
-	if (ret) {
-		return ret;
+	if (zc_frags != NULL) {
+		/* The payload is referenced, not copied, after the headers */
+		net_pkt_append_buffer(pkt, zc_frags);
+	} else if (IS_ENABLED(CONFIG_NET_NATIVE_IP) && len <= UINT16_MAX &&
+		   net_if_need_calc_tx_checksum(net_pkt_iface(pkt),
+						family == AF_INET6 ?
+						NET_IF_CHECKSUM_IPV6_UDP :
+						NET_IF_CHECKSUM_IPV4_UDP)) {
+		size_t hdr_len = net_pkt_get_len(pkt);
+		uint16_t sum = 0U;
+
+		/* Sum the payload up while copying it, so that
+		 * net_udp_finalize() only has to sum the headers.
+		 */
+		ret = context_write_data(pkt, buf, len, msg, &sum);
+		if (ret) {
+			return ret;
+		}
+
+		net_pkt_set_payload_chksum(pkt, sum, net_pkt_get_len(pkt) - hdr_len);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg, NULL);
+		if (ret) {
+			return ret;
+		}
 	}
 
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
@@ -2207,11 +2413,14 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
+			  int flags,
 			  bool sendto)
 {
 	const struct msghdr *msghdr = NULL;
+	struct net_buf *zc_frags = NULL;
 	struct net_if *iface = NULL;
 	struct net_pkt *pkt = NULL;
+	bool zerocopy = false;
 	sa_family_t family;
 	size_t tmp_len;
 	int ret;
@@ -2468,6 +2677,14 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
+	if (context_zerocopy_requested(context, msghdr, flags)) {
+		if (net_if_is_ip_offloaded(iface)) {
+			return -EOPNOTSUPP;
+		}
+
+		zerocopy = true;
+	}
+
 	context->send_cb = cb;
 	context->user_data = user_data;
 
@@ -2477,15 +2694,29 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	if (zerocopy && net_context_get_proto(context) == IPPROTO_UDP) {
+		if (len > context_zerocopy_udp_max_len(context, family)) {
+			return -EMSGSIZE;
+		}
+
+		zc_frags = context_zerocopy_frags_get(context, msghdr, len);
+		if (zc_frags == NULL) {
+			return -ENOBUFS;
+		}
+	}
+
+	/* With zero-copy only the headers are allocated */
+	pkt = context_alloc_pkt(context, family, zc_frags ? 0 : len,
+				PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
-		return -ENOBUFS;
+		ret = -ENOBUFS;
+		goto fail;
 	}
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (zc_frags == NULL && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -2519,7 +2750,7 @@ static int context_sendto(struct net_context *context,
 skip_alloc:
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2537,18 +2768,21 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       zc_frags, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		/* Owned by the packet from now on */
+		zc_frags = NULL;
+
 		context_finalize_packet(context, family, pkt);
 
 		ret = net_try_send_data(pkt, timeout);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr, zerocopy);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2557,7 +2791,7 @@ skip_alloc:
 
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && family == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2613,7 +2847,7 @@ skip_alloc:
 		}
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && family == AF_CAN &&
 		   net_context_get_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2633,7 +2867,19 @@ skip_alloc:
 
 	return len;
 fail:
+	/* The send failed, so the application keeps ownership of its data
+	 * and must not get a completion for it.
+	 */
+	if (zc_frags != NULL) {
+		net_context_zerocopy_disarm(zc_frags);
+		net_buf_unref(zc_frags);
+	}
+
 	if (pkt != NULL) {
+		if (zerocopy) {
+			net_context_zerocopy_disarm(pkt->buffer);
+		}
+
 		net_pkt_unref(pkt);
 	}
 
@@ -2676,7 +2922,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, 0, false);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2695,7 +2941,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, flags, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -2716,7 +2962,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, 0, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -3129,6 +3375,26 @@ static int set_context_txtime(struct net_context *context,
 #endif
 }
 
+static int set_context_zerocopy(struct net_context *context,
+				const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (len != sizeof(struct net_context_zerocopy)) {
+		return -EINVAL;
+	}
+
+	context->options.zerocopy = *((const struct net_context_zerocopy *)value);
+
+	return 0;
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_proxy(struct net_context *context,
 			     const void *value, size_t len)
 {
@@ -3652,6 +3918,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_LOCAL_PORT_RANGE:
 		ret = set_context_local_port_range(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = set_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -3737,6 +4006,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_LOCAL_PORT_RANGE:
 		ret = get_context_local_port_range(context, value, len);
 		break;
+	case NET_OPT_ZEROCOPY:
+		ret = get_context_zerocopy(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -41,6 +41,7 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #include "shell/net_shell.h"
 
 #include "pmtu.h"
+#include "gso.h"
 
 #include "icmpv6.h"
 #include "ipv6.h"
@@ -363,6 +364,49 @@ drop:
 	return ret;
 }
 
+static void update_sent_stats(struct net_if *iface, sa_family_t family)
+{
+	if (IS_ENABLED(CONFIG_NET_STATISTICS)) {
+		switch (family) {
+		case AF_INET:
+			net_stats_update_ipv4_sent(iface);
+			break;
+		case AF_INET6:
+			net_stats_update_ipv6_sent(iface);
+			break;
+		}
+	}
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+struct gso_send_params {
+	k_timeout_t timeout;
+	bool loopback;
+};
+
+static int gso_send_segment(struct net_pkt *seg, void *user_data)
+{
+	struct gso_send_params *params = user_data;
+	struct net_if *iface = net_pkt_iface(seg);
+	sa_family_t family = net_pkt_family(seg);
+
+	if (params->loopback) {
+		processing_data(seg, true);
+		return 0;
+	}
+
+	/* The segment may be gone once it is queued */
+	if (net_if_try_send_data(iface, seg, params->timeout) == NET_DROP) {
+		net_pkt_unref(seg);
+		return -EIO;
+	}
+
+	update_sent_stats(iface, family);
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 {
 	int status;
@@ -396,7 +440,25 @@ int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 		}
 
 		return status;
-	} else if (status > 0) {
+	}
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP super-packets are split here, as late as possible, unless
+	 * the driver does it.
+	 */
+	if (net_pkt_gso_size(pkt) > 0 &&
+	    (status > 0 || !net_gso_hw_offload(net_pkt_iface(pkt)))) {
+		struct gso_send_params params = {
+			.timeout = timeout,
+			.loopback = status > 0,
+		};
+
+		ret = net_gso_segment(pkt, gso_send_segment, &params, timeout);
+		goto err;
+	}
+#endif /* CONFIG_NET_TCP_GSO */
+
+	if (status > 0) {
 		/* Packet is destined back to us so send it directly
 		 * to RX processing.
 		 */
@@ -411,16 +473,7 @@ int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 		goto err;
 	}
 
-	if (IS_ENABLED(CONFIG_NET_STATISTICS)) {
-		switch (net_pkt_family(pkt)) {
-		case AF_INET:
-			net_stats_update_ipv4_sent(net_pkt_iface(pkt));
-			break;
-		case AF_INET6:
-			net_stats_update_ipv6_sent(net_pkt_iface(pkt));
-			break;
-		}
-	}
+	update_sent_stats(net_pkt_iface(pkt), net_pkt_family(pkt));
 
 	ret = 0;
 
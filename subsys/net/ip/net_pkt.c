@@ -1826,10 +1826,11 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
-				  bool copy, bool write)
+				  bool copy, bool write, uint16_t *sum)
 {
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
+	bool odd = false;
 
 	while (c_op->buf && length) {
 		size_t d_len, len;
@@ -1857,7 +1858,21 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			len = d_len;
 		}
 
-		if (copy && data) {
+		if (!IS_ENABLED(CONFIG_NET_RAW_MODE) && copy && data && sum) {
+			/* Each chunk is summed as if it started at an even
+			 * offset, so swap the sum around the odd ones.
+			 */
+			if (odd) {
+				*sum = BSWAP_16(calc_chksum_copy(BSWAP_16(*sum),
+								 c_op->pos,
+								 data, len));
+			} else {
+				*sum = calc_chksum_copy(*sum, c_op->pos,
+							data, len);
+			}
+
+			odd ^= (len & 1U);
+		} else if (copy && data) {
 			memcpy(write ? c_op->pos : data,
 			       write ? data : c_op->pos,
 			       len);
@@ -1890,21 +1905,21 @@ int net_pkt_skip(struct net_pkt *pkt, size_t skip)
 {
 	NET_DBG("pkt %p skip %zu", pkt, skip);
 
-	return net_pkt_cursor_operate(pkt, NULL, skip, false, true);
+	return net_pkt_cursor_operate(pkt, NULL, skip, false, true, NULL);
 }
 
 int net_pkt_memset(struct net_pkt *pkt, int byte, size_t amount)
 {
 	NET_DBG("pkt %p byte %d amount %zu", pkt, byte, amount);
 
-	return net_pkt_cursor_operate(pkt, &byte, amount, false, true);
+	return net_pkt_cursor_operate(pkt, &byte, amount, false, true, NULL);
 }
 
 int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	return net_pkt_cursor_operate(pkt, data, length, true, false);
+	return net_pkt_cursor_operate(pkt, data, length, true, false, NULL);
 }
 
 int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
@@ -1951,8 +1966,20 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 		return net_pkt_skip(pkt, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      NULL);
+}
+
+#if !defined(CONFIG_NET_RAW_MODE)
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *sum)
+{
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true,
+				      sum);
 }
+#endif /* CONFIG_NET_RAW_MODE */
 
 int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
@@ -2085,6 +2112,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_forwarding(clone_pkt, net_pkt_forwarding(pkt));
 	net_pkt_set_chksum_done(clone_pkt, net_pkt_is_chksum_done(pkt));
 	net_pkt_set_ip_reassembled(pkt, net_pkt_is_ip_reassembled(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_cooked_mode(clone_pkt, net_pkt_is_cooked_mode(pkt));
 	net_pkt_set_ipv4_pmtu(clone_pkt, net_pkt_ipv4_pmtu(pkt));
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
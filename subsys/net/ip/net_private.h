@@ -89,6 +89,32 @@ extern void socket_service_init(void);
 static inline void socket_service_init(void) { }
 #endif
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Wrap application owned data into an external net_buf. The zero-copy
+ * callback of the context is called when the buffer is released. Returns
+ * NULL if no descriptor is available.
+ */
+struct net_buf *net_context_zerocopy_buf_get(struct net_context *context,
+					     const void *data, size_t len);
+/* Release zero-copy buffers in a fragment chain without calling back */
+void net_context_zerocopy_disarm(struct net_buf *frags);
+#else
+static inline struct net_buf *net_context_zerocopy_buf_get(struct net_context *context,
+							   const void *data, size_t len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return NULL;
+}
+
+static inline void net_context_zerocopy_disarm(struct net_buf *frags)
+{
+	ARG_UNUSED(frags);
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 #if defined(CONFIG_NET_NATIVE) || defined(CONFIG_NET_OFFLOAD)
 extern void net_context_init(void);
 extern const char *net_context_state(struct net_context *context);
@@ -279,8 +305,36 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
+extern uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst,
+				 const uint8_t *src, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/* Write data with net_pkt_write_chksum() as the continuation of earlier
+ * writes of any length, odd telling whether they add up to an odd length.
+ */
+static inline int net_pkt_write_chksum_cont(struct net_pkt *pkt, const void *data,
+					    size_t length, uint16_t *sum, bool *odd)
+{
+	int ret;
+
+	/* A sum is the same for bytes swapped data, so data starting at an
+	 * odd offset is summed up as if it started at an even one.
+	 */
+	if (*odd) {
+		*sum = BSWAP_16(*sum);
+	}
+
+	ret = net_pkt_write_chksum(pkt, data, length, sum);
+
+	if (*odd) {
+		*sum = BSWAP_16(*sum);
+	}
+
+	*odd ^= (length & 1U) != 0U;
+
+	return ret;
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "gro.h"
 
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
 #define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
@@ -297,6 +298,8 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 #endif
 	struct net_pkt *pkt;
 
+	net_gro_register_thread();
+
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
 		if (pkt == NULL) {
@@ -308,6 +311,13 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 #endif
 
 		net_process_rx_packet(pkt);
+
+		/* Do not keep coalesced TCP segments waiting for packets
+		 * that are not there.
+		 */
+		if (k_fifo_is_empty(fifo)) {
+			net_gro_flush();
+		}
 	}
 }
 #endif
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <limits.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_core.h>
@@ -32,7 +33,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -102,6 +103,10 @@ static void net_route_entry_remove(struct net_nbr *nbr)
 static void net_route_entries_table_clear(struct net_nbr_table *table)
 {
 	NET_DBG("Route table %p cleared", table);
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	route_trie_reset();
+#endif
 }
 
 /*
@@ -125,6 +130,237 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 	return (struct net_route_entry *)nbr->data;
 }
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/* The routes are also kept in a path compressed binary trie, so that
+ * the longest prefix match does not need to look at every route.
+ * Each node stores a masked prefix and the routes, one per interface,
+ * that have exactly that prefix. A node without routes is only kept
+ * as long as it has two children, so there are less than two nodes
+ * per route. The trie is protected by the IPv6 neighbor lock as the
+ * rest of the routing table.
+ */
+struct route_trie_node {
+	struct route_trie_node *parent;
+	struct route_trie_node *child[2];
+	struct net_route_entry *routes;
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+};
+
+static struct route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *route_trie_free;
+static struct route_trie_node *route_trie_root;
+
+static inline uint8_t route_trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7U - (pos % 8U))) & 1U;
+}
+
+static uint8_t route_trie_common_len(const struct in6_addr *addr1,
+				     const struct in6_addr *addr2,
+				     uint8_t max_len)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(struct in6_addr) && len < max_len; i++) {
+		uint8_t diff = addr1->s6_addr[i] ^ addr2->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24U;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static void route_trie_reset(void)
+{
+	int i;
+
+	route_trie_root = NULL;
+	route_trie_free = NULL;
+
+	for (i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		route_trie_nodes[i].child[0] = route_trie_free;
+		route_trie_free = &route_trie_nodes[i];
+	}
+}
+
+static struct route_trie_node *route_trie_node_new(const struct in6_addr *addr,
+						   uint8_t prefix_len,
+						   struct route_trie_node *parent)
+{
+	struct route_trie_node *node = route_trie_free;
+
+	/* Cannot run out as long as there are less routes than nodes / 2 */
+	NET_ASSERT(node != NULL);
+
+	route_trie_free = node->child[0];
+
+	memset(node, 0, sizeof(*node));
+	net_ipv6_addr_prefix_mask(addr->s6_addr, node->prefix.s6_addr,
+				  prefix_len);
+	node->prefix_len = prefix_len;
+	node->parent = parent;
+
+	return node;
+}
+
+static void route_trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = route_trie_free;
+	route_trie_free = node;
+}
+
+static struct route_trie_node **route_trie_link(struct route_trie_node *node)
+{
+	if (node->parent == NULL) {
+		return &route_trie_root;
+	}
+
+	return &node->parent->child[node->parent->child[1] == node];
+}
+
+static void route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node *parent = NULL;
+	struct route_trie_node *node = *link;
+	struct route_trie_node *new, *branch;
+	uint8_t len = route->prefix_len;
+	uint8_t common = 0U;
+
+	/* Walk down as long as the nodes are prefixes of the route */
+	while (node != NULL) {
+		common = route_trie_common_len(&route->addr, &node->prefix,
+					       MIN(len, node->prefix_len));
+		if (common < node->prefix_len || common == len) {
+			break;
+		}
+
+		parent = node;
+		link = &node->child[route_trie_bit(&route->addr, common)];
+		node = *link;
+	}
+
+	if (node == NULL) {
+		new = route_trie_node_new(&route->addr, len, parent);
+		*link = new;
+	} else if (common == node->prefix_len) {
+		/* Same prefix */
+		new = node;
+	} else if (common == len) {
+		/* The route is a prefix of the node, put it above */
+		new = route_trie_node_new(&route->addr, len, parent);
+		new->child[route_trie_bit(&node->prefix, len)] = node;
+		node->parent = new;
+		*link = new;
+	} else {
+		/* They diverge, branch where they do */
+		branch = route_trie_node_new(&route->addr, common, parent);
+		new = route_trie_node_new(&route->addr, len, branch);
+		branch->child[route_trie_bit(&route->addr, common)] = new;
+		branch->child[route_trie_bit(&node->prefix, common)] = node;
+		node->parent = branch;
+		*link = branch;
+	}
+
+	route->trie_next = new->routes;
+	new->routes = route;
+}
+
+static struct route_trie_node *route_trie_find(const struct in6_addr *addr,
+					       uint8_t prefix_len)
+{
+	struct route_trie_node *node = route_trie_root;
+
+	while (node != NULL && node->prefix_len <= prefix_len) {
+		if (!net_ipv6_is_prefix(addr->s6_addr, node->prefix.s6_addr,
+					node->prefix_len)) {
+			return NULL;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			return node;
+		}
+
+		node = node->child[route_trie_bit(addr, node->prefix_len)];
+	}
+
+	return NULL;
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node *node, *child;
+	struct net_route_entry **prev;
+
+	node = route_trie_find(&route->addr, route->prefix_len);
+	if (node == NULL) {
+		return;
+	}
+
+	for (prev = &node->routes; *prev != NULL; prev = &(*prev)->trie_next) {
+		if (*prev == route) {
+			*prev = route->trie_next;
+			break;
+		}
+	}
+
+	/* Drop the nodes that no longer separate anything */
+	while (node != NULL && node->routes == NULL &&
+	       (node->child[0] == NULL || node->child[1] == NULL)) {
+		struct route_trie_node *parent = node->parent;
+
+		child = node->child[0] != NULL ? node->child[0] : node->child[1];
+		*route_trie_link(node) = child;
+
+		if (child != NULL) {
+			child->parent = parent;
+			route_trie_node_free(node);
+			break;
+		}
+
+		route_trie_node_free(node);
+		node = parent;
+	}
+}
+
+static struct net_route_entry *route_trie_lookup(struct net_if *iface,
+						 const struct in6_addr *dst)
+{
+	struct route_trie_node *node = route_trie_root;
+	struct net_route_entry *found = NULL;
+	struct net_route_entry *route;
+
+	while (node != NULL) {
+		if (!net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+					node->prefix_len)) {
+			break;
+		}
+
+		for (route = node->routes; route != NULL; route = route->trie_next) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[route_trie_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_TRIE */
+
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
 	struct net_nbr *ret = NULL;
@@ -263,19 +499,25 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
+	struct net_route_entry *found = NULL;
+#if !defined(CONFIG_NET_ROUTE_TRIE)
+	struct net_route_entry *route;
 	uint8_t longest_match = 0U;
 	int i;
+#endif
 
 	net_ipv6_nbr_lock();
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	found = route_trie_lookup(iface, dst);
+#else
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -297,6 +539,7 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 			longest_match = route->prefix_len;
 		}
 	}
+#endif /* CONFIG_NET_ROUTE_TRIE */
 
 	if (found) {
 		net_route_info("Found", found, dst);
@@ -393,9 +636,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
-
-		sys_slist_find_and_remove(&routes, last);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -444,7 +685,11 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	route_trie_insert(route);
+#endif
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +831,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -596,6 +843,10 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	route_trie_remove(route);
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -1131,6 +1382,9 @@ void net_route_init(void)
 
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
+#endif
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	route_trie_reset();
 #endif
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
@@ -15,6 +15,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
@@ -47,7 +48,7 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
@@ -68,6 +69,11 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Next route with the same prefix in the route trie. */
+	struct net_route_entry *trie_next;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "net_private.h"
 #include "tcp_internal.h"
 #include "pmtu.h"
+#include "gso.h"
 
 #define ACK_TIMEOUT_MS tcp_max_timeout_ms
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
@@ -69,6 +70,15 @@ static int tcp_tx_window =
 #define TCP_CONGESTION_INITIAL_WIN 1
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
 
+/* The congestion window is bounded by the largest window the peer can
+ * advertise.
+ */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#define TCP_CONGESTION_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+#else
+#define TCP_CONGESTION_MAX_WIN UINT16_MAX
+#endif
+
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -447,7 +457,7 @@ static void tcp_derive_rto(struct tcp *conn)
 
 static void tcp_new_reno_log(struct tcp *conn, char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, fast_pend=%u",
 		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
 		conn->ca.pending_fast_retransmit_bytes);
 }
@@ -481,16 +491,16 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 /* For every duplicate ack increment the cwnd by mss */
 static void tcp_new_reno_dup_ack(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
 	int32_t win_inc = MIN(acked_len, conn_mss(conn));
 
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
@@ -500,7 +510,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, TCP_CONGESTION_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -1090,7 +1100,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 static bool tcp_options_check(struct tcp_options *recv_options,
 			      struct net_pkt *pkt, ssize_t len)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[NET_TCP_MAX_OPT_SIZE];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -1100,6 +1110,8 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+	recv_options->sack_perm_found = false;
+	recv_options->num_sacks = 0;
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1145,9 +1157,38 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			/* The first block reports the most recent segment, so
+			 * keep the leading ones if there are more than we track.
+			 */
+			recv_options->num_sacks = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						      NET_TCP_MAX_SACK_BLOCKS);
+			for (int i = 0; i < recv_options->num_sacks; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sacks[i].left =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sacks[i].right =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+			break;
 		default:
 			continue;
 		}
@@ -1338,8 +1379,26 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Value of the window field for an outgoing segment. The window field of
+ * a SYN segment is never scaled (RFC 7323, ch 2.2).
+ */
+static uint16_t tcp_recv_wnd_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+#else
+	ARG_UNUSED(flags);
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1353,14 +1412,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_wnd_field(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1418,23 +1473,77 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#ifdef CONFIG_NET_TCP_SACK
+/* Report the out-of-order data held in the receive queue. The queue only
+ * keeps a single contiguous range, so there is at most one block to send.
+ */
+static size_t tcp_sack_option_add(struct tcp *conn, uint8_t *options)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	struct net_buf *last;
+	uint32_t left;
+	uint32_t right;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	left = tcp_get_seq(conn->queue_recv_data->buffer);
+	last = net_buf_frag_last(conn->queue_recv_data->buffer);
+	right = tcp_get_seq(last) + last->len;
+
+	if (!net_tcp_seq_greater(left, conn->ack)) {
+		return 0;
+	}
+
+	options[0] = NET_TCP_NOP_OPT;
+	options[1] = NET_TCP_NOP_OPT;
+	options[2] = NET_TCP_SACK_OPT;
+	options[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+	UNALIGNED_PUT(htonl(left), (uint32_t *)(options + 4));
+	UNALIGNED_PUT(htonl(right), (uint32_t *)(options + 8));
+
+	return 4 + NET_TCP_SACK_BLOCK_SIZE;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Fill in the TCP options of an outgoing segment. Every option is padded
+ * with NOPs to a multiple of 4 bytes. Returns the length of the options.
+ */
+static size_t tcp_options_add(struct tcp *conn, uint8_t flags, uint8_t *options)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		uint16_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		options[len++] = NET_TCP_MSS_OPT;
+		options[len++] = NET_TCP_MSS_SIZE;
+		UNALIGNED_PUT(htons(recv_mss), (uint16_t *)(options + len));
+		len += sizeof(uint16_t);
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if ((flags & SYN) && conn->wscale_ok) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		options[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		options[len++] = conn->rcv_wscale;
+	}
+#endif
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+#ifdef CONFIG_NET_TCP_SACK
+	if ((flags & SYN) && conn->sack_ok) {
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_NOP_OPT;
+		options[len++] = NET_TCP_SACK_PERM_OPT;
+		options[len++] = NET_TCP_SACK_PERM_SIZE;
+	} else if ((flags & ACK) && conn->sack_ok) {
+		len += tcp_sack_option_add(conn, options + len);
+	}
+#endif
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1541,24 +1650,33 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[NET_TCP_MAX_OPT_SIZE];
+	size_t options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
+	options_len = tcp_options_add(conn, flags, options);
 
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
 
 	if (data) {
+		/* More than one MSS of data makes a super-packet, which is
+		 * segmented on its way out.
+		 */
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+
+		net_pkt_set_payload_chksum(pkt, net_pkt_payload_chksum(data),
+					   net_pkt_payload_chksum_len(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1567,14 +1685,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1617,22 +1735,34 @@ static void tcp_out(struct tcp *conn, uint8_t flags)
 	(void)tcp_out_ext(conn, flags, NULL /* no data */, conn->seq);
 }
 
+/* Drop acknowledged data from the head of the send queue. Fully acked
+ * fragments are released and the first partially acked one is advanced in
+ * place, so the unacknowledged data is never moved. This also keeps
+ * zero-copy fragments, whose data belongs to the application, read-only.
+ */
 static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 {
-	int total = net_pkt_get_len(pkt);
-	int ret = 0;
+	struct net_buf *buf;
 
-	if (len > total) {
-		ret = -EINVAL;
-		goto out;
+	if (len > net_pkt_get_len(pkt)) {
+		return -EINVAL;
+	}
+
+	while (pkt->buffer != NULL) {
+		buf = pkt->buffer;
+
+		if (buf->len > len) {
+			net_buf_pull(buf, len);
+			break;
+		}
+
+		len -= buf->len;
+		pkt->buffer = net_buf_frag_del(NULL, buf);
 	}
 
 	net_pkt_cursor_init(pkt);
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_pull(pkt, len);
-	net_pkt_trim_buffer(pkt);
- out:
-	return ret;
+
+	return 0;
 }
 
 static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
@@ -1649,6 +1779,44 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* Like tcp_pkt_peek(), but sums the data up for the checksum while copying
+ * it, so that it does not have to be read again from the segment.
+ */
+static int tcp_pkt_peek_chksum(struct net_pkt *to, struct net_pkt *from,
+			       size_t pos, size_t len, uint16_t *sum)
+{
+	bool odd = false;
+	size_t chunk;
+	int ret;
+
+	net_pkt_cursor_init(to);
+	net_pkt_cursor_init(from);
+
+	net_pkt_set_overwrite(from, true);
+
+	if (pos) {
+		net_pkt_skip(from, pos);
+	}
+
+	while (len > 0) {
+		chunk = MIN(len, net_pkt_get_contiguous_len(from));
+		if (chunk == 0) {
+			return -ENOBUFS;
+		}
+
+		ret = net_pkt_write_chksum_cont(to, from->cursor.pos, chunk,
+						sum, &odd);
+		if (ret < 0) {
+			return ret;
+		}
+
+		net_pkt_skip(from, chunk);
+		len -= chunk;
+	}
+
+	return 0;
+}
+
 static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 {
 	size_t alloc_len = len;
@@ -1736,13 +1904,89 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+/* Send len bytes of the queued data, starting at offset bytes from the
+ * oldest unacknowledged byte.
+ */
+static int tcp_send_segment(struct tcp *conn, size_t offset, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	if (len > conn_mss(conn)) {
+		/* Super-packets do not fit the MTU, which caps the regular
+		 * allocation.
+		 */
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (pkt && net_pkt_alloc_buffer_raw(pkt, len,
+						    TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+	}
+
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return -ENOBUFS;
+	}
+
+	if (len <= conn_mss(conn) &&
+	    net_if_need_calc_tx_checksum(conn->iface,
+					 net_context_get_family(conn->context) == AF_INET6 ?
+					 NET_IF_CHECKSUM_IPV6_TCP :
+					 NET_IF_CHECKSUM_IPV4_TCP)) {
+		uint16_t sum = 0U;
+
+		/* Sum the data up while copying it, so that net_tcp_finalize()
+		 * only has to sum the headers. Super-packets get their
+		 * checksum once they are segmented.
+		 */
+		ret = tcp_pkt_peek_chksum(pkt, conn->send_data, offset, len, &sum);
+		net_pkt_set_payload_chksum(pkt, sum, len);
+	} else {
+		ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
+	}
+
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+/* Amount of data sent in one packet. With GSO, new data goes out in
+ * super-packets of several MSS, retransmissions stay one MSS.
+ */
+static int tcp_send_max_len(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	if (conn->data_mode == TCP_DATA_MODE_SEND && net_gso_supported(conn->iface)) {
+		return MAX((int)ROUND_DOWN(CONFIG_NET_TCP_GSO_MAX_SIZE, mss), mss);
+	}
+#endif
+
+	return mss;
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
+	int mss = conn_mss(conn);
 	int ret = 0;
 	int len;
-	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), tcp_send_max_len(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1753,21 +1997,14 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
-	}
-
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+	/* Leave a trailing partial segment of a super-packet to Nagle's
+	 * algorithm, as if the segments were sent one by one.
+	 */
+	if (len > mss && !conn->tcp_nodelay) {
+		len = (int)ROUND_DOWN(len, mss);
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
 	if (ret == 0) {
 		conn->unacked_len += len;
 
@@ -1776,22 +2013,182 @@ static int tcp_send_data(struct tcp *conn)
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			for (int sent = 0; sent < len; sent += mss) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
-
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Merge a SACKed range into the scoreboard, which is kept sorted and
+ * without overlapping or adjacent blocks. When the scoreboard is full the
+ * highest block is dropped, the lower ones tell where the next holes are.
+ */
+static void tcp_sack_board_add(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block board[NET_TCP_MAX_SACK_BLOCKS + 1];
+	bool placed = false;
+	int len = 0;
+
+	/* First loss reported since the scoreboard was emptied */
+	if (conn->sack_board_len == 0) {
+		conn->sack_high_rxt = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sack_board_len; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+
+		if (net_tcp_seq_greater(block->left, right)) {
+			if (!placed) {
+				board[len].left = left;
+				board[len].right = right;
+				len++;
+				placed = true;
+			}
+
+			board[len++] = *block;
+		} else if (net_tcp_seq_greater(left, block->right)) {
+			board[len++] = *block;
+		} else {
+			if (net_tcp_seq_greater(left, block->left)) {
+				left = block->left;
+			}
+
+			if (net_tcp_seq_greater(block->right, right)) {
+				right = block->right;
+			}
+		}
+	}
+
+	if (!placed) {
+		board[len].left = left;
+		board[len].right = right;
+		len++;
+	}
+
+	conn->sack_board_len = MIN(len, NET_TCP_MAX_SACK_BLOCKS);
+	memcpy(conn->sack_board, board,
+	       conn->sack_board_len * sizeof(struct tcp_sack_block));
+}
+
+/* Record the SACK blocks of the received segment. Blocks outside of the
+ * data we have in flight, up to SND.NXT, are ignored.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_max = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->recv_options.num_sacks; i++) {
+		uint32_t left = conn->recv_options.sacks[i].left;
+		uint32_t right = conn->recv_options.sacks[i].right;
+
+		if (!net_tcp_seq_greater(right, left) ||
+		    !net_tcp_seq_greater(right, conn->seq) ||
+		    net_tcp_seq_greater(right, snd_max)) {
+			NET_DBG("conn: %p ignoring SACK block %u-%u", conn,
+				left, right);
+			continue;
+		}
+
+		if (net_tcp_seq_greater(conn->seq, left)) {
+			left = conn->seq;
+		}
+
+		tcp_sack_board_add(conn, left, right);
+	}
+}
+
+/* Forget the parts of the scoreboard covered by the cumulative ACK */
+static void tcp_sack_board_ack(struct tcp *conn)
+{
+	int len = 0;
+
+	for (int i = 0; i < conn->sack_board_len; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+
+		if (!net_tcp_seq_greater(block->right, conn->seq)) {
+			continue;
+		}
+
+		if (net_tcp_seq_greater(conn->seq, block->left)) {
+			block->left = conn->seq;
+		}
+
+		conn->sack_board[len++] = *block;
+	}
+
+	conn->sack_board_len = len;
+
+	if (net_tcp_seq_greater(conn->seq, conn->sack_high_rxt)) {
+		conn->sack_high_rxt = conn->seq;
+	}
+}
+
+static bool tcp_sack_board_used(struct tcp *conn)
+{
+	return conn->sack_board_len > 0;
+}
+
+/* Retransmit one segment from the first hole of the scoreboard that has not
+ * been retransmitted yet. The holes are the ranges below the highest SACKed
+ * sequence number which the peer has not reported as received.
+ */
+static int tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t next = conn->sack_high_rxt;
+	int ret;
+	int len;
+
+	if (net_tcp_seq_greater(conn->seq, next)) {
+		next = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sack_board_len; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+
+		if (!net_tcp_seq_greater(block->right, next)) {
+			continue;
+		}
+
+		if (!net_tcp_seq_greater(block->left, next)) {
+			next = block->right;
+			continue;
+		}
+
+		len = MIN(block->left - next, conn_mss(conn));
+
+		NET_DBG("conn: %p SACK retransmit %u-%u", conn, next, next + len);
+
+		ret = tcp_send_segment(conn, next - conn->seq, len);
+		if (ret == 0) {
+			conn->sack_high_rxt = next + len;
+			net_stats_update_tcp_resent(conn->iface, len);
+			net_stats_update_tcp_seg_rexmit(conn->iface);
+		}
+
+		return ret;
+	}
+
+	return -ENODATA;
+}
+#else
+
+static inline bool tcp_sack_board_used(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return false;
+}
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1886,6 +2283,13 @@ static void tcp_resend_data(struct k_work *work)
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
+#ifdef CONFIG_NET_TCP_SACK
+	/* The peer may discard data it has SACKed, so after a timeout the
+	 * scoreboard cannot be trusted anymore (RFC 2018, ch 8).
+	 */
+	conn->sack_board_len = 0;
+#endif
+
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
 	if (ret == 0) {
@@ -2139,7 +2543,7 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_CONGESTION_MAX_WIN;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2215,7 +2619,12 @@ static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
 		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
 }
 
-static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+/* The context, if any, is a hint from the connection handler lookup done
+ * in net_conn_input(), which is indexed and usually hands over the context
+ * of the very connection that the packet is for.
+ */
+static struct tcp *tcp_conn_search(struct net_pkt *pkt,
+				   struct net_context *context)
 {
 	bool found = false;
 	struct tcp *conn;
@@ -2223,6 +2632,12 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 
+	conn = context != NULL ? context->tcp : NULL;
+	if (conn != NULL && tcp_conn_cmp(conn, pkt)) {
+		k_mutex_unlock(&tcp_lock);
+		return conn;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
 		found = tcp_conn_cmp(conn, pkt);
 		if (found) {
@@ -2250,7 +2665,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
-	conn = tcp_conn_search(pkt);
+	conn = tcp_conn_search(pkt, user_data);
 	if (conn) {
 		goto in;
 	}
@@ -2798,6 +3213,75 @@ static void tcp_check_sock_options(struct tcp *conn)
 	}
 }
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+/* Smallest shift count that lets the 16 bit window field cover win */
+static uint8_t tcp_window_scale(uint32_t win)
+{
+	uint8_t shift = 0;
+
+	while ((win >> shift) > UINT16_MAX && shift < NET_TCP_MAX_WINDOW_SCALE) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+/* Offer our optional features in the SYN we are about to send */
+static void tcp_syn_options_offer(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->wscale_ok = true;
+	conn->rcv_wscale = tcp_window_scale(conn->recv_win_max);
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_ok = true;
+#endif
+}
+
+/* Keep only the optional features that the peer has also offered in its
+ * SYN, they are not used unless both ends agree on them.
+ */
+static void tcp_syn_options_negotiate(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	conn->wscale_ok = conn->wscale_ok && conn->recv_options.wnd_found;
+	if (conn->wscale_ok) {
+		if (conn->recv_options.window > NET_TCP_MAX_WINDOW_SCALE) {
+			NET_DBG("conn: %p window scale %u capped to %u", conn,
+				conn->recv_options.window, NET_TCP_MAX_WINDOW_SCALE);
+		}
+
+		conn->snd_wscale = MIN(conn->recv_options.window,
+				       NET_TCP_MAX_WINDOW_SCALE);
+	} else {
+		conn->snd_wscale = 0;
+		conn->rcv_wscale = 0;
+	}
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_ok = conn->sack_ok && conn->recv_options.sack_perm_found;
+#endif
+}
+
+/* Peer's receive window as advertised in th. The window field of a SYN
+ * segment is never scaled.
+ */
+static uint32_t tcp_send_wnd_get(struct tcp *conn, struct tcphdr *th)
+{
+	uint32_t win = ntohs(th_win(th));
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+		win <<= conn->snd_wscale;
+	}
+#else
+	ARG_UNUSED(conn);
+#endif
+
+	return win;
+}
+
 /* TCP state machine, everything happens here */
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -2870,6 +3354,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	/* SACK blocks only describe the segment that carries them */
+	conn->recv_options.num_sacks = 0;
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2895,7 +3382,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (th) {
-		conn->send_win = ntohs(th_win(th));
+		conn->send_win = tcp_send_wnd_get(conn, th);
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2929,6 +3416,8 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_syn_options_offer(conn);
+			tcp_syn_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -2943,6 +3432,7 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+			tcp_syn_options_offer(conn);
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
@@ -3054,6 +3544,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3137,6 +3628,12 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+#ifdef CONFIG_NET_TCP_SACK
+		if (th && conn->sack_ok) {
+			tcp_sack_update(conn);
+		}
+#endif
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3157,21 +3654,34 @@ next_state:
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				if (!tcp_sack_board_used(conn)) {
+					/* Apply a fast retransmit */
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
 			}
+
+#ifdef CONFIG_NET_TCP_SACK
+			/* With SACK, every duplicate ACK in recovery lets the next
+			 * hole be filled instead of waiting for a timeout.
+			 */
+			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			    (conn->dup_ack_cnt >= DUPLICATE_ACK_RETRANSMIT_TRHESHOLD) &&
+			    tcp_sack_board_used(conn)) {
+				(void)tcp_sack_retransmit(conn);
+			}
+#endif
 		}
 #endif
 		NET_ASSERT((conn->send_data_total == 0) ||
@@ -3217,6 +3727,16 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#ifdef CONFIG_NET_TCP_SACK
+			tcp_sack_board_ack(conn);
+
+			/* A partial ACK in recovery, resend the next hole right away */
+			if (conn->data_mode == TCP_DATA_MODE_SEND &&
+			    tcp_sack_board_used(conn)) {
+				(void)tcp_sack_retransmit(conn);
+			}
+#endif
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3712,8 +4232,23 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+static int tcp_pkt_append_zerocopy(struct tcp *conn, const void *data,
+				   size_t len)
+{
+	struct net_buf *buf;
+
+	buf = net_context_zerocopy_buf_get(conn->context, data, len);
+	if (buf == NULL) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_append_buffer(conn->send_data, buf);
+
+	return 0;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg)
+		  const struct msghdr *msg, bool zerocopy)
 {
 	struct tcp *conn = context->tcp;
 	size_t queued_len = 0;
@@ -3753,9 +4288,20 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		for (int i = 0; i < msg->msg_iovlen; i++) {
 			int iovlen = MIN(msg->msg_iov[i].iov_len, len);
 
-			ret = tcp_pkt_append(conn->send_data,
-					     msg->msg_iov[i].iov_base,
-					     iovlen);
+			if (iovlen == 0) {
+				continue;
+			}
+
+			if (zerocopy) {
+				ret = tcp_pkt_append_zerocopy(conn,
+							      msg->msg_iov[i].iov_base,
+							      iovlen);
+			} else {
+				ret = tcp_pkt_append(conn->send_data,
+						     msg->msg_iov[i].iov_base,
+						     iovlen);
+			}
+
 			if (ret < 0) {
 				if (queued_len == 0) {
 					goto out;
@@ -4102,7 +4648,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* Super-packets get their checksum once they are segmented */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4146,7 +4694,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 	enum net_verdict verdict = NET_DROP;
 
 	if (th) {
-		struct tcp *conn = tcp_conn_search(pkt);
+		struct tcp *conn = tcp_conn_search(pkt, NULL);
 
 		if (conn == NULL && SYN == th_flags(th)) {
 			struct net_context *context =
@@ -4228,7 +4776,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 {
 	struct net_udp_hdr *uh = net_udp_get_hdr(pkt, NULL);
 	size_t data_len = ntohs(uh->len) - sizeof(*uh);
-	struct tcp *conn = tcp_conn_search(pkt);
+	struct tcp *conn = tcp_conn_search(pkt, NULL);
 	size_t json_len = 0;
 	struct tp *tp;
 	struct tp_new *tp_new;
@@ -293,20 +293,23 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @param data		Pointer to the data
  * @param len		Number of bytes
  * @param msg		Data for a vector array operation
+ * @param zerocopy	Reference the msg data instead of copying it
  *
  * @return 0 if ok, < 0 if error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg);
+		  const struct msghdr *msg, bool zerocopy);
 #else
 static inline int net_tcp_queue(struct net_context *context, const void *data,
-				size_t len, const struct msghdr *msg)
+				size_t len, const struct msghdr *msg,
+				bool zerocopy)
 {
 	ARG_UNUSED(context);
 	ARG_UNUSED(data);
 	ARG_UNUSED(len);
 	ARG_UNUSED(msg);
+	ARG_UNUSED(zerocopy);
 
 	return -EPROTONOSUPPORT;
 }
@@ -146,7 +146,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -192,10 +192,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_LISTEN,
@@ -227,26 +223,47 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* TCP header max options size */
+#define NET_TCP_MAX_OPT_SIZE 40
+
+/* Largest shift count allowed by RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
+/* SACK blocks that fit in the option space next to a timestamp option */
+#define NET_TCP_MAX_SACK_BLOCKS 3
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	uint8_t num_sacks;
+	struct tcp_sack_block sacks[NET_TCP_MAX_SACK_BLOCKS];
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
 struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
 };
 #endif
 
@@ -314,11 +331,22 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#ifdef CONFIG_NET_TCP_SACK
+	/* SACKed ranges above seq, sorted and not overlapping */
+	struct tcp_sack_block sack_board[NET_TCP_MAX_SACK_BLOCKS];
+	/* Highest sequence number resent from the scoreboard holes */
+	uint32_t sack_high_rxt;
+	uint8_t sack_board_len;
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	uint8_t snd_wscale;
+	uint8_t rcv_wscale;
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
@@ -339,6 +367,12 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+	bool wscale_ok : 1;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_ok : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -27,6 +27,16 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#if defined(CONFIG_NET_CHKSUM_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#endif /* CONFIG_NET_CHKSUM_SIMD */
+
 char *net_sprint_addr(sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -548,6 +558,12 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #define CHECKSUM_BIG_ENDIAN 1
 #endif
 
+#if defined(CONFIG_64BIT)
+#define CHECKSUM_WORD_SIZE sizeof(uint64_t)
+#else
+#define CHECKSUM_WORD_SIZE sizeof(uint32_t)
+#endif
+
 static uint16_t offset_based_swap8(const uint8_t *data)
 {
 	uint16_t data16 = (uint16_t)*data;
@@ -559,18 +575,185 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* Sum whole vectors of data, copying them to dst on the way unless it is
+ * NULL. The 32-bit words are added in 64-bit lanes, so no carry is lost.
+ * Returns the number of bytes consumed.
+ */
+static ALWAYS_INLINE size_t chksum_simd(uint64_t *sum, uint8_t *dst,
+					const uint8_t *data, size_t len)
+{
+	size_t done = 0;
+
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(__AVX2__)
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc_lo = zero;
+	__m256i acc_hi = zero;
+	uint64_t lanes[4];
+
+	for (; len - done >= sizeof(__m256i); done += sizeof(__m256i)) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(data + done));
+
+		if (dst != NULL) {
+			_mm256_storeu_si256((__m256i *)(dst + done), v);
+		}
+
+		acc_lo = _mm256_add_epi64(acc_lo, _mm256_unpacklo_epi32(v, zero));
+		acc_hi = _mm256_add_epi64(acc_hi, _mm256_unpackhi_epi32(v, zero));
+	}
+
+	_mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc_lo, acc_hi));
+	*sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__SSE2__)
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc_lo = zero;
+	__m128i acc_hi = zero;
+	uint64_t lanes[2];
+
+	for (; len - done >= sizeof(__m128i); done += sizeof(__m128i)) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + done));
+
+		if (dst != NULL) {
+			_mm_storeu_si128((__m128i *)(dst + done), v);
+		}
+
+		acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(v, zero));
+		acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(v, zero));
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc_lo, acc_hi));
+	*sum += lanes[0] + lanes[1];
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+	uint64x2_t acc_a = vdupq_n_u64(0);
+	uint64x2_t acc_b = vdupq_n_u64(0);
+
+	for (; len - done >= sizeof(uint32x4_t) * 2; done += sizeof(uint32x4_t) * 2) {
+		uint32x4_t v_a = vld1q_u32((const uint32_t *)(data + done));
+		uint32x4_t v_b = vld1q_u32((const uint32_t *)(data + done) + 4);
+
+		if (dst != NULL) {
+			vst1q_u32((uint32_t *)(dst + done), v_a);
+			vst1q_u32((uint32_t *)(dst + done) + 4, v_b);
+		}
+
+		/* Pairwise add to 64 bits and accumulate */
+		acc_a = vpadalq_u32(acc_a, v_a);
+		acc_b = vpadalq_u32(acc_b, v_b);
+	}
+
+	*sum += vaddvq_u64(vaddq_u64(acc_a, acc_b));
+#else
+	ARG_UNUSED(sum);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+#endif
+
+	return done;
+}
+
+/* Sum whole words of word aligned data, copying them to dst on the way
+ * unless it is NULL. Returns the number of bytes consumed.
+ */
+static ALWAYS_INLINE size_t chksum_words(uint64_t *sum, uint8_t *dst,
+					 const uint8_t *data, size_t len)
+{
+#if defined(CONFIG_64BIT)
+	const uint64_t *p = (const uint64_t *)data;
+	uint64_t *q = (uint64_t *)dst;
+	uint64_t sum_a = 0;
+	uint64_t sum_b = 0;
+	uint64_t carry = 0;
+	size_t i = 0;
+
+	/* 2^64 folds to 1 in one's complement arithmetic, so the carries out
+	 * of the 64-bit additions are just added back in at the end.
+	 */
+	while (len >= sizeof(uint64_t) * 2) {
+		uint64_t word_a = p[i];
+		uint64_t word_b = p[i + 1];
+
+		if (q != NULL) {
+			q[i] = word_a;
+			q[i + 1] = word_b;
+		}
+
+		len -= sizeof(uint64_t) * 2;
+		i += 2;
+		sum_a += word_a;
+		carry += (sum_a < word_a);
+		sum_b += word_b;
+		carry += (sum_b < word_b);
+	}
+	if (len >= sizeof(uint64_t)) {
+		uint64_t word_a = p[i];
+
+		if (q != NULL) {
+			q[i] = word_a;
+		}
+
+		i++;
+		sum_a += word_a;
+		carry += (sum_a < word_a);
+	}
+
+	*sum += (sum_a & 0xffffffff) + (sum_a >> 32) +
+		(sum_b & 0xffffffff) + (sum_b >> 32) + carry;
+
+	return i * sizeof(uint64_t);
+#else
+	const uint32_t *p = (const uint32_t *)data;
+	uint32_t *q = (uint32_t *)dst;
+	uint64_t sum_words = 0;
+	size_t i = 0;
+
+	/* Do loop unrolling for the very large data sets */
+	while (len >= sizeof(uint32_t) * 4) {
+		uint32_t word_a = p[i];
+		uint32_t word_b = p[i + 1];
+		uint32_t word_c = p[i + 2];
+		uint32_t word_d = p[i + 3];
+
+		if (q != NULL) {
+			q[i] = word_a;
+			q[i + 1] = word_b;
+			q[i + 2] = word_c;
+			q[i + 3] = word_d;
+		}
+
+		len -= sizeof(uint32_t) * 4;
+		i += 4;
+		sum_words += ((uint64_t)word_a + word_c) + ((uint64_t)word_b + word_d);
+	}
+	while (len >= sizeof(uint32_t)) {
+		if (q != NULL) {
+			q[i] = p[i];
+		}
+
+		len -= sizeof(uint32_t);
+		sum_words += p[i++];
+	}
+
+	*sum += sum_words;
+
+	return i * sizeof(uint32_t);
+#endif
+}
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ *
+ * If dst is not NULL, the data is copied there while being summed. It must then have the same
+ * alignment as the data, modulo the word size.
  */
-uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+static ALWAYS_INLINE uint16_t chksum_calc(uint16_t sum_in, uint8_t *dst,
+					  const uint8_t *data, size_t len)
 {
 	uint64_t sum;
-	uint32_t *p;
-	size_t i = 0;
+	size_t done;
 	size_t pending = len;
 	int odd_start = ((uintptr_t)data & 0x01);
 
@@ -583,42 +766,81 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum_in;
 	}
 
-	/* Process up to 3 data elements up front, so the data is aligned further down the line */
+	/* Process up to 7 data elements up front, so the data is aligned further down the line */
 	if ((((uintptr_t)data & 0x01) != 0) && (pending >= 1)) {
 		sum += offset_based_swap8(data);
+		if (dst != NULL) {
+			*dst++ = *data;
+		}
 		data++;
 		pending--;
 	}
 	if ((((uintptr_t)data & 0x02) != 0) && (pending >= sizeof(uint16_t))) {
+		uint16_t word = *((uint16_t *)data);
+
+		if (dst != NULL) {
+			*((uint16_t *)dst) = word;
+			dst += sizeof(uint16_t);
+		}
 		pending -= sizeof(uint16_t);
-		sum = sum + *((uint16_t *)data);
+		sum = sum + word;
 		data += sizeof(uint16_t);
 	}
-	p = (uint32_t *)data;
+	if ((CHECKSUM_WORD_SIZE > sizeof(uint32_t)) && (((uintptr_t)data & 0x04) != 0) &&
+	    (pending >= sizeof(uint32_t))) {
+		uint32_t word = *((uint32_t *)data);
 
-	/* Do loop unrolling for the very large data sets */
-	while (pending >= sizeof(uint32_t) * 4) {
-		uint64_t sum_a = p[i];
-		uint64_t sum_b = p[i + 1];
+		if (dst != NULL) {
+			*((uint32_t *)dst) = word;
+			dst += sizeof(uint32_t);
+		}
+		pending -= sizeof(uint32_t);
+		sum = sum + word;
+		data += sizeof(uint32_t);
+	}
 
-		pending -= sizeof(uint32_t) * 4;
-		sum_a += p[i + 2];
-		sum_b += p[i + 3];
-		i += 4;
-		sum += sum_a + sum_b;
+	done = chksum_simd(&sum, dst, data, pending);
+	data += done;
+	pending -= done;
+	if (dst != NULL) {
+		dst += done;
+	}
+
+	done = chksum_words(&sum, dst, data, pending);
+	data += done;
+	pending -= done;
+	if (dst != NULL) {
+		dst += done;
 	}
-	while (pending >= sizeof(uint32_t)) {
+
+	/* At most 7 bytes are left */
+	if (pending >= sizeof(uint32_t)) {
+		uint32_t word = *((uint32_t *)data);
+
+		if (dst != NULL) {
+			*((uint32_t *)dst) = word;
+			dst += sizeof(uint32_t);
+		}
 		pending -= sizeof(uint32_t);
-		sum = sum + p[i++];
+		sum = sum + word;
+		data += sizeof(uint32_t);
 	}
-	data = (uint8_t *)(p + i);
 	if (pending >= 2) {
+		uint16_t word = *((uint16_t *)data);
+
+		if (dst != NULL) {
+			*((uint16_t *)dst) = word;
+			dst += sizeof(uint16_t);
+		}
 		pending -= sizeof(uint16_t);
-		sum = sum + *((uint16_t *)data);
+		sum = sum + word;
 		data += sizeof(uint16_t);
 	}
 	if (pending == 1) {
 		sum += offset_based_swap8(data);
+		if (dst != NULL) {
+			*dst = *data;
+		}
 	}
 
 	/* Fold sum into 16-bit word. */
@@ -636,8 +858,27 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
+{
+	return chksum_calc(sum_in, NULL, data, len);
+}
+
+uint16_t calc_chksum_copy(uint16_t sum_in, uint8_t *dst, const uint8_t *src, size_t len)
+{
+	/* Words can only be copied as they are summed if both sides line up */
+	if ((((uintptr_t)dst ^ (uintptr_t)src) & (CHECKSUM_WORD_SIZE - 1)) != 0) {
+		memcpy(dst, src, len);
+
+		return calc_chksum(sum_in, dst, len);
+	}
+
+	return chksum_calc(sum_in, dst, src, len);
+}
+
 #if defined(CONFIG_NET_NATIVE_IP)
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+/* Sum up to max_len bytes of the packet from its cursor */
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum,
+				       size_t max_len)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
 	size_t len;
@@ -646,13 +887,14 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 		return sum;
 	}
 
-	len = cur->buf->len - (cur->pos - cur->buf->data);
+	len = MIN((size_t)(cur->buf->len - (cur->pos - cur->buf->data)), max_len);
 
 	while (cur->buf) {
 		sum = calc_chksum(sum, cur->pos, len);
+		max_len -= len;
 
 		cur->buf = cur->buf->frags;
-		if (!cur->buf || !cur->buf->len) {
+		if (!cur->buf || !cur->buf->len || max_len == 0U) {
 			break;
 		}
 
@@ -665,9 +907,10 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 			}
 
 			cur->pos++;
-			len = cur->buf->len - 1;
+			max_len--;
+			len = MIN((size_t)cur->buf->len - 1U, max_len);
 		} else {
-			len = cur->buf->len;
+			len = MIN((size_t)cur->buf->len, max_len);
 		}
 	}
 
@@ -676,8 +919,10 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 
 uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 {
+	size_t payload_len = net_pkt_payload_chksum_len(pkt);
 	size_t len = 0U;
 	uint16_t sum = 0U;
+	uint16_t payload_sum;
 	struct net_pkt_cursor backup;
 	bool ow;
 
@@ -711,7 +956,21 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	if (payload_len > 0U) {
+		/* The payload was summed up as it was written, past the
+		 * even sized transport header.
+		 */
+		sum = pkt_calc_chksum(pkt, sum,
+				      net_pkt_remaining_data(pkt) - payload_len);
+
+		payload_sum = net_pkt_payload_chksum(pkt);
+		sum += payload_sum;
+		if (sum < payload_sum) {
+			sum++;
+		}
+	} else {
+		sum = pkt_calc_chksum(pkt, sum, SIZE_MAX);
+	}
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
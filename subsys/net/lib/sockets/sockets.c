@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/internal/syscall_handler.h>
 
 #include "sockets_internal.h"
@@ -436,6 +437,11 @@ static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
 		}
 	}
 
+	/* The iovec data is a temporary kernel copy which is freed below, so
+	 * it can never be referenced by a zero-copy send.
+	 */
+	flags &= ~ZSOCK_MSG_ZEROCOPY;
+
 	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
 				   flags);
 
@@ -710,6 +716,32 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+ssize_t zsock_recvbuf(int sock, struct net_buf **buf, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int bytes_received;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*buf = NULL;
+
+	bytes_received = VTABLE_CALL(recvbuf, sock, buf, flags, src_addr, addrlen);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+
+void zsock_recvbuf_release(struct net_buf *buf)
+{
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -911,6 +943,12 @@ int z_vrfy_zsock_setsockopt(int sock, int level, int optname,
 	void *kernel_optval;
 	int ret;
 
+	/* The completion callback would run in supervisor mode */
+	if (level == SOL_SOCKET && optname == SO_ZEROCOPY) {
+		errno = EPERM;
+		return -1;
+	}
+
 	kernel_optval = k_usermode_alloc_from_copy((const void *)optval, optlen);
 	K_OOPS(!kernel_optval);
 
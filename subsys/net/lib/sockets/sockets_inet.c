@@ -1506,6 +1506,149 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Hand over the unread part of a received packet as a bare fragment chain.
+ * Everything before the cursor (link, IP and transport headers, already
+ * consumed data) is dropped, then the packet itself is released.
+ */
+static struct net_buf *sock_pkt_detach_data(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	struct net_buf *cur = pkt->cursor.buf;
+
+	if (cur != NULL) {
+		while (buf != cur) {
+			buf = net_buf_frag_del(NULL, buf);
+		}
+
+		net_buf_pull(buf, pkt->cursor.pos - buf->data);
+	} else if (buf != NULL) {
+		/* Cursor at the end, nothing left to read */
+		net_buf_unref(buf);
+		buf = NULL;
+	}
+
+	while (buf != NULL && buf->len == 0) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_cursor_init(pkt);
+	net_pkt_unref(pkt);
+
+	return buf;
+}
+
+static ssize_t zsock_recvbuf_ctx(struct net_context *ctx, struct net_buf **buf,
+				 int flags, struct sockaddr *src_addr,
+				 socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	size_t len;
+	int ret;
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type != SOCK_DGRAM && sock_type != SOCK_STREAM) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM &&
+	    net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_type == SOCK_STREAM) {
+			if (sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			}
+
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				errno = EAGAIN;
+				return -1;
+			}
+
+			continue;
+		}
+
+		if (sock_type == SOCK_DGRAM && src_addr != NULL && addrlen != NULL) {
+			if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+			    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+				ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
+								    *addrlen);
+			} else {
+				ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+							    src_addr, *addrlen);
+			}
+
+			if (ret < 0) {
+				net_pkt_unref(pkt);
+				errno = -ret;
+				return -1;
+			}
+
+			*addrlen = src_addr->sa_family == AF_INET ?
+				   sizeof(struct sockaddr_in) :
+				   sizeof(struct sockaddr_in6);
+		}
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+		    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		len = net_pkt_remaining_data(pkt);
+		*buf = sock_pkt_detach_data(pkt);
+
+		if (sock_type == SOCK_STREAM) {
+			if (len == 0) {
+				/* EOF marker or fully peeked segment */
+				continue;
+			}
+
+			net_context_update_recv_wnd(ctx, len);
+		}
+
+		return len;
+	}
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1748,6 +1891,32 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 			break;
 
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				struct net_context_zerocopy value;
+				size_t len = sizeof(value);
+				struct zsock_zerocopy *zc = optval;
+
+				if (*optlen != sizeof(*zc)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     &value, &len);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				zc->cb = value.cb;
+				zc->user_data = value.user_data;
+
+				return 0;
+			}
+			break;
+
 		case SO_PROTOCOL: {
 			int proto = (int)net_context_get_proto(ctx);
 
@@ -2356,6 +2525,32 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_ZEROCOPY:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+				const struct zsock_zerocopy *zc = optval;
+				struct net_context_zerocopy value;
+
+				if (zc == NULL || optlen != sizeof(*zc)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				value.cb = zc->cb;
+				value.user_data = zc->user_data;
+
+				ret = net_context_set_option(ctx,
+							     NET_OPT_ZEROCOPY,
+							     &value, sizeof(value));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_SOCKS5:
 			if (IS_ENABLED(CONFIG_SOCKS)) {
 				ret = net_context_set_option(ctx,
@@ -2979,6 +3174,14 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+static ssize_t sock_recvbuf_vmeth(void *obj, struct net_buf **buf, int flags,
+				  struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	return zsock_recvbuf_ctx(obj, buf, flags, src_addr, addrlen);
+}
+#endif
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -3027,6 +3230,9 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.setsockopt = sock_setsockopt_vmeth,
 	.getpeername = sock_getpeername_vmeth,
 	.getsockname = sock_getsockname_vmeth,
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	.recvbuf = sock_recvbuf_vmeth,
+#endif
 };
 
 static bool inet_is_supported(int family, int type, int proto)
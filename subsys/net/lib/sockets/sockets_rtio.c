@@ -0,0 +1,549 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_rtio, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/zvfs/eventfd.h>
+#include <zephyr/zvfs/epoll.h>
+
+#define MAX_EVENTS 8
+
+enum sock_rtio_status {
+	SOCK_RTIO_UNINITIALIZED = 0,
+	SOCK_RTIO_FAILED,
+	SOCK_RTIO_RUNNING,
+};
+
+/* Operations of one direction of a socket, done in order */
+struct sock_rtio_queue {
+	/* Operation being tried, waiting for the socket when set */
+	struct rtio_iodev_sqe *head;
+	struct mpsc pending;
+};
+
+struct sock_rtio_state {
+	/* Receives and accepts */
+	struct sock_rtio_queue in;
+	/* Sends and connects */
+	struct sock_rtio_queue out;
+	/* Events registered in the epoll instance */
+	uint32_t events;
+};
+
+static void sock_rtio_thread(void *p1, void *p2, void *p3);
+
+K_THREAD_DEFINE(net_socket_rtio_thread, CONFIG_NET_SOCKETS_RTIO_STACK_SIZE, sock_rtio_thread,
+		NULL, NULL, NULL, CONFIG_NET_SOCKETS_RTIO_THREAD_PRIO, 0, 0);
+
+static struct mpsc submit_q = MPSC_INIT(submit_q);
+static atomic_t status;
+/* Orders the submissions made while the dispatcher starts with its status */
+static struct k_spinlock status_lock;
+/* Set while the dispatcher has been woken up but has not yet taken the submissions */
+static atomic_t wake_pending;
+static int epfd = -1;
+static int wakefd = -1;
+static struct sock_rtio_state socks[CONFIG_ZVFS_OPEN_MAX];
+
+static void sock_rtio_complete(struct rtio_iodev_sqe *iodev_sqe, int ret)
+{
+	if (ret < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, ret);
+	}
+}
+
+static struct sock_rtio_queue *sock_rtio_queue_get(int fd, const struct rtio_sqe *sqe)
+{
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+	case RTIO_OP_SOCK_ACCEPT:
+		return &socks[fd].in;
+	case RTIO_OP_TX:
+	case RTIO_OP_TINY_TX:
+	case RTIO_OP_SOCK_CONNECT:
+		return &socks[fd].out;
+	default:
+		return NULL;
+	}
+}
+
+static int sock_rtio_set_nonblock(int fd)
+{
+	int flags;
+
+	flags = zsock_fcntl(fd, ZVFS_F_GETFL, 0);
+	if (flags < 0) {
+		return -errno;
+	}
+
+	if ((flags & ZVFS_O_NONBLOCK) != 0) {
+		return 0;
+	}
+
+	if (zsock_fcntl(fd, ZVFS_F_SETFL, flags | ZVFS_O_NONBLOCK) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static void sock_rtio_release_rx_buf(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+
+	if ((sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) == 0) {
+		return;
+	}
+
+	rtio_release_buffer(iodev_sqe->r, sqe->rx.buf, sqe->rx.buf_len);
+	sqe->rx.buf = NULL;
+	sqe->rx.buf_len = 0;
+}
+
+static int sock_rtio_recv(int fd, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	struct rtio_iodev_sqe *next;
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t ret;
+
+	/* A buffer from the memory pool is only taken while receiving */
+	ret = rtio_sqe_rx_buf(iodev_sqe, 1, CONFIG_NET_SOCKETS_RTIO_RECV_SIZE, &buf, &buf_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = zsock_recv(fd, buf, buf_len, ZSOCK_MSG_DONTWAIT);
+	if (ret <= 0) {
+		ret = (ret < 0) ? -errno : 0;
+		sock_rtio_release_rx_buf(iodev_sqe);
+		return ret;
+	}
+
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if ((sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) != 0) {
+		/* Give back the blocks that were not filled */
+		uint32_t used = ROUND_UP(ret, rtio_mempool_block_size(iodev_sqe->r));
+
+		rtio_release_buffer(iodev_sqe->r, buf + used, buf_len - used);
+		sqe->rx.buf_len = used;
+	}
+#endif
+
+	next = rtio_chain_next(iodev_sqe);
+	if ((next != NULL) && (next->sqe.op == RTIO_OP_TX) &&
+	    ((next->sqe.iodev_flags & RTIO_IODEV_SOCK_SEND_RECEIVED) != 0)) {
+		next->sqe.tx.buf = buf;
+		next->sqe.tx.buf_len = ret;
+	}
+
+	return ret;
+}
+
+static int sock_rtio_accept(int fd, struct rtio_sqe *sqe)
+{
+	socklen_t addrlen = sqe->accept.addrlen;
+	int ret;
+
+	ret = sock_rtio_set_nonblock(fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = zsock_accept(fd, sqe->accept.addr, (sqe->accept.addr != NULL) ? &addrlen : NULL);
+	if (ret < 0) {
+		return -errno;
+	}
+
+#ifdef CONFIG_USERSPACE
+	/* The new socket is only granted to this thread, not to the user mode submitter */
+	if (sqe->accept.owner != NULL) {
+		k_object_access_grant(z_impl_zsock_get_context_object(ret), sqe->accept.owner);
+	}
+#endif
+
+	return ret;
+}
+
+static int sock_rtio_connect(int fd, struct rtio_sqe *sqe)
+{
+	int ret;
+
+	ret = sock_rtio_set_nonblock(fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Called again once writable to get the outcome of the connection */
+	ret = zsock_connect(fd, sqe->connect.addr, sqe->connect.addrlen);
+	if (ret < 0) {
+		ret = ((errno == EINPROGRESS) || (errno == EALREADY)) ? -EAGAIN : -errno;
+	}
+
+	return ret;
+}
+
+/* Try an operation, returns -EAGAIN when the socket is not ready for it */
+static int sock_rtio_try(int fd, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	ssize_t ret;
+
+	if ((sqe->flags & RTIO_SQE_CANCELED) != 0) {
+		return -ECANCELED;
+	}
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		return sock_rtio_recv(fd, iodev_sqe);
+	case RTIO_OP_TX:
+		if ((sqe->tx.buf == NULL) &&
+		    ((sqe->iodev_flags & RTIO_IODEV_SOCK_SEND_RECEIVED) != 0)) {
+			/* Nothing was received to send */
+			return -ECANCELED;
+		}
+
+		ret = zsock_send(fd, sqe->tx.buf, sqe->tx.buf_len, ZSOCK_MSG_DONTWAIT);
+		break;
+	case RTIO_OP_TINY_TX:
+		ret = zsock_send(fd, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len, ZSOCK_MSG_DONTWAIT);
+		break;
+	case RTIO_OP_SOCK_ACCEPT:
+		return sock_rtio_accept(fd, sqe);
+	case RTIO_OP_SOCK_CONNECT:
+		return sock_rtio_connect(fd, sqe);
+	default:
+		return -ENOTSUP;
+	}
+
+	return (ret < 0) ? -errno : ret;
+}
+
+/* Run the operations of a queue until one has to wait for the socket */
+static void sock_rtio_run(int fd, struct sock_rtio_queue *queue)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	struct mpsc_node *node;
+	int ret;
+
+	while (true) {
+		if (queue->head == NULL) {
+			node = mpsc_pop(&queue->pending);
+			if (node == NULL) {
+				break;
+			}
+
+			queue->head = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+		}
+
+		iodev_sqe = queue->head;
+
+		ret = sock_rtio_try(fd, iodev_sqe);
+		if (ret == -EAGAIN) {
+			break;
+		}
+
+		/* A multishot receive ends with its first failure */
+		if ((iodev_sqe->sqe.op == RTIO_OP_RX) && (ret <= 0)) {
+			iodev_sqe->sqe.flags &= ~RTIO_SQE_MULTISHOT;
+		}
+
+		/* Completing may submit again, the queue must be consistent by then */
+		queue->head = NULL;
+		sock_rtio_complete(iodev_sqe, ret);
+	}
+}
+
+static void sock_rtio_fail(struct sock_rtio_queue *queue, int err)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	struct mpsc_node *node;
+
+	while (true) {
+		iodev_sqe = queue->head;
+		if (iodev_sqe == NULL) {
+			node = mpsc_pop(&queue->pending);
+			if (node == NULL) {
+				break;
+			}
+
+			iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+		}
+
+		queue->head = NULL;
+		iodev_sqe->sqe.flags &= ~RTIO_SQE_MULTISHOT;
+		sock_rtio_complete(iodev_sqe, err);
+	}
+}
+
+/* Register in the epoll instance the events the queues of a socket wait for */
+static void sock_rtio_arm(int fd)
+{
+	struct sock_rtio_state *state = &socks[fd];
+	struct zvfs_epoll_event ev = {
+		.data.fd = fd,
+	};
+	int op;
+	int ret;
+
+	ev.events = ((state->in.head != NULL) ? ZVFS_EPOLLIN : 0) |
+		    ((state->out.head != NULL) ? ZVFS_EPOLLOUT : 0);
+
+	if (ev.events == state->events) {
+		return;
+	}
+
+	if (state->events == 0) {
+		op = ZVFS_EPOLL_CTL_ADD;
+	} else if (ev.events == 0) {
+		op = ZVFS_EPOLL_CTL_DEL;
+	} else {
+		op = ZVFS_EPOLL_CTL_MOD;
+	}
+
+	ret = zvfs_epoll_ctl(epfd, op, fd, &ev);
+	if ((ret < 0) && (errno == ENOENT) && (op != ZVFS_EPOLL_CTL_ADD)) {
+		/* The socket was closed and reopened since it was registered */
+		ret = (op == ZVFS_EPOLL_CTL_MOD) ? zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, fd, &ev)
+						 : 0;
+	}
+
+	if (ret < 0) {
+		ret = -errno;
+		NET_ERR("Cannot wait for socket %d (%d)", fd, ret);
+
+		(void)zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, fd, NULL);
+		state->events = 0;
+		sock_rtio_fail(&state->in, ret);
+		sock_rtio_fail(&state->out, ret);
+		return;
+	}
+
+	state->events = ev.events;
+}
+
+static void sock_rtio_start(struct rtio_iodev_sqe *iodev_sqe)
+{
+	int fd = RTIO_IODEV_SOCK_FD_GET(iodev_sqe->sqe.iodev_flags);
+	struct sock_rtio_queue *queue;
+
+	if (fd >= (int)ARRAY_SIZE(socks)) {
+		rtio_iodev_sqe_err(iodev_sqe, -EBADF);
+		return;
+	}
+
+	queue = sock_rtio_queue_get(fd, &iodev_sqe->sqe);
+	if (queue == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	if (queue->head != NULL) {
+		/* Will run once the operations ahead of it are done */
+		mpsc_push(&queue->pending, &iodev_sqe->q);
+		return;
+	}
+
+	queue->head = iodev_sqe;
+	sock_rtio_run(fd, queue);
+	sock_rtio_arm(fd);
+}
+
+static void sock_rtio_take_submissions(void)
+{
+	struct mpsc_node *node;
+
+	/* Completions may add to the queue while it is drained */
+	while ((node = mpsc_pop(&submit_q)) != NULL) {
+		sock_rtio_start(CONTAINER_OF(node, struct rtio_iodev_sqe, q));
+	}
+}
+
+static bool sock_rtio_is_canceled(const struct sock_rtio_queue *queue)
+{
+	return (queue->head != NULL) && ((queue->head->sqe.flags & RTIO_SQE_CANCELED) != 0);
+}
+
+/* Complete the canceled operations that wait for their socket */
+static void sock_rtio_sweep(void)
+{
+	ARRAY_FOR_EACH(socks, fd) {
+		if (socks[fd].events == 0) {
+			continue;
+		}
+
+		if (sock_rtio_is_canceled(&socks[fd].in)) {
+			sock_rtio_run(fd, &socks[fd].in);
+		}
+
+		if (sock_rtio_is_canceled(&socks[fd].out)) {
+			sock_rtio_run(fd, &socks[fd].out);
+		}
+
+		sock_rtio_arm(fd);
+	}
+}
+
+static int sock_rtio_setup(void)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+	};
+
+	ARRAY_FOR_EACH(socks, fd) {
+		mpsc_init(&socks[fd].in.pending);
+		mpsc_init(&socks[fd].out.pending);
+	}
+
+	epfd = zvfs_epoll_create(0);
+	if (epfd < 0) {
+		return -errno;
+	}
+
+	wakefd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	if (wakefd < 0) {
+		return -errno;
+	}
+
+	ev.data.fd = wakefd;
+	if (zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, wakefd, &ev) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static void sock_rtio_thread(void *p1, void *p2, void *p3)
+{
+	struct zvfs_epoll_event events[MAX_EVENTS];
+	struct sock_rtio_state *state;
+	struct mpsc_node *node;
+	k_spinlock_key_t key;
+	zvfs_eventfd_t value;
+	int ret;
+	int fd;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	ret = sock_rtio_setup();
+	if (ret < 0) {
+		NET_ERR("Socket RTIO dispatcher setup failed (%d)", ret);
+	}
+
+	/* The submissions made until now are taken below */
+	key = k_spin_lock(&status_lock);
+	atomic_set(&status, (ret < 0) ? SOCK_RTIO_FAILED : SOCK_RTIO_RUNNING);
+	k_spin_unlock(&status_lock, key);
+
+	if (ret < 0) {
+		while ((node = mpsc_pop(&submit_q)) != NULL) {
+			rtio_iodev_sqe_err(CONTAINER_OF(node, struct rtio_iodev_sqe, q), -EIO);
+		}
+
+		return;
+	}
+
+	while (true) {
+		sock_rtio_take_submissions();
+
+		ret = zvfs_epoll_wait(epfd, events, ARRAY_SIZE(events), K_FOREVER);
+		if (ret < 0) {
+			NET_ERR("Socket RTIO dispatcher wait failed (%d)", -errno);
+			continue;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			fd = events[i].data.fd;
+
+			if (fd == wakefd) {
+				(void)zvfs_eventfd_read(wakefd, &value);
+				atomic_clear(&wake_pending);
+				sock_rtio_sweep();
+				continue;
+			}
+
+			state = &socks[fd];
+
+			if ((events[i].events & (ZVFS_EPOLLIN | ZVFS_EPOLLERR | ZVFS_EPOLLHUP)) != 0) {
+				sock_rtio_run(fd, &state->in);
+			}
+
+			if ((events[i].events & (ZVFS_EPOLLOUT | ZVFS_EPOLLERR | ZVFS_EPOLLHUP)) != 0) {
+				sock_rtio_run(fd, &state->out);
+			}
+
+			sock_rtio_arm(fd);
+		}
+	}
+}
+
+static void sock_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	if (atomic_get(&status) != SOCK_RTIO_RUNNING) {
+		k_spinlock_key_t key = k_spin_lock(&status_lock);
+		atomic_val_t current = atomic_get(&status);
+
+		/* Taken by the dispatcher once it runs */
+		if (current == SOCK_RTIO_UNINITIALIZED) {
+			mpsc_push(&submit_q, &iodev_sqe->q);
+		}
+
+		k_spin_unlock(&status_lock, key);
+
+		if (current == SOCK_RTIO_FAILED) {
+			rtio_iodev_sqe_err(iodev_sqe, -EIO);
+		}
+
+		if (current != SOCK_RTIO_RUNNING) {
+			return;
+		}
+	}
+
+	mpsc_push(&submit_q, &iodev_sqe->q);
+
+	/* Submissions made while completing are taken without waking up the dispatcher,
+	 * and a batch of submissions only wakes it up once.
+	 */
+	if ((k_current_get() != net_socket_rtio_thread) && atomic_cas(&wake_pending, 0, 1)) {
+		(void)zvfs_eventfd_write(wakefd, 1);
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+void z_net_socket_rtio_vrfy_sqe(struct rtio_sqe *sqe)
+{
+	/* Checked for each submission as it is copied in, chained ones included, as the
+	 * dispatcher cannot tell which thread submitted an operation.
+	 */
+	if (z_impl_zsock_get_context_object(RTIO_IODEV_SOCK_FD_GET(sqe->iodev_flags)) == NULL) {
+		/* Out of the descriptor table, the operation completes with -EBADF */
+		sqe->iodev_flags = RTIO_IODEV_SOCK_FD_SET(RTIO_IODEV_SOCK_FD_MASK);
+	}
+
+	if (sqe->op == RTIO_OP_SOCK_ACCEPT) {
+		sqe->accept.owner = k_current_get();
+	}
+}
+#endif /* CONFIG_USERSPACE */
+
+static const struct rtio_iodev_api sock_rtio_api = {
+	.submit = sock_rtio_submit,
+};
+
+RTIO_IODEV_DEFINE(net_socket_rtio_iodev, &sock_rtio_api, NULL);
@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
 #include <zephyr/zvfs/eventfd.h>
+#include <zephyr/zvfs/epoll.h>
 
 static int init_socket_service(void);
 
@@ -29,7 +30,9 @@ STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
 static struct service {
-	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
+	/* With epoll, only the restart eventfd lives here */
+	struct zsock_pollfd events[COND_CODE_1(CONFIG_NET_SOCKETS_SERVICE_EPOLL,
+					       (1), (CONFIG_ZVFS_POLL_MAX))];
 	int count;
 } ctx;
 
@@ -98,6 +101,7 @@ out:
 	return ret;
 }
 
+#if !defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
 static struct net_socket_service_desc *find_svc_and_event(
 	struct zsock_pollfd *pev,
 	struct net_socket_service_event **event)
@@ -113,6 +117,7 @@ static struct net_socket_service_desc *find_svc_and_event(
 
 	return NULL;
 }
+#endif /* !CONFIG_NET_SOCKETS_SERVICE_EPOLL */
 
 /* We do not set the user callback to our work struct because we need to
  * hook into the flow and restore the global poll array so that the next poll
@@ -126,6 +131,7 @@ void net_socket_service_callback(struct net_socket_service_event *pev)
 	ev.callback(&ev);
 }
 
+#if !defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
 static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event)
 {
 	int ret = 0;
@@ -164,11 +170,138 @@ static int trigger_work(struct zsock_pollfd *pev)
 
 	return call_work(pev, event);
 }
+#else
+static struct net_socket_service_desc *find_svc(struct net_socket_service_event *event)
+{
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		if (event >= svc->pev && event < svc->pev + svc->pev_len) {
+			return svc;
+		}
+	}
 
-static void socket_service_thread(void)
+	return NULL;
+}
+
+/* Build a new interest list from the registered services. The restart
+ * eventfd is tagged with a NULL pointer, the sockets with their service event.
+ */
+static int socket_service_epoll_setup(int efd)
+{
+	struct zvfs_epoll_event ev;
+	int epfd, ret;
+
+	epfd = zvfs_epoll_create(0);
+	if (epfd < 0) {
+		return -errno;
+	}
+
+	ev.events = ZVFS_EPOLLIN;
+	ev.data.ptr = NULL;
+
+	ret = zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd, &ev);
+	if (ret < 0) {
+		ret = -errno;
+		(void)zsock_close(epfd);
+		return ret;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
+		for (int j = 0; j < svc->pev_len; j++) {
+			if (svc->pev[j].event.fd < 0) {
+				continue;
+			}
+
+			ev.events = svc->pev[j].event.events;
+			ev.data.ptr = &svc->pev[j];
+
+			ret = zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, svc->pev[j].event.fd, &ev);
+			if (ret < 0) {
+				ret = -errno;
+				NET_ERR("Cannot monitor fd %d (%d)", svc->pev[j].event.fd, ret);
+				if (ret == -ENOSPC) {
+					NET_ERR("Please increase value of %s",
+						"CONFIG_ZVFS_EPOLL_ITEMS_MAX");
+				}
+				goto fail;
+			}
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return epfd;
+
+fail:
+	k_mutex_unlock(&lock);
+	(void)zsock_close(epfd);
+
+	return ret;
+}
+
+/* Only the sockets that became ready are visited on each round, so the
+ * number of monitored sockets is not limited by CONFIG_ZVFS_POLL_MAX.
+ */
+static int socket_service_epoll_loop(int efd)
 {
-	int ret, i, fd, count = 0;
+	struct zvfs_epoll_event evs[CONFIG_ZVFS_POLL_MAX];
+	struct net_socket_service_event *event;
+	struct net_socket_service_desc *svc;
 	zvfs_eventfd_t value;
+	bool restart;
+	int epfd, ret;
+
+restart:
+	epfd = socket_service_epoll_setup(efd);
+	if (epfd < 0) {
+		NET_ERR("epoll setup failed (%d)", epfd);
+		return epfd;
+	}
+
+	while (true) {
+		ret = zvfs_epoll_wait(epfd, evs, ARRAY_SIZE(evs), K_FOREVER);
+		if (ret < 0) {
+			ret = -errno;
+			NET_ERR("epoll wait failed (%d)", ret);
+			(void)zsock_close(epfd);
+			return ret;
+		}
+
+		restart = false;
+
+		for (int i = 0; i < ret; i++) {
+			event = evs[i].data.ptr;
+			if (event == NULL) {
+				restart = true;
+				continue;
+			}
+
+			svc = find_svc(event);
+			if (svc == NULL) {
+				continue;
+			}
+
+			event->svc = svc;
+			event->event.revents = evs[i].events;
+
+			net_socket_service_callback(event);
+		}
+
+		/* Handle after the callbacks so the work gets done before restarting */
+		if (restart) {
+			zvfs_eventfd_read(efd, &value);
+			NET_DBG("Received restart event.");
+			(void)zsock_close(epfd);
+			goto restart;
+		}
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
+
+static void socket_service_thread(void)
+{
+	int ret, fd, count = 0;
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
 	if (ret == 0) {
@@ -186,7 +319,8 @@ static void socket_service_thread(void)
 		count += svc->pev_len;
 	}
 
-	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
+	if (!IS_ENABLED(CONFIG_NET_SOCKETS_SERVICE_EPOLL) &&
+	    (count + 1) > ARRAY_SIZE(ctx.events)) {
 		NET_ERR("You have %d services to monitor but "
 			"%zd poll entries configured.",
 			count + 1, ARRAY_SIZE(ctx.events));
@@ -213,6 +347,13 @@ static void socket_service_thread(void)
 	ctx.events[0].fd = fd;
 	ctx.events[0].events = ZSOCK_POLLIN;
 
+#if defined(CONFIG_NET_SOCKETS_SERVICE_EPOLL)
+	(void)socket_service_epoll_loop(fd);
+	goto out;
+#else
+	zvfs_eventfd_t value;
+	int i;
+
 restart:
 	i = 1;
 
@@ -263,6 +404,7 @@ restart:
 			goto restart;
 		}
 	}
+#endif /* CONFIG_NET_SOCKETS_SERVICE_EPOLL */
 
 out:
 	NET_DBG("Socket service thread stopped");
@@ -20,10 +20,58 @@ static char sample_packet[PACKET_SIZE_MAX];
 
 static struct zperf_async_upload_context tcp_async_upload_ctx;
 
+#if defined(CONFIG_NET_ZPERF_ZEROCOPY)
+/* The sample packet is static and never changes while it is being sent,
+ * so the completions do not need to be waited for.
+ */
+static void zerocopy_done(const void *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(user_data);
+}
+
+static ssize_t send_data(int sock, const void *buf, size_t len)
+{
+	struct iovec iov = {
+		.iov_base = (void *)buf,
+		.iov_len = len,
+	};
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+
+	return zsock_sendmsg(sock, &msg, ZSOCK_MSG_ZEROCOPY);
+}
+
+static void zerocopy_enable(int sock)
+{
+	struct zsock_zerocopy zc = {
+		.cb = zerocopy_done,
+	};
+
+	/* Falls back to copying if this fails */
+	if (zsock_setsockopt(sock, SOL_SOCKET, SO_ZEROCOPY, &zc, sizeof(zc)) != 0) {
+		NET_WARN("Failed to set SOL_SOCKET - SO_ZEROCOPY socket option.");
+	}
+}
+#else
+static ssize_t send_data(int sock, const void *buf, size_t len)
+{
+	return zsock_send(sock, buf, len, 0);
+}
+
+static void zerocopy_enable(int sock)
+{
+	ARG_UNUSED(sock);
+}
+#endif
+
 static ssize_t sendall(int sock, const void *buf, size_t len)
 {
 	while (len) {
-		ssize_t out_len = zsock_send(sock, buf, len, 0);
+		ssize_t out_len = send_data(sock, buf, len);
 
 		if (out_len < 0) {
 			return out_len;
@@ -53,6 +101,8 @@ static int tcp_upload(int sock,
 		packet_size = PACKET_SIZE_MAX;
 	}
 
+	zerocopy_enable(sock);
+
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 
@@ -7,9 +7,154 @@
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/kernel.h>
 
+#ifdef CONFIG_RTIO_TIMEOUT
+/* Delays and linked timeouts put a bare _timeout of each submission on the
+ * kernel timeout queue, as k_timer does. A k_timer would add a wait queue and
+ * user data that the submission pools would carry for every entry.
+ */
+#include <timeout_q.h>
+#endif
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(rtio_executor, CONFIG_RTIO_LOG_LEVEL);
 
+static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe);
+
+#ifdef CONFIG_RTIO_TIMEOUT
+
+/* States of a linked timeout */
+enum {
+	RTIO_LINK_TIMEOUT_ARMED,
+	RTIO_LINK_TIMEOUT_EXPIRED,
+	RTIO_LINK_TIMEOUT_DONE,
+};
+
+/* Serializes the expiry of linked timeouts with the completion of their chain */
+static struct k_spinlock rtio_timeout_lock;
+
+static void rtio_delay_expired(struct _timeout *t)
+{
+	struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(t, struct rtio_iodev_sqe, timeout);
+
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+}
+
+static void rtio_delay_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	uint32_t ticks = iodev_sqe->sqe.delay.ticks;
+
+	if (ticks == RTIO_SQE_DELAY_FOREVER) {
+		rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
+		return;
+	}
+
+	if (ticks == 0U) {
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
+		return;
+	}
+
+	z_add_timeout(&iodev_sqe->timeout, rtio_delay_expired, K_TICKS(ticks));
+
+	/* Canceled while being armed, the cancellation could not abort it */
+	if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+		rtio_executor_cancel_delay(iodev_sqe);
+	}
+}
+
+void rtio_executor_cancel_delay(struct rtio_iodev_sqe *iodev_sqe)
+{
+	if ((iodev_sqe->sqe.op == RTIO_OP_DELAY) && (z_abort_timeout(&iodev_sqe->timeout) == 0)) {
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+	}
+}
+
+static void rtio_link_timeout_expired(struct _timeout *t)
+{
+	struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(t, struct rtio_iodev_sqe, timeout);
+	k_spinlock_key_t key = k_spin_lock(&rtio_timeout_lock);
+
+	if (iodev_sqe->timeout_state == RTIO_LINK_TIMEOUT_DONE) {
+		/* The chain completed while the timeout was expiring */
+		k_spin_unlock(&rtio_timeout_lock, key);
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
+		return;
+	}
+
+	iodev_sqe->timeout_state = RTIO_LINK_TIMEOUT_EXPIRED;
+
+	/* Report the expiry right away, the timeout is released with its chain */
+	if ((iodev_sqe->sqe.flags & (RTIO_SQE_CANCELED | RTIO_SQE_NO_RESPONSE)) == 0) {
+		rtio_cqe_submit(iodev_sqe->r, -ETIMEDOUT, iodev_sqe->sqe.userdata, 0);
+	}
+
+	k_spin_unlock(&rtio_timeout_lock, key);
+}
+
+static void rtio_link_timeout_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev_sqe *first = iodev_sqe->next;
+
+	if (!FIELD_GET(RTIO_SQE_CHAINED, iodev_sqe->sqe.flags) ||
+	    (iodev_sqe->sqe.delay.ticks == RTIO_SQE_DELAY_FOREVER)) {
+		rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
+		return;
+	}
+
+	for (struct rtio_iodev_sqe *curr = first; curr != NULL; curr = rtio_iodev_sqe_next(curr)) {
+		curr->link_timeout = iodev_sqe;
+	}
+
+	/* The timeout is no longer part of the chain, it completes after it */
+	iodev_sqe->sqe.flags &= ~RTIO_SQE_CHAINED;
+	iodev_sqe->next = NULL;
+	iodev_sqe->timeout_state = RTIO_LINK_TIMEOUT_ARMED;
+
+	z_add_timeout(&iodev_sqe->timeout, rtio_link_timeout_expired,
+		      K_TICKS(iodev_sqe->sqe.delay.ticks));
+
+	rtio_iodev_submit(first);
+}
+
+/**
+ * @brief Continue a chain bounded by a linked timeout
+ *
+ * @param link_timeout Linked timeout of the chain
+ * @param next Next submission of the chain, NULL if the chain has completed
+ */
+static void rtio_link_timeout_next(struct rtio_iodev_sqe *link_timeout,
+				   struct rtio_iodev_sqe *next)
+{
+	k_spinlock_key_t key = k_spin_lock(&rtio_timeout_lock);
+	const bool expired = link_timeout->timeout_state == RTIO_LINK_TIMEOUT_EXPIRED;
+	bool aborted = false;
+
+	if ((next == NULL) && !expired) {
+		/* Abort with the lock held, so an expiring timeout sees the chain done */
+		link_timeout->timeout_state = RTIO_LINK_TIMEOUT_DONE;
+		aborted = z_abort_timeout(&link_timeout->timeout) == 0;
+	}
+
+	k_spin_unlock(&rtio_timeout_lock, key);
+
+	if (next != NULL) {
+		if (expired) {
+			rtio_iodev_sqe_err(next, -ECANCELED);
+		} else {
+			rtio_iodev_submit(next);
+		}
+	} else if (expired) {
+		/* The completion was generated on expiry */
+		link_timeout->sqe.flags |= RTIO_SQE_NO_RESPONSE;
+		rtio_iodev_sqe_err(link_timeout, -ETIMEDOUT);
+	} else if (aborted) {
+		rtio_iodev_sqe_ok(link_timeout, 0);
+	}
+
+	/* Otherwise the expiring timeout completes itself */
+}
+
+#endif /* CONFIG_RTIO_TIMEOUT */
+
 /**
  * @brief Executor handled submissions
  */
@@ -22,6 +167,14 @@ static void rtio_executor_op(struct rtio_iodev_sqe *iodev_sqe)
 		sqe->callback.callback(iodev_sqe->r, sqe, sqe->callback.arg0);
 		rtio_iodev_sqe_ok(iodev_sqe, 0);
 		break;
+#ifdef CONFIG_RTIO_TIMEOUT
+	case RTIO_OP_DELAY:
+		rtio_delay_submit(iodev_sqe);
+		break;
+	case RTIO_OP_LINK_TIMEOUT:
+		rtio_link_timeout_submit(iodev_sqe);
+		break;
+#endif
 	default:
 		rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
 	}
@@ -71,6 +224,11 @@ void rtio_executor_submit(struct rtio *r)
 			iodev_sqe->sqe.flags |= cancel_no_response;
 		}
 		iodev_sqe->r = r;
+#ifdef CONFIG_RTIO_TIMEOUT
+		/* Initialized before any cancellation may try to abort it */
+		z_init_timeout(&iodev_sqe->timeout);
+		iodev_sqe->link_timeout = NULL;
+#endif
 
 		struct rtio_iodev_sqe *curr = iodev_sqe, *next;
 
@@ -95,6 +253,10 @@ void rtio_executor_submit(struct rtio *r)
 			curr->next = next;
 			curr = next;
 			curr->r = r;
+#ifdef CONFIG_RTIO_TIMEOUT
+			z_init_timeout(&curr->timeout);
+			curr->link_timeout = NULL;
+#endif
 
 			__ASSERT(
 				curr != NULL,
@@ -147,6 +309,9 @@ static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int resu
 	struct rtio_iodev_sqe *curr = iodev_sqe, *next;
 	void *userdata;
 	uint32_t sqe_flags, cqe_flags;
+#ifdef CONFIG_RTIO_TIMEOUT
+	struct rtio_iodev_sqe *link_timeout = iodev_sqe->link_timeout;
+#endif
 
 	do {
 		userdata = curr->sqe.userdata;
@@ -172,6 +337,13 @@ static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int resu
 		}
 	} while (sqe_flags & RTIO_SQE_TRANSACTION);
 
+#ifdef CONFIG_RTIO_TIMEOUT
+	if (link_timeout != NULL) {
+		rtio_link_timeout_next(link_timeout, (sqe_flags & RTIO_SQE_CHAINED) ? curr : NULL);
+		return;
+	}
+#endif
+
 	/* curr should now be the last sqe in the transaction if that is what completed */
 	if (sqe_flags & RTIO_SQE_CHAINED) {
 		rtio_iodev_submit(curr);
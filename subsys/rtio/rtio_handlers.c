@@ -8,6 +8,9 @@
 #include <stdbool.h>
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/internal/syscall_handler.h>
+#ifdef CONFIG_NET_SOCKETS_RTIO
+#include <zephyr/net/socket_rtio.h>
+#endif
 
 /**
  * Verify each SQE type operation and its fields ensuring
@@ -25,22 +28,46 @@ static inline bool rtio_vrfy_sqe(struct rtio_sqe *sqe)
 
 	bool valid_sqe = true;
 
+#ifdef CONFIG_NET_SOCKETS_RTIO
+	if (sqe->iodev == &net_socket_rtio_iodev) {
+		z_net_socket_rtio_vrfy_sqe(sqe);
+	}
+#endif
+
+	/* K_SYSCALL_MEMORY() is true when the access is denied */
 	switch (sqe->op) {
 	case RTIO_OP_NOP:
 		break;
 	case RTIO_OP_TX:
-		valid_sqe &= K_SYSCALL_MEMORY(sqe->tx.buf, sqe->tx.buf_len, false);
+		/* An empty send, like a socket send of the bytes received, has no buffer */
+		if ((sqe->tx.buf != NULL) || (sqe->tx.buf_len != 0)) {
+			valid_sqe &= !K_SYSCALL_MEMORY(sqe->tx.buf, sqe->tx.buf_len, false);
+		}
 		break;
 	case RTIO_OP_RX:
 		if ((sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) == 0) {
-			valid_sqe &= K_SYSCALL_MEMORY(sqe->rx.buf, sqe->rx.buf_len, true);
+			valid_sqe &= !K_SYSCALL_MEMORY(sqe->rx.buf, sqe->rx.buf_len, true);
 		}
 		break;
 	case RTIO_OP_TINY_TX:
 		break;
 	case RTIO_OP_TXRX:
-		valid_sqe &= K_SYSCALL_MEMORY(sqe->txrx.tx_buf, sqe->txrx.buf_len, true);
-		valid_sqe &= K_SYSCALL_MEMORY(sqe->txrx.rx_buf, sqe->txrx.buf_len, true);
+		valid_sqe &= !K_SYSCALL_MEMORY(sqe->txrx.tx_buf, sqe->txrx.buf_len, true);
+		valid_sqe &= !K_SYSCALL_MEMORY(sqe->txrx.rx_buf, sqe->txrx.buf_len, true);
+		break;
+	case RTIO_OP_SOCK_ACCEPT:
+		if (sqe->accept.addr != NULL) {
+			valid_sqe &= !K_SYSCALL_MEMORY(sqe->accept.addr, sqe->accept.addrlen,
+						       true);
+		}
+		break;
+	case RTIO_OP_SOCK_CONNECT:
+		valid_sqe &= !K_SYSCALL_MEMORY(sqe->connect.addr, sqe->connect.addrlen, false);
+		break;
+	case RTIO_OP_ERASE:
+		break;
+	case RTIO_OP_DELAY:
+	case RTIO_OP_LINK_TIMEOUT:
 		break;
 	default:
 		/* RTIO OP must be known and allowable from user mode
@@ -58,19 +58,41 @@ struct rtio_work_req *rtio_work_req_alloc(void)
 	return req;
 }
 
-void rtio_work_req_submit(struct rtio_work_req *req,
-			  struct rtio_iodev_sqe *iodev_sqe,
-			  rtio_work_submit_t handler)
+static struct rtio_iodev_sqe *rtio_work_queue_next(struct rtio_work_queue *queue)
 {
-	if (!req) {
-		return;
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	struct mpsc_node *node = mpsc_pop(&queue->pending);
+
+	/* Pushes are done with the lock held, so an empty queue is really empty */
+	if (node == NULL) {
+		queue->busy = false;
 	}
 
-	if (!iodev_sqe || !handler) {
-		k_mem_slab_free(&rtio_work_items_slab, req);
-		return;
+	k_spin_unlock(&queue->lock, key);
+
+	return node == NULL ? NULL : CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+}
+
+static void rtio_work_queue_handler(struct k_p4wq_work *work)
+{
+	struct rtio_work_req *req = CONTAINER_OF(work,
+						 struct rtio_work_req,
+						 work);
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	/** Submissions pushed meanwhile, like the next ones of a chain, are
+	 * handled by this same request.
+	 */
+	while ((iodev_sqe = rtio_work_queue_next(req->queue)) != NULL) {
+		req->handler(iodev_sqe);
 	}
+}
 
+static void rtio_work_req_init(struct rtio_work_req *req,
+			       struct rtio_iodev_sqe *iodev_sqe,
+			       rtio_work_submit_t handler,
+			       k_p4wq_handler_t work_handler)
+{
 	struct k_p4wq_work *work = &req->work;
 	struct rtio_sqe *sqe = &iodev_sqe->sqe;
 
@@ -80,7 +102,7 @@ void rtio_work_req_submit(struct rtio_work_req *req,
 	req->handler = handler;
 
 	/** Set the required information to handle the action */
-	work->handler = rtio_work_handler;
+	work->handler = work_handler;
 	work->deadline = 0;
 
 	if (sqe->prio == RTIO_PRIO_LOW) {
@@ -90,9 +112,59 @@ void rtio_work_req_submit(struct rtio_work_req *req,
 	} else {
 		work->priority = RTIO_WORKQ_PRIO_MED;
 	}
+}
+
+void rtio_work_req_submit(struct rtio_work_req *req,
+			  struct rtio_iodev_sqe *iodev_sqe,
+			  rtio_work_submit_t handler)
+{
+	if (!req) {
+		return;
+	}
+
+	if (!iodev_sqe || !handler) {
+		k_mem_slab_free(&rtio_work_items_slab, req);
+		return;
+	}
+
+	rtio_work_req_init(req, iodev_sqe, handler, rtio_work_handler);
+	req->queue = NULL;
 
 	/** Decoupling action: Let the P4WQ execute the action. */
-	k_p4wq_submit(&rtio_workq, work);
+	k_p4wq_submit(&rtio_workq, &req->work);
+}
+
+void rtio_work_queue_submit(struct rtio_work_queue *queue,
+			    struct rtio_iodev_sqe *iodev_sqe,
+			    rtio_work_submit_t handler)
+{
+	struct rtio_work_req *req;
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+	mpsc_push(&queue->pending, &iodev_sqe->q);
+
+	/* The request draining the queue handles this submission too */
+	if (queue->busy) {
+		k_spin_unlock(&queue->lock, key);
+		return;
+	}
+
+	queue->busy = true;
+	k_spin_unlock(&queue->lock, key);
+
+	req = rtio_work_req_alloc();
+	if (req == NULL) {
+		while ((iodev_sqe = rtio_work_queue_next(queue)) != NULL) {
+			rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		}
+		return;
+	}
+
+	/** The priority of the request is the one of the submission starting it */
+	rtio_work_req_init(req, iodev_sqe, handler, rtio_work_queue_handler);
+	req->queue = queue;
+
+	k_p4wq_submit(&rtio_workq, &req->work);
 }
 
 uint32_t rtio_work_req_used_count_get(void)
@@ -48,6 +48,16 @@ struct settings_nvs {
 	uint16_t cache_total;
 	bool loaded;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	struct {
+		uint16_t name_hash;
+		uint16_t name_id;
+	} name_index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+
+	uint16_t name_index_count;
+	bool name_index_loaded;
+	bool name_index_partial;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -120,6 +120,157 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+/* At least one slot in eight is kept free, so that probe sequences stay short and always end */
+#define SETTINGS_NVS_NAME_INDEX_MAX_IDS                                                            \
+	(CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE - MAX(CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE / 8, 1))
+
+/* Name ID of the free slots, below the first name ID */
+#define SETTINGS_NVS_NAME_INDEX_FREE 0
+
+static inline size_t settings_nvs_index_home(uint16_t name_hash)
+{
+	return name_hash % CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE;
+}
+
+static inline size_t settings_nvs_index_next(size_t pos)
+{
+	return (pos + 1 == CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE) ? 0 : pos + 1;
+}
+
+static void settings_nvs_index_add(struct settings_nvs *cf, const char *name, uint16_t name_id)
+{
+	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	size_t pos = settings_nvs_index_home(name_hash);
+
+	if (cf->name_index_count == SETTINGS_NVS_NAME_INDEX_MAX_IDS) {
+		/* The names left out are still found by reading all of them */
+		cf->name_index_partial = true;
+		return;
+	}
+
+	while (cf->name_index[pos].name_id != SETTINGS_NVS_NAME_INDEX_FREE) {
+		pos = settings_nvs_index_next(pos);
+	}
+
+	cf->name_index[pos].name_hash = name_hash;
+	cf->name_index[pos].name_id = name_id;
+	cf->name_index_count++;
+}
+
+/* Remove the entry of name_id, moving back the following entries of its probe sequence
+ * that could otherwise no longer be found.
+ */
+static void settings_nvs_index_remove(struct settings_nvs *cf, const char *name,
+				      uint16_t name_id)
+{
+	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	size_t pos = settings_nvs_index_home(name_hash);
+	size_t hole;
+	size_t home;
+
+	while (cf->name_index[pos].name_id != name_id) {
+		if (cf->name_index[pos].name_id == SETTINGS_NVS_NAME_INDEX_FREE) {
+			return;
+		}
+
+		pos = settings_nvs_index_next(pos);
+	}
+
+	hole = pos;
+
+	while (true) {
+		pos = settings_nvs_index_next(pos);
+		if (cf->name_index[pos].name_id == SETTINGS_NVS_NAME_INDEX_FREE) {
+			break;
+		}
+
+		/* Entries whose home slot lies cyclically in (hole, pos] must stay in place */
+		home = settings_nvs_index_home(cf->name_index[pos].name_hash);
+		if ((hole < pos) ? ((home > hole) && (home <= pos))
+				 : ((home > hole) || (home <= pos))) {
+			continue;
+		}
+
+		cf->name_index[hole] = cf->name_index[pos];
+		hole = pos;
+	}
+
+	cf->name_index[hole].name_id = SETTINGS_NVS_NAME_INDEX_FREE;
+	cf->name_index_count--;
+}
+
+static void settings_nvs_index_reset(struct settings_nvs *cf)
+{
+	memset(cf->name_index, 0, sizeof(cf->name_index));
+	cf->name_index_count = 0;
+	cf->name_index_loaded = false;
+	cf->name_index_partial = false;
+}
+
+/* Index all the stored names, when they have not been loaded yet */
+static void settings_nvs_index_build(struct settings_nvs *cf, char *rdname, size_t len)
+{
+	ssize_t rc;
+
+	settings_nvs_index_reset(cf);
+
+	for (uint16_t name_id = cf->last_name_id; name_id > NVS_NAMECNT_ID; name_id--) {
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len);
+		if (rc <= 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+		settings_nvs_index_add(cf, rdname, name_id);
+	}
+
+	cf->name_index_loaded = true;
+}
+
+/* Return the lowest name ID not in use */
+static uint16_t settings_nvs_index_free_id(struct settings_nvs *cf, char *rdname, size_t len)
+{
+	for (uint16_t name_id = NVS_NAMECNT_ID + 1; name_id < cf->last_name_id; name_id++) {
+		if (nvs_read(&cf->cf_nvs, name_id, rdname, len) == -ENOENT) {
+			return name_id;
+		}
+	}
+
+	return cf->last_name_id + 1;
+}
+
+static uint16_t settings_nvs_index_match(struct settings_nvs *cf, const char *name,
+					 char *rdname, size_t len)
+{
+	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	size_t pos = settings_nvs_index_home(name_hash);
+	int rc;
+
+	for (; cf->name_index[pos].name_id != SETTINGS_NVS_NAME_INDEX_FREE;
+	     pos = settings_nvs_index_next(pos)) {
+		if (cf->name_index[pos].name_hash != name_hash) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, cf->name_index[pos].name_id, rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname)) {
+			continue;
+		}
+
+		return cf->name_index[pos].name_id;
+	}
+
+	return NVS_NAMECNT_ID;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -137,6 +288,15 @@ static int settings_nvs_load(struct settings_store *cs,
 	cf->loaded = false;
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* The names are indexed on the first load, the index is then kept up to date by saves */
+	bool indexing = !cf->name_index_loaded;
+
+	if (indexing) {
+		settings_nvs_index_reset(cf);
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -146,6 +306,10 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 			cf->loaded = true;
 			cf->cache_total = cached;
+#endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			/* A save called by a handler may have indexed the names meanwhile */
+			cf->name_index_loaded = true;
 #endif
 			break;
 		}
@@ -155,6 +319,28 @@ static int settings_nvs_load(struct settings_store *cs,
 		 * setting's value.
 		 */
 		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		if ((rc1 > 0) && arg && arg->subtree) {
+			/* Names outside of the loaded subtree are skipped without
+			 * reading their value.
+			 */
+			name[rc1] = '\0';
+			if (!settings_name_steq(name, arg->subtree, NULL)) {
+#if CONFIG_SETTINGS_NVS_NAME_CACHE
+				/* The cache must hold all the names for saves to
+				 * rely on it once loaded.
+				 */
+				settings_nvs_cache_add(cf, name, name_id);
+				cached++;
+#endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+				if (indexing && !cf->name_index_loaded) {
+					settings_nvs_index_add(cf, name, name_id);
+				}
+#endif
+				continue;
+			}
+		}
+
 		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
 			       &buf, sizeof(buf));
 
@@ -182,6 +368,13 @@ static int settings_nvs_load(struct settings_store *cs,
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			if ((rc1 > 0) && cf->name_index_loaded) {
+				name[rc1] = '\0';
+				settings_nvs_index_remove(cf, name, name_id);
+			}
+#endif
+
 			if (name_id == cf->last_name_id) {
 				cf->last_name_id--;
 				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -200,6 +393,11 @@ static int settings_nvs_load(struct settings_store *cs,
 		settings_nvs_cache_add(cf, name, name_id);
 		cached++;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		if (indexing && !cf->name_index_loaded) {
+			settings_nvs_index_add(cf, name, name_id);
+		}
+#endif
 
 		ret = settings_call_set_handler(
 			name, rc2,
@@ -240,10 +438,40 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (!cf->name_index_loaded) {
+		settings_nvs_index_build(cf, rdname, sizeof(rdname));
+	}
+
+	name_id = settings_nvs_index_match(cf, name, rdname, sizeof(rdname));
+	if (name_id != NVS_NAMECNT_ID) {
+		write_name_id = name_id;
+		write_name = false;
+		goto found;
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* A name missing from a complete index is not stored. It is given the
+	 * next ID, or the first free one when names have been deleted.
+	 */
+	if (!cf->name_index_partial) {
+		if (delete) {
+			return 0;
+		}
+
+		if (cf->name_index_count < cf->last_name_id - NVS_NAMECNT_ID) {
+			write_name_id = settings_nvs_index_free_id(cf, rdname, sizeof(rdname));
+		}
+
+		goto found;
+	}
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	/* We can skip reading NVS if we know that the cache wasn't overflowed. */
 	if (cf->loaded && !SETTINGS_NVS_CACHE_OVFL(cf)) {
@@ -297,6 +525,10 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_remove(cf, name, name_id);
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -351,6 +583,12 @@ found:
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (write_name) {
+		settings_nvs_index_add(cf, name, write_name_id);
+	}
+#endif
+
 	return 0;
 }
 
@@ -172,6 +172,16 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 		 */
 		rc1 = zms_read(&cf->cf_zms, ZMS_NAME_ID_FROM_LL_NODE(ll_hash_id), &name,
 			       sizeof(name) - 1);
+		if ((rc1 > 0) && arg && arg->subtree) {
+			/* Names outside of the loaded subtree are skipped without
+			 * looking up their value.
+			 */
+			name[rc1] = '\0';
+			if (!settings_name_steq(name, arg->subtree, NULL)) {
+				goto next;
+			}
+		}
+
 		/* get the length of data and verify that it exists */
 		rc2 = zms_get_data_length(&cf->cf_zms, ZMS_NAME_ID_FROM_LL_NODE(ll_hash_id) +
 							       ZMS_DATA_ID_OFFSET);
@@ -200,6 +210,7 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 			break;
 		}
 
+next:
 		/* update next ll_hash_id */
 		ret = zms_read(&cf->cf_zms, ll_hash_id, &settings_element,
 			       sizeof(struct settings_hash_linked_list));
@@ -8,9 +8,9 @@
 #if K_HEAP_MEM_POOL_SIZE > 0
 #include "kernel_shell.h"
 
-#include <zephyr/sys/sys_heap.h>
+#include <zephyr/kernel.h>
 
-extern struct sys_heap _system_heap;
+extern struct k_heap _system_heap;
 
 static int cmd_kernel_heap(const struct shell *sh, size_t argc, char **argv)
 {
@@ -20,7 +20,7 @@ static int cmd_kernel_heap(const struct shell *sh, size_t argc, char **argv)
 	int err;
 	struct sys_memory_stats stats;
 
-	err = sys_heap_runtime_stats_get(&_system_heap, &stats);
+	err = k_heap_runtime_stats_get(&_system_heap, &stats);
 	if (err) {
 		shell_error(sh, "Failed to read kernel system heap statistics (err %d)", err);
 		return -ENOEXEC;
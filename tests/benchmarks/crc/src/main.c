@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the throughput of the CRC routines
+ * for buffers of different sizes.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/crc.h>
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define MAX_LENGTH     16384
+
+static const size_t lengths[] = { 64, 1024, MAX_LENGTH };
+
+static uint8_t data[MAX_LENGTH];
+
+static uint32_t rand_state = 0x2545f491;
+
+/* Deterministic xorshift so that all the tiers see the same data */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static uint32_t reflect_bitwise(uint32_t poly, uint32_t crc, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (int j = 0; j < 8; j++) {
+			crc = (crc & 1U) ? (crc >> 1) ^ poly : crc >> 1;
+		}
+	}
+
+	return crc;
+}
+
+static uint32_t run_crc32_ieee(size_t len)
+{
+	return crc32_ieee(data, len);
+}
+
+static uint32_t ref_crc32_ieee(size_t len)
+{
+	return ~reflect_bitwise(0xedb88320, ~0U, len);
+}
+
+static uint32_t run_crc32_c(size_t len)
+{
+	return crc32_c(0, data, len, true, true);
+}
+
+static uint32_t ref_crc32_c(size_t len)
+{
+	return ~reflect_bitwise(0x82f63b78, ~0U, len);
+}
+
+static uint32_t run_crc16_ccitt(size_t len)
+{
+	return crc16_ccitt(0xffff, data, len);
+}
+
+static uint32_t ref_crc16_ccitt(size_t len)
+{
+	return crc16_reflect(0x8408, 0xffff, data, len);
+}
+
+static uint32_t run_crc16_itu_t(size_t len)
+{
+	return crc16_itu_t(0xffff, data, len);
+}
+
+static uint32_t ref_crc16_itu_t(size_t len)
+{
+	return crc16(0x1021, 0xffff, data, len);
+}
+
+static const struct {
+	const char *name;
+	uint32_t (*run)(size_t len);
+	uint32_t (*ref)(size_t len);
+} algorithms[] = {
+	{ "crc32_ieee", run_crc32_ieee, ref_crc32_ieee },
+	{ "crc32_c", run_crc32_c, ref_crc32_c },
+	{ "crc16_ccitt", run_crc16_ccitt, ref_crc16_ccitt },
+	{ "crc16_itu_t", run_crc16_itu_t, ref_crc16_itu_t },
+};
+
+static const char *tier_name(void)
+{
+	if (IS_ENABLED(CONFIG_CRC_HW_ACCEL)) {
+		return "hw";
+	}
+
+	if (IS_ENABLED(CONFIG_CRC_SPEED_OPTIMIZED)) {
+		return "speed";
+	}
+
+	return "size";
+}
+
+static int test_algorithm(unsigned int a, size_t len)
+{
+	uint32_t expected = algorithms[a].ref(len);
+	uint64_t total = 0;
+	uint64_t average;
+	uint64_t ns;
+	timing_t start;
+	timing_t finish;
+	int mismatches = 0;
+
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		uint32_t crc;
+
+		start = timing_counter_get();
+		crc = algorithms[a].run(len);
+		finish = timing_counter_get();
+
+		total += timing_cycles_get(&start, &finish);
+
+		if (crc != expected) {
+			mismatches++;
+		}
+	}
+
+	average = total / NUM_ITERATIONS;
+	ns = MAX(timing_cycles_to_ns(average), 1);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: crc.%s.%s.%zu - "
+	       "%s over %zu bytes (%s), avg. : "
+	       "%7llu cycles , %7u ns :\n", algorithms[a].name, tier_name(), len,
+	       algorithms[a].name, len, tier_name(), average, (uint32_t)ns);
+#else
+	printk("------------------------------------\n");
+	printk("%s over %zu bytes (%s)\n", algorithms[a].name, len, tier_name());
+	printk("    Average : %7llu cycles (%7u nsec)\n", average, (uint32_t)ns);
+#endif
+	printk("    Throughput : %u KiB/s\n",
+	       (uint32_t)((uint64_t)len * NSEC_PER_SEC / 1024U / ns));
+
+	if (mismatches != 0) {
+		printk("%d results did not match the reference\n", mismatches);
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)next_rand();
+	}
+
+	timing_init();
+
+	printk("Time Measurements for the CRC routines (%s)\n", tier_name());
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	ARRAY_FOR_EACH(lengths, l) {
+		ARRAY_FOR_EACH(algorithms, a) {
+			status |= test_algorithm(a, lengths[l]);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
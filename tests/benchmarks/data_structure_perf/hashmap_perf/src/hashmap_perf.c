@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Hashmap performance tests
+ *
+ * Compare the Hashmap implementations on insertion, lookup of present and
+ * absent keys, and removal.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/hash_map.h>
+
+#define N_KEYS	       512
+#define NUM_ITERATIONS 10
+
+SYS_HASHMAP_SC_DEFINE(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE(oa_lp_map);
+SYS_HASHMAP_SWISS_DEFINE(swiss_map);
+#ifdef CONFIG_SYS_HASH_MAP_CXX
+SYS_HASHMAP_CXX_DEFINE(cxx_map);
+#endif
+
+static const struct {
+	const char *name;
+	struct sys_hashmap *map;
+} backends[] = {
+	{ "separate_chaining", &sc_map },
+	{ "open_addressing", &oa_lp_map },
+	{ "swiss_table", &swiss_map },
+#ifdef CONFIG_SYS_HASH_MAP_CXX
+	{ "cxx", &cxx_map },
+#endif
+};
+
+enum hashmap_op {
+	OP_INSERT,
+	OP_GET_HIT,
+	OP_GET_MISS,
+	OP_REMOVE,
+	OP_COUNT,
+};
+
+static const char *const op_names[OP_COUNT] = {
+	"insert", "lookup hit", "lookup miss", "remove",
+};
+
+/* Present keys are even, absent keys are odd */
+static uint64_t keys[N_KEYS];
+static uint64_t missing_keys[N_KEYS];
+
+static uint32_t rand_state = 0x2545f491;
+
+/* Deterministic xorshift so that all the implementations see the same keys */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void *setup(void)
+{
+	for (size_t i = 0; i < N_KEYS; i++) {
+		keys[i] = ((uint64_t)next_rand() << 32 | next_rand()) & ~1ULL;
+		missing_keys[i] = ((uint64_t)next_rand() << 32 | next_rand()) | 1ULL;
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	timing_stop();
+}
+
+static uint64_t run_op(struct sys_hashmap *map, enum hashmap_op op)
+{
+	timing_t start;
+	timing_t finish;
+	uint64_t value;
+
+	start = timing_counter_get();
+
+	for (size_t i = 0; i < N_KEYS; i++) {
+		switch (op) {
+		case OP_INSERT:
+			zassert_true(sys_hashmap_insert(map, keys[i], i, NULL) >= 0);
+			break;
+		case OP_GET_HIT:
+			zassert_true(sys_hashmap_get(map, keys[i], &value));
+			break;
+		case OP_GET_MISS:
+			zassert_false(sys_hashmap_get(map, missing_keys[i], &value));
+			break;
+		case OP_REMOVE:
+			zassert_true(sys_hashmap_remove(map, keys[i], &value));
+			break;
+		default:
+			break;
+		}
+	}
+
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+/**
+ * @brief Measure the average cost of each Hashmap operation
+ *
+ * @details For each implementation, insert @ref N_KEYS random keys, look
+ * all of them up, look up as many absent keys and remove the keys again,
+ * growing and shrinking the table along the way.
+ */
+ZTEST(hashmap_perf, test_hashmap_ops)
+{
+	uint64_t totals[OP_COUNT];
+	uint64_t average;
+
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	ARRAY_FOR_EACH(backends, b) {
+		struct sys_hashmap *map = backends[b].map;
+
+		memset(totals, 0, sizeof(totals));
+
+		for (int i = 0; i < NUM_ITERATIONS; i++) {
+			for (int op = 0; op < OP_COUNT; op++) {
+				totals[op] += run_op(map, op);
+			}
+
+			zassert_true(sys_hashmap_is_empty(map));
+		}
+
+		for (int op = 0; op < OP_COUNT; op++) {
+			average = totals[op] / (NUM_ITERATIONS * N_KEYS);
+
+			TC_PRINT("%-17s %-11s: %6llu cycles (%6u nsec)\n", backends[b].name,
+				 op_names[op], average, (uint32_t)timing_cycles_to_ns(average));
+		}
+	}
+}
+
+ZTEST_SUITE(hashmap_perf, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief ZMS and NVS lookup benchmark
+ *
+ * Measure the mount time and the read latency of ZMS or NVS on the flash
+ * simulator against the number of stored IDs, to compare the lookups walking
+ * the flash with the ones using the lookup cache or the lookup index.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/storage/flash_map.h>
+#ifdef CONFIG_ZMS
+#include <zephyr/fs/zms.h>
+#else
+#include <zephyr/fs/nvs.h>
+#endif
+
+#define STORAGE_PARTITION        storage_partition
+#define STORAGE_PARTITION_DEVICE FIXED_PARTITION_DEVICE(STORAGE_PARTITION)
+#define STORAGE_PARTITION_OFFSET FIXED_PARTITION_OFFSET(STORAGE_PARTITION)
+#define STORAGE_PARTITION_SIZE   FIXED_PARTITION_SIZE(STORAGE_PARTITION)
+
+/* Every ID is written this many times, so that lookups also skip older ATEs */
+#define NUM_WRITES 2
+
+static const uint16_t id_counts[] = {16, 64, 256, 1024};
+
+#ifdef CONFIG_ZMS
+static struct zms_fs fs;
+
+#define storage_mount()              zms_mount(&fs)
+#define storage_clear()              zms_clear(&fs)
+#define storage_write(id, data, len) zms_write(&fs, id, data, len)
+#define storage_read(id, data, len)  zms_read(&fs, id, data, len)
+#else
+static struct nvs_fs fs;
+
+#define storage_mount()              nvs_mount(&fs)
+#define storage_clear()              nvs_clear(&fs)
+#define storage_write(id, data, len) nvs_write(&fs, id, data, len)
+#define storage_read(id, data, len)  nvs_read(&fs, id, data, len)
+#endif
+
+static void *setup(void)
+{
+	struct flash_pages_info info;
+	int err;
+
+	fs.flash_device = STORAGE_PARTITION_DEVICE;
+	zassert_true(device_is_ready(fs.flash_device), "flash device not ready");
+
+	fs.offset = STORAGE_PARTITION_OFFSET;
+	err = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	zassert_ok(err, "Unable to get page info: %d", err);
+
+	fs.sector_size = info.size;
+	fs.sector_count = STORAGE_PARTITION_SIZE / info.size;
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	timing_stop();
+}
+
+static void fill_storage(uint16_t num_ids)
+{
+	uint32_t data;
+	int err;
+
+	err = storage_mount();
+	zassert_ok(err, "mount failure: %d", err);
+	err = storage_clear();
+	zassert_ok(err, "clear failure: %d", err);
+	err = storage_mount();
+	zassert_ok(err, "mount failure: %d", err);
+
+	for (int i = 0; i < NUM_WRITES; i++) {
+		for (uint16_t id = 0; id < num_ids; id++) {
+			data = id + i;
+			err = storage_write(id, &data, sizeof(data));
+			zassert_equal(err, sizeof(data), "write failure: %d", err);
+		}
+	}
+}
+
+static uint64_t read_ids(uint16_t first_id, uint16_t num_ids, bool present)
+{
+	timing_t start;
+	timing_t finish;
+	uint32_t data;
+	int err;
+
+	start = timing_counter_get();
+
+	for (uint16_t id = first_id; id < first_id + num_ids; id++) {
+		err = storage_read(id, &data, sizeof(data));
+		if (present) {
+			zassert_equal(err, sizeof(data), "read failure: %d", err);
+			zassert_equal(data, id + NUM_WRITES - 1, "incorrect data read");
+		} else {
+			zassert_equal(err, -ENOENT, "missing ID found: %d", err);
+		}
+	}
+
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish) / num_ids;
+}
+
+/**
+ * @brief Measure the mount time and the read latency against the number of IDs
+ *
+ * @details For each count in @ref id_counts, write that many IDs @ref NUM_WRITES
+ * times, then time mounting the storage, reading every ID and reading as many
+ * IDs that do not exist.
+ */
+ZTEST(fs_lookup, test_lookup)
+{
+	timing_t start;
+	timing_t finish;
+	uint64_t mount;
+	uint64_t hit;
+	uint64_t miss;
+	int err;
+
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	ARRAY_FOR_EACH(id_counts, i) {
+		uint16_t num_ids = id_counts[i];
+
+		fill_storage(num_ids);
+
+		start = timing_counter_get();
+		err = storage_mount();
+		finish = timing_counter_get();
+		zassert_ok(err, "mount failure: %d", err);
+		mount = timing_cycles_get(&start, &finish);
+
+		hit = read_ids(0, num_ids, true);
+		miss = read_ids(num_ids, num_ids, false);
+
+		TC_PRINT("%4u IDs: mount %9llu cycles (%7u usec), read %7llu cycles (%7u nsec), "
+			 "read missing %7llu cycles (%7u nsec)\n",
+			 num_ids, mount, (uint32_t)(timing_cycles_to_ns(mount) / 1000U), hit,
+			 (uint32_t)timing_cycles_to_ns(hit), miss,
+			 (uint32_t)timing_cycles_to_ns(miss));
+	}
+}
+
+ZTEST_SUITE(fs_lookup, NULL, setup, NULL, NULL, teardown);
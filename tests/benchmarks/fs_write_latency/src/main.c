@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief ZMS write latency benchmark
+ *
+ * Measure the distribution of the ZMS write latency on the flash simulator
+ * with simulated flash timings, while the writes regularly fill sectors and
+ * trigger garbage collections, to compare the garbage collection done by the
+ * write closing a sector with the one done in the background.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/fs/zms.h>
+
+#define STORAGE_PARTITION        storage_partition
+#define STORAGE_PARTITION_DEVICE FIXED_PARTITION_DEVICE(STORAGE_PARTITION)
+#define STORAGE_PARTITION_OFFSET FIXED_PARTITION_OFFSET(STORAGE_PARTITION)
+#define STORAGE_PARTITION_SIZE   FIXED_PARTITION_SIZE(STORAGE_PARTITION)
+
+#define NUM_IDS         48
+#define DATA_SIZE       64
+#define NUM_WRITES      1024
+/* Idle time between the writes, where a background garbage collection can run */
+#define WRITE_PERIOD_MS 10
+
+/* Latencies are counted in power of 2 buckets of microseconds */
+#define NUM_BUCKETS 16
+
+static struct zms_fs fs;
+static uint32_t histogram[NUM_BUCKETS];
+
+static void *setup(void)
+{
+	struct flash_pages_info info;
+	int err;
+
+	fs.flash_device = STORAGE_PARTITION_DEVICE;
+	zassert_true(device_is_ready(fs.flash_device), "flash device not ready");
+
+	fs.offset = STORAGE_PARTITION_OFFSET;
+	err = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	zassert_ok(err, "Unable to get page info: %d", err);
+
+	fs.sector_size = info.size;
+	fs.sector_count = STORAGE_PARTITION_SIZE / info.size;
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	timing_stop();
+}
+
+static uint32_t latency_bucket(uint32_t usec)
+{
+	uint32_t bucket = 0;
+
+	while ((usec >>= 1) != 0U) {
+		bucket++;
+	}
+
+	return MIN(bucket, NUM_BUCKETS - 1);
+}
+
+/**
+ * @brief Measure the latency of periodic writes
+ *
+ * @details Write @ref NUM_WRITES times to @ref NUM_IDS IDs in turn, sleeping
+ * @ref WRITE_PERIOD_MS between the writes, and count the latency of each write
+ * in a histogram. The writes that trigger a garbage collection form the tail.
+ */
+ZTEST(fs_write_latency, test_write_latency)
+{
+	uint8_t data[DATA_SIZE];
+	uint8_t read_data[DATA_SIZE];
+	timing_t start;
+	timing_t finish;
+	uint64_t total = 0;
+	uint32_t usec;
+	uint32_t max_usec = 0;
+	uint32_t last_write;
+	int err;
+
+	err = zms_mount(&fs);
+	zassert_ok(err, "mount failure: %d", err);
+	err = zms_clear(&fs);
+	zassert_ok(err, "clear failure: %d", err);
+	err = zms_mount(&fs);
+	zassert_ok(err, "mount failure: %d", err);
+
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (uint32_t i = 0; i < NUM_WRITES; i++) {
+		memset(data, (uint8_t)i, sizeof(data));
+
+		start = timing_counter_get();
+		err = zms_write(&fs, i % NUM_IDS, data, sizeof(data));
+		finish = timing_counter_get();
+		zassert_equal(err, sizeof(data), "write failure: %d", err);
+
+		usec = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / 1000U);
+		histogram[latency_bucket(usec)]++;
+		total += usec;
+		max_usec = MAX(max_usec, usec);
+
+		k_msleep(WRITE_PERIOD_MS);
+	}
+
+	/* The garbage collection must not have lost anything */
+	for (uint32_t id = 0; id < NUM_IDS; id++) {
+		err = zms_read(&fs, id, read_data, sizeof(read_data));
+		zassert_equal(err, sizeof(read_data), "read failure: %d", err);
+		last_write = ((NUM_WRITES - 1 - id) / NUM_IDS) * NUM_IDS + id;
+		memset(data, (uint8_t)last_write, sizeof(data));
+		zassert_mem_equal(data, read_data, sizeof(data), "incorrect data read");
+	}
+
+	TC_PRINT("%u writes of %u bytes: average %u usec, max %u usec\n", NUM_WRITES, DATA_SIZE,
+		 (uint32_t)(total / NUM_WRITES), max_usec);
+
+	for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+		if (histogram[i] == 0U) {
+			continue;
+		}
+
+		TC_PRINT("  >= %7u usec: %5u writes\n", (i == 0U) ? 0U : BIT(i), histogram[i]);
+	}
+}
+
+ZTEST_SUITE(fs_write_latency, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_SYMS_H
+#define BENCH_SYMS_H
+
+#include <zephyr/sys/util.h>
+
+/* Built-in symbols exported by the application and linked by the extension */
+#define NUM_BENCH_SYMS 1024
+
+#define BENCH_SYM_DECLARE(i, _) int bench_sym_##i(int x)
+
+LISTIFY(NUM_BENCH_SYMS, BENCH_SYM_DECLARE, (;));
+
+#endif /* BENCH_SYMS_H */
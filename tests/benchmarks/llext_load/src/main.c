@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief LLEXT load time benchmark
+ *
+ * Measure the time to load an extension whose relocations all have to be
+ * resolved against the table of built-in symbols, to compare the linear,
+ * sorted and SLID based lookups of the built-in symbols.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/llext/buf_loader.h>
+#include <zephyr/llext/llext.h>
+#include <zephyr/llext/symbol.h>
+
+#include "bench_syms.h"
+
+#define NUM_LOADS 10
+
+#define BENCH_SYM_DEFINE(i, _)				\
+	int bench_sym_##i(int x)			\
+	{						\
+		return x + i;				\
+	}						\
+	EXPORT_SYMBOL(bench_sym_##i);
+
+LISTIFY(NUM_BENCH_SYMS, BENCH_SYM_DEFINE, ())
+
+static const uint8_t relocs_ext[] __aligned(4) = {
+#include "relocs.inc"
+};
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	timing_stop();
+}
+
+/**
+ * @brief Measure the loading of an extension
+ *
+ * @details The extension has a relocation against each of the exported
+ * bench_sym_N functions, each needing a lookup in the built-in symbol table.
+ */
+ZTEST(llext_load, test_load)
+{
+	struct llext_load_param ldr_parm = LLEXT_LOAD_PARAM_DEFAULT;
+	struct llext *ext;
+	int (*test_entry_fn)(void);
+	uint64_t cycles = 0U;
+	timing_t start;
+	timing_t finish;
+	size_t num_builtins;
+	int ret;
+
+	STRUCT_SECTION_COUNT(llext_const_symbol, &num_builtins);
+
+	for (int i = 0; i < NUM_LOADS; i++) {
+		struct llext_buf_loader buf_loader =
+			LLEXT_BUF_LOADER(relocs_ext, sizeof(relocs_ext));
+
+		ext = NULL;
+
+		start = timing_counter_get();
+		ret = llext_load(&buf_loader.loader, "relocs", &ext, &ldr_parm);
+		finish = timing_counter_get();
+
+		zassert_ok(ret, "load failed (%d)", ret);
+		cycles += timing_cycles_get(&start, &finish);
+
+		test_entry_fn = llext_find_sym(&ext->exp_tab, "test_entry");
+		zassert_not_null(test_entry_fn, "test_entry should be an exported symbol");
+		zassert_equal(test_entry_fn(), NUM_BENCH_SYMS * (NUM_BENCH_SYMS - 1) / 2,
+			      "Unexpected relocation");
+
+		llext_unload(&ext);
+	}
+
+	TC_PRINT("%u relocations against %zu built-in symbols: load %llu us\n",
+		 NUM_BENCH_SYMS, num_builtins,
+		 (unsigned long long)(timing_cycles_to_ns(cycles / NUM_LOADS) / NSEC_PER_USEC));
+}
+
+ZTEST_SUITE(llext_load, NULL, setup, NULL, NULL, teardown);
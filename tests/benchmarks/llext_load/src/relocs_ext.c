@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Extension with one relocation against a different built-in symbol for
+ * each entry of its function table.
+ */
+
+#include <zephyr/llext/symbol.h>
+#include "bench_syms.h"
+
+#define BENCH_SYM_REF(i, _) bench_sym_##i
+
+static int (*const bench_syms[])(int x) = {
+	LISTIFY(NUM_BENCH_SYMS, BENCH_SYM_REF, (,))
+};
+
+int test_entry(void)
+{
+	int sum = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(bench_syms); i++) {
+		sum += bench_syms[i](0);
+	}
+
+	return sum;
+}
+EXPORT_SYMBOL(test_entry);
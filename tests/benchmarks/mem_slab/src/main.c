@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the throughput of memory slab
+ * allocations and frees, first from a single thread and then from one
+ * thread per CPU all hammering the same slab at once.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define BURST          CONFIG_BENCHMARK_BURST
+#define NUM_WORKERS    CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define BLOCK_SIZE 64
+#define NUM_BLOCKS (NUM_WORKERS * BURST * 2)
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, NUM_BLOCKS, 8);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[NUM_WORKERS];
+static uint64_t worker_cycles[NUM_WORKERS];
+static int worker_errors[NUM_WORKERS];
+static atomic_t workers_ready;
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int num_workers = POINTER_TO_UINT(p2);
+	void *blocks[BURST];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p3);
+
+	/* Start hammering the slab only once every worker is ready to */
+	atomic_inc(&workers_ready);
+	while (atomic_get(&workers_ready) < num_workers) {
+		k_busy_wait(1);
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < BURST; j++) {
+			if (k_mem_slab_alloc(&slab, &blocks[j], K_NO_WAIT) != 0) {
+				worker_errors[id]++;
+				blocks[j] = NULL;
+			}
+		}
+
+		for (unsigned int j = 0; j < BURST; j++) {
+			if (blocks[j] != NULL) {
+				k_mem_slab_free(&slab, blocks[j]);
+			}
+		}
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static int test_alloc_free(unsigned int num_workers)
+{
+	uint64_t total = 0;
+	uint64_t average;
+	int errors = 0;
+
+	atomic_set(&workers_ready, 0);
+
+	/* Lower priority than main, so that all of them get created before
+	 * the last one can run on this CPU.
+	 */
+	for (unsigned int i = 0; i < num_workers; i++) {
+		worker_errors[i] = 0;
+		k_thread_create(&worker_threads[i], worker_stacks[i], STACK_SIZE,
+				worker, UINT_TO_POINTER(i), UINT_TO_POINTER(num_workers),
+				NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_workers; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		total += worker_cycles[i];
+		errors += worker_errors[i];
+	}
+
+	average = total / ((uint64_t)num_workers * NUM_ITERATIONS * BURST);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: mem_slab.alloc_free.%u.cpus - "
+	       "allocate and free a block on %u CPUs, avg. : "
+	       "%7llu cycles , %7u ns :\n", num_workers, num_workers,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("------------------------------------\n");
+	printk("allocate and free a block on %u CPUs\n", num_workers);
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+
+	if (errors != 0) {
+		printk("%d allocations failed\n", errors);
+		return TC_FAIL;
+	}
+
+	/* Everything was freed, whatever the caches are holding */
+	if (k_mem_slab_num_used_get(&slab) != 0U) {
+		printk("%u blocks still in use\n", k_mem_slab_num_used_get(&slab));
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	timing_init();
+
+	printk("Time Measurements for %smemory slabs\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_CPU_CACHE) ? "per-CPU cached " : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	status |= test_alloc_free(1);
+	if (arch_num_cpus() > 1) {
+		status |= test_alloc_free(arch_num_cpus());
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
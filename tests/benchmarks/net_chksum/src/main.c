@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of the software Internet
+ * checksum for data of typical packet sizes.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <string.h>
+
+#include "net_private.h"
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define MAX_LENGTH     1500
+
+static const size_t lengths[] = { 20, 64, 256, 576, MAX_LENGTH };
+
+static uint8_t src_data[MAX_LENGTH] __aligned(8);
+static uint8_t dst_data[MAX_LENGTH] __aligned(8);
+
+static uint32_t rand_state = 0x2545f491;
+
+/* Deterministic xorshift so that all the variants see the same data */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Plain 16-bit word at a time sum, as found in RFC 1071 */
+static uint16_t chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		uint16_t tmp = (i % 2) == 0 ? data[i] << 8 : data[i];
+
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+static uint16_t chksum_plain(size_t len)
+{
+	return calc_chksum(0, src_data, len);
+}
+
+static uint16_t chksum_reference(size_t len)
+{
+	return chksum_ref(0, src_data, len);
+}
+
+static uint16_t chksum_memcpy(size_t len)
+{
+	memcpy(dst_data, src_data, len);
+
+	return calc_chksum(0, dst_data, len);
+}
+
+static uint16_t chksum_copy(size_t len)
+{
+	return calc_chksum_copy(0, dst_data, src_data, len);
+}
+
+static const struct {
+	const char *name;
+	const char *desc;
+	uint16_t (*fn)(size_t len);
+} routines[] = {
+	{ "reference", "16-bit reference sum", chksum_reference },
+	{ "sum", "calc_chksum()", chksum_plain },
+	{ "memcpy_sum", "memcpy() and calc_chksum()", chksum_memcpy },
+	{ "copy_sum", "calc_chksum_copy()", chksum_copy },
+};
+
+static int test_routine(unsigned int r, size_t len)
+{
+	uint16_t expected = chksum_ref(0, src_data, len);
+	uint64_t total = 0;
+	uint64_t average;
+	timing_t start;
+	timing_t finish;
+	int mismatches = 0;
+
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		uint16_t sum;
+
+		start = timing_counter_get();
+		sum = routines[r].fn(len);
+		finish = timing_counter_get();
+
+		total += timing_cycles_get(&start, &finish);
+
+		if (sum != expected) {
+			mismatches++;
+		}
+	}
+
+	average = total / NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.chksum.%s.%zu - "
+	       "%s of %zu bytes, avg. : "
+	       "%7llu cycles , %7u ns :\n", routines[r].name, len,
+	       routines[r].desc, len, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("------------------------------------\n");
+	printk("%s of %zu bytes\n", routines[r].desc, len);
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+
+	if (mismatches != 0) {
+		printk("%d sums did not match the reference\n", mismatches);
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	for (size_t i = 0; i < sizeof(src_data); i++) {
+		src_data[i] = (uint8_t)next_rand();
+	}
+
+	timing_init();
+
+	printk("Time Measurements for the Internet checksum%s\n",
+	       IS_ENABLED(CONFIG_NET_CHKSUM_SIMD) ? " with vector instructions" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	ARRAY_FOR_EACH(lengths, l) {
+		ARRAY_FOR_EACH(routines, r) {
+			status |= test_routine(r, lengths[l]);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of an IPv6 route lookup
+ * as the routing table grows.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/dummy.h>
+#include <stdio.h>
+
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define MAX_ROUTES     CONFIG_NET_MAX_ROUTES
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+static uint8_t nexthop_mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+
+static struct in6_addr nexthop_addr = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+					    0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct in6_addr route_addrs[MAX_ROUTES];
+static uint8_t route_prefix_lens[MAX_ROUTES];
+static struct in6_addr lookup_addrs[NUM_ITERATIONS];
+
+static struct net_if *iface;
+
+static uint32_t rand_state = 0x2545f491;
+
+/* Deterministic xorshift so that both lookup algorithms see the same load */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/*
+ * The routes must not overlap, as adding a route that is covered by an
+ * existing one with the same next hop just refreshes the existing one.
+ * Every route gets its own scattered 16 bit value right before the end of
+ * its prefix, in one of two ranges depending on its prefix length.
+ */
+static void make_route(unsigned int i)
+{
+	uint16_t key = (uint16_t)(i * 0x9e37U);
+	struct in6_addr *addr = &route_addrs[i];
+
+	memset(addr, 0, sizeof(*addr));
+	addr->s6_addr[0] = 0x20;
+	addr->s6_addr[1] = 0x01;
+	addr->s6_addr[2] = 0x0d;
+
+	if ((i % 2U) == 0U) {
+		addr->s6_addr[3] = 0xb8;
+		addr->s6_addr[4] = key >> 8;
+		addr->s6_addr[5] = key & 0xff;
+		route_prefix_lens[i] = 48U;
+	} else {
+		addr->s6_addr[3] = 0xb9;
+		addr->s6_addr[5] = key >> 8;
+		addr->s6_addr[6] = key & 0xff;
+		route_prefix_lens[i] = ((i % 4U) == 1U) ? 64U : 56U;
+	}
+}
+
+static int add_routes(unsigned int from, unsigned int to)
+{
+	struct net_route_entry *route;
+
+	for (unsigned int i = from; i < to; i++) {
+		make_route(i);
+
+		route = net_route_add(iface, &route_addrs[i], route_prefix_lens[i],
+				      &nexthop_addr, NET_IPV6_ND_INFINITE_LIFETIME,
+				      NET_ROUTE_PREFERENCE_MEDIUM);
+		if (route == NULL) {
+			printk("Cannot add route %u\n", i);
+			return TC_FAIL;
+		}
+	}
+
+	return TC_PASS;
+}
+
+/* Destinations are random hosts within random routes */
+static void make_lookup_addrs(unsigned int num_routes)
+{
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		unsigned int route = next_rand() % num_routes;
+		uint32_t host = next_rand();
+
+		lookup_addrs[i] = route_addrs[route];
+		memcpy(&lookup_addrs[i].s6_addr[12], &host, sizeof(host));
+	}
+}
+
+static int test_lookup(unsigned int num_routes)
+{
+	uint64_t total = 0;
+	uint64_t average;
+	timing_t start;
+	timing_t finish;
+	int misses = 0;
+
+	make_lookup_addrs(num_routes);
+
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		struct net_route_entry *route;
+
+		start = timing_counter_get();
+		route = net_route_lookup(NULL, &lookup_addrs[i]);
+		finish = timing_counter_get();
+
+		total += timing_cycles_get(&start, &finish);
+
+		if (route == NULL) {
+			misses++;
+		}
+	}
+
+	average = total / NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: net.route.lookup.%u.routes - "
+	       "IPv6 route lookup with %u routes, avg. : "
+	       "%7llu cycles , %7u ns :\n", num_routes, num_routes,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("------------------------------------\n");
+	printk("IPv6 route lookup with %u routes\n", num_routes);
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+
+	if (misses != 0) {
+		printk("%d lookups found no route\n", misses);
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	uint8_t nexthop_ll[sizeof(nexthop_mac_addr)];
+	struct net_linkaddr lladdr = {
+		.addr = nexthop_ll,
+		.len = sizeof(nexthop_ll),
+		.type = NET_LINK_ETHERNET,
+	};
+	unsigned int num_routes = 0;
+	int status = TC_PASS;
+
+	memcpy(nexthop_ll, nexthop_mac_addr, sizeof(nexthop_ll));
+
+	timing_init();
+
+	printk("Time Measurements for IPv6 route lookups%s\n",
+	       IS_ENABLED(CONFIG_NET_ROUTE_TRIE) ? " with a prefix trie" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (iface == NULL ||
+	    net_ipv6_nbr_add(iface, &nexthop_addr, &lladdr, false,
+			     NET_IPV6_NBR_STATE_REACHABLE) == NULL) {
+		printk("Cannot set up the next hop\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_start();
+
+	for (unsigned int n = 16; n <= MAX_ROUTES && status == TC_PASS; n *= 4) {
+		status |= add_routes(num_routes, n);
+		num_routes = n;
+
+		if (status == TC_PASS) {
+			status |= test_lookup(num_routes);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Socket echo server benchmark
+ *
+ * Measure the message rate of a TCP echo server serving many loopback
+ * connections, and the number of calls it makes to wait and do socket I/O,
+ * to compare a server calling poll(), recv() and send() with a server
+ * submitting batches of RTIO socket operations.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+
+#define SERVER_ADDR "127.0.0.1"
+#define SERVER_PORT 4242
+
+#define NUM_CONNS  16
+#define NUM_ROUNDS 200
+#define MSG_SIZE   64
+
+#define SERVER_STACK_SIZE 2048
+#define SERVER_PRIO       K_PRIO_PREEMPT(5)
+
+#define MEM_BLK_SIZE 64
+
+/* A receive and the send of the received data per connection */
+RTIO_DEFINE_WITH_MEMPOOL(r, 2 * NUM_CONNS, 2 * NUM_CONNS, NUM_CONNS, MEM_BLK_SIZE, 4);
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+
+static int c_socks[NUM_CONNS];
+static int s_socks[NUM_CONNS];
+
+/* Calls made by the server to wait for the sockets and do I/O */
+static uint32_t server_calls;
+
+static void connect_all(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int l_sock;
+	int ret;
+
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr), 1);
+
+	l_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(l_sock >= 0, "socket failed (%d)", -errno);
+	ret = zsock_bind(l_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(ret, "bind failed (%d)", -errno);
+	ret = zsock_listen(l_sock, NUM_CONNS);
+	zassert_ok(ret, "listen failed (%d)", -errno);
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		c_socks[i] = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		zassert_true(c_socks[i] >= 0, "socket failed (%d)", -errno);
+		ret = zsock_connect(c_socks[i], (struct sockaddr *)&addr, sizeof(addr));
+		zassert_ok(ret, "connect failed (%d)", -errno);
+		s_socks[i] = zsock_accept(l_sock, NULL, NULL);
+		zassert_true(s_socks[i] >= 0, "accept failed (%d)", -errno);
+	}
+
+	zsock_close(l_sock);
+}
+
+static void poll_server(void *p1, void *p2, void *p3)
+{
+	struct zsock_pollfd fds[NUM_CONNS];
+	uint8_t buf[MSG_SIZE];
+	int open = NUM_CONNS;
+	ssize_t len;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		fds[i].fd = s_socks[i];
+		fds[i].events = ZSOCK_POLLIN;
+	}
+
+	while (open > 0) {
+		server_calls++;
+		if (zsock_poll(fds, NUM_CONNS, -1) < 0) {
+			break;
+		}
+
+		for (int i = 0; i < NUM_CONNS; i++) {
+			if ((fds[i].fd < 0) || (fds[i].revents == 0)) {
+				continue;
+			}
+
+			server_calls++;
+			len = zsock_recv(fds[i].fd, buf, sizeof(buf), 0);
+			if (len > 0) {
+				server_calls++;
+				len = zsock_send(fds[i].fd, buf, len, 0);
+			}
+
+			if (len <= 0) {
+				/* Negative descriptors are ignored by poll() */
+				fds[i].fd = -1;
+				open--;
+			}
+		}
+	}
+}
+
+static void rtio_server_submit(struct rtio_sqe *sqes, int conn)
+{
+	/* The userdata tells the receive, with an even index, from the send */
+	net_socket_rtio_prep_recv_with_pool(&sqes[0], s_socks[conn], INT_TO_POINTER(2 * conn));
+	sqes[0].flags |= RTIO_SQE_CHAINED;
+	net_socket_rtio_prep_send_received(&sqes[1], s_socks[conn],
+					   INT_TO_POINTER(2 * conn + 1));
+}
+
+static void rtio_server(void *p1, void *p2, void *p3)
+{
+	struct rtio_sqe sqes[2 * NUM_CONNS];
+	struct rtio_cqe cqes[2 * NUM_CONNS];
+	struct rtio_cqe *cqe;
+	uint8_t *bufs[NUM_CONNS];
+	uint32_t buf_lens[NUM_CONNS];
+	bool closed[NUM_CONNS] = {0};
+	int open = NUM_CONNS;
+	int num_cqes;
+	int num_sqes = 0;
+	int conn;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (conn = 0; conn < NUM_CONNS; conn++) {
+		rtio_server_submit(&sqes[num_sqes], conn);
+		num_sqes += 2;
+	}
+
+	while (open > 0) {
+		/* All the operations of the previous round are submitted at once */
+		if (num_sqes > 0) {
+			/* The submission queue holds the operations of all the connections */
+			server_calls += 2;
+			(void)rtio_sqe_copy_in(&r, sqes, num_sqes);
+			(void)rtio_submit(&r, 0);
+			num_sqes = 0;
+		}
+
+		/* Wait for a completion, then take all the available ones */
+		server_calls++;
+		cqe = rtio_cqe_consume_block(&r);
+		num_cqes = 0;
+
+		while (cqe != NULL) {
+			cqes[num_cqes++] = *cqe;
+			rtio_cqe_release(&r, cqe);
+			cqe = (num_cqes < ARRAY_SIZE(cqes)) ? rtio_cqe_consume(&r) : NULL;
+		}
+
+		for (int i = 0; i < num_cqes; i++) {
+			conn = POINTER_TO_INT(cqes[i].userdata) / 2;
+
+			if ((POINTER_TO_INT(cqes[i].userdata) % 2) == 0) {
+				/* Keep the received data until it has been sent */
+				rtio_cqe_get_mempool_buffer(&r, &cqes[i], &bufs[conn],
+							    &buf_lens[conn]);
+				closed[conn] = (cqes[i].result <= 0);
+				continue;
+			}
+
+			rtio_release_buffer(&r, bufs[conn], buf_lens[conn]);
+
+			if (closed[conn] || (cqes[i].result < 0)) {
+				open--;
+				continue;
+			}
+
+			rtio_server_submit(&sqes[num_sqes], conn);
+			num_sqes += 2;
+		}
+	}
+}
+
+static void run_echo(const char *name, k_thread_entry_t server)
+{
+	uint8_t msg[MSG_SIZE];
+	uint8_t buf[MSG_SIZE];
+	timing_t start;
+	timing_t finish;
+	uint64_t ns;
+	ssize_t len;
+
+	connect_all();
+	server_calls = 0;
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack), server,
+			NULL, NULL, NULL, SERVER_PRIO, 0, K_NO_WAIT);
+
+	memset(msg, 0x5a, sizeof(msg));
+
+	start = timing_counter_get();
+
+	/* Each round sends a message on every connection and waits for all the echoes */
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		for (int i = 0; i < NUM_CONNS; i++) {
+			len = zsock_send(c_socks[i], msg, sizeof(msg), 0);
+			zassert_equal(len, sizeof(msg), "send failed (%d)", -errno);
+		}
+
+		for (int i = 0; i < NUM_CONNS; i++) {
+			for (size_t received = 0; received < sizeof(msg); received += len) {
+				len = zsock_recv(c_socks[i], buf, sizeof(msg) - received, 0);
+				zassert_true(len > 0, "recv failed (%d)", -errno);
+			}
+		}
+	}
+
+	finish = timing_counter_get();
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		zsock_close(c_socks[i]);
+	}
+
+	zassert_ok(k_thread_join(&server_thread, K_SECONDS(10)), "server did not stop");
+
+	for (int i = 0; i < NUM_CONNS; i++) {
+		zsock_close(s_socks[i]);
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+	TC_PRINT("%-5s server, %u connections: %6u messages/s, %5u server calls per "
+		 "100 messages\n", name, NUM_CONNS,
+		 (uint32_t)((uint64_t)NUM_ROUNDS * NUM_CONNS * NSEC_PER_SEC / ns),
+		 (uint32_t)((uint64_t)server_calls * 100U / (NUM_ROUNDS * NUM_CONNS)));
+
+	/* Let the connections close before reusing the port */
+	k_msleep(2 * CONFIG_NET_TCP_TIME_WAIT_DELAY);
+}
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	timing_stop();
+}
+
+/**
+ * @brief Measure the echo server based on poll()
+ *
+ * @details Each round, every connection sends a message which the server
+ * receives after poll() reported it and echoes with send().
+ */
+ZTEST(net_socket_rtio, test_poll_echo)
+{
+	run_echo("poll", poll_server);
+}
+
+/**
+ * @brief Measure the echo server based on RTIO socket operations
+ *
+ * @details The server keeps a receive chained to the send of the received data
+ * submitted for every connection, and submits them again in one batch for all
+ * the connections completed at once.
+ */
+ZTEST(net_socket_rtio, test_rtio_echo)
+{
+	run_echo("rtio", rtio_server);
+}
+
+ZTEST_SUITE(net_socket_rtio, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Settings load and save benchmark
+ *
+ * Measure the latency of saving settings and the time taken to load them
+ * against the number of stored settings, on the flash simulator with the ZMS
+ * or NVS backend, to compare the name lookups of the NVS backend with and
+ * without its name cache or name index.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/settings/settings.h>
+
+#define STORAGE_PARTITION_ID FIXED_PARTITION_ID(storage_partition)
+
+/* Settings of a small subtree, loaded among all the others */
+#define NUM_OTHER_KEYS 8
+
+#define NAME_LEN sizeof("bench/0000")
+
+static const uint16_t key_counts[] = {128, 512, 2048};
+
+struct load_ctx {
+	uint32_t count;
+	uint32_t errors;
+};
+
+static void *setup(void)
+{
+	const struct flash_area *fa;
+	int err;
+
+	/* Start from an empty storage */
+	err = flash_area_open(STORAGE_PARTITION_ID, &fa);
+	zassert_ok(err, "Unable to open the storage partition: %d", err);
+	err = flash_area_flatten(fa, 0, fa->fa_size);
+	zassert_ok(err, "Unable to erase the storage partition: %d", err);
+	flash_area_close(fa);
+
+	err = settings_subsys_init();
+	zassert_ok(err, "settings init failure: %d", err);
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	timing_stop();
+}
+
+static uint32_t save_key(const char *subtree, uint32_t key, uint32_t value)
+{
+	char name[NAME_LEN];
+	timing_t start;
+	timing_t finish;
+	int err;
+
+	snprintf(name, sizeof(name), "%s/%04x", subtree, key);
+
+	start = timing_counter_get();
+	err = settings_save_one(name, &value, sizeof(value));
+	finish = timing_counter_get();
+	zassert_ok(err, "save failure: %d", err);
+
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / 1000U);
+}
+
+/* The value of each setting is its key, with the MSB set once it has been updated */
+static int load_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+		   void *param)
+{
+	struct load_ctx *ctx = param;
+	uint32_t value;
+
+	if ((len != sizeof(value)) || (read_cb(cb_arg, &value, sizeof(value)) != sizeof(value)) ||
+	    (value != (strtoul(key, NULL, 16) | BIT(31)))) {
+		ctx->errors++;
+	}
+
+	ctx->count++;
+
+	return 0;
+}
+
+static uint32_t load_subtree(const char *subtree, uint32_t count)
+{
+	struct load_ctx ctx = {0};
+	timing_t start;
+	timing_t finish;
+	int err;
+
+	start = timing_counter_get();
+	err = settings_load_subtree_direct(subtree, load_cb, &ctx);
+	finish = timing_counter_get();
+	zassert_ok(err, "load failure: %d", err);
+	zassert_equal(ctx.count, count, "%u settings loaded instead of %u", ctx.count, count);
+	zassert_equal(ctx.errors, 0, "%u settings loaded incorrectly", ctx.errors);
+
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &finish)) / 1000U);
+}
+
+/**
+ * @brief Measure the save and load times against the number of settings
+ *
+ * @details Grow the number of stored settings through @ref key_counts. At
+ * each step, save the new settings, update all of them, then load all of them
+ * and a small subtree of @ref NUM_OTHER_KEYS settings.
+ */
+ZTEST(settings_load_save, test_load_save)
+{
+	uint64_t total_new;
+	uint64_t total_update;
+	uint32_t load_all;
+	uint32_t load_other;
+	uint32_t stored = 0;
+
+	TC_PRINT("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (uint32_t key = 0; key < NUM_OTHER_KEYS; key++) {
+		save_key("other", key, key | BIT(31));
+	}
+
+	ARRAY_FOR_EACH(key_counts, i) {
+		total_new = 0;
+		total_update = 0;
+
+		for (uint32_t key = stored; key < key_counts[i]; key++) {
+			total_new += save_key("bench", key, key);
+		}
+
+		for (uint32_t key = 0; key < key_counts[i]; key++) {
+			total_update += save_key("bench", key, key | BIT(31));
+		}
+
+		load_all = load_subtree("bench", key_counts[i]);
+		load_other = load_subtree("other", NUM_OTHER_KEYS);
+
+		TC_PRINT("%5u settings: save new %6u usec, save update %6u usec, "
+			 "load %8u usec, load subtree %8u usec\n",
+			 key_counts[i], (uint32_t)(total_new / (key_counts[i] - stored)),
+			 (uint32_t)(total_update / key_counts[i]), load_all, load_other);
+
+		stored = key_counts[i];
+	}
+}
+
+ZTEST_SUITE(settings_load_save, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the distribution of sys_heap
+ * allocation latencies under the random workload of the heap stress
+ * rig, at a few different fill levels.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define HEAP_SIZE      CONFIG_BENCHMARK_HEAP_SIZE
+
+static uint8_t __aligned(8) heap_mem[HEAP_SIZE];
+static void *scratch_mem[HEAP_SIZE / 2 / sizeof(void *)];
+static struct sys_heap heap;
+
+static uint32_t alloc_cycles[NUM_ITERATIONS];
+static size_t num_samples;
+
+static void *timed_alloc(void *arg, size_t bytes)
+{
+	timing_t start;
+	timing_t finish;
+	void *mem;
+
+	start = timing_counter_get();
+	mem = sys_heap_alloc(arg, bytes);
+	finish = timing_counter_get();
+
+	if (num_samples < NUM_ITERATIONS) {
+		alloc_cycles[num_samples++] = (uint32_t)timing_cycles_get(&start, &finish);
+	}
+
+	return mem;
+}
+
+static void timed_free(void *arg, void *mem)
+{
+	sys_heap_free(arg, mem);
+}
+
+/* Partially sorts the samples so that the k-th smallest is at index k */
+static uint32_t select_kth(uint32_t *samples, size_t n, size_t k)
+{
+	size_t lo = 0;
+	size_t hi = n - 1;
+
+	while (lo < hi) {
+		uint32_t pivot = samples[lo + (hi - lo) / 2];
+		size_t i = lo;
+		size_t j = hi;
+
+		while (i <= j) {
+			while (samples[i] < pivot) {
+				i++;
+			}
+			while (samples[j] > pivot) {
+				j--;
+			}
+			if (i <= j) {
+				uint32_t tmp = samples[i];
+
+				samples[i] = samples[j];
+				samples[j] = tmp;
+				i++;
+				if (j == 0) {
+					break;
+				}
+				j--;
+			}
+		}
+
+		if (k <= j) {
+			hi = j;
+		} else if (k >= i) {
+			lo = i;
+		} else {
+			break;
+		}
+	}
+
+	return samples[k];
+}
+
+static void report(unsigned int fill, const char *stat, uint32_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: sys_heap.alloc.%u.percent.%s - "
+	       "allocation with heap %u%% full, %s : %7u cycles , %7u ns :\n",
+	       fill, stat, fill, stat, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("    %-7s : %7u cycles (%7u nsec)\n", stat, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static void test_alloc_latency(unsigned int fill)
+{
+	struct z_heap_stress_result result;
+	size_t n;
+
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+	num_samples = 0;
+
+	sys_heap_stress(timed_alloc, timed_free, &heap, sizeof(heap_mem), NUM_ITERATIONS,
+			scratch_mem, sizeof(scratch_mem), fill, &result);
+
+	n = num_samples;
+
+#ifndef CONFIG_BENCHMARK_RECORDING
+	printk("------------------------------------\n");
+	printk("%u allocations (%u successful) with heap %u%% full\n",
+	       result.total_allocs, result.successful_allocs, fill);
+#endif
+
+	/* Each selection leaves everything below its index smaller */
+	report(fill, "p50", select_kth(alloc_cycles, n, n / 2));
+	report(fill, "p90", select_kth(alloc_cycles, n, (n * 9) / 10));
+	report(fill, "p99", select_kth(alloc_cycles, n, (n * 99) / 100));
+	report(fill, "max", select_kth(alloc_cycles, n, n - 1));
+}
+
+int main(void)
+{
+	static const unsigned int fills[] = { 25, 50, 90 };
+
+	timing_init();
+
+	printk("Time Measurements for sys_heap allocations%s\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES) ? " with size classes" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (size_t i = 0; i < ARRAY_SIZE(fills); i++) {
+		test_alloc_latency(fills[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the time required to arm and abort
+ * a kernel timeout while a varying number of other timeouts are pending.
+ * The timeouts are driven directly through the timeout queue API so that
+ * neither thread nor timer bookkeeping ends up in the measurements, and they
+ * are scheduled far enough in the future that none of them ever expires
+ * while the test runs.
+ *
+ * On SMP targets it also measures the same operations while every CPU
+ * concurrently arms and aborts its own timeout, to show contention on the
+ * timeout queue locks.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+#include <stdio.h>
+
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define MAX_TIMEOUTS   CONFIG_BENCHMARK_MAX_TIMEOUTS
+
+/* Expiries are spread over this many ticks, starting this far out */
+#define EXPIRY_BASE    1000
+#define EXPIRY_SPREAD  1000000
+
+static struct _timeout background[MAX_TIMEOUTS];
+static struct _timeout probe;
+
+static uint64_t add_cycles[NUM_ITERATIONS];
+static uint64_t abort_cycles[NUM_ITERATIONS];
+
+static uint32_t rand_state = 0x2545f491;
+
+#ifdef CONFIG_SMP
+#define NUM_CONTENDERS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(contender_stacks, NUM_CONTENDERS, STACK_SIZE);
+static struct k_thread contender_threads[NUM_CONTENDERS];
+static struct _timeout contender_timeouts[NUM_CONTENDERS];
+static uint64_t contender_cycles[NUM_CONTENDERS];
+static atomic_t contenders_ready;
+#endif /* CONFIG_SMP */
+
+/* Deterministic xorshift so that both queue algorithms see the same load */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static k_timeout_t random_timeout(void)
+{
+	return K_TICKS(EXPIRY_BASE + (next_rand() % EXPIRY_SPREAD));
+}
+
+static void dummy_expiry(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	/* None of the timeouts are supposed to expire */
+	printk("Unexpected timeout expiry\n");
+}
+
+static void background_set(unsigned int num_timeouts)
+{
+	static unsigned int pending;
+
+	while (pending < num_timeouts) {
+		z_add_timeout(&background[pending], dummy_expiry, random_timeout());
+		pending++;
+	}
+
+	while (pending > num_timeouts) {
+		pending--;
+		z_abort_timeout(&background[pending]);
+	}
+}
+
+static void report(const char *op, unsigned int num_timeouts, uint64_t *cycles)
+{
+	uint64_t minimum = cycles[0];
+	uint64_t maximum = cycles[0];
+	uint64_t total = 0;
+	uint64_t average;
+	char tag[50];
+	char description[120];
+
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		minimum = MIN(minimum, cycles[i]);
+		maximum = MAX(maximum, cycles[i]);
+		total += cycles[i];
+	}
+	average = total / NUM_ITERATIONS;
+
+	snprintf(tag, sizeof(tag), "timeout.%s.%u.pending", op, num_timeouts);
+	snprintf(description, sizeof(description), "%s a timeout with %u pending", op,
+		 num_timeouts);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.min - %s, min. : %7llu cycles , %7u ns :\n", tag, description,
+	       minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s.max - %s, max. : %7llu cycles , %7u ns :\n", tag, description,
+	       maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s.avg - %s, avg. : %7llu cycles , %7u ns :\n", tag, description,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("------------------------------------\n");
+	printk("%s\n", description);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_add_abort(unsigned int num_timeouts)
+{
+	timing_t start;
+	timing_t finish;
+	k_timeout_t timeout;
+	unsigned int key;
+
+	background_set(num_timeouts);
+
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		timeout = random_timeout();
+
+		key = irq_lock();
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, dummy_expiry, timeout);
+		finish = timing_counter_get();
+		add_cycles[i] = timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		z_abort_timeout(&probe);
+		finish = timing_counter_get();
+		abort_cycles[i] = timing_cycles_get(&start, &finish);
+
+		irq_unlock(key);
+	}
+
+	report("add", num_timeouts, add_cycles);
+	report("abort", num_timeouts, abort_cycles);
+}
+
+#ifdef CONFIG_SMP
+static void contender(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int num_contenders = POINTER_TO_UINT(p2);
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p3);
+
+	/* Start hammering the queues only once every CPU is ready to */
+	atomic_inc(&contenders_ready);
+	while (atomic_get(&contenders_ready) < num_contenders) {
+		k_busy_wait(1);
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		z_add_timeout(&contender_timeouts[id], dummy_expiry,
+			      K_TICKS(EXPIRY_BASE + (i % EXPIRY_SPREAD)));
+		z_abort_timeout(&contender_timeouts[id]);
+	}
+	finish = timing_counter_get();
+
+	contender_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static void test_contention(unsigned int num_timeouts)
+{
+	unsigned int num_contenders = arch_num_cpus();
+	uint64_t total = 0;
+	uint64_t average;
+
+	background_set(num_timeouts);
+	atomic_set(&contenders_ready, 0);
+
+	/* Lower priority than main, so that all of them get created before
+	 * the last one can run on this CPU.
+	 */
+	for (unsigned int i = 0; i < num_contenders; i++) {
+		k_thread_create(&contender_threads[i], contender_stacks[i], STACK_SIZE,
+				contender, UINT_TO_POINTER(i), UINT_TO_POINTER(num_contenders),
+				NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_contenders; i++) {
+		k_thread_join(&contender_threads[i], K_FOREVER);
+		total += contender_cycles[i];
+	}
+
+	average = total / ((uint64_t)num_contenders * NUM_ITERATIONS);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: timeout.add_abort.%u.cpus.%u.pending - "
+	       "add and abort a timeout on %u CPUs with %u pending, avg. : "
+	       "%7llu cycles , %7u ns :\n", num_contenders, num_timeouts,
+	       num_contenders, num_timeouts, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("------------------------------------\n");
+	printk("add and abort a timeout on %u CPUs with %u pending\n", num_contenders,
+	       num_timeouts);
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+#endif /* CONFIG_SMP */
+
+int main(void)
+{
+	unsigned int num_timeouts;
+
+	timing_init();
+
+	printk("Time Measurements for %s%s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_PER_CPU) ? "per-CPU " : "",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "delta list");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (num_timeouts = 10; num_timeouts <= MAX_TIMEOUTS; num_timeouts *= 10) {
+		test_add_abort(num_timeouts);
+	}
+
+#ifdef CONFIG_SMP
+	for (num_timeouts = 10; num_timeouts <= MAX_TIMEOUTS; num_timeouts *= 10) {
+		test_contention(num_timeouts);
+	}
+#endif /* CONFIG_SMP */
+
+	timing_stop();
+
+	background_set(0);
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -15,6 +15,9 @@
  * reduce the memory footprint as not only are thread stacks not required,
  * but we also do not need the full k_thread structure for each of these
  * dummy threads.
+ *
+ * On SMP targets it also measures semaphore operations done concurrently
+ * on every CPU, each with its own semaphore.
  */
 
 #include <zephyr/kernel.h>
@@ -211,6 +214,138 @@ static void compute_and_report_stats(unsigned int num_threads, unsigned int num_
 #endif
 }
 
+#ifdef CONFIG_SMP
+/*
+ * Contention tests: each CPU hammers its own semaphore through threads
+ * pinned to it.  Nothing but kernel internal locks is shared between the
+ * CPUs, so comparing the single CPU and all CPU figures shows how much
+ * unrelated wait queues serialize against each other.
+ */
+
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* The waiter must preempt the worker as soon as it gets woken up */
+#define WAITER_PRIO K_PRIO_PREEMPT(1)
+#define WORKER_PRIO K_PRIO_PREEMPT(2)
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread worker_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread waiter_threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct k_sem sems[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static unsigned int num_workers;
+static atomic_t workers_ready;
+
+/* Start hammering the semaphores only once every CPU is ready to */
+static void wait_for_workers(void)
+{
+	atomic_inc(&workers_ready);
+	while (atomic_get(&workers_ready) < num_workers) {
+		k_busy_wait(1);
+	}
+}
+
+static void give_take(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wait_for_workers();
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_sem_give(&sems[id]);
+		(void)k_sem_take(&sems[id], K_NO_WAIT);
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static void wake(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wait_for_workers();
+
+	/* Every give switches to the waiter, which pends again */
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_sem_give(&sems[id]);
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&sems[id], K_FOREVER);
+	}
+}
+
+static void start_pinned(struct k_thread *thread, k_thread_stack_t *stack,
+			 k_thread_entry_t entry, unsigned int cpu, int prio)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry, UINT_TO_POINTER(cpu),
+			NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_cpu_pin(thread, cpu);
+	k_thread_start(thread);
+}
+
+static void test_contention(unsigned int num_cpus, bool pend)
+{
+	char description[120];
+	char tag[50];
+
+	num_workers = num_cpus;
+	atomic_set(&workers_ready, 0);
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_sem_init(&sems[i], 0, K_SEM_MAX_LIMIT);
+		if (pend) {
+			start_pinned(&waiter_threads[i], waiter_stacks[i], waiter, i,
+				     WAITER_PRIO);
+		}
+		start_pinned(&worker_threads[i], worker_stacks[i], pend ? wake : give_take, i,
+			     WORKER_PRIO);
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		if (pend) {
+			k_thread_abort(&waiter_threads[i]);
+		}
+	}
+
+	snprintf(tag, sizeof(tag), "sem.%s.%u.cpus", pend ? "wake" : "give_take", num_cpus);
+	snprintf(description, sizeof(description), "%s on %u CPUs",
+		 pend ? "Wake a thread pended on own semaphore" : "Give and take own semaphore",
+		 num_cpus);
+
+	compute_and_report_stats(num_cpus, CONFIG_BENCHMARK_NUM_ITERATIONS, worker_cycles, tag,
+				 description);
+}
+#endif /* CONFIG_SMP */
+
 int main(void)
 {
 	unsigned int i;
@@ -318,6 +453,13 @@ int main(void)
 	}
 #endif
 
+#ifdef CONFIG_SMP
+	test_contention(1, false);
+	test_contention(arch_num_cpus(), false);
+	test_contention(1, true);
+	test_contention(arch_num_cpus(), true);
+#endif /* CONFIG_SMP */
+
 	timing_stop();
 
 	TC_END_REPORT(0);
@@ -291,3 +291,172 @@ ZTEST(k_heap_api, test_k_heap_calloc)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+#ifdef CONFIG_HEAP_ARENAS
+#define ARENA_HEAP_SIZE  (CONFIG_MP_MAX_NUM_CPUS * 2 * CONFIG_HEAP_ARENA_MIN_SIZE)
+#define ARENA_BLOCK_SIZE 256
+#define ARENA_MAX_BLOCKS (ARENA_HEAP_SIZE / ARENA_BLOCK_SIZE)
+
+K_HEAP_DEFINE(arena_heap, ARENA_HEAP_SIZE);
+static void *arena_blocks[ARENA_MAX_BLOCKS];
+
+static size_t arena_heap_fill(void)
+{
+	size_t n = 0;
+
+	while (n < ARENA_MAX_BLOCKS) {
+		arena_blocks[n] = k_heap_alloc(&arena_heap, ARENA_BLOCK_SIZE, K_NO_WAIT);
+		if (arena_blocks[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+
+	return n;
+}
+
+static void thread_free_arena_blocks(void *p1, void *p2, void *p3)
+{
+	size_t n = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (size_t i = 0; i < n; i += 2) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+}
+#endif /* CONFIG_HEAP_ARENAS */
+
+/**
+ * @brief Validate that a heap split in per-CPU arenas can be used whole
+ *
+ * @details Fill the heap with small blocks, which has to spill over the
+ * arena of the current CPU, then free half of them from another thread,
+ * which may run on another CPU, and the rest from this one. The heap
+ * should then fit exactly as many blocks again.
+ *
+ * @ingroup kernel_heap_tests
+ */
+ZTEST(k_heap_api, test_k_heap_arenas)
+{
+#ifdef CONFIG_HEAP_ARENAS
+	size_t n = arena_heap_fill();
+
+	zassert_true(n > ARENA_MAX_BLOCKS / 2, "only %zu blocks allocated", n);
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      thread_free_arena_blocks, UINT_TO_POINTER(n), NULL, NULL,
+				      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+
+	k_thread_join(tid, K_FOREVER);
+
+	for (size_t i = 1; i < n; i += 2) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+
+	zassert_equal(arena_heap_fill(), n, "blocks lost after freeing");
+
+	for (size_t i = 0; i < n; i++) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+#else
+	ztest_test_skip();
+#endif /* CONFIG_HEAP_ARENAS */
+}
+
+/**
+ * @brief Validate that small blocks of a heap split in arenas fit a pointer
+ *
+ * @details Blocks freed from another CPU are linked through their first
+ * pointer, so even the smallest blocks with a small alignment must be
+ * pointer sized and aligned. Free them from another thread, which may run
+ * on another CPU, and check the heap can still be filled whole.
+ *
+ * @ingroup kernel_heap_tests
+ */
+ZTEST(k_heap_api, test_k_heap_arenas_small_blocks)
+{
+#ifdef CONFIG_HEAP_ARENAS
+	size_t n = arena_heap_fill();
+
+	for (size_t i = 0; i < n; i++) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+
+	for (size_t i = 0; i < ARENA_MAX_BLOCKS; i++) {
+		arena_blocks[i] = k_heap_aligned_alloc(&arena_heap, 4, 1, K_NO_WAIT);
+		zassert_not_null(arena_blocks[i], "small block allocation failed");
+		zassert_true(IS_PTR_ALIGNED(arena_blocks[i], void *),
+			     "small block %p not pointer aligned", arena_blocks[i]);
+	}
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      thread_free_arena_blocks,
+				      UINT_TO_POINTER(ARENA_MAX_BLOCKS), NULL, NULL,
+				      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+
+	k_thread_join(tid, K_FOREVER);
+
+	for (size_t i = 1; i < ARENA_MAX_BLOCKS; i += 2) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+
+	zassert_equal(arena_heap_fill(), n, "blocks lost after freeing small blocks");
+
+	for (size_t i = 0; i < n; i++) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+#else
+	ztest_test_skip();
+#endif /* CONFIG_HEAP_ARENAS */
+}
+
+/**
+ * @brief Validate the runtime stats of a heap split in per-CPU arenas
+ *
+ * @details Fill the heap over several arenas, and check that the stats
+ * count all of it, then that blocks freed from another thread count as
+ * free before their arena takes them back.
+ *
+ * @ingroup kernel_heap_tests
+ */
+ZTEST(k_heap_api, test_k_heap_arenas_stats)
+{
+#if defined(CONFIG_HEAP_ARENAS) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	struct sys_memory_stats empty, full, half;
+	size_t n;
+
+	zassert_ok(k_heap_runtime_stats_get(&arena_heap, &empty));
+	zassert_ok(k_heap_runtime_stats_reset_max(&arena_heap));
+
+	n = arena_heap_fill();
+	zassert_ok(k_heap_runtime_stats_get(&arena_heap, &full));
+	zassert_true(full.allocated_bytes >= n * ARENA_BLOCK_SIZE,
+		     "%zu bytes allocated for %zu blocks", full.allocated_bytes, n);
+	zassert_equal(full.allocated_bytes + full.free_bytes,
+		      empty.allocated_bytes + empty.free_bytes, "heap size changed");
+	zassert_equal(full.max_allocated_bytes, full.allocated_bytes,
+		      "maximum not summed over the arenas");
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      thread_free_arena_blocks, UINT_TO_POINTER(n), NULL, NULL,
+				      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_ok(k_heap_runtime_stats_get(&arena_heap, &half));
+	zassert_true(half.allocated_bytes < full.allocated_bytes, "freed blocks not counted");
+	zassert_true(half.allocated_bytes >= (n / 2) * ARENA_BLOCK_SIZE,
+		     "%zu bytes allocated for %zu blocks", half.allocated_bytes, n / 2);
+
+	for (size_t i = 1; i < n; i += 2) {
+		k_heap_free(&arena_heap, arena_blocks[i]);
+	}
+
+	zassert_ok(k_heap_runtime_stats_get(&arena_heap, &half));
+	zassert_equal(half.allocated_bytes, empty.allocated_bytes, "blocks lost after freeing");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_HEAP_ARENAS && CONFIG_SYS_HEAP_RUNTIME_STATS */
+}
@@ -21,13 +21,13 @@ ZTEST(hash_map, test_load_factor_default)
 		ret = sys_hashmap_insert(&map, i, i, NULL);
 		zassert_equal(1, ret, "failed to insert (%zu, %zu): %d", i, i, ret);
 		load_factor = sys_hashmap_load_factor(&map);
-		zassert_true(load_factor > 0 && load_factor <= SYS_HASHMAP_DEFAULT_LOAD_FACTOR);
+		zassert_true(load_factor > 0 && load_factor <= map.config->load_factor);
 	}
 
 	for (size_t i = MANY; i > 0; --i) {
 		zassert_equal(true, sys_hashmap_remove(&map, i - 1, NULL));
 		load_factor = sys_hashmap_load_factor(&map);
-		zassert_true(load_factor <= SYS_HASHMAP_DEFAULT_LOAD_FACTOR);
+		zassert_true(load_factor <= map.config->load_factor);
 	}
 }
 
@@ -1362,4 +1362,228 @@ ZTEST(lib_json_test, test_json_array_alignment)
 	zassert_equal(o.array[1].int3, 6, "Element 1 int3 not decoded correctly");
 }
 
+static const char stream_encoded[] =
+	"{\"some_string\":\"zephyr \\\"streaming\\\" \\u00e9 parser\","
+	"\"some_int\":-42,"
+	"\"some_bool\":true,"
+	"\"extra_struct\":{\"nested\":[{\"a\":\"}]\"},[1,2,{}]],\"b\":null},"
+	"\"some_int64\":-4611686018427387904,"
+	"\"some_uint64\":18446744073709551615,"
+	"\"some_nested_struct\":{\"nested_int\":-1234,\"nested_bool\":false,"
+	"\"nested_string\":\"this should be escaped: \\t\","
+	"\"nested_int64\":9223372036854775807},"
+	"\"some_array\":[11,22, 33,\t45,\n299],"
+	"\"another_b!@l\":true,"
+	"\"4nother_ne$+\":{\"nested_int\":1234,"
+	"\"nested_string\":\"no escape necessary\"},"
+	"\"nested_obj_array\":["
+	"{\"nested_int\":1,\"nested_string\":\"true\"},"
+	"{\"nested_int\":0,\"nested_string\":\"false\"}]"
+	"}";
+
+static int64_t stream_feed_chunks(struct json_stream *stream, const char *data, size_t len,
+				  size_t chunk)
+{
+	int64_t ret = -EAGAIN;
+
+	for (size_t i = 0; i < len && ret == -EAGAIN; i += chunk) {
+		ret = json_stream_feed(stream, data + i, MIN(chunk, len - i));
+	}
+
+	return ret;
+}
+
+ZTEST(lib_json_test, test_json_stream_decoding)
+{
+	static const size_t chunk_sizes[] = { 1, 2, 3, 7, 16, 64, sizeof(stream_encoded) };
+	char encoded[sizeof(stream_encoded)];
+	struct test_struct expected;
+	struct test_struct ts;
+	struct json_stream stream;
+	char buf[256];
+	int64_t expected_ret;
+	int64_t ret;
+
+	memcpy(encoded, stream_encoded, sizeof(encoded));
+	expected_ret = json_obj_parse(encoded, sizeof(encoded) - 1, test_descr,
+				      ARRAY_SIZE(test_descr), &expected);
+	zassert_true(expected_ret > 0, "Decoding failed with %d", (int)expected_ret);
+
+	ARRAY_FOR_EACH(chunk_sizes, i) {
+		memset(&ts, 0, sizeof(ts));
+
+		ret = json_stream_obj_init(&stream, test_descr, ARRAY_SIZE(test_descr), &ts,
+					   buf, sizeof(buf));
+		zassert_ok(ret, "Stream initialization failed");
+
+		ret = stream_feed_chunks(&stream, stream_encoded, sizeof(stream_encoded) - 1,
+					 chunk_sizes[i]);
+		zassert_equal(ret, expected_ret, "Streaming in chunks of %zu decoded %d",
+			      chunk_sizes[i], (int)ret);
+
+		zassert_str_equal(ts.some_string, expected.some_string,
+				  "String not decoded correctly");
+		zassert_equal(ts.some_int, expected.some_int,
+			      "Integer not decoded correctly");
+		zassert_equal(ts.some_bool, expected.some_bool,
+			      "Boolean not decoded correctly");
+		zassert_equal(ts.some_int64, expected.some_int64,
+			      "int64 not decoded correctly");
+		zassert_equal(ts.some_uint64, expected.some_uint64,
+			      "uint64 not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int,
+			      expected.some_nested_struct.nested_int,
+			      "Nested integer not decoded correctly");
+		zassert_str_equal(ts.some_nested_struct.nested_string,
+				  expected.some_nested_struct.nested_string,
+				  "Nested string not decoded correctly");
+		zassert_equal(ts.some_nested_struct.nested_int64,
+			      expected.some_nested_struct.nested_int64,
+			      "Nested int64 not decoded correctly");
+		zassert_equal(ts.some_array_len, expected.some_array_len,
+			      "Array doesn't have correct number of items");
+		zassert_mem_equal(ts.some_array, expected.some_array,
+				  ts.some_array_len * sizeof(ts.some_array[0]),
+				  "Array not decoded with expected values");
+		zassert_equal(ts.another_bxxl, expected.another_bxxl,
+			      "Named boolean not decoded correctly");
+		zassert_str_equal(ts.xnother_nexx.nested_string,
+				  expected.xnother_nexx.nested_string,
+				  "Named nested string not decoded correctly");
+		zassert_equal(ts.obj_array_len, 2,
+			      "Array of objects does not have correct number of items");
+		zassert_str_equal(ts.nested_obj_array[1].nested_string, "false",
+				  "String in object array element not decoded correctly");
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_arr_decoding)
+{
+	static const char encoded[] = "[{\"height\":168,\"name\":\"Sim\303\263n Bol\303\255var\"},"
+				      "{\"height\":173,\"name\":\"Pel\303\251\"},"
+				      "{\"height\":195,\"name\":\"Usain Bolt\"}"
+				      "]";
+	struct obj_array obj_array_array_ts;
+	struct json_stream stream;
+	char buf[64];
+	int64_t ret;
+
+	ret = json_stream_arr_init(&stream, obj_array_descr, &obj_array_array_ts, buf,
+				   sizeof(buf));
+	zassert_ok(ret, "Stream initialization failed");
+
+	ret = stream_feed_chunks(&stream, encoded, sizeof(encoded) - 1, 1);
+	zassert_equal(ret, 0, "Decoding array of objects returned error %d", (int)ret);
+
+	zassert_equal(obj_array_array_ts.num_elements, 3,
+		      "Array doesn't have correct number of items");
+	zassert_str_equal(obj_array_array_ts.elements[0].name,
+			  "Sim\303\263n Bol\303\255var",
+			  "String not decoded correctly");
+	zassert_equal(obj_array_array_ts.elements[1].height, 173,
+		      "Pel\303\251 height not decoded correctly");
+	zassert_str_equal(obj_array_array_ts.elements[2].name, "Usain Bolt",
+			  "String not decoded correctly");
+}
+
+struct raw_array {
+	const char *name;
+	struct json_obj_token elements;
+	int count;
+};
+
+static const struct json_obj_descr raw_array_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct raw_array, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct raw_array, elements, JSON_TOK_OBJ_ARRAY),
+	JSON_OBJ_DESCR_PRIM(struct raw_array, count, JSON_TOK_NUMBER),
+};
+
+ZTEST(lib_json_test, test_json_stream_obj_array_token)
+{
+	static const char elements[] = "[{\"name\":\"Pel\303\251\",\"height\":173}, "
+				       "{\"name\":\"[\\\"]\",\"height\":195}]";
+	static const char encoded[] = "{\"name\":\"heights\",\"elements\":"
+				      "[{\"name\":\"Pel\303\251\",\"height\":173}, "
+				      "{\"name\":\"[\\\"]\",\"height\":195}],"
+				      "\"count\":2}";
+	struct raw_array raw;
+	struct json_stream stream;
+	struct json_obj json;
+	struct elt elt;
+	char buf[128];
+	int64_t ret;
+
+	ret = json_stream_obj_init(&stream, raw_array_descr, ARRAY_SIZE(raw_array_descr), &raw,
+				   buf, sizeof(buf));
+	zassert_ok(ret, "Stream initialization failed");
+
+	ret = stream_feed_chunks(&stream, encoded, sizeof(encoded) - 1, 1);
+	zassert_equal(ret, 0x7, "Not all fields decoded correctly");
+
+	zassert_str_equal(raw.name, "heights", "String not decoded correctly");
+	zassert_equal(raw.count, 2, "Integer after the array not decoded correctly");
+	zassert_equal(raw.elements.length, sizeof(elements) - 1,
+		      "Array text does not have the correct length");
+	zassert_str_equal(raw.elements.start, elements, "Array text not kept correctly");
+
+	ret = json_arr_separate_object_parse_init(&json, raw.elements.start,
+						  raw.elements.length);
+	zassert_ok(ret, "Array start not detected");
+
+	ret = json_arr_separate_parse_object(&json, elt_descr, ARRAY_SIZE(elt_descr), &elt);
+	zassert_equal(ret, 0x3, "First object not decoded correctly");
+	zassert_str_equal(elt.name, "Pel\303\251", "String not decoded correctly");
+	zassert_equal(elt.height, 173, "Integer not decoded correctly");
+
+	ret = json_arr_separate_parse_object(&json, elt_descr, ARRAY_SIZE(elt_descr), &elt);
+	zassert_equal(ret, 0x3, "Second object not decoded correctly");
+	zassert_str_equal(elt.name, "[\\\"]", "String not decoded correctly");
+	zassert_equal(elt.height, 195, "Integer not decoded correctly");
+
+	ret = json_arr_separate_parse_object(&json, elt_descr, ARRAY_SIZE(elt_descr), &elt);
+	zassert_equal(ret, 0, "End of array not detected");
+}
+
+ZTEST(lib_json_test, test_json_stream_errors)
+{
+	static const char long_string[] =
+		"{\"some_string\":\"a value longer than the scratch buffer\"}";
+	static const char deep[] = "{\"key_not_in_descr\":[[[[[[[[[[[[1]]]]]]]]]]]],"
+				   "\"some_int\":7}";
+	struct test_struct ts;
+	struct json_stream stream;
+	char buf[32];
+	int64_t ret;
+
+	/* Values are kept in the scratch buffer */
+	json_stream_obj_init(&stream, test_descr, ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+	ret = json_stream_feed(&stream, long_string, sizeof(long_string) - 1);
+	zassert_equal(ret, -ENOMEM, "Scratch buffer overflow not detected");
+	ret = json_stream_feed(&stream, "}", 1);
+	zassert_equal(ret, -ENOMEM, "Error not kept");
+
+	/* Tokens may be split across chunks */
+	json_stream_obj_init(&stream, test_descr, ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+	ret = json_stream_feed(&stream, "{\"some_i", 8);
+	zassert_equal(ret, -EAGAIN, "Incomplete object not detected");
+	ret = json_stream_feed(&stream, "nt\":-4", 6);
+	zassert_equal(ret, -EAGAIN, "Incomplete object not detected");
+	ret = json_stream_feed(&stream, "2}trailing data", 15);
+	zassert_equal(ret, 0x2, "Integer not decoded correctly");
+	zassert_equal(ts.some_int, -42, "Integer not decoded correctly");
+
+	/* Invalid input is detected in any chunk */
+	json_stream_obj_init(&stream, test_descr, ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+	ret = json_stream_feed(&stream, "{\"some_int\":42,", 15);
+	zassert_equal(ret, -EAGAIN, "Incomplete object not detected");
+	ret = json_stream_feed(&stream, "}", 1);
+	zassert_equal(ret, -EINVAL, "Trailing comma not detected");
+
+	/* Skipped values take no nesting depth */
+	json_stream_obj_init(&stream, test_descr, ARRAY_SIZE(test_descr), &ts, buf, sizeof(buf));
+	ret = stream_feed_chunks(&stream, deep, sizeof(deep) - 1, 5);
+	zassert_equal(ret, 0x2, "Deeply nested unknown value not skipped");
+	zassert_equal(ts.some_int, 7, "Integer not decoded correctly");
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
 #include <zephyr/net/net_l2.h>
 #include <zephyr/net/udp.h>
 
+#include "ipv4.h"
 #include "ipv6.h"
 #include "udp_internal.h"
 
@@ -763,6 +764,43 @@ ZTEST(net_chksum_offload, test_tx_chksum_offload_enabled_test_v4)
 	test_tx_chksum(AF_INET, true);
 }
 
+/* A payload summed up while it is written in odd sized pieces must give the
+ * same checksum as summing the whole packet up.
+ */
+ZTEST(net_chksum_offload, test_tx_chksum_payload_sum)
+{
+	static const size_t chunk_lens[] = { 3, 100, 1, 57, 139 };
+	struct net_pkt *pkt;
+	size_t offset = 0;
+	uint16_t sum = 0U;
+	bool odd = false;
+
+	pkt = net_pkt_alloc_with_buffer(eth_interfaces[0], 300, AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+
+	zassert_ok(net_ipv4_create(pkt, &in4addr_my, &in4addr_dst));
+	zassert_ok(net_udp_create(pkt, htons(TEST_PORT), htons(TEST_PORT)));
+
+	ARRAY_FOR_EACH(chunk_lens, i) {
+		zassert_ok(net_pkt_write_chksum_cont(pkt, test_data_large + offset,
+						     chunk_lens[i], &sum, &odd));
+		offset += chunk_lens[i];
+	}
+
+	net_pkt_set_payload_chksum(pkt, sum, offset);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP));
+	zassert_true(net_pkt_is_chksum_done(pkt), "Checksum not calculated");
+
+	/* Sum the whole packet up, the checksum included */
+	net_pkt_set_payload_chksum(pkt, 0U, 0U);
+	zassert_equal(net_calc_verify_chksum_udp(pkt), 0U, "Checksum mismatch");
+
+	net_pkt_unref(pkt);
+}
+
 static void test_tx_chksum_udp_frag(sa_family_t family, bool offloaded)
 {
 	struct k_sem *wait_data = offloaded ? &wait_data_off : &wait_data_nonoff;
@@ -666,6 +666,59 @@ ZTEST(net_pkt_test_suite, test_net_pkt_copy)
 		     "Pkt not properly unreferenced");
 }
 
+static uint16_t chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		uint16_t tmp = (i % 2) == 0 ? data[i] << 8 : data[i];
+
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_write_chksum)
+{
+	static const size_t frag_lens[] = { 7, 30, 1, 64 };
+	uint8_t data[99];
+	uint8_t out[sizeof(data)];
+	struct net_pkt *pkt;
+	uint16_t sum = 0x1234;
+
+	sys_rand_get(data, sizeof(data));
+
+	pkt = net_pkt_alloc_on_iface(eth_if, K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+
+	/* Odd sized buffers, so that the data straddles them */
+	ARRAY_FOR_EACH(frag_lens, i) {
+		struct net_buf *buf = net_pkt_get_frag(pkt, frag_lens[i], K_NO_WAIT);
+
+		zassert_true(buf != NULL, "Buffer not allocated");
+		net_pkt_append_buffer(pkt, buf);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* A sum carried over writes needs even lengths but for the last */
+	zassert_ok(net_pkt_write_chksum(pkt, data, 40, &sum), "Write failed");
+	zassert_ok(net_pkt_write_chksum(pkt, data + 40, sizeof(data) - 40, &sum),
+		   "Write failed");
+
+	zassert_equal(sum, chksum_ref(0x1234, data, sizeof(data)),
+		      "Checksum mismatch");
+	zassert_equal(net_pkt_get_len(pkt), sizeof(data), "Wrong length");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, out, sizeof(out)), "Read failed");
+	zassert_mem_equal(out, data, sizeof(data), "Data mismatch");
+
+	net_pkt_unref(pkt);
+}
+
 #define PULL_TEST_PKT_DATA_SIZE 600
 
 ZTEST(net_pkt_test_suite, test_net_pkt_pull)
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket_rtio.h>
+
+#include "../../socket_helpers.h"
+
+#define MY_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT  4242
+
+#define TEST_STR "test"
+#define NUM_MSGS 3
+
+#define WAIT_TIME K_MSEC(500)
+
+#define MEM_BLK_COUNT 16
+#define MEM_BLK_SIZE  16
+#define MEM_BLK_ALIGN 4
+
+RTIO_DEFINE_WITH_MEMPOOL(r, 8, 8, MEM_BLK_COUNT, MEM_BLK_SIZE, MEM_BLK_ALIGN);
+
+static ZTEST_BMEM int s_sock;
+static ZTEST_BMEM int c_sock;
+static ZTEST_BMEM int new_sock;
+
+static struct rtio_cqe wait_cqe(void *userdata)
+{
+	struct rtio_cqe cqe;
+
+	zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, WAIT_TIME), 1, "No completion");
+	zassert_equal_ptr(cqe.userdata, userdata, "Unexpected completion");
+
+	return cqe;
+}
+
+static void release_cqe_buffer(struct rtio_cqe *cqe)
+{
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+	rtio_release_buffer(&r, buf, buf_len);
+}
+
+/* Connect a client to the server with accept and connect operations submitted together */
+static void before(void *fixture)
+{
+	struct sockaddr_in s_addr;
+	struct sockaddr_in peer_addr;
+	struct rtio_sqe sqes[2];
+	struct rtio_cqe cqe;
+	int ret;
+
+	ARG_UNUSED(fixture);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_addr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &c_sock, &s_addr);
+
+	ret = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_ok(ret, "bind failed (%d)", -errno);
+	ret = zsock_listen(s_sock, 1);
+	zassert_ok(ret, "listen failed (%d)", -errno);
+
+	net_socket_rtio_prep_accept(&sqes[0], s_sock, &peer_addr, sizeof(peer_addr), &s_sock);
+	net_socket_rtio_prep_connect(&sqes[1], c_sock, &s_addr, sizeof(s_addr), &c_sock);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, 0));
+
+	new_sock = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(sqes); i++) {
+		zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, WAIT_TIME), 1, "No completion");
+
+		if (cqe.userdata == &s_sock) {
+			zassert_true(cqe.result >= 0, "accept failed (%d)", cqe.result);
+			new_sock = cqe.result;
+		} else {
+			zassert_ok(cqe.result, "connect failed (%d)", cqe.result);
+		}
+	}
+
+	zassert_equal(peer_addr.sin_family, AF_INET, "Invalid peer address");
+
+#ifdef CONFIG_USERSPACE
+	rtio_access_grant(&r, k_current_get());
+	k_object_access_grant(&net_socket_rtio_iodev, k_current_get());
+#endif
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zsock_close(c_sock);
+	zsock_close(new_sock);
+	zsock_close(s_sock);
+
+	/* Let the connections close */
+	k_msleep(2 * CONFIG_NET_TCP_TIME_WAIT_DELAY);
+}
+
+ZTEST(net_socket_rtio, test_recv_send)
+{
+	uint8_t buf[sizeof(TEST_STR)];
+	struct rtio_sqe sqe;
+	struct rtio_cqe cqe;
+
+	/* The receive waits for the data sent after it was submitted */
+	net_socket_rtio_prep_recv(&sqe, new_sock, buf, sizeof(buf), buf);
+	zassert_ok(rtio_sqe_copy_in(&r, &sqe, 1));
+	zassert_ok(rtio_submit(&r, 0));
+
+	zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, K_MSEC(50)), 0, "Early completion");
+
+	net_socket_rtio_prep_send(&sqe, c_sock, TEST_STR, strlen(TEST_STR), &c_sock);
+	zassert_ok(rtio_sqe_copy_in(&r, &sqe, 1));
+	zassert_ok(rtio_submit(&r, 0));
+
+	cqe = wait_cqe(&c_sock);
+	zassert_equal(cqe.result, strlen(TEST_STR), "send failed (%d)", cqe.result);
+
+	cqe = wait_cqe(buf);
+	zassert_equal(cqe.result, strlen(TEST_STR), "recv failed (%d)", cqe.result);
+	zassert_mem_equal(buf, TEST_STR, strlen(TEST_STR));
+}
+
+ZTEST(net_socket_rtio, test_echo)
+{
+	uint8_t buf[sizeof(TEST_STR)];
+	struct rtio_sqe sqes[2];
+	struct rtio_cqe cqe;
+	struct rtio_cqe recv_cqe;
+	ssize_t len;
+
+	/* Echo the received data with a chained send */
+	net_socket_rtio_prep_recv_with_pool(&sqes[0], new_sock, &sqes[0]);
+	sqes[0].flags |= RTIO_SQE_CHAINED;
+	net_socket_rtio_prep_send_received(&sqes[1], new_sock, &sqes[1]);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, 0));
+
+	len = zsock_send(c_sock, TEST_STR, strlen(TEST_STR), 0);
+	zassert_equal(len, strlen(TEST_STR), "send failed (%d)", -errno);
+
+	recv_cqe = wait_cqe(&sqes[0]);
+	zassert_equal(recv_cqe.result, strlen(TEST_STR), "recv failed (%d)", recv_cqe.result);
+
+	cqe = wait_cqe(&sqes[1]);
+	zassert_equal(cqe.result, strlen(TEST_STR), "send failed (%d)", cqe.result);
+
+	/* The buffer is only released once the send is done */
+	release_cqe_buffer(&recv_cqe);
+
+	len = zsock_recv(c_sock, buf, sizeof(buf), 0);
+	zassert_equal(len, strlen(TEST_STR), "recv failed (%d)", -errno);
+	zassert_mem_equal(buf, TEST_STR, strlen(TEST_STR));
+}
+
+ZTEST(net_socket_rtio, test_recv_multishot)
+{
+	struct rtio_sqe sqe;
+	struct rtio_cqe cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t len;
+
+	net_socket_rtio_prep_recv_multishot(&sqe, new_sock, &sqe);
+	zassert_ok(rtio_sqe_copy_in(&r, &sqe, 1));
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		len = zsock_send(c_sock, TEST_STR, strlen(TEST_STR), 0);
+		zassert_equal(len, strlen(TEST_STR), "send failed (%d)", -errno);
+
+		cqe = wait_cqe(&sqe);
+		zassert_equal(cqe.result, strlen(TEST_STR), "recv failed (%d)", cqe.result);
+
+		/* Only the blocks that were filled are kept */
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, &cqe, &buf, &buf_len));
+		zassert_equal(buf_len, MEM_BLK_SIZE);
+		zassert_mem_equal(buf, TEST_STR, strlen(TEST_STR));
+		rtio_release_buffer(&r, buf, buf_len);
+	}
+
+	/* The multishot receive ends when the peer closes the connection */
+	zsock_close(c_sock);
+	c_sock = -1;
+
+	cqe = wait_cqe(&sqe);
+	zassert_equal(cqe.result, 0, "Expected the end of the stream (%d)", cqe.result);
+	release_cqe_buffer(&cqe);
+
+	zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, K_MSEC(50)), 0, "Unexpected completion");
+	zassert_equal(rtio_sqe_acquirable(&r), 8, "Submission not released");
+}
+
+ZTEST(net_socket_rtio, test_cancel)
+{
+	uint8_t buf[sizeof(TEST_STR)];
+	struct rtio_sqe sqe;
+	struct rtio_sqe *handle;
+	struct rtio_cqe cqe;
+
+	net_socket_rtio_prep_recv(&sqe, new_sock, buf, sizeof(buf), buf);
+	zassert_ok(rtio_sqe_copy_in_get_handles(&r, &sqe, &handle, 1));
+	zassert_ok(rtio_submit(&r, 0));
+
+	zassert_ok(rtio_sqe_cancel(handle));
+
+	/* The canceled receive is completed at the next submission, without completion */
+	net_socket_rtio_prep_send(&sqe, c_sock, TEST_STR, strlen(TEST_STR), &c_sock);
+	zassert_ok(rtio_sqe_copy_in(&r, &sqe, 1));
+	zassert_ok(rtio_submit(&r, 1));
+
+	cqe = wait_cqe(&c_sock);
+	zassert_equal(cqe.result, strlen(TEST_STR), "send failed (%d)", cqe.result);
+
+	zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, K_MSEC(50)), 0, "Unexpected completion");
+	zassert_equal(rtio_sqe_acquirable(&r), 8, "Submission not released");
+}
+
+ZTEST(net_socket_rtio, test_invalid_socket)
+{
+	uint8_t buf[sizeof(TEST_STR)];
+	struct rtio_sqe sqe;
+	struct rtio_cqe cqe;
+
+	net_socket_rtio_prep_recv(&sqe, -1, buf, sizeof(buf), buf);
+	zassert_ok(rtio_sqe_copy_in(&r, &sqe, 1));
+	zassert_ok(rtio_submit(&r, 1));
+
+	cqe = wait_cqe(buf);
+	zassert_equal(cqe.result, -EBADF, "Unexpected result (%d)", cqe.result);
+}
+
+#ifdef CONFIG_USERSPACE
+ZTEST_USER(net_socket_rtio, test_user_foreign_socket)
+{
+	uint8_t buf[sizeof(TEST_STR)];
+	struct rtio_sqe sqes[2];
+	struct rtio_cqe cqe;
+	ssize_t len;
+
+	/* Drop the access to the client socket, used by the second send of a chain */
+	k_object_release(zsock_get_context_object(c_sock));
+
+	net_socket_rtio_prep_send(&sqes[0], new_sock, TEST_STR, strlen(TEST_STR), &sqes[0]);
+	sqes[0].flags |= RTIO_SQE_CHAINED;
+	net_socket_rtio_prep_send(&sqes[1], c_sock, TEST_STR, strlen(TEST_STR), &sqes[1]);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, 0));
+
+	cqe = wait_cqe(&sqes[0]);
+	zassert_equal(cqe.result, strlen(TEST_STR), "send failed (%d)", cqe.result);
+
+	cqe = wait_cqe(&sqes[1]);
+	zassert_equal(cqe.result, -EBADF, "Unexpected result (%d)", cqe.result);
+
+	/* Nothing was sent on the client socket */
+	k_msleep(50);
+	len = zsock_recv(new_sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, -1, "Unexpected data received");
+	zassert_equal(errno, EAGAIN, "Unexpected errno (%d)", errno);
+}
+
+ZTEST_USER(net_socket_rtio, test_user_accept)
+{
+	uint8_t buf[sizeof(TEST_STR)];
+	struct sockaddr_in s_addr;
+	struct rtio_sqe sqes[2];
+	struct rtio_cqe cqe;
+	int sock;
+	int accepted = -1;
+	ssize_t len;
+
+	/* Connect another client, accepted on behalf of this thread */
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &sock, &s_addr);
+
+	net_socket_rtio_prep_accept(&sqes[0], s_sock, NULL, 0, &s_sock);
+	net_socket_rtio_prep_connect(&sqes[1], sock, &s_addr, sizeof(s_addr), &sock);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (int i = 0; i < ARRAY_SIZE(sqes); i++) {
+		zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, WAIT_TIME), 1, "No completion");
+
+		if (cqe.userdata == &s_sock) {
+			zassert_true(cqe.result >= 0, "accept failed (%d)", cqe.result);
+			accepted = cqe.result;
+		} else {
+			zassert_ok(cqe.result, "connect failed (%d)", cqe.result);
+		}
+	}
+
+	/* The accepted socket was granted to this thread */
+	net_socket_rtio_prep_recv(&sqes[0], accepted, buf, sizeof(buf), buf);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, 1));
+	zassert_ok(rtio_submit(&r, 0));
+
+	len = zsock_send(sock, TEST_STR, strlen(TEST_STR), 0);
+	zassert_equal(len, strlen(TEST_STR), "send failed (%d)", -errno);
+
+	cqe = wait_cqe(buf);
+	zassert_equal(cqe.result, strlen(TEST_STR), "recv failed (%d)", cqe.result);
+	zassert_mem_equal(buf, TEST_STR, strlen(TEST_STR));
+
+	zassert_ok(zsock_close(accepted), "close failed (%d)", -errno);
+	zassert_ok(zsock_close(sock), "close failed (%d)", -errno);
+}
+#endif /* CONFIG_USERSPACE */
+
+ZTEST_SUITE(net_socket_rtio, NULL, NULL, before, after, NULL);
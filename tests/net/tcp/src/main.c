@@ -114,6 +114,8 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_CLIENT_WINDOW_SCALE_IPV4 = 19,
+	TEST_CLIENT_SACK_RETRANSMIT_IPV4 = 20,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +140,9 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_SACK)
+static void handle_client_wscale_sack_test(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -235,23 +240,24 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
-static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
-					      uint16_t src_port,
-					      uint16_t dst_port,
-					      uint8_t flags,
-					      const uint8_t *data,
-					      size_t len)
+/* Build a TCP segment from the peer, opts_len must be a multiple of 4 and
+ * win is the window field in network byte order.
+ */
+static struct net_pkt *tester_prepare_tcp_pkt_opts(sa_family_t af,
+						   uint16_t src_port,
+						   uint16_t dst_port,
+						   uint8_t flags,
+						   const uint8_t *opts,
+						   size_t opts_len,
+						   uint16_t win,
+						   const uint8_t *data,
+						   size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
-	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		opts_len = sizeof(tcp_options);
-	}
-
 	/* Allocate buffer */
 	pkt = net_pkt_alloc_with_buffer(net_iface,
 					sizeof(struct tcphdr) + len + opts_len,
@@ -284,14 +290,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = 5U + opts_len / 4U;
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = win;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -303,9 +304,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts && opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -338,6 +339,26 @@ fail:
 	return NULL;
 }
 
+static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
+					      uint16_t src_port,
+					      uint16_t dst_port,
+					      uint8_t flags,
+					      const uint8_t *data,
+					      size_t len)
+{
+	const uint8_t *opts = NULL;
+	size_t opts_len = 0;
+
+	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
+		opts_len = sizeof(tcp_options);
+	}
+
+	return tester_prepare_tcp_pkt_opts(af, src_port, dst_port, flags,
+					   opts, opts_len, NET_IPV6_MTU,
+					   data, len);
+}
+
 static struct net_pkt *prepare_syn_packet(sa_family_t af, uint16_t src_port,
 					  uint16_t dst_port)
 {
@@ -490,6 +511,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_SACK)
+	case TEST_CLIENT_WINDOW_SCALE_IPV4:
+	case TEST_CLIENT_SACK_RETRANSMIT_IPV4:
+		handle_client_wscale_sack_test(pkt, &th);
+		break;
+#endif
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -2602,4 +2629,409 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_SACK)
+/* 128 KiB receive window, it needs a window scale of 2 to fit the window
+ * field.
+ */
+#define TEST_RECV_WIN (128U * 1024U)
+#define TEST_WSCALE_SHIFT 2U
+#define TEST_PEER_WSCALE_SHIFT 3U
+#define TEST_PEER_WIN (96U * 1024U)
+
+/* The interface MTU is 127 bytes, keep the segments below it */
+#define TEST_SACK_MSS 64U
+#define TEST_SACK_SEGMENTS 5U
+
+static const uint8_t wscale_sack_syn_ack_opts[] = {
+	NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, 0x00, TEST_SACK_MSS,
+	NET_TCP_NOP_OPT, NET_TCP_WINDOW_SCALE_OPT, NET_TCP_WINDOW_SCALE_SIZE,
+	TEST_PEER_WSCALE_SHIFT,
+	NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_PERM_OPT,
+	NET_TCP_SACK_PERM_SIZE,
+};
+
+static uint16_t wscale_sack_peer_port;
+static int sack_tx_count[TEST_SACK_SEGMENTS];
+static int sack_tx_last;
+static int sack_tx_total;
+static int sack_tx_expected;
+
+static size_t read_tcp_options(struct net_pkt *pkt, struct tcphdr *th,
+			       uint8_t *opts, size_t max_len)
+{
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+
+	zassert_true(len <= max_len, "Too long TCP options (%zu)", len);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	zassert_ok(net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+				net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr)),
+		   "Cannot skip to TCP options");
+	if (len > 0) {
+		zassert_ok(net_pkt_read(pkt, opts, len),
+			   "Cannot read TCP options");
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return len;
+}
+
+static const uint8_t *find_tcp_option(const uint8_t *opts, size_t len,
+				      uint8_t kind)
+{
+	size_t i = 0;
+
+	while (i < len && opts[i] != NET_TCP_END_OPT) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= len || opts[i + 1] < 2) {
+			break;
+		}
+
+		if (opts[i] == kind) {
+			return &opts[i];
+		}
+
+		i += opts[i + 1];
+	}
+
+	return NULL;
+}
+
+static size_t tcp_payload_len(struct net_pkt *pkt, struct tcphdr *th)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+}
+
+static struct net_pkt *prepare_wscale_ack_packet(uint16_t win)
+{
+	return tester_prepare_tcp_pkt_opts(AF_INET, htons(MY_PORT),
+					   wscale_sack_peer_port, ACK,
+					   NULL, 0U, htons(win), NULL, 0U);
+}
+
+/* Duplicate ACK reporting the given segments as received */
+static struct net_pkt *prepare_sack_packet(const uint8_t *segs, size_t count)
+{
+	uint8_t opts[4 + NET_TCP_MAX_SACK_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
+	uint32_t base = device_initial_seq + 1U;
+	size_t len = 0;
+
+	zassert_true(count <= NET_TCP_MAX_SACK_BLOCKS, "Too many SACK blocks");
+
+	opts[len++] = NET_TCP_NOP_OPT;
+	opts[len++] = NET_TCP_NOP_OPT;
+	opts[len++] = NET_TCP_SACK_OPT;
+	opts[len++] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (size_t i = 0; i < count; i++) {
+		UNALIGNED_PUT(htonl(base + segs[i] * TEST_SACK_MSS),
+			      (uint32_t *)(opts + len));
+		len += sizeof(uint32_t);
+		UNALIGNED_PUT(htonl(base + (segs[i] + 1U) * TEST_SACK_MSS),
+			      (uint32_t *)(opts + len));
+		len += sizeof(uint32_t);
+	}
+
+	return tester_prepare_tcp_pkt_opts(AF_INET, htons(MY_PORT),
+					   wscale_sack_peer_port, ACK,
+					   opts, len, htons(UINT16_MAX),
+					   NULL, 0U);
+}
+
+static void inject_packet(struct net_pkt *pkt, int line)
+{
+	zassert_not_null(pkt, "Cannot prepare packet (line %d)", line);
+	zassert_ok(net_recv_data(net_iface, pkt),
+		   "Cannot inject packet (line %d)", line);
+}
+
+static void handle_client_wscale_sack_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[NET_TCP_MAX_OPT_SIZE];
+	struct net_pkt *reply;
+	const uint8_t *opt;
+	size_t opts_len;
+	uint32_t rel_seq;
+	size_t len;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+
+		opts_len = read_tcp_options(pkt, th, opts, sizeof(opts));
+		opt = find_tcp_option(opts, opts_len, NET_TCP_WINDOW_SCALE_OPT);
+		zassert_not_null(opt, "No window scale option in SYN");
+		zassert_not_null(find_tcp_option(opts, opts_len,
+						 NET_TCP_SACK_PERM_OPT),
+				 "No SACK permitted option in SYN");
+
+		if (test_case_no == TEST_CLIENT_WINDOW_SCALE_IPV4) {
+			zassert_equal(opt[2], TEST_WSCALE_SHIFT,
+				      "Unexpected window scale %u", opt[2]);
+			/* The window field of a SYN is never scaled */
+			zassert_equal(ntohs(th->th_win), UINT16_MAX,
+				      "Unexpected SYN window %u",
+				      ntohs(th->th_win));
+		}
+
+		device_initial_seq = ntohl(th->th_seq);
+		seq = 0U;
+		ack = device_initial_seq + 1U;
+		wscale_sack_peer_port = th->th_sport;
+		reply = tester_prepare_tcp_pkt_opts(AF_INET, htons(MY_PORT),
+						    wscale_sack_peer_port, SYN | ACK,
+						    wscale_sack_syn_ack_opts,
+						    sizeof(wscale_sack_syn_ack_opts),
+						    htons(UINT16_MAX), NULL, 0U);
+		seq++;
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+
+		if (test_case_no == TEST_CLIENT_WINDOW_SCALE_IPV4) {
+			zassert_equal(ntohs(th->th_win),
+				      TEST_RECV_WIN >> TEST_WSCALE_SHIFT,
+				      "Unexpected window %u", ntohs(th->th_win));
+		}
+
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		len = tcp_payload_len(pkt, th);
+		if (len == 0) {
+			/* Pure ACKs carry nothing to check */
+			return;
+		}
+
+		test_verify_flags(th, PSH | ACK);
+
+		rel_seq = get_rel_seq(th) - 1U;
+		zassert_equal(rel_seq % TEST_SACK_MSS, 0,
+			      "Segment not on an MSS boundary (%u)", rel_seq);
+		zassert_equal(len, TEST_SACK_MSS, "Unexpected segment length %zu",
+			      len);
+		zassert_true(rel_seq / TEST_SACK_MSS < TEST_SACK_SEGMENTS,
+			     "Segment beyond the sent data (%u)", rel_seq);
+
+		sack_tx_last = rel_seq / TEST_SACK_MSS;
+		sack_tx_count[sack_tx_last]++;
+		if (++sack_tx_total == sack_tx_expected) {
+			test_sem_give();
+		}
+
+		return;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		t_state = T_FIN_ACK;
+		reply = prepare_fin_ack_packet(AF_INET, htons(MY_PORT),
+					       wscale_sack_peer_port);
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	zassert_ok(net_recv_data(net_iface, reply), "%s failed", __func__);
+}
+
+/* Test case scenario IPv4
+ *   expect SYN with a window scale of 2 and SACK permitted,
+ *   send SYN ACK with a window scale of 3 and SACK permitted,
+ *   expect ACK with a window scaled by 2,
+ *   send ACK with a window scaled by 3 to more than 64 KiB,
+ *   expect FIN,
+ *   send FIN ACK,
+ *   expect ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_window_scale_ipv4)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_WINDOW_SCALE_IPV4;
+	seq = ack = 0;
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	/* Windows above 64 KiB can only be used with window scaling */
+	conn = ctx->tcp;
+	conn->recv_win_max = TEST_RECV_WIN;
+	conn->recv_win = TEST_RECV_WIN;
+	conn->recv_win_sent = TEST_RECV_WIN;
+	conn->send_win_max = TEST_RECV_WIN;
+
+	zassert_ok(net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				       sizeof(struct sockaddr_in), NULL,
+				       K_MSEC(100), NULL),
+		   "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_true(conn->wscale_ok, "Window scaling not negotiated");
+	zassert_equal(conn->rcv_wscale, TEST_WSCALE_SHIFT,
+		      "Unexpected receive window scale %u", conn->rcv_wscale);
+	zassert_equal(conn->snd_wscale, TEST_PEER_WSCALE_SHIFT,
+		      "Unexpected send window scale %u", conn->snd_wscale);
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+
+	inject_packet(prepare_wscale_ack_packet(TEST_PEER_WIN >> TEST_PEER_WSCALE_SHIFT),
+		      __LINE__);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(conn->send_win, TEST_PEER_WIN,
+		      "Unexpected send window %u", conn->send_win);
+
+	t_state = T_FIN;
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+/* Test case scenario IPv4
+ *   expect SYN,
+ *   send SYN ACK with SACK permitted,
+ *   expect ACK,
+ *   expect 5 data segments,
+ *   send ACK for the first segment,
+ *   send 3 duplicate ACKs with SACK blocks for segments 2 and 4,
+ *   expect segment 1 only,
+ *   send duplicate ACK,
+ *   expect segment 3 only,
+ *   send duplicate ACK,
+ *   expect nothing,
+ *   send ACK for all data and close the connection.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_client_sack_retransmit_ipv4)
+{
+	static const uint8_t sack_2[] = { 2 };
+	static const uint8_t sack_4_2[] = { 4, 2 };
+	struct net_context *ctx;
+	struct tcp *conn;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_FAST_RETRANSMIT);
+
+	t_state = T_SYN;
+	test_case_no = TEST_CLIENT_SACK_RETRANSMIT_IPV4;
+	seq = ack = 0;
+	memset(sack_tx_count, 0, sizeof(sack_tx_count));
+	sack_tx_total = 0;
+	sack_tx_expected = TEST_SACK_SEGMENTS;
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	zassert_ok(net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				       sizeof(struct sockaddr_in), NULL,
+				       K_MSEC(100), NULL),
+		   "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	/* Let all the segments out without waiting for ACKs */
+	conn->ca.cwnd = TEST_SACK_SEGMENTS * TEST_SACK_MSS;
+#endif
+
+	ret = net_context_send(ctx, lorem_ipsum,
+			       TEST_SACK_SEGMENTS * TEST_SACK_MSS,
+			       NULL, K_NO_WAIT, NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to send data to peer");
+	}
+
+	/* Peer will release the semaphore after all segments are sent */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Segment 0 is received, segments 1 and 3 are lost. The steps below
+	 * need to finish before the retransmission timeout.
+	 */
+	ack = device_initial_seq + 1U + TEST_SACK_MSS;
+	inject_packet(prepare_wscale_ack_packet(UINT16_MAX), __LINE__);
+
+	sack_tx_expected = sack_tx_total + 1;
+	inject_packet(prepare_sack_packet(sack_2, ARRAY_SIZE(sack_2)), __LINE__);
+	inject_packet(prepare_sack_packet(sack_4_2, ARRAY_SIZE(sack_4_2)), __LINE__);
+	inject_packet(prepare_sack_packet(sack_4_2, ARRAY_SIZE(sack_4_2)), __LINE__);
+
+	/* The third duplicate ACK fills the first hole */
+	test_sem_take(K_MSEC(50), __LINE__);
+	zassert_equal(sack_tx_last, 1, "Resent segment %d instead of 1",
+		      sack_tx_last);
+
+	sack_tx_expected = sack_tx_total + 1;
+	inject_packet(prepare_sack_packet(sack_4_2, ARRAY_SIZE(sack_4_2)), __LINE__);
+
+	test_sem_take(K_MSEC(50), __LINE__);
+	zassert_equal(sack_tx_last, 3, "Resent segment %d instead of 3",
+		      sack_tx_last);
+
+	/* Both holes are filled, nothing is left to resend */
+	sack_tx_expected = sack_tx_total + 1;
+	inject_packet(prepare_sack_packet(sack_4_2, ARRAY_SIZE(sack_4_2)), __LINE__);
+
+	test_sem_take_failure(K_MSEC(20), __LINE__);
+
+	zassert_equal(sack_tx_count[0], 1, "Segment 0 resent");
+	zassert_equal(sack_tx_count[1], 2, "Segment 1 not resent once");
+	zassert_equal(sack_tx_count[2], 1, "SACKed segment 2 resent");
+	zassert_equal(sack_tx_count[3], 2, "Segment 3 not resent once");
+	zassert_equal(sack_tx_count[4], 1, "SACKed segment 4 resent");
+
+	ack = device_initial_seq + 1U + TEST_SACK_SEGMENTS * TEST_SACK_MSS;
+	inject_packet(prepare_wscale_ack_packet(UINT16_MAX), __LINE__);
+	k_sleep(K_MSEC(10));
+
+	t_state = T_FIN;
+	net_context_put(ctx);
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#endif /* CONFIG_NET_TCP_WINDOW_SCALE && CONFIG_NET_TCP_SACK */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
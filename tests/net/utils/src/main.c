@@ -938,4 +938,60 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+#define CHECKSUM_FUZZ_ROUNDS 2000
+#define CHECKSUM_FUZZ_ALIGN 16
+
+uint8_t fuzz_src[CHECKSUM_TEST_LENGTH + CHECKSUM_FUZZ_ALIGN];
+uint8_t fuzz_dst[CHECKSUM_TEST_LENGTH + CHECKSUM_FUZZ_ALIGN + 1];
+
+static uint32_t fuzz_state = 0x6d2b79f5;
+
+/* Deterministic xorshift, so that a failing round can be reproduced */
+static uint32_t fuzz_rand(void)
+{
+	fuzz_state ^= fuzz_state << 13;
+	fuzz_state ^= fuzz_state >> 17;
+	fuzz_state ^= fuzz_state << 5;
+
+	return fuzz_state;
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_fuzz)
+{
+	for (int round = 0; round < CHECKSUM_FUZZ_ROUNDS; round++) {
+		size_t src_off = fuzz_rand() % CHECKSUM_FUZZ_ALIGN;
+		size_t dst_off = fuzz_rand() % CHECKSUM_FUZZ_ALIGN;
+		size_t length = fuzz_rand() % (CHECKSUM_TEST_LENGTH + 1);
+		uint16_t sum_in = fuzz_rand();
+		uint16_t sum_exp;
+		uint16_t sum_got;
+
+		/* All ones data stresses the carries */
+		for (size_t i = 0; i < length; i++) {
+			fuzz_src[src_off + i] = (round % 8) == 0 ? 0xff : fuzz_rand();
+		}
+
+		sum_exp = calc_chksum_ref(sum_in, fuzz_src + src_off, length);
+
+		sum_got = calc_chksum(sum_in, fuzz_src + src_off, length);
+		zassert_equal(sum_got, sum_exp,
+			      "Checksum mismatch, round %d offset %zu length %zu",
+			      round, src_off, length);
+
+		memset(fuzz_dst, 0x5a, sizeof(fuzz_dst));
+
+		sum_got = calc_chksum_copy(sum_in, fuzz_dst + dst_off,
+					   fuzz_src + src_off, length);
+		zassert_equal(sum_got, sum_exp,
+			      "Copy checksum mismatch, round %d offsets %zu/%zu length %zu",
+			      round, src_off, dst_off, length);
+		zassert_mem_equal(fuzz_dst + dst_off, fuzz_src + src_off, length,
+				  "Copy mismatch, round %d", round);
+		zassert_equal(fuzz_dst[dst_off + length], 0x5a,
+			      "Copy overrun, round %d", round);
+		zassert_true(dst_off == 0 || fuzz_dst[dst_off - 1] == 0x5a,
+			     "Copy underrun, round %d", round);
+	}
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/posix/poll.h>
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/posix/unistd.h>
+#include <zephyr/ztest.h>
+
+#define NUM_EFDS 3
+
+static int epfd = -1;
+static int efds[NUM_EFDS] = {-1, -1, -1};
+
+static void add(int fd, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev), "epoll_ctl() failed: %d", errno);
+}
+
+static void signal_efd(int fd)
+{
+	zassert_ok(eventfd_write(fd, 1));
+}
+
+static void drain_efd(int fd)
+{
+	eventfd_t val;
+
+	zassert_ok(eventfd_read(fd, &val));
+}
+
+ZTEST(posix_epoll, test_epoll_timeout)
+{
+	struct epoll_event ev;
+
+	add(efds[0], EPOLLIN);
+
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 0);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 10), 0);
+}
+
+ZTEST(posix_epoll, test_epoll_ctl_errors)
+{
+	struct epoll_event ev = {.events = EPOLLIN};
+
+	add(efds[0], EPOLLIN);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, efds[0], &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_MOD, efds[1], &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, efds[1], NULL), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(efds[1], EPOLL_CTL_ADD, efds[0], &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, -1, &ev), -1);
+	zassert_equal(errno, EBADF);
+}
+
+ZTEST(posix_epoll, test_epoll_level_triggered)
+{
+	struct epoll_event ev;
+
+	add(efds[0], EPOLLIN);
+	add(efds[1], EPOLLIN);
+
+	signal_efd(efds[1]);
+
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+	zassert_equal(ev.data.fd, efds[1]);
+	zassert_equal(ev.events, EPOLLIN);
+
+	/* still reported while not drained */
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 1);
+	zassert_equal(ev.data.fd, efds[1]);
+
+	drain_efd(efds[1]);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 0);
+}
+
+ZTEST(posix_epoll, test_epoll_edge_triggered)
+{
+	struct epoll_event ev;
+
+	add(efds[0], EPOLLIN | EPOLLET);
+
+	signal_efd(efds[0]);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+	zassert_equal(ev.data.fd, efds[0]);
+
+	drain_efd(efds[0]);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 0);
+
+	signal_efd(efds[0]);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+	zassert_equal(ev.data.fd, efds[0]);
+}
+
+ZTEST(posix_epoll, test_epoll_oneshot)
+{
+	struct epoll_event ev;
+
+	add(efds[0], EPOLLIN | EPOLLONESHOT);
+
+	signal_efd(efds[0]);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+
+	/* disabled until re-armed with EPOLL_CTL_MOD */
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 0);
+
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.fd = efds[0];
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_MOD, efds[0], &ev));
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+	zassert_equal(ev.data.fd, efds[0]);
+}
+
+ZTEST(posix_epoll, test_epoll_maxevents)
+{
+	struct epoll_event ev[NUM_EFDS];
+	int seen = 0;
+
+	ARRAY_FOR_EACH(efds, i) {
+		add(efds[i], EPOLLIN);
+		signal_efd(efds[i]);
+	}
+
+	/* entries that do not fit are reported by the next call */
+	for (int i = 0; i < NUM_EFDS; i++) {
+		zassert_equal(epoll_wait(epfd, ev, 1, 100), 1);
+		seen |= BIT(ev[0].data.fd);
+		drain_efd(ev[0].data.fd);
+	}
+
+	ARRAY_FOR_EACH(efds, i) {
+		zassert_true(seen & BIT(efds[i]), "fd %d not reported", efds[i]);
+	}
+
+	zassert_equal(epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0), 0);
+}
+
+ZTEST(posix_epoll, test_epoll_del_and_close)
+{
+	struct epoll_event ev;
+
+	add(efds[0], EPOLLIN);
+	add(efds[1], EPOLLIN);
+
+	signal_efd(efds[0]);
+	signal_efd(efds[1]);
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_DEL, efds[0], NULL));
+	zassert_ok(close(efds[1]));
+	efds[1] = -1;
+
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 0);
+}
+
+ZTEST(posix_epoll, test_epoll_poll_epfd)
+{
+	struct pollfd pfd = {
+		.fd = epfd,
+		.events = POLLIN,
+	};
+
+	add(efds[0], EPOLLIN);
+
+	zassert_equal(poll(&pfd, 1, 0), 0);
+
+	signal_efd(efds[0]);
+	zassert_equal(poll(&pfd, 1, 100), 1);
+	zassert_equal(pfd.revents, POLLIN);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1() failed: %d", errno);
+
+	ARRAY_FOR_EACH(efds, i) {
+		efds[i] = eventfd(0, EFD_NONBLOCK);
+		zassert_true(efds[i] >= 0, "eventfd() failed: %d", errno);
+	}
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	ARRAY_FOR_EACH(efds, i) {
+		if (efds[i] >= 0) {
+			zassert_ok(close(efds[i]));
+			efds[i] = -1;
+		}
+	}
+
+	zassert_ok(close(epfd));
+	epfd = -1;
+}
+
+ZTEST_SUITE(posix_epoll, NULL, NULL, before, after, NULL);
@@ -964,6 +964,131 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 #endif
 }
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+static size_t num_index_entries_in_sector(uint16_t sector, struct nvs_fs *fs)
+{
+	size_t num = 0;
+
+	for (int i = 0; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		if ((fs->lookup_index[i].id != 0xFFFF) &&
+		    ((fs->lookup_index[i].addr >> ADDR_SECT_SHIFT) == sector)) {
+			num++;
+		}
+	}
+
+	return num;
+}
+
+static void check_index_ids(struct nvs_fs *fs, uint16_t num_ids)
+{
+	int err;
+	uint16_t data;
+
+	for (uint16_t id = 0; id < num_ids; id++) {
+		err = nvs_read(fs, id, &data, sizeof(data));
+		if (id % 4 == 0) {
+			zassert_equal(err, -ENOENT, "deleted ID %u found: %d", id, err);
+		} else {
+			zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+			zassert_equal(data, id, "incorrect data read");
+		}
+	}
+}
+#endif
+
+/*
+ * Test that when more NVS IDs are written than the NVS lookup index holds, they
+ * all can still be read and the deleted ones are not found, also after remounting.
+ */
+ZTEST_F(nvs, test_nvs_index_overflow)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	const uint16_t num_ids = CONFIG_NVS_LOOKUP_INDEX_SIZE + 8;
+	int err;
+	uint16_t data;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_false(fixture->fs.lookup_index_partial, "index partial on empty store");
+
+	for (uint16_t id = 0; id < num_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.lookup_index_partial, "index not partial after overflow");
+
+	for (uint16_t id = 0; id < num_ids; id += 4) {
+		err = nvs_delete(&fixture->fs, id);
+		zassert_true(err == 0, "nvs_delete call failure: %d", err);
+	}
+
+	check_index_ids(&fixture->fs, num_ids);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	check_index_ids(&fixture->fs, num_ids);
+#endif
+}
+
+/*
+ * Test that NVS lookup index follows the IDs moved by gc and does not contain
+ * any address from gc-ed sector
+ */
+ZTEST_F(nvs, test_nvs_index_gc)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t data = 0;
+	uint16_t data_1;
+	uint16_t read_data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) + sizeof(struct nvs_ate)
+	       <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+	data_1 = data;
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 1,
+		      "invalid index content after filling sector 0");
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* At this point sector 0 should have been gc-ed and ID 1 moved to sector 2 */
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 0,
+		      "index entries left in sector 0 after gc");
+	zassert_equal(num_index_entries_in_sector(2, &fixture->fs), 2,
+		      "invalid index content after gc");
+	zassert_equal(fixture->fs.lookup_index_count, 2, "invalid index size after gc");
+	zassert_false(fixture->fs.lookup_index_partial, "index partial after gc");
+
+	err = nvs_read(&fixture->fs, 1, &read_data, sizeof(read_data));
+	zassert_equal(err, sizeof(read_data), "nvs_read call failure: %d", err);
+	zassert_equal(read_data, data_1, "incorrect data read for ID 1");
+
+	err = nvs_read(&fixture->fs, 2, &read_data, sizeof(read_data));
+	zassert_equal(err, sizeof(read_data), "nvs_read call failure: %d", err);
+	zassert_equal(read_data, data, "incorrect data read for ID 2");
+#endif
+}
+
 /*
  * Test NVS bad region initialization recovery.
  */
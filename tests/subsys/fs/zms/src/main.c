@@ -133,6 +133,37 @@ ZTEST_F(zms, test_zms_write)
 	execute_long_pattern_write(TEST_DATA_ID, &fixture->fs);
 }
 
+/*
+ * Test that mounting recovers the data write address when the only ATE of the write
+ * sector is in its first slot, so that the next write does not overwrite its data
+ */
+ZTEST_F(zms, test_zms_remount_first_ate)
+{
+	int err;
+	ssize_t len;
+	uint8_t wr_buf[32];
+	uint8_t rd_buf[32];
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	memset(wr_buf, 0xaa, sizeof(wr_buf));
+	len = zms_write(&fixture->fs, TEST_DATA_ID, wr_buf, sizeof(wr_buf));
+	zassert_true(len == sizeof(wr_buf), "zms_write failed: %d", len);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	memset(wr_buf, 0x55, sizeof(wr_buf));
+	len = zms_write(&fixture->fs, TEST_DATA_ID + 1, wr_buf, sizeof(wr_buf));
+	zassert_true(len == sizeof(wr_buf), "zms_write failed: %d", len);
+
+	memset(wr_buf, 0xaa, sizeof(wr_buf));
+	len = zms_read(&fixture->fs, TEST_DATA_ID, rd_buf, sizeof(rd_buf));
+	zassert_true(len == sizeof(rd_buf), "zms_read unexpected failure: %d", len);
+	zassert_mem_equal(rd_buf, wr_buf, sizeof(rd_buf), "RD buff should be equal to the WR buff");
+}
+
 #ifdef CONFIG_TEST_ZMS_SIMULATOR
 static int flash_sim_write_calls_find(struct stats_hdr *hdr, void *arg, const char *name,
 				      uint16_t off)
@@ -167,6 +198,9 @@ ZTEST_F(zms, test_zms_corrupted_write)
 	char pattern_2[] = {0x03, 0xAA, 0x85, 0x6F};
 	uint32_t *flash_write_stat;
 	uint32_t *flash_max_write_calls;
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	struct k_work_sync sync;
+#endif
 
 	err = zms_mount(&fixture->fs);
 	zassert_true(err == 0, "zms_mount call failure: %d", err);
@@ -209,6 +243,10 @@ ZTEST_F(zms, test_zms_corrupted_write)
 	zassert_true(len == sizeof(wr_buf_2), "zms_write failed: %d", len);
 
 	/* Reinitialize the ZMS. */
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* The background GC work must not be queued anymore when wiping it */
+	(void)k_work_cancel_sync(&fixture->fs.gc_work, &sync);
+#endif
 	memset(&fixture->fs, 0, sizeof(fixture->fs));
 	(void)setup();
 	err = zms_mount(&fixture->fs);
@@ -889,3 +927,250 @@ ZTEST_F(zms, test_zms_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+static size_t num_index_entries_in_sector(uint32_t sector, struct zms_fs *fs)
+{
+	size_t num = 0;
+
+	for (int i = 0; i < CONFIG_ZMS_LOOKUP_INDEX_SIZE; i++) {
+		if ((fs->lookup_index[i].id != ZMS_HEAD_ID) &&
+		    (fs->lookup_index[i].sector == sector)) {
+			num++;
+		}
+	}
+
+	return num;
+}
+
+static void check_index_ids(struct zms_fs *fs, uint32_t num_ids)
+{
+	int err;
+	uint32_t data;
+
+	for (uint32_t id = 0; id < num_ids; id++) {
+		err = zms_read(fs, id, &data, sizeof(data));
+		if (id % 4 == 0) {
+			zassert_equal(err, -ENOENT, "deleted ID %u found: %d", id, err);
+		} else {
+			zassert_equal(err, sizeof(data), "zms_read call failure: %d", err);
+			zassert_equal(data, id, "incorrect data read");
+		}
+	}
+}
+#endif
+
+/*
+ * Test that when more ZMS IDs are written than the ZMS lookup index holds, they
+ * all can still be read and the deleted ones are not found, also after remounting.
+ */
+ZTEST_F(zms, test_zms_index_overflow)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	const uint32_t num_ids = CONFIG_ZMS_LOOKUP_INDEX_SIZE + 8;
+	int err;
+	uint32_t data;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_false(fixture->fs.lookup_index_partial, "index partial on empty store");
+
+	for (uint32_t id = 0; id < num_ids; id++) {
+		data = id;
+		err = zms_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.lookup_index_partial, "index not partial after overflow");
+
+	for (uint32_t id = 0; id < num_ids; id += 4) {
+		err = zms_delete(&fixture->fs, id);
+		zassert_true(err == 0, "zms_delete call failure: %d", err);
+	}
+
+	check_index_ids(&fixture->fs, num_ids);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	check_index_ids(&fixture->fs, num_ids);
+#endif
+}
+
+/*
+ * Test that ZMS lookup index follows the IDs moved by gc and does not contain
+ * any address from gc-ed sector
+ */
+ZTEST_F(zms, test_zms_index_gc)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	int err;
+	uint16_t data = 0;
+	uint16_t data_1;
+	uint16_t read_data;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) + sizeof(struct zms_ate) <=
+	       fixture->fs.ate_wra) {
+		++data;
+		err = zms_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+	data_1 = data;
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 1,
+		      "invalid index content after filling sector 0");
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = zms_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "zms_write call failure: %d", err);
+	}
+
+	/* At this point sector 0 should have been gc-ed and ID 1 moved to sector 2 */
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 0,
+		      "index entries left in sector 0 after gc");
+	zassert_equal(num_index_entries_in_sector(2, &fixture->fs), 2,
+		      "invalid index content after gc");
+	zassert_equal(fixture->fs.lookup_index_count, 2, "invalid index size after gc");
+	zassert_false(fixture->fs.lookup_index_partial, "index partial after gc");
+
+	err = zms_read(&fixture->fs, 1, &read_data, sizeof(read_data));
+	zassert_equal(err, sizeof(read_data), "zms_read call failure: %d", err);
+	zassert_equal(read_data, data_1, "incorrect data read for ID 1");
+
+	err = zms_read(&fixture->fs, 2, &read_data, sizeof(read_data));
+	zassert_equal(err, sizeof(read_data), "zms_read call failure: %d", err);
+	zassert_equal(read_data, data, "incorrect data read for ID 2");
+#endif
+}
+
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+static void wait_background_gc(struct zms_fs *fs)
+{
+	while (k_work_busy_get(&fs->gc_work)) {
+		k_msleep(1);
+	}
+}
+#endif
+
+/*
+ * Test that the garbage collection started by a write is done by the background
+ * work and that the content stays readable while it is pending
+ */
+ZTEST_F(zms, test_zms_background_gc)
+{
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	int err;
+	const uint16_t max_id = 10;
+	/* 41st write will trigger 1st GC. */
+	const uint16_t max_writes = 41;
+	/* 61st write will trigger 2nd GC. */
+	const uint16_t max_writes_2 = 41 + 20;
+
+	fixture->fs.sector_count = 3;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	write_content(max_id, 0, max_writes, &fixture->fs);
+
+	/* The test thread is cooperative, the background work did not run yet */
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2, "unexpected write sector");
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_PENDING, "gc should be pending");
+	check_content(max_id, &fixture->fs);
+
+	wait_background_gc(&fixture->fs);
+
+	zassert_not_equal(fixture->fs.gc_state, ZMS_GC_PENDING, "gc should be done");
+	check_content(max_id, &fixture->fs);
+
+	/* Writes keep going while the oldest sector is relocated */
+	write_content(max_id, max_writes, max_writes_2, &fixture->fs);
+	check_content(max_id, &fixture->fs);
+
+	wait_background_gc(&fixture->fs);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	check_content(max_id, &fixture->fs);
+#endif
+}
+
+/*
+ * Test that a background garbage collection interrupted by a reboot is resumed
+ * without losing the writes done while it was pending
+ */
+ZTEST_F(zms, test_zms_background_gc_resume)
+{
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	int err;
+	const uint16_t max_id = 10;
+	/* 41st write will trigger 1st GC. */
+	const uint16_t max_writes = 41;
+
+	fixture->fs.sector_count = 3;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	write_content(max_id, 0, max_writes, &fixture->fs);
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_PENDING, "gc should be pending");
+
+	/* Overwrite some IDs while the gc is pending */
+	write_content(max_id, max_writes, max_writes + 5, &fixture->fs);
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_PENDING, "gc should be pending");
+
+	/* Mount again before the background work could run */
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2, "unexpected write sector");
+	zassert_equal(fixture->fs.gc_state, ZMS_GC_PENDING, "gc should be resumed");
+	check_content(max_id, &fixture->fs);
+
+	wait_background_gc(&fixture->fs);
+
+	zassert_not_equal(fixture->fs.gc_state, ZMS_GC_PENDING, "gc should be done");
+	check_content(max_id, &fixture->fs);
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	check_content(max_id, &fixture->fs);
+#endif
+}
+
+/*
+ * Test that the sectors erased with background garbage collection are marked, so
+ * that a garbage collection interrupted in them is resumed by any build
+ */
+ZTEST_F(zms, test_zms_background_gc_flag)
+{
+	int err;
+	struct zms_ate empty_ate;
+	uint64_t sector;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+
+	sector = SECTOR_NUM(fixture->fs.ate_wra);
+	err = flash_read(fixture->fs.flash_device,
+			 fixture->fs.offset + (sector + 1) * fixture->fs.sector_size -
+				 fixture->fs.ate_size,
+			 &empty_ate, sizeof(empty_ate));
+	zassert_true(err == 0, "flash_read call failure: %d", err);
+
+	zassert_equal(empty_ate.id, ZMS_HEAD_ID, "no empty ATE in the write sector");
+	zassert_equal((empty_ate.metadata & ZMS_BACKGROUND_GC_FLAG) != 0,
+		      IS_ENABLED(CONFIG_ZMS_BACKGROUND_GC), "unexpected background gc flag");
+}
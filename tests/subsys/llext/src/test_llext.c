@@ -376,6 +376,16 @@ ZTEST(llext, test_inspect)
 	do_inspect_checks(ldr, ext, LLEXT_MEM_RODATA, ".my_rodata", "number_in_my_rodata");
 	do_inspect_checks(ldr, ext, LLEXT_MEM_TEXT, ".text", "function_in_text");
 
+#ifdef CONFIG_LLEXT_STORAGE_XIP
+	/* String tables are used in place, writable data is always copied */
+	zassert_false(ext->mem_on_heap[LLEXT_MEM_STRTAB], "strtab should be used in place");
+	zassert_true((uintptr_t)ext->mem[LLEXT_MEM_STRTAB] >= (uintptr_t)inspect_ext &&
+		     (uintptr_t)ext->mem[LLEXT_MEM_STRTAB] <
+		     (uintptr_t)inspect_ext + sizeof(inspect_ext),
+		     "strtab should be in the ELF buffer");
+	zassert_true(ext->mem_on_heap[LLEXT_MEM_DATA], "data should be copied");
+#endif
+
 	max_alloc_bytes = ext->alloc_size;
 	llext_free_inspection_data(ldr, ext);
 	zassert_true(ext->alloc_size < max_alloc_bytes, "inspection data should be freed");
@@ -780,6 +780,106 @@ ZTEST(rtio_api, test_rtio_callback_chaining)
 	test_rtio_callback_chaining_(&r_callback_chaining);
 }
 
+RTIO_DEFINE(r_timeout, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+static void check_timeout_cqe(struct rtio *r, uintptr_t *userdata, int result)
+{
+	struct rtio_cqe cqe;
+
+	zassert_equal(1, rtio_cqe_copy_out(r, &cqe, 1, K_MSEC(100)), "Expected a CQE");
+	zassert_equal_ptr(cqe.userdata, userdata, "Unexpected CQE");
+	zassert_equal(cqe.result, result, "Unexpected result %d", cqe.result);
+}
+
+/**
+ * @brief Test a delay chained to an operation
+ *
+ * Ensures the operation chained to a delay only starts once the delay expired.
+ */
+ZTEST(rtio_api, test_rtio_delay)
+{
+	uintptr_t userdata[2] = {0, 1};
+	struct rtio_sqe sqe[2];
+	struct rtio_cqe cqe;
+
+	rtio_sqe_prep_delay(&sqe[0], K_MSEC(30), &userdata[0]);
+	sqe[0].flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_nop(&sqe[1], (struct rtio_iodev *)&iodev_test_simple, &userdata[1]);
+	zassert_ok(rtio_sqe_copy_in(&r_timeout, sqe, 2));
+	zassert_ok(rtio_submit(&r_timeout, 0));
+
+	zassert_equal(0, rtio_cqe_copy_out(&r_timeout, &cqe, 1, K_MSEC(15)), "Early CQE");
+
+	check_timeout_cqe(&r_timeout, &userdata[0], 0);
+	check_timeout_cqe(&r_timeout, &userdata[1], 0);
+	zassert_equal(SQE_POOL_SIZE, rtio_sqe_acquirable(&r_timeout));
+}
+
+ZTEST(rtio_api, test_rtio_delay_cancel)
+{
+	uintptr_t userdata = 0;
+	struct rtio_sqe sqe;
+	struct rtio_sqe *handle;
+	struct rtio_cqe cqe;
+
+	rtio_sqe_prep_delay(&sqe, K_SECONDS(10), &userdata);
+	zassert_ok(rtio_sqe_copy_in_get_handles(&r_timeout, &sqe, &handle, 1));
+	zassert_ok(rtio_submit(&r_timeout, 0));
+
+	/* The waiting delay is released right away, without a CQE */
+	zassert_ok(rtio_sqe_cancel(handle));
+	zassert_equal(SQE_POOL_SIZE, rtio_sqe_acquirable(&r_timeout));
+	zassert_equal(0, rtio_cqe_copy_out(&r_timeout, &cqe, 1, K_MSEC(15)), "Unexpected CQE");
+}
+
+/**
+ * @brief Test a linked timeout expiring during its chain
+ *
+ * Each test iodev operation takes 10ms, so the timeout expires while the
+ * second operation is in progress, which completes, and the third one is
+ * canceled.
+ */
+ZTEST(rtio_api, test_rtio_link_timeout)
+{
+	uintptr_t userdata[4] = {0, 1, 2, 3};
+	struct rtio_sqe sqe[4];
+
+	rtio_sqe_prep_link_timeout(&sqe[0], K_MSEC(15), &userdata[0]);
+	for (int i = 1; i < ARRAY_SIZE(sqe); i++) {
+		rtio_sqe_prep_nop(&sqe[i], (struct rtio_iodev *)&iodev_test_simple, &userdata[i]);
+		sqe[i].flags |= (i < ARRAY_SIZE(sqe) - 1) ? RTIO_SQE_CHAINED : 0;
+	}
+	zassert_ok(rtio_sqe_copy_in(&r_timeout, sqe, ARRAY_SIZE(sqe)));
+	zassert_ok(rtio_submit(&r_timeout, 0));
+
+	check_timeout_cqe(&r_timeout, &userdata[1], 0);
+	check_timeout_cqe(&r_timeout, &userdata[0], -ETIMEDOUT);
+	check_timeout_cqe(&r_timeout, &userdata[2], 0);
+	check_timeout_cqe(&r_timeout, &userdata[3], -ECANCELED);
+	zassert_equal(SQE_POOL_SIZE, rtio_sqe_acquirable(&r_timeout));
+}
+
+ZTEST(rtio_api, test_rtio_link_timeout_in_time)
+{
+	uintptr_t userdata[3] = {0, 1, 2};
+	struct rtio_sqe sqe[3];
+	struct rtio_cqe cqe;
+
+	rtio_sqe_prep_link_timeout(&sqe[0], K_MSEC(100), &userdata[0]);
+	rtio_sqe_prep_nop(&sqe[1], (struct rtio_iodev *)&iodev_test_simple, &userdata[1]);
+	sqe[1].flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_nop(&sqe[2], (struct rtio_iodev *)&iodev_test_simple, &userdata[2]);
+	zassert_ok(rtio_sqe_copy_in(&r_timeout, sqe, ARRAY_SIZE(sqe)));
+	zassert_ok(rtio_submit(&r_timeout, 0));
+
+	/* The timeout completes with the chain, and does not expire later */
+	check_timeout_cqe(&r_timeout, &userdata[1], 0);
+	check_timeout_cqe(&r_timeout, &userdata[2], 0);
+	check_timeout_cqe(&r_timeout, &userdata[0], 0);
+	zassert_equal(SQE_POOL_SIZE, rtio_sqe_acquirable(&r_timeout));
+	zassert_equal(0, rtio_cqe_copy_out(&r_timeout, &cqe, 1, K_MSEC(150)), "Unexpected CQE");
+}
+
 static void *rtio_api_setup(void)
 {
 #ifdef CONFIG_USERSPACE
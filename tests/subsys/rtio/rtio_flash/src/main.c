@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/storage/flash_map.h>
+
+#define TEST_OFFSET FIXED_PARTITION_OFFSET(storage_partition)
+#define TEST_SIZE   FIXED_PARTITION_SIZE(storage_partition)
+
+#define NUM_WRITES 4
+#define WRITE_SIZE 64
+
+#define WAIT_TIME K_MSEC(500)
+
+FLASH_IODEV_DEFINE(flash_iodev, FIXED_PARTITION_DEVICE(storage_partition));
+
+RTIO_DEFINE(r, 2 * NUM_WRITES, 2 * NUM_WRITES);
+
+static uint8_t write_buf[NUM_WRITES][WRITE_SIZE];
+static uint8_t read_buf[NUM_WRITES][WRITE_SIZE];
+
+static struct rtio_cqe wait_cqe(void *userdata)
+{
+	struct rtio_cqe cqe;
+
+	zassert_equal(rtio_cqe_copy_out(&r, &cqe, 1, WAIT_TIME), 1, "No completion");
+	zassert_equal_ptr(cqe.userdata, userdata, "Unexpected completion");
+
+	return cqe;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < NUM_WRITES; i++) {
+		memset(write_buf[i], i + 1, WRITE_SIZE);
+	}
+
+	memset(read_buf, 0, sizeof(read_buf));
+}
+
+ZTEST(rtio_flash, test_erase_write_verify)
+{
+	struct rtio_sqe sqes[3];
+	struct rtio_cqe cqe;
+
+	/* Erase the storage, then write it and read it back */
+	rtio_sqe_prep_erase(&sqes[0], &flash_iodev, RTIO_PRIO_NORM, TEST_OFFSET, TEST_SIZE,
+			    &sqes[0]);
+	sqes[0].flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_write_at(&sqes[1], &flash_iodev, RTIO_PRIO_NORM, TEST_OFFSET, write_buf[0],
+			       WRITE_SIZE, &sqes[1]);
+	sqes[1].flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_read_at(&sqes[2], &flash_iodev, RTIO_PRIO_NORM, TEST_OFFSET, read_buf[0],
+			      WRITE_SIZE, &sqes[2]);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (int i = 0; i < ARRAY_SIZE(sqes); i++) {
+		cqe = wait_cqe(&sqes[i]);
+		zassert_ok(cqe.result, "Submission %d failed (%d)", i, cqe.result);
+	}
+
+	zassert_mem_equal(read_buf[0], write_buf[0], WRITE_SIZE);
+}
+
+ZTEST(rtio_flash, test_batch)
+{
+	struct rtio_sqe sqes[2 * NUM_WRITES];
+	struct rtio_sqe *sqe = sqes;
+	struct rtio_cqe cqe;
+
+	zassert_ok(flash_erase(FIXED_PARTITION_DEVICE(storage_partition), TEST_OFFSET, TEST_SIZE));
+
+	/* Unchained writes and reads, which are done in submission order */
+	for (int i = 0; i < NUM_WRITES; i++) {
+		rtio_sqe_prep_write_at(sqe, &flash_iodev, RTIO_PRIO_NORM,
+				       TEST_OFFSET + i * WRITE_SIZE, write_buf[i], WRITE_SIZE, sqe);
+		sqe++;
+	}
+
+	for (int i = 0; i < NUM_WRITES; i++) {
+		rtio_sqe_prep_read_at(sqe, &flash_iodev, RTIO_PRIO_NORM,
+				      TEST_OFFSET + i * WRITE_SIZE, read_buf[i], WRITE_SIZE, sqe);
+		sqe++;
+	}
+
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, ARRAY_SIZE(sqes)));
+
+	for (int i = 0; i < ARRAY_SIZE(sqes); i++) {
+		cqe = wait_cqe(&sqes[i]);
+		zassert_ok(cqe.result, "Submission %d failed (%d)", i, cqe.result);
+	}
+
+	zassert_mem_equal(read_buf, write_buf, sizeof(write_buf));
+}
+
+ZTEST(rtio_flash, test_transaction_error)
+{
+	struct rtio_sqe sqes[2];
+	struct rtio_cqe cqe;
+
+	/* A failing erase cancels the write of the same transaction */
+	rtio_sqe_prep_erase(&sqes[0], &flash_iodev, RTIO_PRIO_NORM, TEST_OFFSET + 1, TEST_SIZE,
+			    &sqes[0]);
+	sqes[0].flags |= RTIO_SQE_TRANSACTION;
+	rtio_sqe_prep_write_at(&sqes[1], &flash_iodev, RTIO_PRIO_NORM, TEST_OFFSET, write_buf[0],
+			       WRITE_SIZE, &sqes[1]);
+	zassert_ok(rtio_sqe_copy_in(&r, sqes, ARRAY_SIZE(sqes)));
+	zassert_ok(rtio_submit(&r, 0));
+
+	cqe = wait_cqe(&sqes[0]);
+	zassert_true(cqe.result < 0, "Unaligned erase succeeded");
+
+	cqe = wait_cqe(&sqes[1]);
+	zassert_equal(cqe.result, -ECANCELED, "Unexpected result (%d)", cqe.result);
+}
+
+ZTEST_SUITE(rtio_flash, NULL, NULL, before, NULL, NULL);
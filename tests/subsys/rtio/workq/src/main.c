@@ -39,7 +39,19 @@ struct rtio_iodev_api r_iodev_test_api = {
 	.submit = dummy_submit,
 };
 
+static struct rtio_work_queue dummy_queue = RTIO_WORK_QUEUE_INIT(dummy_queue);
+
+static void dummy_queued_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	rtio_work_queue_submit(&dummy_queue, iodev_sqe, work_handler);
+}
+
+struct rtio_iodev_api r_iodev_queued_test_api = {
+	.submit = dummy_queued_submit,
+};
+
 RTIO_IODEV_DEFINE(dummy_iodev, &r_iodev_test_api, NULL);
+RTIO_IODEV_DEFINE(dummy_queued_iodev, &r_iodev_queued_test_api, NULL);
 RTIO_IODEV_DEFINE(dummy_iodev_2, &r_iodev_test_api, NULL);
 RTIO_IODEV_DEFINE(dummy_iodev_3, &r_iodev_test_api, NULL);
 
@@ -170,6 +182,52 @@ ZTEST(rtio_work, test_work_supports_preempting_on_higher_prio_submissions)
 	rtio_cqe_release(&r_test_3, cqe);
 }
 
+ZTEST(rtio_work, test_work_queue_serializes_submissions)
+{
+	struct rtio_sqe *sqe_a;
+	struct rtio_sqe *sqe_b;
+	struct rtio_sqe *sqe_c;
+	struct rtio_cqe *cqe;
+
+	sqe_a = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_a, &dummy_queued_iodev, &work_handler_sem_1);
+	sqe_a->prio = RTIO_PRIO_NORM;
+
+	sqe_b = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_b, &dummy_queued_iodev, &work_handler_sem_2);
+	sqe_b->prio = RTIO_PRIO_NORM;
+
+	sqe_c = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_c, &dummy_queued_iodev, &work_handler_sem_3);
+	sqe_c->prio = RTIO_PRIO_NORM;
+
+	zassert_ok(rtio_submit(&r_test, 0));
+
+	/** Only the first submission is handled, the others wait in the queue */
+	zassert_equal(1, work_handler_called);
+	zassert_equal(1, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_1);
+	zassert_equal(2, work_handler_called);
+	zassert_equal(1, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_2);
+	k_sem_give(&work_handler_sem_3);
+	zassert_equal(3, work_handler_called);
+	zassert_equal(0, rtio_work_req_used_count_get());
+
+	/** Completions come in submission order */
+	cqe = rtio_cqe_consume_block(&r_test);
+	zassert_equal_ptr(&work_handler_sem_1, cqe->userdata);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test);
+	zassert_equal_ptr(&work_handler_sem_2, cqe->userdata);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test);
+	zassert_equal_ptr(&work_handler_sem_3, cqe->userdata);
+	rtio_cqe_release(&r_test, cqe);
+}
+
 ZTEST(rtio_work, test_used_count_keeps_track_of_alloc_items)
 {
 	struct rtio_work_req *req_a = NULL;
@@ -23,4 +23,75 @@ ZTEST(settings_functional, test_setting_storage_get)
 
 	zassert_true(nvs_rc >= 0, "Can't read nvs record (err=%d).", rc);
 }
+
+int settings_deregister(struct settings_handler *handler);
+
+static unsigned int outside_set_calls;
+static uint8_t outside_val;
+
+static int outside_set(const char *key, size_t len, settings_read_cb read_cb,
+		       void *cb_arg)
+{
+	outside_set_calls++;
+
+	if (len != sizeof(outside_val)) {
+		return -EINVAL;
+	}
+
+	return read_cb(cb_arg, &outside_val, sizeof(outside_val)) == sizeof(outside_val) ?
+	       0 : -EIO;
+}
+
+static struct settings_handler outside_settings = {
+	.name = "outside",
+	.h_set = outside_set,
+};
+
+/* Names skipped by a subtree load must still be found by saves and deletes */
+ZTEST(settings_functional, test_save_delete_outside_loaded_subtree)
+{
+	uint8_t val = 1;
+	int rc;
+
+	rc = settings_subsys_init();
+	zassert_equal(0, rc, "subsys init failed (err=%d)", rc);
+
+	rc = settings_register(&outside_settings);
+	zassert_equal(0, rc, "register of outside settings failed (err=%d)", rc);
+
+	rc = settings_save_one("inside/val", &val, sizeof(val));
+	zassert_equal(0, rc, "save of inside/val failed (err=%d)", rc);
+	rc = settings_save_one("outside/val", &val, sizeof(val));
+	zassert_equal(0, rc, "save of outside/val failed (err=%d)", rc);
+
+	rc = settings_load_subtree("inside");
+	zassert_equal(0, rc, "subtree load failed (err=%d)", rc);
+
+	/* Saving again must update the stored name, not add another one */
+	val = 2;
+	rc = settings_save_one("outside/val", &val, sizeof(val));
+	zassert_equal(0, rc, "save of outside/val failed (err=%d)", rc);
+
+	outside_set_calls = 0;
+	rc = settings_load_subtree("outside");
+	zassert_equal(0, rc, "subtree load failed (err=%d)", rc);
+	zassert_equal(1, outside_set_calls, "outside/val stored %u times",
+		      outside_set_calls);
+	zassert_equal(2, outside_val, "wrong value loaded for outside/val");
+
+	rc = settings_load_subtree("inside");
+	zassert_equal(0, rc, "subtree load failed (err=%d)", rc);
+
+	rc = settings_delete("outside/val");
+	zassert_equal(0, rc, "delete of outside/val failed (err=%d)", rc);
+
+	outside_set_calls = 0;
+	rc = settings_load_subtree("outside");
+	zassert_equal(0, rc, "subtree load failed (err=%d)", rc);
+	zassert_equal(0, outside_set_calls, "outside/val not deleted");
+
+	(void)settings_delete("inside/val");
+	(void)settings_deregister(&outside_settings);
+}
+
 ZTEST_SUITE(settings_functional, NULL, NULL, NULL, NULL, NULL);
@@ -12,6 +12,9 @@
 #include "../../../lib/crc/crc32c_sw.c"
 #include "../../../lib/crc/crc7_sw.c"
 #include "../../../lib/crc/crc24_sw.c"
+#if defined(CONFIG_CRC_SPEED_OPTIMIZED)
+#include "../../../lib/crc/crc_tables.c"
+#endif
 
 ZTEST(crc, test_crc32c)
 {
@@ -292,4 +295,52 @@ ZTEST(crc, test_crc8)
 	zassert_equal(fcs, expected, "0x%02x vs 0x%02x", fcs, expected);
 }
 
+static uint32_t crc32_reflect_bitwise(uint32_t poly, uint32_t crc,
+				      const uint8_t *src, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= src[i];
+
+		for (int j = 0; j < 8; j++) {
+			crc = (crc & 1U) ? (crc >> 1) ^ poly : crc >> 1;
+		}
+	}
+
+	return crc;
+}
+
+ZTEST(crc, test_crc_long_buffers)
+{
+	static uint8_t data[1024];
+	uint32_t state = 0x2545f491;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		state = state * 1103515245U + 12345U;
+		data[i] = state >> 16;
+	}
+
+	/* Every alignment and length around the 8 byte steps */
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t len = 0; len < 80; len++) {
+			const uint8_t *src = data + offset;
+
+			zassert_equal(crc32_ieee_update(0x12345678, src, len),
+				      ~crc32_reflect_bitwise(0xEDB88320, ~0x12345678U,
+							     src, len));
+			zassert_equal(crc32_c(0x12345678, src, len, false, false),
+				      crc32_reflect_bitwise(0x82F63B78, 0x12345678,
+							    src, len));
+			zassert_equal(crc16_ccitt(0x1234, src, len),
+				      crc16_reflect(0x8408, 0x1234, src, len));
+			zassert_equal(crc16_itu_t(0x1234, src, len),
+				      crc16(0x1021, 0x1234, src, len));
+		}
+	}
+
+	zassert_equal(crc32_ieee(data, sizeof(data)),
+		      ~crc32_reflect_bitwise(0xEDB88320, ~0U, data, sizeof(data)));
+	zassert_equal(crc32_c(0, data, sizeof(data), true, true),
+		      ~crc32_reflect_bitwise(0x82F63B78, ~0U, data, sizeof(data)));
+}
+
 ZTEST_SUITE(crc, NULL, NULL, NULL, NULL, NULL);